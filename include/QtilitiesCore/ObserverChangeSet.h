@@ -0,0 +1 @@
+#include "../../src/Core/source/ObserverChangeSet.h"
@@ -0,0 +1 @@
+#include "../../src/CoreGui/source/ObserverSearchIndex.h"
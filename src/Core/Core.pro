@@ -39,6 +39,7 @@ HEADERS += \
     source/FileLocker.h \
     source/FileSetInfo.h \
     source/FileUtils.h \
+    source/FileWatchService.h \
     source/GenericProperty.h \
     source/GenericPropertyManager.h \
     source/IAvailablePropertyProvider.h \
@@ -56,6 +57,7 @@ HEADERS += \
     source/ITaskContainer.h \
     source/ITask.h \
     source/ObjectManager.h \
+    source/ObserverChangeSet.h \
     source/ObserverData.h \
     source/ObserverDotWriter.h \
     source/Observer.h \
@@ -88,6 +90,7 @@ SOURCES += \
     source/FileLocker.cpp \
     source/FileSetInfo.cpp \
     source/FileUtils.cpp \
+    source/FileWatchService.cpp \
     source/GenericProperty.cpp \
     source/GenericPropertyManager.cpp \
     source/IExportable.cpp \
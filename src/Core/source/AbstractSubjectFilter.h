@@ -174,6 +174,44 @@ namespace Qtilities {
                 Q_UNUSED(detachment_successful)
                 Q_UNUSED(subject_deleted)
             }
+            //! Initialize the detachment of a batch of subjects from the filter's observer context.
+            /*!
+                Observer calls this function instead of initializeDetachment() when all its subjects are detached or deleted at once
+                in Observer::detachAll() and Observer::deleteAll(). Filters which can handle a batch more efficiently than one subject at
+                a time should reimplement this function together with finalizeBatchDetachment().
+
+                \param objects The objects to be detached. The objects are still alive when this function is called.
+                \param rejectMsg A reject message when the initialization fails.
+                \param subjects_deleted Indicates if the objects will be deleted after they were detached.
+                \returns True if the detachment of all objects is allowed, false otherwise. When false is returned during Observer::detachAll(), the observer
+                detaches the subjects one at a time instead.
+
+                \note By default initializeDetachment() is called for each object.
+
+                <i>This function was added in %Qtilities v1.5.</i>
+              */
+            virtual bool initializeBatchDetachment(const QList<QObject*>& objects, QString* rejectMsg = 0, bool subjects_deleted = false) {
+                bool success = true;
+                for (int i = 0; i < objects.count(); ++i) {
+                    if (!initializeDetachment(objects.at(i),rejectMsg,subjects_deleted))
+                        success = false;
+                }
+                return success;
+            }
+            //! Finalize the detachment of a batch of subjects from the filter's observer context.
+            /*!
+                \param objects The objects which were detached. The objects are still alive when this function is called.
+                \param detachment_successful True if the detachment was successfull, false otherwise.
+                \param subjects_deleted Indicates if the objects will be deleted after they were detached. In this case the objects were already removed from the observer context.
+
+                \note By default finalizeDetachment() is called for each object.
+
+                <i>This function was added in %Qtilities v1.5.</i>
+              */
+            virtual void finalizeBatchDetachment(const QList<QObject*>& objects, bool detachment_successful, bool subjects_deleted = false) {
+                for (int i = 0; i < objects.count(); ++i)
+                    finalizeDetachment(objects.at(i),detachment_successful,subjects_deleted);
+            }
 
         protected:
             //! Function which should react to QDynamicPropertyChangeEvents on properties which are reserved by the subject filter.
@@ -17,6 +17,7 @@
 #include <Logger.h>
 
 #include <QVariant>
+#include <QSet>
 #include <QCoreApplication>
 #include <QDomElement>
 
@@ -671,6 +672,61 @@ void Qtilities::Core::ActivityPolicyFilter::finalizeDetachment(QObject* obj, boo
         setModificationState(true,IModificationNotifier::NotifyNone);
 }
 
+void Qtilities::Core::ActivityPolicyFilter::finalizeBatchDetachment(const QList<QObject*>& objects, bool detachment_successful, bool subjects_deleted) {
+    #ifndef QT_NO_DEBUG
+        Q_ASSERT(observer != 0);
+    #endif
+
+    if ((!detachment_successful && !subjects_deleted) || objects.isEmpty())
+        return;
+
+    // Ensure that property changes are not handled by the QDynamicPropertyChangeEvent handler.
+    filter_mutex.tryLock();
+    QObject* new_active_subject = 0;
+    if (d->minimum_activity_policy == ActivityPolicyFilter::ProhibitNoneActive) {
+        bool detached_active_subject = false;
+        for (int i = 0; i < objects.count(); ++i) {
+            if (observer->getMultiContextPropertyValue(objects.at(i),qti_prop_ACTIVITY_MAP).toBool()) {
+                detached_active_subject = true;
+                break;
+            }
+        }
+
+        if (detached_active_subject) {
+            // The objects might still be attached to the observer when they are not deleted, thus only consider the remaining subjects:
+            QSet<QObject*> detached_objects = objects.toSet();
+            bool remaining_active_subject = false;
+            QObject* first_remaining_subject = 0;
+            for (int i = 0; i < observer->subjectCount(); ++i) {
+                QObject* subject = observer->subjectAt(i);
+                if (detached_objects.contains(subject))
+                    continue;
+                if (!first_remaining_subject)
+                    first_remaining_subject = subject;
+                if (observer->getMultiContextPropertyValue(subject,qti_prop_ACTIVITY_MAP).toBool()) {
+                    remaining_active_subject = true;
+                    break;
+                }
+            }
+
+            if (!remaining_active_subject && first_remaining_subject && ObjectManager::propertyExists(first_remaining_subject,qti_prop_ACTIVITY_MAP))
+                new_active_subject = first_remaining_subject;
+        }
+    }
+
+    // Unlock the filter mutex.
+    filter_mutex.unlock();
+
+    if (new_active_subject)
+        setActiveSubject(new_active_subject);
+
+    if (!observer->isProcessingCycleActive()) {
+        emit activeSubjectsChanged(activeSubjects(),inactiveSubjects());
+        setModificationState(true);
+    } else
+        setModificationState(true,IModificationNotifier::NotifyNone);
+}
+
 QStringList Qtilities::Core::ActivityPolicyFilter::monitoredProperties() const {
     QStringList reserved_properties;
     reserved_properties << QString(qti_prop_ACTIVITY_MAP);
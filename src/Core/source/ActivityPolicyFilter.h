@@ -232,6 +232,11 @@ ActivityPolicyFilter* activity_filter = tree_node->enableActivityControl(Observe
             bool initializeAttachment(QObject* obj, QString* rejectMsg = 0, bool import_cycle = false);
             void finalizeAttachment(QObject* obj, bool attachment_successful, bool import_cycle = false);
             void finalizeDetachment(QObject* obj, bool detachment_successful, bool subject_deleted = false);
+            //! Checks the activity of the remaining subjects once for the complete batch.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void finalizeBatchDetachment(const QList<QObject*>& objects, bool detachment_successful, bool subjects_deleted = false);
             QString filterName() const { return qti_def_FACTORY_TAG_ACTIVITY_FILTER; }
             QStringList monitoredProperties() const;
         protected:
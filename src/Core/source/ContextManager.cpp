@@ -16,6 +16,7 @@
 #include <Logger.h>
 
 #include <QList>
+#include <QBitArray>
 #include <QtDebug>
 #include <QPointer>
 #include <QCoreApplication>
@@ -31,6 +32,43 @@ struct Qtilities::Core::ContextManagerPrivateData {
 
     QList<int> active_contexts;
     QList<int> contexts;
+    //! The registered contexts as a bit array indexed by context ID.
+    QBitArray registered_context_bits;
+    //! The active contexts as a bit array indexed by context ID.
+    QBitArray active_context_bits;
+
+    //! Sets the bit for \p context_id in \p bits, growing the array when needed.
+    static void setContextBit(QBitArray& bits, int context_id, bool value) {
+        if (context_id < 0)
+            return;
+        if (context_id >= bits.size()) {
+            if (!value)
+                return;
+            bits.resize(context_id + 1);
+        }
+        bits.setBit(context_id,value);
+    }
+    //! Tests the bit for \p context_id in \p bits.
+    static bool testContextBit(const QBitArray& bits, int context_id) {
+        return (context_id >= 0 && context_id < bits.size() && bits.testBit(context_id));
+    }
+
+    void addRegisteredContext(int context_id) {
+        contexts.push_front(context_id);
+        setContextBit(registered_context_bits,context_id,true);
+    }
+    void removeRegisteredContext(int context_id) {
+        contexts.removeOne(context_id);
+        setContextBit(registered_context_bits,context_id,false);
+    }
+    void appendActiveContext(int context_id) {
+        active_contexts.append(context_id);
+        setContextBit(active_context_bits,context_id,true);
+    }
+    void clearActiveContexts() {
+        active_contexts.clear();
+        active_context_bits.fill(false);
+    }
 };
 
 Qtilities::Core::ContextManager::ContextManager(QObject* parent) : IContextManager(parent)
@@ -39,7 +77,7 @@ Qtilities::Core::ContextManager::ContextManager(QObject* parent) : IContextManag
     setObjectName("Context Manager");
 
     // Add the standard context
-    d->contexts.push_front(contextID(qti_def_CONTEXT_STANDARD));
+    d->addRegisteredContext(contextID(qti_def_CONTEXT_STANDARD));
     setNewContext(qti_def_CONTEXT_STANDARD);
 }
 
@@ -48,8 +86,8 @@ int Qtilities::Core::ContextManager::registerContext(const QString& context, con
     if (id == -1)
         return -1;
 
-    if (!d->contexts.contains(id)) {
-        d->contexts.push_front(id);
+    if (!ContextManagerPrivateData::testContextBit(d->registered_context_bits,id)) {
+        d->addRegisteredContext(id);
         d->string_help_id_map[context] = context_help_id;
         if (context_help_id.isEmpty())
             LOG_TRACE("Context Manager: Registering new context: " + context + " with ID " + QString::number(id) + ".");
@@ -68,11 +106,11 @@ bool Qtilities::Core::ContextManager::unregisterContext(int context_id, bool not
         emit aboutToUnregisterContext(context_id);
 
     // Check if its an active context:
-    if (activeContexts().contains(context_id))
+    if (ContextManagerPrivateData::testContextBit(d->active_context_bits,context_id))
         removeContext(context_id,notify);
 
     // Now remove it:
-    d->contexts.removeOne(context_id);
+    d->removeRegisteredContext(context_id);
 
     // Notice that we always emit the following, this is needed because action manager needs it:
     emit finishedUnregisterContext(context_id);
@@ -101,15 +139,15 @@ QStringList Qtilities::Core::ContextManager::activeContextNames() const {
 }
 
 bool Qtilities::Core::ContextManager::hasContext(QList<int> context) const {
-    for (int i=0; i< d->contexts.count(); ++i) {
-        if (context.contains(d->contexts.at(i)))
+    for (int i = 0; i < context.count(); ++i) {
+        if (ContextManagerPrivateData::testContextBit(d->registered_context_bits,context.at(i)))
             return true;
     }
     return false;
 }
 
 bool Qtilities::Core::ContextManager::hasContext(int context) const {
-    return d->contexts.contains(context);
+    return ContextManagerPrivateData::testContextBit(d->registered_context_bits,context);
 }
 
 bool Qtilities::Core::ContextManager::hasContext(const QString& context_string) const {
@@ -117,12 +155,8 @@ bool Qtilities::Core::ContextManager::hasContext(const QString& context_string)
 }
 
 void Qtilities::Core::ContextManager::setNewContext(int context, bool notify) {
-    if (d->active_contexts.contains(context) && !notify) {
-        LOG_TRACE("Context already active, the following contexts are currently active:");
-        for (int i = 0; i < activeContexts().size(); ++i) {
-            QString debug_string = QString("- %1 - ID: %2, Name: %3").arg(i).arg(activeContexts().at(i)).arg(contextName(activeContexts().at(i)));
-            LOG_TRACE(debug_string);
-        }
+    if (ContextManagerPrivateData::testContextBit(d->active_context_bits,context) && !notify) {
+        logActiveContexts("Context already active, the following contexts are currently active:");
         return;
     }
 
@@ -130,18 +164,14 @@ void Qtilities::Core::ContextManager::setNewContext(int context, bool notify) {
         emit aboutToSetNewContext(context);
 
     // Clear contexts, and add standard.
-    d->active_contexts.clear();
+    d->clearActiveContexts();
     if (context != 0)
-        d->active_contexts.append(0);
+        d->appendActiveContext(0);
 
     // If a valid context is not sent, we just set the context to the standard context.
-    if (d->contexts.contains(context)) {
-        d->active_contexts.append(context);
-        LOG_TRACE("Context set to new, the following contexts are currently active:");
-        for (int i = 0; i < activeContexts().size(); ++i) {
-            QString debug_string = QString("- %1 - ID: %2, Name: %3").arg(i).arg(activeContexts().at(i)).arg(contextName(activeContexts().at(i)));
-            LOG_TRACE(debug_string);
-        }
+    if (ContextManagerPrivateData::testContextBit(d->registered_context_bits,context)) {
+        d->appendActiveContext(context);
+        logActiveContexts("Context set to new, the following contexts are currently active:");
     } else
         LOG_WARNING(tr("Attempting to set new unregistered context in function setNewContext with ID: ") + context);
 
@@ -156,30 +186,20 @@ void Qtilities::Core::ContextManager::setNewContext(int context, bool notify) {
 }
 
 void Qtilities::Core::ContextManager::appendContext(int context, bool notify) {
-    if (d->contexts.contains(context)) {
-        if (d->active_contexts.contains(context)) {
-            LOG_TRACE("Context already active, the following contexts are currently active:");
-            for (int i = 0; i < activeContexts().size(); ++i) {
-                QString debug_string = QString("- %1 - ID: %2, Name: %3").arg(i).arg(activeContexts().at(i)).arg(contextName(activeContexts().at(i)));
-                LOG_TRACE(debug_string);
-            }
+    if (ContextManagerPrivateData::testContextBit(d->registered_context_bits,context)) {
+        if (ContextManagerPrivateData::testContextBit(d->active_context_bits,context)) {
+            logActiveContexts("Context already active, the following contexts are currently active:");
             return;
         }
 
         if (notify)
             emit aboutToAppendContext(context);
-        d->active_contexts.append(context);
+        d->appendActiveContext(context);
 
         if (notify)
             emit contextChanged(activeContexts());
 
-        #ifndef QT_NO_DEBUG
-        LOG_TRACE("Context appended, the following contexts are currently active:");
-        for (int i = 0; i < activeContexts().size(); ++i) {
-            QString debug_string = QString("%1 - ID: %2, Name: %3").arg(i).arg(activeContexts().at(i)).arg(contextName(activeContexts().at(i)));
-            LOG_TRACE(debug_string);
-        }
-        #endif
+        logActiveContexts("Context appended, the following contexts are currently active:");
 
         if (notify)
             emit finishedAppendContext(context);
@@ -197,24 +217,18 @@ void Qtilities::Core::ContextManager::removeContext(int context, bool notify) {
     if (context == contextID(qti_def_CONTEXT_STANDARD))
         return;
 
-    for (int i = 0; i < d->active_contexts.count(); ++i) {
-        if (d->active_contexts.at(i) == context) {
-            emit aboutToRemoveContext(context);
-            d->active_contexts.removeAt(i);
-
-            #ifndef QT_NO_DEBUG
-            LOG_TRACE("Context removed, the following contexts are currently active:");
-            for (int i = 0; i < activeContexts().size(); ++i) {
-                QString debug_string = QString("- %1 - ID: %2, Name: %3").arg(i).arg(activeContexts().at(i)).arg(contextName(activeContexts().at(i)));
-                LOG_TRACE(debug_string);
-            }
-            #endif
-
-            if (notify) {
-                emit finishedRemoveContext(context);
-                emit contextChanged(activeContexts());
-            }
-        }
+    if (!ContextManagerPrivateData::testContextBit(d->active_context_bits,context))
+        return;
+
+    emit aboutToRemoveContext(context);
+    d->active_contexts.removeAll(context);
+    ContextManagerPrivateData::setContextBit(d->active_context_bits,context,false);
+
+    logActiveContexts("Context removed, the following contexts are currently active:");
+
+    if (notify) {
+        emit finishedRemoveContext(context);
+        emit contextChanged(activeContexts());
     }
 }
 
@@ -286,11 +300,23 @@ void Qtilities::Core::ContextManager::addContexts(QObject* obj) {
 }
 
 QString Qtilities::Core::ContextManager::contextName(int id) const {
-    if (d->contexts.contains(id))
+    if (ContextManagerPrivateData::testContextBit(d->registered_context_bits,id))
         return d->string_id_map.key(id);
     return QString();
 }
 
+void Qtilities::Core::ContextManager::logActiveContexts(const QString& message) const {
+    // Only build the list when trace messages are logged:
+    if (!Log->isMessageTypeAccepted(Logger::Trace,Logger::SystemWideMessages))
+        return;
+
+    LOG_TRACE(message);
+    for (int i = 0; i < d->active_contexts.count(); ++i) {
+        int context_id = d->active_contexts.at(i);
+        LOG_TRACE(QString("- %1 - ID: %2, Name: %3").arg(i).arg(context_id).arg(contextName(context_id)));
+    }
+}
+
 void Qtilities::Core::ContextManager::broadcastState() {
     emit contextChanged(activeContexts());
 }
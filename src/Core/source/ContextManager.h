@@ -74,6 +74,8 @@ namespace Qtilities {
 
         private:
             QString contextName(int id) const;
+            //! Logs \p message followed by the active contexts as trace messages.
+            void logActiveContexts(const QString& message) const;
             ContextManagerPrivateData* d;
         };
     }
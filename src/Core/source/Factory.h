@@ -147,22 +147,23 @@ namespace Qtilities {
                 \sa tagCategoryMap()
                 */
               QStringList tags(const QtilitiesCategory& category_filter = QtilitiesCategory()) const {
+                    if (!category_filter.isValid())
+                        return data_ifaces.keys();
+
                     QStringList tags;
-                    for (int i = 0; i < data_ifaces.count(); i++) {
-                        if (category_filter.isValid()) {
-                            if (data_ifaces.values().at(i).category == category_filter)
-                                tags << data_ifaces.values().at(i).tag;
-                        } else
-                            tags << data_ifaces.values().at(i).tag;
+                    QMap<QString,FactoryItemID>::const_iterator itr;
+                    for (itr = data_ifaces.constBegin(); itr != data_ifaces.constEnd(); ++itr) {
+                        if (itr.value().category == category_filter)
+                            tags << itr.value().tag;
                     }
                     return tags;
               }             
               //! Returns a tag-category map of registered tags.
               QMap<QString, QtilitiesCategory> tagCategoryMap() const {
                     QMap<QString, QtilitiesCategory> tag_category_map;
-                    for (int i = 0; i < data_ifaces.count(); i++) {
-                        tag_category_map[data_ifaces.values().at(i).tag] = data_ifaces.values().at(i).category;
-                    }
+                    QMap<QString,FactoryItemID>::const_iterator itr;
+                    for (itr = data_ifaces.constBegin(); itr != data_ifaces.constEnd(); ++itr)
+                        tag_category_map.insert(itr.key(),itr.value().category);
                     return tag_category_map;
               }
               //! Function which verifies the validity of a new tag. If the tag is already present, false is returned.
@@ -174,19 +175,16 @@ namespace Qtilities {
                 <i>This function was added in %Qtilities v1.2.</i>
                 */
               inline QtilitiesCategory categoryForTag(const QString& tag) const {
-                  if (data_ifaces.contains(tag)) {
-                      FactoryItemID item_data = data_ifaces[tag];
-                      return item_data.category;
-                  }
+                  QMap<QString,FactoryItemID>::const_iterator itr = data_ifaces.constFind(tag);
+                  if (itr != data_ifaces.constEnd())
+                      return itr.value().category;
                   return QtilitiesCategory();
               }
               //! Creates an instance of the factory interface implementation registered with the specified tag. If an invalid tag is specified, null will be returned.
               BaseClass* createInstance(const QString& tag) {
-                  for (int i = 0; i < data_ifaces.count(); i++) {
-                      if (tag == data_ifaces.values().at(i).tag)
-                          return reg_ifaces.values().at(i)->createInstance();
-                  }
-                  Q_ASSERT(!isTagValid(tag));
+                  FactoryInterface<BaseClass>* factory_interface = reg_ifaces.value(tag);
+                  if (factory_interface)
+                      return factory_interface->createInstance();
                   return 0;
               }
 
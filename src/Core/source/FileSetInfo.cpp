@@ -11,6 +11,7 @@
 
 #include "FileSetInfo.h"
 #include "FileUtils.h"
+#include "FileWatchService.h"
 #include "QtilitiesCoreConstants.h"
 
 #include <QDir>
@@ -31,7 +32,6 @@ struct Qtilities::Core::FileSetInfoPrivateData {
 
     QList<QtilitiesFileInfo>    files;
     int                         files_hash;
-    QFileSystemWatcher          watcher;
 
     bool                        file_watching_enabled;
 };
@@ -46,19 +46,14 @@ using namespace Qtilities::Core;
 
 Qtilities::Core::FileSetInfo::FileSetInfo(QObject* parent) : QObject(parent) {
     d = new FileSetInfoPrivateData;
-    connect(&d->watcher,SIGNAL(fileChanged(QString)),SIGNAL(fileChanged(QString)));
-    connect(&d->watcher,SIGNAL(fileChanged(QString)),SIGNAL(setChanged()));
 }
 
 FileSetInfo::FileSetInfo(const FileSetInfo &other) : QObject(other.parent()) {
     d = new FileSetInfoPrivateData;
-    connect(&d->watcher,SIGNAL(fileChanged(QString)),SIGNAL(fileChanged(QString)));
-    connect(&d->watcher,SIGNAL(fileChanged(QString)),SIGNAL(setChanged()));
 
-    d->watcher.removePaths(d->watcher.files());
     d->files = other.files();
-    if (d->files.count() > 0)
-        d->watcher.addPaths(filePaths());
+    if (d->files.count() > 0 && d->file_watching_enabled)
+        FileWatchService::instance()->watchFiles(filePaths(),this,SLOT(handleWatchedFilesChanged(QStringList)));
 
     emit setChanged();
 }
@@ -66,10 +61,10 @@ FileSetInfo::FileSetInfo(const FileSetInfo &other) : QObject(other.parent()) {
 FileSetInfo& Qtilities::Core::FileSetInfo::operator=(const FileSetInfo& other) {
     if (this==&other) return *this;
 
-    d->watcher.removePaths(d->watcher.files());
+    FileWatchService::instance()->unwatchAll(this);
     d->files = other.files();
-    if (d->files.count() > 0)
-        d->watcher.addPaths(filePaths());
+    if (d->files.count() > 0 && d->file_watching_enabled)
+        FileWatchService::instance()->watchFiles(filePaths(),this,SLOT(handleWatchedFilesChanged(QStringList)));
 
     emit setChanged();
 
@@ -77,6 +72,7 @@ FileSetInfo& Qtilities::Core::FileSetInfo::operator=(const FileSetInfo& other) {
 }
 
 Qtilities::Core::FileSetInfo::~FileSetInfo() {
+    FileWatchService::instance()->unwatchAll(this);
     delete d;
 }
 
@@ -89,10 +85,8 @@ bool FileSetInfo::addFile(const QString &file_path) {
 
     QtilitiesFileInfo fi(file_path);
     if (!d->files.contains(fi)) {
-        if (d->file_watching_enabled) {
-            if (fi.exists())
-                d->watcher.addPath(fi.actualFilePath());
-        }
+        if (d->file_watching_enabled)
+            FileWatchService::instance()->watchFile(fi.actualFilePath(),this,SLOT(handleWatchedFilesChanged(QStringList)));
         d->files << fi;
         emit setChanged();
         return true;
@@ -103,10 +97,8 @@ bool FileSetInfo::addFile(const QString &file_path) {
 
 bool FileSetInfo::addFile(QtilitiesFileInfo file_info) {
     if (!d->files.contains(file_info)) {
-        if (d->file_watching_enabled) {
-            if (file_info.exists())
-                d->watcher.addPath(file_info.actualFilePath());
-        }
+        if (d->file_watching_enabled)
+            FileWatchService::instance()->watchFile(file_info.actualFilePath(),this,SLOT(handleWatchedFilesChanged(QStringList)));
         d->files << file_info;
         emit setChanged();
         return true;
@@ -118,7 +110,7 @@ bool FileSetInfo::addFile(QtilitiesFileInfo file_info) {
 bool FileSetInfo::removeFile(const QString &file_path) {
     QtilitiesFileInfo fi(file_path);
     if (!d->files.contains(fi)) {
-        d->watcher.removePath(fi.actualFilePath());
+        FileWatchService::instance()->unwatchFile(fi.actualFilePath(),this);
         d->files.removeOne(fi);
         emit setChanged();
         return true;
@@ -129,7 +121,7 @@ bool FileSetInfo::removeFile(const QString &file_path) {
 
 bool FileSetInfo::removeFile(QtilitiesFileInfo file_info) {
     if (!d->files.contains(file_info)) {
-        d->watcher.removePath(file_info.actualFilePath());
+        FileWatchService::instance()->unwatchFile(file_info.actualFilePath(),this);
         d->files.removeOne(file_info);
         emit setChanged();
         return true;
@@ -164,8 +156,7 @@ int FileSetInfo::count() const {
 }
 
 void FileSetInfo::clear() {
-    if (d->watcher.files().count() > 0)
-        d->watcher.removePaths(d->watcher.files());
+    FileWatchService::instance()->unwatchAll(this);
     d->files.clear();
     emit setChanged();
 }
@@ -204,17 +195,20 @@ int FileSetInfo::fileSetHash(bool update_previous_hash_storage) const {
     if (d->files.isEmpty())
         return -1;
 
-    // We store the file with its corresponding hash code in a map in order
-    // to always sort the hash code order according to the file name:
-    QMap<QString,int> sorted_hash_codes;
-
-    QString hash_string = "";
-    foreach (const QString& file, filePaths())
-        sorted_hash_codes[file] = FileUtils::fileHashCode(file);
-
-    for (int i = 0 ; i < sorted_hash_codes.count(); ++i) {
-        //qDebug() << "TEST" << i << sorted_hash_codes.values().at(i) << sorted_hash_codes.keys().at(i);
-        hash_string.append(QString::number(sorted_hash_codes.values().at(i)));
+    // filePaths() is sorted, thus the combined hash is always built in file name order.
+    // FileUtils caches file hashes by path, size and modification time, thus only files
+    // which changed since the previous call are read again:
+    QStringList file_paths = filePaths();
+    QHash<QString,QByteArray> file_hashes = FileUtils::fileHashes(file_paths);
+
+    QByteArray hash_string;
+    foreach (const QString& file, file_paths) {
+        QByteArray file_hash = file_hashes.value(file);
+        // Files which can't be read contribute a fixed marker:
+        if (file_hash.isEmpty())
+            hash_string.append("-1");
+        else
+            hash_string.append(file_hash);
     }
 
     //qDebug() << "Combined hash string" << hash_string << qHash(hash_string);
@@ -244,8 +238,7 @@ bool FileSetInfo::allFilesExists() const {
 
 void FileSetInfo::disableFileWatching() {
     if (d->file_watching_enabled) {
-        if (d->watcher.files().count() > 0)
-            d->watcher.removePaths(d->watcher.files());
+        FileWatchService::instance()->unwatchAll(this);
         d->file_watching_enabled = false;
     }
 }
@@ -253,7 +246,7 @@ void FileSetInfo::disableFileWatching() {
 void FileSetInfo::enableFileWatching() {
     if (!d->file_watching_enabled) {
         if (d->files.count() > 0)
-            d->watcher.addPaths(filePaths());
+            FileWatchService::instance()->watchFiles(filePaths(),this,SLOT(handleWatchedFilesChanged(QStringList)));
         d->file_watching_enabled = true;
     }
 }
@@ -271,6 +264,12 @@ bool FileSetInfo::fileWatchingEnabled() const {
     return d->file_watching_enabled;
 }
 
+void FileSetInfo::handleWatchedFilesChanged(const QStringList& paths) {
+    foreach (const QString& path, paths)
+        emit fileChanged(path);
+    emit setChanged();
+}
+
 // --------------------------------
 // IExportable Implementation
 // --------------------------------
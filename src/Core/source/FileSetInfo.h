@@ -139,6 +139,9 @@ namespace Qtilities {
              *fileSetHashPrevious() will be updated. When false, the new hash will only be returned and the internal storage won't be modified.
              *\returns The file set hash for the files in this set. If no files are in the set, this function will return -1.
              *
+             *\note From %Qtilities v1.5 onwards the files are hashed through FileUtils::fileHashes(). Files which did not change since the
+             *previous call are not read again, and hashes stored by previous versions of %Qtilities will not match the new hash.
+             *
              *\sa fileSetHashPrevious()
              */
             int fileSetHash(bool update_previous_hash_storage = true) const;
@@ -217,8 +220,9 @@ namespace Qtilities {
              * \brief fileChanged Emitted when the contents of any monitored file in the set is changed, renamed or removed.
              * \param path The path of the file that changed.
              *
-             *Internally this class uses QFileSystemWatcher to monitor changes to file contents and this signal
-             *is basically connected to the same signal on the internal file system watcher.
+             *Internally this class uses FileWatchService to monitor changes to file contents. Changes which happen
+             *in quick succession are reported together, in which case this signal is emitted once for each changed file
+             *followed by a single setChanged() signal.
              */
             void fileChanged(const QString & path);
 
@@ -234,6 +238,10 @@ namespace Qtilities {
              */
             void setChanged();
 
+        private slots:
+            //! Handles batched change notifications from FileWatchService.
+            void handleWatchedFilesChanged(const QStringList& paths);
+
         private:
             FileSetInfoPrivateData* d;
         };
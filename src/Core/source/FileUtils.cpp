@@ -20,13 +20,291 @@
 #include <QFileInfo>
 #include <QFileInfoList>
 #include <QHash>
+#include <QSet>
+#include <QPair>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QRunnable>
+#include <QThreadPool>
+#include <QDataStream>
+#include <QDateTime>
+#include <QCryptographicHash>
 #include <QtDebug>
 #include <QCoreApplication>
 
+#include <cstring>
+
 using namespace Qtilities::Core::Interfaces;
 
+// --------------------------------
+// Directory scanning helpers used by findFilesUnderDir()
+// --------------------------------
+namespace {
+    //! Magic number and version of the directory listing cache files written by FileUtils.
+    const quint32 qti_file_scan_cache_magic     = 0x51534343;
+    const qint32  qti_file_scan_cache_version   = 1;
+
+    //! A cached directory listing: modification time (msecs since epoch) and entry names, directories end with '/'.
+    typedef QPair<qint64,QStringList> FileScanCacheEntry;
+    typedef QHash<QString,FileScanCacheEntry> FileScanCache;
+
+    struct FileScanDir;
+
+    //! An entry found in a directory which is part of the result, or which is a directory that must be descended into.
+    struct FileScanEntry {
+        FileScanEntry() : child(0), matched(false) { }
+
+        QFileInfo       info;
+        FileScanDir*    child;
+        bool            matched;
+    };
+
+    //! A single directory visited during a scan.
+    struct FileScanDir {
+        FileScanDir(const QString& dir_path, FileScanDir* parent_dir) : path(dir_path), parent(parent_dir), pending(1) { }
+
+        QString                 path;
+        FileScanDir*            parent;
+        // The number of unfinished directories in this subtree, including this directory itself.
+        int                     pending;
+        QList<FileScanEntry>    entries;
+    };
+
+    //! State shared between all jobs of a single findFilesUnderDir() call.
+    struct FileScanState {
+        FileScanState() : pool(0),
+            cache(0),
+            want_files(true),
+            want_dirs(false),
+            batch_size(1000),
+            completed_top_level_dirs(0),
+            found_count(0) { }
+        ~FileScanState() {
+            qDeleteAll(dirs);
+        }
+
+        QThreadPool*            pool;
+        FileScanCache*          cache;
+        QList<QRegExp>          name_filters;
+        QList<QRegExp>          ignore_patterns;
+        QDir::Filters           listing_filters;
+        QDir::SortFlags         sort;
+        bool                    want_files;
+        bool                    want_dirs;
+        int                     batch_size;
+
+        // Everything below is protected by lock:
+        QMutex                  lock;
+        QList<FileScanDir*>     dirs;
+        QSet<QString>           visited;
+        QFileInfoList           current_batch;
+        QList<QFileInfoList>    ready_batches;
+        int                     completed_top_level_dirs;
+        int                     found_count;
+    };
+
+    bool fileScanMatches(const QList<QRegExp>& patterns, const QString& value) {
+        for (int i = 0; i < patterns.count(); ++i) {
+            // Work on a local copy: QRegExp stores match state and is shared between threads here.
+            QRegExp reg_exp(patterns.at(i));
+            if (reg_exp.exactMatch(value))
+                return true;
+        }
+        return false;
+    }
+
+    void scanDirectory(FileScanState* state, FileScanDir* node);
+
+    //! Runs scanDirectory() for a single directory on the scan's thread pool.
+    class FileScanJob : public QRunnable {
+    public:
+        FileScanJob(FileScanState* state, FileScanDir* node) : d_state(state), d_node(node) { }
+        void run() {
+            scanDirectory(d_state,d_node);
+        }
+
+    private:
+        FileScanState*  d_state;
+        FileScanDir*    d_node;
+    };
+
+    void scanDirectory(FileScanState* state, FileScanDir* node) {
+        const QString dir_prefix = node->path.endsWith(QLatin1Char('/')) ? node->path : node->path + QLatin1Char('/');
+        QStringList names;
+        QFileInfoList listed_infos;
+        bool from_cache = false;
+
+        qint64 last_modified = -1;
+        QString cache_key;
+        if (state->cache) {
+            // The cache is shared between searches, thus it is keyed by absolute paths even when the search root is relative:
+            QFileInfo dir_info(node->path);
+            cache_key = QDir::cleanPath(dir_info.absoluteFilePath());
+            last_modified = dir_info.lastModified().toMSecsSinceEpoch();
+            QMutexLocker locker(&state->lock);
+            state->visited.insert(cache_key);
+            FileScanCache::const_iterator itr = state->cache->constFind(cache_key);
+            if (itr != state->cache->constEnd() && itr.value().first == last_modified) {
+                names = itr.value().second;
+                from_cache = true;
+            }
+        }
+
+        if (!from_cache) {
+            listed_infos = QDir(node->path).entryInfoList(state->listing_filters,state->sort);
+            names.reserve(listed_infos.count());
+            for (int i = 0; i < listed_infos.count(); ++i) {
+                if (listed_infos.at(i).isDir())
+                    names << listed_infos.at(i).fileName() + QLatin1Char('/');
+                else
+                    names << listed_infos.at(i).fileName();
+            }
+            if (state->cache) {
+                QMutexLocker locker(&state->lock);
+                state->cache->insert(cache_key,FileScanCacheEntry(last_modified,names));
+            }
+        }
+
+        QList<FileScanDir*> children;
+        QFileInfoList matched_infos;
+        for (int i = 0; i < names.count(); ++i) {
+            const QString& name = names.at(i);
+            const bool is_dir = name.endsWith(QLatin1Char('/'));
+            const QString entry_name = is_dir ? name.left(name.length()-1) : name;
+            const QString entry_path = dir_prefix + entry_name;
+
+            // IMPORTANT: For paths, \\ separators does not do the trick. We need to use /
+            if (!state->ignore_patterns.isEmpty() && fileScanMatches(state->ignore_patterns,FileUtils::toUnixPath(entry_path)))
+                continue;
+
+            FileScanEntry entry;
+            entry.info = from_cache ? QFileInfo(entry_path) : listed_infos.at(i);
+            if (is_dir) {
+                entry.child = new FileScanDir(entry_path,node);
+                entry.matched = state->want_dirs;
+                children << entry.child;
+            } else {
+                entry.matched = state->want_files && (state->name_filters.isEmpty() || fileScanMatches(state->name_filters,entry_name));
+                if (!entry.matched)
+                    continue;
+            }
+
+            if (entry.matched)
+                matched_infos << entry.info;
+            node->entries << entry;
+        }
+
+        {
+            QMutexLocker locker(&state->lock);
+            state->dirs << children;
+            node->pending += children.count();
+            state->found_count += matched_infos.count();
+            state->current_batch << matched_infos;
+            if (state->current_batch.count() >= state->batch_size) {
+                state->ready_batches << state->current_batch;
+                state->current_batch.clear();
+            }
+        }
+
+        for (int i = 0; i < children.count(); ++i)
+            state->pool->start(new FileScanJob(state,children.at(i)));
+
+        // This directory is done, propagate completion up the tree:
+        QMutexLocker locker(&state->lock);
+        FileScanDir* current = node;
+        while (current && --current->pending == 0) {
+            // Directories directly under the root are used for progress reporting.
+            if (current->parent && !current->parent->parent)
+                ++state->completed_top_level_dirs;
+            current = current->parent;
+        }
+    }
+
+    // --------------------------------
+    // File hashing helpers used by fileHash() and fileHashes()
+    // --------------------------------
+    //! The chunk size used when files are read or compared without memory mapping them.
+    const int qti_file_hash_chunk_size = 64 * 1024;
+
+    struct FileHashCacheEntry {
+        qint64      size;
+        qint64      last_modified;
+        QByteArray  hash;
+    };
+
+    //! Process wide cache of file hashes, keyed by absolute file path.
+    struct FileHashCache {
+        QMutex                              lock;
+        QHash<QString,FileHashCacheEntry>   entries;
+    };
+
+    //! Hashes the contents of a file without reading it into memory as a whole.
+    QByteArray calculateFileHash(const QString& file_name) {
+        QFile file(file_name);
+        if (!file.open(QIODevice::ReadOnly))
+            return QByteArray();
+
+        QCryptographicHash hash(QCryptographicHash::Md5);
+        const qint64 size = file.size();
+        uchar* mapped = size > 0 ? file.map(0,size) : 0;
+        if (mapped) {
+            // QCryptographicHash::addData() takes an int length, thus feed big files in pieces.
+            qint64 offset = 0;
+            while (offset < size) {
+                int length = (int) qMin((qint64) (16 * qti_file_hash_chunk_size),size - offset);
+                hash.addData((const char*) mapped + offset,length);
+                offset += length;
+            }
+            file.unmap(mapped);
+        } else {
+            QByteArray buffer(qti_file_hash_chunk_size,'\0');
+            qint64 read_count;
+            while ((read_count = file.read(buffer.data(),qti_file_hash_chunk_size)) > 0)
+                hash.addData(buffer.constData(),(int) read_count);
+            if (read_count < 0)
+                return QByteArray();
+        }
+        file.close();
+        return hash.result();
+    }
+
+    //! Calculates FileUtils::fileHash() for a single file on a thread pool.
+    class FileHashJob : public QRunnable {
+    public:
+        FileHashJob(const QString& file_name, QHash<QString,QByteArray>* results, QMutex* lock) : d_file_name(file_name),
+            d_results(results),
+            d_lock(lock) { }
+        void run() {
+            QByteArray hash = Qtilities::Core::FileUtils::fileHash(d_file_name);
+            QMutexLocker locker(d_lock);
+            d_results->insert(d_file_name,hash);
+        }
+
+    private:
+        QString                     d_file_name;
+        QHash<QString,QByteArray>*  d_results;
+        QMutex*                     d_lock;
+    };
+
+    //! Appends the results under node in the order in which a sequential depth first search finds them.
+    void collectScanResults(const FileScanDir* node, QFileInfoList& results) {
+        for (int i = 0; i < node->entries.count(); ++i) {
+            const FileScanEntry& entry = node->entries.at(i);
+            if (entry.child)
+                collectScanResults(entry.child,results);
+            if (entry.matched)
+                results << entry.info;
+        }
+    }
+}
+
+Q_GLOBAL_STATIC(FileHashCache, qti_file_hash_cache)
+
 struct Qtilities::Core::FileUtilsPrivateData {
-    FileUtilsPrivateData() { }
+    FileUtilsPrivateData() : batch_size(1000),
+        cache_loaded(false),
+        cache_listing_filters(0),
+        cache_sort(0) { }
 
     // Storage for findFilesUnderDir() future calls:
     QString             dirName;
@@ -36,6 +314,15 @@ struct Qtilities::Core::FileUtilsPrivateData {
     QDir::SortFlags     sort;
 
     QFileInfoList       find_files_under_dir_list;
+
+    // Scanning infrastructure used by findFilesUnderDir():
+    QThreadPool         scan_pool;
+    int                 batch_size;
+    QString             cache_file;
+    bool                cache_loaded;
+    FileScanCache       cache;
+    int                 cache_listing_filters;
+    int                 cache_sort;
 };
 
 Qtilities::Core::FileUtils::FileUtils(bool enable_tasking, QObject* parent) : QObject(parent) {
@@ -52,6 +339,7 @@ Qtilities::Core::FileUtils::FileUtils(bool enable_tasking, QObject* parent) : QO
 }
 
 Qtilities::Core::FileUtils::~FileUtils() {
+    d->scan_pool.waitForDone();
     delete d;
 }
 
@@ -65,6 +353,7 @@ QFileInfoList Qtilities::Core::FileUtils::findFilesUnderDir(const QString &dirNa
                                                             QDir::Filters filters,
                                                             QDir::SortFlags sort,
                                                             bool first_run) {
+    // When first_run is false, results are appended to lastFilesUnderDir() and the task is not used:
     if (first_run)
         d->find_files_under_dir_list.clear();
 
@@ -75,122 +364,142 @@ QFileInfoList Qtilities::Core::FileUtils::findFilesUnderDir(const QString &dirNa
 
     int task_id = findTaskID(taskNameToString(TaskFindFilesUnderDir));
     Task* task_ref = 0;
-    if (isTaskActive(task_id)) {
+    if (first_run && isTaskActive(task_id)) {
         task_ref = findTask(taskNameToString(TaskFindFilesUnderDir));
     }
 
-    if (!file_filters.isEmpty()) {
-        QStringList file_filters_list = file_filters.split(" ",QString::SkipEmptyParts);
-        dir.setNameFilters(file_filters_list);
-    }
-
-    QDir::Filters final_filters = filters;
-    // Always add QDir::NoDotAndDotDot otherwise we can go into an endless loop here.
-    final_filters |= QDir::NoDotAndDotDot;
-    //qDebug() << "XXX" << dir.path() << file_filters << ignore_list << final_filters;
+    // Compile all patterns once for the complete search:
+    FileScanState state;
+    state.pool = &d->scan_pool;
+    state.batch_size = qMax(1,d->batch_size);
+    state.sort = sort;
+    state.want_files = (filters & QDir::Files);
+    state.want_dirs = (filters & QDir::Dirs);
+    // Always add QDir::NoDotAndDotDot otherwise we can go into an endless loop here. Directories are
+    // always listed since we need to descend into them, name filters are applied by the scan itself.
+    state.listing_filters = (filters & ~(QDir::Dirs | QDir::Files | QDir::Drives)) | QDir::AllEntries | QDir::AllDirs | QDir::NoDotAndDotDot;
+
+    Qt::CaseSensitivity name_filter_cs = (filters & QDir::CaseSensitive) ? Qt::CaseSensitive : Qt::CaseInsensitive;
+    foreach (const QString& file_filter, file_filters.split(" ",QString::SkipEmptyParts))
+        state.name_filters << QRegExp(file_filter,name_filter_cs,QRegExp::Wildcard);
 
     QStringList ignore_patterns = ignore_list.split(" ",QString::SkipEmptyParts);
     ignore_patterns.removeDuplicates();
-
-    if (first_run) {
-        if (task_ref) {
-            // Calculate an estimate of the number of sub tasks:
-            // Sub folders count as 10, files count as 1:
-            int folder_count = 0;
-            int file_count = 0;
-            foreach (const QFileInfo& info, dir.entryInfoList(final_filters,sort)) {
-                // Check if this entry must be ignored:
-                bool not_ignored = true;
-                if (!ignore_list.isEmpty()) {
-                    foreach (const QString& ignore_pattern, ignore_patterns) {
-                        // IMPORTANT: For paths, \\ separators does not do the trick. We need to use /
-                        QString path_to_match = FileUtils::toUnixPath(info.filePath());
-                        QString match_value_correct_sep = FileUtils::toUnixPath(ignore_pattern);
-
-                        QRegExp regExp(match_value_correct_sep);
-                        regExp.setPatternSyntax(QRegExp::Wildcard);
-                        if (regExp.exactMatch(path_to_match)) {
-                            not_ignored = false;
-                            continue;
-                        }
-                    }
-                }
-
-                if (not_ignored) {
-                    if (info.isDir())
-                        ++folder_count;
-                    else
-                        ++file_count;
-                }
+    foreach (const QString& ignore_pattern, ignore_patterns)
+        state.ignore_patterns << QRegExp(FileUtils::toUnixPath(ignore_pattern),Qt::CaseSensitive,QRegExp::Wildcard);
+
+    if (!d->cache_file.isEmpty()) {
+        if (!d->cache_loaded) {
+            d->cache_loaded = true;
+            QFile file(d->cache_file);
+            if (file.open(QIODevice::ReadOnly)) {
+                QDataStream stream(&file);
+                stream.setVersion(QDataStream::Qt_4_7);
+                quint32 magic;
+                qint32 version;
+                stream >> magic >> version;
+                if (magic == qti_file_scan_cache_magic && version == qti_file_scan_cache_version)
+                    stream >> d->cache_listing_filters >> d->cache_sort >> d->cache;
+                if (stream.status() != QDataStream::Ok)
+                    d->cache.clear();
+                file.close();
             }
+        }
 
-            task_ref->setDisplayName("Finding Files: " + dir.dirName());
-            task_ref->startTask(folder_count*10 + file_count);
-            task_ref->logMessage("Searching for files in directory: " + dirName);
+        // Listings made with different filters or sorting can't be reused:
+        if (d->cache_listing_filters != (int) state.listing_filters || d->cache_sort != (int) sort) {
+            d->cache.clear();
+            d->cache_listing_filters = state.listing_filters;
+            d->cache_sort = sort;
         }
-        d->find_files_under_dir_list.clear();
-    } else {
-        // If its not the first run, we are in a recursive call. In this case, remove QDir::AllDirs which is passed as an argument
-        // for the recursive calls.
-        final_filters &= ~QDir::AllDirs;
+        state.cache = &d->cache;
     }
 
-    foreach (const QFileInfo& info, dir.entryInfoList(final_filters | QDir::AllDirs,sort)) {
-        QCoreApplication::processEvents();
-        // Check if this entry must be ignored:
-        bool not_ignored = true;
-        if (!ignore_list.isEmpty()) {
-            foreach (const QString& ignore_pattern, ignore_patterns) {
-                // IMPORTANT: For paths, \\ separators does not do the trick. We need to use /
-                QString path_to_match = FileUtils::toUnixPath(info.filePath());
-                QString match_value_correct_sep = FileUtils::toUnixPath(ignore_pattern);
-
-                QRegExp regExp(match_value_correct_sep);
-                regExp.setPatternSyntax(QRegExp::Wildcard);
-                if (regExp.exactMatch(path_to_match)) {
-                    not_ignored = false;
-                    continue;
-                }
-            }
+    // The root directory is scanned in this thread, this gives us the first level entries needed for progress estimation:
+    // Keep the path form (relative or absolute) passed by the caller, the returned QFileInfos and ignore pattern matching depend on it:
+    FileScanDir* root = new FileScanDir(dir.path(),0);
+    state.dirs << root;
+    scanDirectory(&state,root);
+
+    int top_level_reported = 0;
+    if (task_ref) {
+        // Calculate an estimate of the number of sub tasks:
+        // Sub folders count as 10, files count as 1:
+        int folder_count = 0;
+        int file_count = 0;
+        foreach (const FileScanEntry& entry, root->entries) {
+            if (entry.child)
+                ++folder_count;
+            else
+                ++file_count;
         }
 
-        if (not_ignored) {
-            if (info.isDir()) {
-                if (task_ref) {
-                    task_ref->logMessage("Searching for files in directory: " + info.absoluteFilePath());
-                    task_ref->setDisplayName("Finding Files: " + info.dir().dirName());
-                }
-                findFilesUnderDir(info.absoluteFilePath(),file_filters,ignore_list,filters | QDir::AllDirs,sort,false);
-
-                if (final_filters & QDir::Dirs) {
-                    if (task_ref)
-                        task_ref->logMessage("Found directory: " + info.absoluteFilePath());
-                    d->find_files_under_dir_list.append(info);
-                }
-
-                if (task_ref && first_run)
-                    task_ref->addCompletedSubTasks(10);
-            } else {
-                if (final_filters & QDir::Files) {
-                    if (task_ref)
-                        task_ref->logMessage("Found file: " + info.absoluteFilePath());
-                    d->find_files_under_dir_list.append(info);
-                }
-
-                if (task_ref && first_run)
-                    task_ref->addCompletedSubTasks(1);
-            }
-        } else if (first_run) {
-            if (task_ref) {
-                if (info.isDir())
-                    task_ref->logMessage("Ignoring directory: " + info.absoluteFilePath());
-                else
-                    task_ref->logMessage("Ignoring file: " + info.absoluteFilePath());
+        task_ref->setDisplayName("Finding Files: " + dir.dirName());
+        task_ref->startTask(folder_count*10 + file_count);
+        task_ref->logMessage("Searching for files in directory: " + dirName);
+        if (file_count > 0)
+            task_ref->addCompletedSubTasks(file_count);
+    }
+
+    // Wait for the workers while keeping the event loop alive, streaming results as they become available:
+    forever {
+        bool done = d->scan_pool.waitForDone(50);
+
+        QList<QFileInfoList> ready_batches;
+        int completed_top_level_dirs;
+        {
+            QMutexLocker locker(&state.lock);
+            ready_batches = state.ready_batches;
+            state.ready_batches.clear();
+            if (done && !state.current_batch.isEmpty()) {
+                ready_batches << state.current_batch;
+                state.current_batch.clear();
             }
+            completed_top_level_dirs = state.completed_top_level_dirs;
+        }
+
+        foreach (const QFileInfoList& batch, ready_batches)
+            emit filesFoundUnderDir(batch);
+
+        if (task_ref && completed_top_level_dirs > top_level_reported) {
+            task_ref->addCompletedSubTasks((completed_top_level_dirs - top_level_reported) * 10);
+            top_level_reported = completed_top_level_dirs;
+        }
+
+        if (done)
+            break;
+
+        QCoreApplication::processEvents();
+    }
+
+    d->find_files_under_dir_list.reserve(d->find_files_under_dir_list.count() + state.found_count);
+    collectScanResults(root,d->find_files_under_dir_list);
+
+    if (state.cache) {
+        // Drop cached listings of directories under the root which no longer exist or are ignored now:
+        const QString root_key = QDir::cleanPath(dir.absolutePath());
+        const QString root_prefix = root_key.endsWith(QLatin1Char('/')) ? root_key : root_key + QLatin1Char('/');
+        FileScanCache::iterator itr = d->cache.begin();
+        while (itr != d->cache.end()) {
+            if (itr.key().startsWith(root_prefix) && !state.visited.contains(itr.key()))
+                itr = d->cache.erase(itr);
+            else
+                ++itr;
+        }
+
+        QFile file(d->cache_file);
+        if (file.open(QIODevice::WriteOnly)) {
+            QDataStream stream(&file);
+            stream.setVersion(QDataStream::Qt_4_7);
+            stream << qti_file_scan_cache_magic << qti_file_scan_cache_version;
+            stream << d->cache_listing_filters << d->cache_sort << d->cache;
+            file.close();
+        } else if (task_ref) {
+            task_ref->logWarning("Failed to write directory listing cache to: " + d->cache_file);
         }
     }
 
-    if (first_run && task_ref) {
+    if (task_ref) {
         task_ref->setDisplayName(tr("Found Files In: ") + dir.dirName());
         task_ref->logMessage("Successfully searched for and found " + QString::number(d->find_files_under_dir_list.count()) + " files under directory: " + dirName);
         task_ref->completeTask(ITask::TaskSuccessful);
@@ -211,6 +520,41 @@ void Qtilities::Core::FileUtils::setFindFilesUnderDirParams(const QString &dirNa
     d->sort = sort;
 }
 
+void Qtilities::Core::FileUtils::setFindFilesUnderDirThreadCount(int thread_count) {
+    d->scan_pool.setMaxThreadCount(qMax(1,thread_count));
+}
+
+int Qtilities::Core::FileUtils::findFilesUnderDirThreadCount() const {
+    return d->scan_pool.maxThreadCount();
+}
+
+void Qtilities::Core::FileUtils::setFindFilesUnderDirBatchSize(int batch_size) {
+    d->batch_size = qMax(1,batch_size);
+}
+
+int Qtilities::Core::FileUtils::findFilesUnderDirBatchSize() const {
+    return d->batch_size;
+}
+
+void Qtilities::Core::FileUtils::setFindFilesUnderDirCacheFile(const QString &cache_file) {
+    if (d->cache_file == cache_file)
+        return;
+
+    d->cache_file = cache_file;
+    d->cache.clear();
+    d->cache_loaded = false;
+}
+
+QString Qtilities::Core::FileUtils::findFilesUnderDirCacheFile() const {
+    return d->cache_file;
+}
+
+void Qtilities::Core::FileUtils::clearFindFilesUnderDirCache() {
+    d->cache.clear();
+    if (!d->cache_file.isEmpty())
+        QFile::remove(d->cache_file);
+}
+
 QFileInfoList Qtilities::Core::FileUtils::findFilesUnderDirLauncher() {
     int task_id = findTaskID(taskNameToString(TaskFindFilesUnderDir));
     Task* task_ref = 0;
@@ -269,21 +613,82 @@ QString Qtilities::Core::FileUtils::removeFromFileName(const QString &fullFileNa
 }
 
 int Qtilities::Core::FileUtils::fileHashCode(const QString& file_name) {
-    QFile file(file_name);
-    if (!file.open(QIODevice::ReadOnly))
+    QByteArray hash = FileUtils::fileHash(file_name);
+    if (hash.isEmpty())
         return -1;
-    QByteArray file_contents = file.readAll();
-    //qDebug() << "textFileHashCode" << file_name << qHash(file_contents);
-    file.close();
-    return qHash(file_contents);
+    return qHash(hash);
+}
+
+QByteArray Qtilities::Core::FileUtils::fileHash(const QString& file_name) {
+    QFileInfo fi(file_name);
+    if (!fi.exists())
+        return QByteArray();
+
+    const QString key = fi.absoluteFilePath();
+    const qint64 size = fi.size();
+    const qint64 last_modified = fi.lastModified().toMSecsSinceEpoch();
+
+    FileHashCache* cache = qti_file_hash_cache();
+    {
+        QMutexLocker locker(&cache->lock);
+        QHash<QString,FileHashCacheEntry>::const_iterator itr = cache->entries.constFind(key);
+        if (itr != cache->entries.constEnd() && itr.value().size == size && itr.value().last_modified == last_modified)
+            return itr.value().hash;
+    }
+
+    QByteArray hash = calculateFileHash(key);
+    if (!hash.isEmpty()) {
+        FileHashCacheEntry entry;
+        entry.size = size;
+        entry.last_modified = last_modified;
+        entry.hash = hash;
+        QMutexLocker locker(&cache->lock);
+        cache->entries.insert(key,entry);
+    }
+    return hash;
+}
+
+QHash<QString,QByteArray> Qtilities::Core::FileUtils::fileHashes(const QStringList& files) {
+    QHash<QString,QByteArray> hashes;
+    if (files.count() == 1) {
+        hashes[files.front()] = FileUtils::fileHash(files.front());
+        return hashes;
+    }
+
+    QThreadPool pool;
+    QMutex lock;
+    foreach (const QString& file, files)
+        pool.start(new FileHashJob(file,&hashes,&lock));
+    pool.waitForDone();
+    return hashes;
+}
+
+void Qtilities::Core::FileUtils::clearFileHashCache() {
+    FileHashCache* cache = qti_file_hash_cache();
+    QMutexLocker locker(&cache->lock);
+    cache->entries.clear();
 }
 
 bool Qtilities::Core::FileUtils::compareFiles(const QString& file1, const QString& file2) {
-    int original = FileUtils::fileHashCode(file1);
-    int readback = FileUtils::fileHashCode(file2);
-    if (original == -1 || readback == -1)
+    QFile file_1(file1);
+    QFile file_2(file2);
+    if (!file_1.open(QIODevice::ReadOnly) || !file_2.open(QIODevice::ReadOnly))
+        return false;
+    if (file_1.size() != file_2.size())
         return false;
-    return (original == readback);
+
+    QByteArray buffer_1(qti_file_hash_chunk_size,'\0');
+    QByteArray buffer_2(qti_file_hash_chunk_size,'\0');
+    forever {
+        qint64 read_1 = file_1.read(buffer_1.data(),qti_file_hash_chunk_size);
+        qint64 read_2 = file_2.read(buffer_2.data(),qti_file_hash_chunk_size);
+        if (read_1 != read_2 || read_1 < 0)
+            return false;
+        if (read_1 == 0)
+            return true;
+        if (memcmp(buffer_1.constData(),buffer_2.constData(),read_1) != 0)
+            return false;
+    }
 }
 
 bool FileUtils::comparePaths(const QString &path1, const QString &path2, Qt::CaseSensitivity cs) {
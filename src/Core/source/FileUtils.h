@@ -17,6 +17,7 @@
 #include "Task.h"
 
 #include <QList>
+#include <QHash>
 #include <QUrl>
 #include <QDir>
 #include <QObject>
@@ -81,12 +82,20 @@ QFileInfoList files = fu.findFilesUnderDir("/my_path","*.txt");
 
                 It is possible to find just directories by specifying the filters to be QDir::AllDirs without including QDir::Files.
 
+               From %Qtilities v1.5 onwards the directory hierarchy is walked in parallel on a thread pool owned by this object (see
+               setFindFilesUnderDirThreadCount()). The ignore and file filter patterns are compiled once per call and ignored directories
+               are pruned before they are descended into. While the search is busy, found files are streamed in batches through
+               the filesFoundUnderDir() signal (see setFindFilesUnderDirBatchSize()). The list returned at the end is always in
+               the same order as a sequential search would produce. When a cache file is set through setFindFilesUnderDirCacheFile(),
+               directories which were not modified since the previous search are not listed again.
+
                \param dirName Path of directory to search under.
                \param file_filters The list of files which must be returned, when empty all files are returned. For example: *.bit *.log *.ngc, when empty all files added by default (*.*).
                \param ignore_list Files which should be ignored. Must be in the format: *.svn *.bak *.tmp
                \param filters The QDir::Filters to apply when searching for files and folders.
                \param sort The QDir::SortFlags to apply when searching for files and folders.
-               \param first_run Ignore this parameter, used in recursive operations.
+               \param first_run When true (the default) the results of previous searches are cleared. When false, the results are appended to
+               the results of the previous search and the TaskFindFilesUnderDir task is not started.
                \return A list of QFileInfos containing the information about found files.
               */
             QFileInfoList findFilesUnderDir(const QString &dirName,
@@ -111,6 +120,65 @@ QFileInfoList files = fu.findFilesUnderDir("/my_path","*.txt");
                                             const QString& ignore_list = QString(),
                                             QDir::Filters filters = QDir::Files | QDir::NoDotAndDotDot,
                                             QDir::SortFlags sort = QDir::NoSort);
+            //! Sets the maximum number of threads used by findFilesUnderDir().
+            /*!
+              By default QThread::idealThreadCount() threads are used.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void setFindFilesUnderDirThreadCount(int thread_count);
+            //! Gets the maximum number of threads used by findFilesUnderDir().
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            int findFilesUnderDirThreadCount() const;
+            //! Sets the number of files which are collected before filesFoundUnderDir() is emitted during findFilesUnderDir().
+            /*!
+              The default batch size is 1000 files.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void setFindFilesUnderDirBatchSize(int batch_size);
+            //! Gets the number of files which are collected before filesFoundUnderDir() is emitted during findFilesUnderDir().
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            int findFilesUnderDirBatchSize() const;
+            //! Sets the path of the file used to persist the directory listing cache used by findFilesUnderDir().
+            /*!
+              The cache stores the modification time and contents of every directory visited by findFilesUnderDir(). On following
+              searches only directories with a different modification time are listed again. The cache is read from \p cache_file
+              the first time it is needed and written back to it after each search.
+
+              Set an empty path to disable the cache, which is the default.
+
+              \note The cache only tracks directory contents. Modifications to the contents of files are not detected by it, which is not
+              needed by findFilesUnderDir().
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void setFindFilesUnderDirCacheFile(const QString& cache_file);
+            //! Gets the path of the file used to persist the directory listing cache used by findFilesUnderDir().
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            QString findFilesUnderDirCacheFile() const;
+            //! Clears the directory listing cache used by findFilesUnderDir().
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void clearFindFilesUnderDirCache();
+
+        signals:
+            //! Emitted during findFilesUnderDir() every time a batch of matching files was found.
+            /*!
+              The signal is emitted from the thread in which findFilesUnderDir() was called. The order of files in the batches is not
+              defined, use the list returned by findFilesUnderDir() when the order is important.
+
+              <i>This signal was added in %Qtilities v1.5.</i>
+              */
+            void filesFoundUnderDir(const QFileInfoList& files);
+
         private slots:
             //! Finds all files in the directory hierarhcy under a directory.
             /*!
@@ -135,9 +203,43 @@ QFileInfoList files = fu.findFilesUnderDir("/my_path","*.txt");
             //! Calculates a hash code for a text file.
             /*!
               If something went wrong (for example if the file does not exist), -1 is returned as an error code.
+
+              \note From %Qtilities v1.5 onwards this function is a convenience wrapper around fileHash(). Hash codes calculated
+              by previous versions of %Qtilities will therefore not match the hash codes returned by this function.
               */
             static int fileHashCode(const QString& file);
+            //! Calculates a MD5 hash for the contents of a file.
+            /*!
+              The file is not loaded into memory as a whole, it is memory mapped when possible and read in fixed size chunks
+              otherwise.
+
+              Results are cached in a process wide cache keyed by the file's path, size and last modified time. Thus, calling
+              this function again on a file which did not change will not read the file again.
+
+              \returns The hash of the file, or an empty QByteArray if the file could not be read.
+
+              \sa fileHashes(), clearFileHashCache()
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            static QByteArray fileHash(const QString& file);
+            //! Calculates fileHash() for a list of files, hashing all files which are not in the hash cache in parallel.
+            /*!
+              \returns A hash with file paths as keys and the fileHash() of each file as values.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            static QHash<QString,QByteArray> fileHashes(const QStringList& files);
+            //! Clears the process wide cache used by fileHash() and fileHashes().
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            static void clearFileHashCache();
             //! Compares two files and returns true if they are exactly the same, false otherwise.
+            /*!
+              From %Qtilities v1.5 onwards the sizes of the files are compared first, after which the contents of the files are compared
+              chunk by chunk until the first difference is found.
+              */
             static bool compareFiles(const QString& file1, const QString& file2);
             //! Compares two paths in a system independant way.
             /*!
@@ -0,0 +1,376 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#include "FileWatchService.h"
+
+#include <QCoreApplication>
+#include <QFileSystemWatcher>
+#include <QFileInfo>
+#include <QDateTime>
+#include <QDir>
+#include <QHash>
+#include <QSet>
+#include <QMutex>
+#include <QPointer>
+#include <QTimer>
+
+using namespace Qtilities::Core;
+
+namespace {
+    //! The state of a watched file, used to detect which files in a watched directory changed.
+    struct FileWatchSnapshot {
+        FileWatchSnapshot() : exists(false),
+            size(-1),
+            last_modified(-1) { }
+        explicit FileWatchSnapshot(const QString& path) {
+            QFileInfo fi(path);
+            exists = fi.exists();
+            size = exists ? fi.size() : -1;
+            last_modified = exists ? fi.lastModified().toMSecsSinceEpoch() : -1;
+        }
+        bool operator!=(const FileWatchSnapshot& other) const {
+            return exists != other.exists || size != other.size || last_modified != other.last_modified;
+        }
+
+        bool    exists;
+        qint64  size;
+        qint64  last_modified;
+    };
+
+    struct WatchedFile {
+        QString             dir;
+        QList<QObject*>     subscribers;
+        FileWatchSnapshot   snapshot;
+    };
+
+    struct WatchSubscriber {
+        //! The name of the slot to invoke.
+        QByteArray              member;
+        //! The watched paths, normalized path -> path as given by the subscriber.
+        QHash<QString,QString>  paths;
+    };
+
+    QString normalizedWatchPath(const QString& path) {
+        return QDir::cleanPath(QFileInfo(path).absoluteFilePath());
+    }
+}
+
+struct Qtilities::Core::FileWatchServicePrivateData {
+    FileWatchServicePrivateData() : watcher(0),
+        debounce_timer(0),
+        directory_watch_threshold(16) { }
+
+    QFileSystemWatcher*                 watcher;
+    QTimer*                             debounce_timer;
+    int                                 directory_watch_threshold;
+
+    //! All watched files, keyed by normalized path.
+    QHash<QString,WatchedFile>          files;
+    //! The watched files in each directory.
+    QHash<QString,QSet<QString> >       dir_files;
+    //! Files which are currently watched individually by the watcher.
+    QSet<QString>                       watched_files;
+    //! Directories which are currently watched by the watcher.
+    QSet<QString>                       watched_dirs;
+    QHash<QObject*,WatchSubscriber>     subscribers;
+
+    //! Changes received since the last flush.
+    QSet<QString>                       changed_files;
+    QSet<QString>                       changed_dirs;
+};
+
+Qtilities::Core::FileWatchService* Qtilities::Core::FileWatchService::m_Instance = 0;
+
+Qtilities::Core::FileWatchService* Qtilities::Core::FileWatchService::instance() {
+    static QMutex mutex;
+    if (!m_Instance)
+    {
+      mutex.lock();
+
+      if (!m_Instance)
+        m_Instance = new FileWatchService;
+
+      mutex.unlock();
+    }
+
+    return m_Instance;
+}
+
+Qtilities::Core::FileWatchService::FileWatchService() : QObject() {
+    d = new FileWatchServicePrivateData;
+
+    // The service must live in the main thread where its watcher and timer events are processed:
+    if (QCoreApplication::instance())
+        moveToThread(QCoreApplication::instance()->thread());
+
+    d->watcher = new QFileSystemWatcher(this);
+    connect(d->watcher,SIGNAL(fileChanged(QString)),SLOT(handleFileChanged(QString)));
+    connect(d->watcher,SIGNAL(directoryChanged(QString)),SLOT(handleDirectoryChanged(QString)));
+
+    d->debounce_timer = new QTimer(this);
+    d->debounce_timer->setSingleShot(true);
+    d->debounce_timer->setInterval(100);
+    connect(d->debounce_timer,SIGNAL(timeout()),SLOT(flushChanges()));
+}
+
+Qtilities::Core::FileWatchService::~FileWatchService() {
+    delete d;
+}
+
+void Qtilities::Core::FileWatchService::watchFile(const QString& path, QObject* receiver, const char* member) {
+    watchFiles(QStringList(path),receiver,member);
+}
+
+void Qtilities::Core::FileWatchService::watchFiles(const QStringList& paths, QObject* receiver, const char* member) {
+    if (!receiver || paths.isEmpty())
+        return;
+
+    if (!d->subscribers.contains(receiver)) {
+        if (!member)
+            return;
+
+        // Strip the SLOT() code and the parameter list to get the method name:
+        QByteArray method_name(member + 1);
+        method_name.truncate(method_name.indexOf('('));
+
+        WatchSubscriber subscriber;
+        subscriber.member = method_name;
+        d->subscribers[receiver] = subscriber;
+        connect(receiver,SIGNAL(destroyed(QObject*)),SLOT(handleReceiverDestroyed(QObject*)));
+    }
+    WatchSubscriber& subscriber = d->subscribers[receiver];
+
+    QSet<QString> touched_dirs;
+    foreach (const QString& path, paths) {
+        QString key = normalizedWatchPath(path);
+        if (subscriber.paths.contains(key))
+            continue;
+        subscriber.paths[key] = path;
+
+        QHash<QString,WatchedFile>::iterator itr = d->files.find(key);
+        if (itr == d->files.end()) {
+            WatchedFile watched_file;
+            watched_file.dir = QFileInfo(key).path();
+            watched_file.snapshot = FileWatchSnapshot(key);
+            itr = d->files.insert(key,watched_file);
+            d->dir_files[watched_file.dir].insert(key);
+            touched_dirs.insert(watched_file.dir);
+        }
+        itr.value().subscribers << receiver;
+    }
+
+    foreach (const QString& dir, touched_dirs)
+        updateDirectoryWatch(dir);
+}
+
+void Qtilities::Core::FileWatchService::unwatchFile(const QString& path, QObject* receiver) {
+    unwatchFiles(QStringList(path),receiver);
+}
+
+void Qtilities::Core::FileWatchService::unwatchFiles(const QStringList& paths, QObject* receiver) {
+    QHash<QObject*,WatchSubscriber>::iterator sub_itr = d->subscribers.find(receiver);
+    if (sub_itr == d->subscribers.end())
+        return;
+
+    QSet<QString> touched_dirs;
+    QStringList removed_watches;
+    foreach (const QString& path, paths) {
+        QString key = normalizedWatchPath(path);
+        if (sub_itr.value().paths.remove(key) == 0)
+            continue;
+
+        QHash<QString,WatchedFile>::iterator itr = d->files.find(key);
+        if (itr == d->files.end())
+            continue;
+
+        itr.value().subscribers.removeOne(receiver);
+        if (itr.value().subscribers.isEmpty()) {
+            QString dir = itr.value().dir;
+            d->files.erase(itr);
+            d->dir_files[dir].remove(key);
+            d->changed_files.remove(key);
+            if (d->watched_files.remove(key))
+                removed_watches << key;
+            touched_dirs.insert(dir);
+        }
+    }
+
+    if (!removed_watches.isEmpty())
+        d->watcher->removePaths(removed_watches);
+
+    if (sub_itr.value().paths.isEmpty()) {
+        d->subscribers.erase(sub_itr);
+        disconnect(receiver,SIGNAL(destroyed(QObject*)),this,SLOT(handleReceiverDestroyed(QObject*)));
+    }
+
+    foreach (const QString& dir, touched_dirs)
+        updateDirectoryWatch(dir);
+}
+
+void Qtilities::Core::FileWatchService::unwatchAll(QObject* receiver) {
+    if (!d->subscribers.contains(receiver))
+        return;
+
+    unwatchFiles(d->subscribers.value(receiver).paths.values(),receiver);
+}
+
+QStringList Qtilities::Core::FileWatchService::watchedFiles(QObject* receiver) const {
+    return d->subscribers.value(receiver).paths.values();
+}
+
+bool Qtilities::Core::FileWatchService::isWatching(const QString& path, QObject* receiver) const {
+    QHash<QObject*,WatchSubscriber>::const_iterator itr = d->subscribers.constFind(receiver);
+    if (itr == d->subscribers.constEnd())
+        return false;
+    return itr.value().paths.contains(normalizedWatchPath(path));
+}
+
+void Qtilities::Core::FileWatchService::setDebounceInterval(int msec) {
+    d->debounce_timer->setInterval(qMax(0,msec));
+}
+
+int Qtilities::Core::FileWatchService::debounceInterval() const {
+    return d->debounce_timer->interval();
+}
+
+void Qtilities::Core::FileWatchService::setDirectoryWatchThreshold(int file_count) {
+    if (d->directory_watch_threshold == file_count)
+        return;
+
+    d->directory_watch_threshold = qMax(0,file_count);
+    foreach (const QString& dir, d->dir_files.keys())
+        updateDirectoryWatch(dir);
+}
+
+int Qtilities::Core::FileWatchService::directoryWatchThreshold() const {
+    return d->directory_watch_threshold;
+}
+
+void Qtilities::Core::FileWatchService::handleFileChanged(const QString& path) {
+    // QFileSystemWatcher stops watching files which are removed, this is also the case for files replaced through a rename.
+    // Thus we stop watching the file here and let flushChanges() watch it again once the burst of changes is over:
+    if (d->watched_files.remove(path))
+        d->watcher->removePath(path);
+
+    d->changed_files.insert(path);
+    if (!d->debounce_timer->isActive())
+        d->debounce_timer->start();
+}
+
+void Qtilities::Core::FileWatchService::handleDirectoryChanged(const QString& path) {
+    d->changed_dirs.insert(path);
+    if (!d->debounce_timer->isActive())
+        d->debounce_timer->start();
+}
+
+void Qtilities::Core::FileWatchService::handleReceiverDestroyed(QObject* receiver) {
+    unwatchAll(receiver);
+}
+
+void Qtilities::Core::FileWatchService::flushChanges() {
+    QSet<QString> changed;
+    QSet<QString> touched_dirs;
+
+    // Files watched individually reported their changes directly:
+    foreach (const QString& path, d->changed_files) {
+        QHash<QString,WatchedFile>::iterator itr = d->files.find(path);
+        if (itr == d->files.end())
+            continue;
+        itr.value().snapshot = FileWatchSnapshot(path);
+        changed.insert(path);
+        touched_dirs.insert(itr.value().dir);
+    }
+
+    // For watched directories we need to find out which of the watched files in it changed:
+    foreach (const QString& dir, d->changed_dirs) {
+        foreach (const QString& path, d->dir_files.value(dir)) {
+            WatchedFile& watched_file = d->files[path];
+            FileWatchSnapshot snapshot(path);
+            if (snapshot != watched_file.snapshot) {
+                watched_file.snapshot = snapshot;
+                changed.insert(path);
+            }
+        }
+        touched_dirs.insert(dir);
+    }
+
+    d->changed_files.clear();
+    d->changed_dirs.clear();
+
+    // Files which were removed or replaced must be watched again, or through their directory:
+    foreach (const QString& dir, touched_dirs)
+        updateDirectoryWatch(dir);
+
+    if (changed.isEmpty())
+        return;
+
+    // Build one notification per subscriber:
+    QHash<QObject*,QStringList> notifications;
+    foreach (const QString& path, changed) {
+        const WatchedFile& watched_file = d->files[path];
+        foreach (QObject* receiver, watched_file.subscribers)
+            notifications[receiver] << d->subscribers[receiver].paths.value(path);
+    }
+
+    QList<QPointer<QObject> > receivers;
+    foreach (QObject* receiver, notifications.keys())
+        receivers << receiver;
+
+    // Subscribers can change subscriptions or delete other subscribers in their slots, thus work on copies and guarded pointers:
+    foreach (const QPointer<QObject>& receiver, receivers) {
+        if (!receiver || !d->subscribers.contains(receiver))
+            continue;
+        QByteArray member = d->subscribers.value(receiver).member;
+        QMetaObject::invokeMethod(receiver,member.constData(),Q_ARG(QStringList,notifications.value(receiver)));
+    }
+}
+
+void Qtilities::Core::FileWatchService::updateDirectoryWatch(const QString& dir_path) {
+    QHash<QString,QSet<QString> >::iterator dir_itr = d->dir_files.find(dir_path);
+    if (dir_itr == d->dir_files.end() || dir_itr.value().isEmpty()) {
+        if (dir_itr != d->dir_files.end())
+            d->dir_files.erase(dir_itr);
+        if (d->watched_dirs.remove(dir_path))
+            d->watcher->removePath(dir_path);
+        return;
+    }
+
+    // Existing files are always watched individually: directory watches do not report writes to the contents of
+    // files in the directory. The directory is watched in addition to detect files being created, removed or
+    // renamed, which is needed when files are missing and which is cheaper than re-adding many replaced files:
+    const QSet<QString>& dir_files = dir_itr.value();
+    bool watch_dir = (d->directory_watch_threshold > 0 && dir_files.count() >= d->directory_watch_threshold);
+
+    QStringList add_files;
+    foreach (const QString& path, dir_files) {
+        if (QFile::exists(path)) {
+            if (!d->watched_files.contains(path)) {
+                d->watched_files.insert(path);
+                add_files << path;
+            }
+        } else {
+            // Files which does not exist can't be watched, the directory tells us when they are created again:
+            watch_dir = true;
+        }
+    }
+
+    if (!add_files.isEmpty())
+        d->watcher->addPaths(add_files);
+
+    if (watch_dir && !d->watched_dirs.contains(dir_path)) {
+        if (QFileInfo(dir_path).isDir()) {
+            d->watched_dirs.insert(dir_path);
+            d->watcher->addPath(dir_path);
+        }
+    } else if (!watch_dir && d->watched_dirs.remove(dir_path)) {
+        d->watcher->removePath(dir_path);
+    }
+}
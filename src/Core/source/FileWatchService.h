@@ -0,0 +1,121 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#ifndef FILE_WATCH_SERVICE_H
+#define FILE_WATCH_SERVICE_H
+
+#include "QtilitiesCore_global.h"
+
+#include <QObject>
+#include <QStringList>
+
+namespace Qtilities {
+    namespace Core {
+        /*!
+        \struct FileWatchServicePrivateData
+        \brief Structure used by FileWatchService to store private data.
+          */
+        struct FileWatchServicePrivateData;
+
+        /*!
+        \class FileWatchService
+        \brief The FileWatchService class is a process wide service which monitors files for changes on behalf of multiple subscribers.
+
+        Using a QFileSystemWatcher per object which needs to know about file changes does not scale well: the same path is watched
+        multiple times, and editors that save files by renaming them generate bursts of change notifications which are handled one by
+        one. FileWatchService solves these problems by:
+        - Sharing a single QFileSystemWatcher between all subscribers. Paths are reference counted, thus a path is watched once no matter
+          how many subscribers are interested in it.
+        - Watching the directory of watched files in addition to the files themselves when many watched files share a directory (see
+          setDirectoryWatchThreshold()), or when watched files do not exist. The directory watch detects files being created, removed or renamed,
+          which is done by comparing the size, modification time and existence of the watched files in the directory. Writes to the contents of
+          files are always detected through the file watches, since directory watches do not report them.
+        - Collecting all changes within a debounce window (see setDebounceInterval()) and notifying each subscriber once with all changed
+          paths it is interested in.
+        - Watching files again after they were replaced through a rename.
+
+\code
+FileWatchService::instance()->watchFiles(my_files,this,SLOT(handleFilesChanged(QStringList)));
+\endcode
+
+        The slot is invoked with the paths exactly as they were passed to watchFile() or watchFiles(). Subscribers are unsubscribed from all their
+        paths automatically when they are destroyed.
+
+        <i>This class was added in %Qtilities v1.5.</i>
+          */
+        class QTILIITES_CORE_SHARED_EXPORT FileWatchService : public QObject {
+            Q_OBJECT
+
+        public:
+            static FileWatchService* instance();
+            virtual ~FileWatchService();
+
+            //! Starts watching a file on behalf of the receiver.
+            /*!
+              \param path The path of the file to watch.
+              \param receiver The subscriber.
+              \param member The slot of the receiver which must be called when watched files changed. The slot must take a QStringList
+              parameter, for example SLOT(handleFilesChanged(QStringList)). Once a receiver subscribed with a slot, the same slot is used for
+              all paths it subscribes to and later values of this parameter are ignored.
+              */
+            void watchFile(const QString& path, QObject* receiver, const char* member);
+            //! Starts watching a list of files on behalf of the receiver.
+            /*!
+              This is more efficient than calling watchFile() for each file. See watchFile() for a description of the parameters.
+              */
+            void watchFiles(const QStringList& paths, QObject* receiver, const char* member);
+            //! Stops watching a file on behalf of the receiver.
+            void unwatchFile(const QString& path, QObject* receiver);
+            //! Stops watching a list of files on behalf of the receiver.
+            void unwatchFiles(const QStringList& paths, QObject* receiver);
+            //! Stops watching all files on behalf of the receiver.
+            void unwatchAll(QObject* receiver);
+            //! Returns all files watched on behalf of the receiver.
+            QStringList watchedFiles(QObject* receiver) const;
+            //! Indicates if the receiver is watching the specified file.
+            bool isWatching(const QString& path, QObject* receiver) const;
+
+            //! Sets the debounce interval in milliseconds.
+            /*!
+              All changes which happen within this interval after the first change are reported in a single notification. The default is 100 ms.
+              */
+            void setDebounceInterval(int msec);
+            //! Gets the debounce interval in milliseconds.
+            int debounceInterval() const;
+            //! Sets the number of watched files in a single directory from which the directory is watched in addition to the individual files.
+            /*!
+              The directory watch detects files being created, removed or renamed. Existing files are always watched individually since directory
+              watches do not report writes to the contents of files. Directories which contain watched files that do not exist are always watched.
+
+              The default is 16. Set to 0 to only watch directories which contain watched files that do not exist.
+              */
+            void setDirectoryWatchThreshold(int file_count);
+            //! Gets the number of watched files in a single directory from which the directory is watched in addition to the individual files.
+            int directoryWatchThreshold() const;
+
+        private slots:
+            void handleFileChanged(const QString& path);
+            void handleDirectoryChanged(const QString& path);
+            void handleReceiverDestroyed(QObject* receiver);
+            void flushChanges();
+
+        private:
+            FileWatchService();
+            //! Updates the way files in dir_path are watched after files were added to or removed from it.
+            void updateDirectoryWatch(const QString& dir_path);
+
+            FileWatchServicePrivateData* d;
+            static FileWatchService* m_Instance;
+        };
+    }
+}
+
+#endif // FILE_WATCH_SERVICE_H
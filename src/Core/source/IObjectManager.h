@@ -77,32 +77,32 @@ namespace Qtilities {
                 virtual Observer* objectPool() = 0;
                 //! A function which moves a list of objects from one observer to another observer.
                 /*!
-                  This function will attempt to move subjects from one observer context to another. If any of the subjects
-                  cannot be attached, it will be skipped and attempt to move the next subject in the list. If any of the
-                  subjects could not be attached, the function will return false. If all subjects was moved successfully the
-                  function will return true.
+                  This function will attempt to move subjects from one observer context to another. The move is done as a
+                  single transaction: all subjects are validated before any of them are moved, and when any of the subjects
+                  cannot be moved the subjects which were already moved are moved back to the source observer. Both observers
+                  notify their views once after the move completed. The ownership of moved subjects is kept.
 
                   \param objects The objects which must be moved.
                   \param source_observer_id The source observer ID.
                   \param destination_observer_id The destination observer ID.
                   \param error_msg When valid it will be populated with any error messages produced during the move operation.
                   \param silent When true the subjects must be moved without showing any dialogs.
-                  \return True if all objects were moved successfully, false if some of the objects failed.
+                  \return True if all objects were moved successfully, false if the move was rolled back.
                   */
                 virtual bool moveSubjects(QList<QObject*> objects, int source_observer_id, int destination_observer_id, QString* error_msg = 0,bool silent = false) = 0;
                 //! Move subjects by providing the objects as a list with smart pointers.
                 /*!
-                  This function will attempt to move subjects from one observer context to another. If any of the subjects
-                  cannot be attached, it will be skipped and attempt to move the next subject in the list. If any of the
-                  subjects could not be attached, the function will return false. If all subjects was moved successfully the
-                  function will return true.
+                  This function will attempt to move subjects from one observer context to another. The move is done as a
+                  single transaction: all subjects are validated before any of them are moved, and when any of the subjects
+                  cannot be moved the subjects which were already moved are moved back to the source observer. Both observers
+                  notify their views once after the move completed. The ownership of moved subjects is kept.
 
                   \param objects The objects which must be moved.
                   \param source_observer_id The source observer ID.
                   \param destination_observer_id The destination observer ID.
                   \param error_msg When valid it will be populated with any error messages produced during the move operation.
                   \param silent When true the subjects must be moved without showing any dialogs.
-                  \return True if all objects were moved successfully, false if some of the objects failed.
+                  \return True if all objects were moved successfully, false if the move was rolled back.
                   */
                 virtual bool moveSubjects(QList<QPointer<QObject> > objects, int source_observer_id, int destination_observer_i, QString* error_msg = 0, bool silent = false) = 0;
                 //! Registers an observer in the observer manager.
@@ -138,6 +138,14 @@ for (int i = 0; i < projectItemObjects.count(); i++) {
         projectItems.append(part);
 }
 \endcode
+
+                  Since %Qtilities v1.5 the object manager keeps an index of the objects implementing each interface which was
+                  passed to this function. The first call for an interface searches the object pool, after which the index is
+                  updated by registerObject() and removeObject() and when registered objects are deleted. To pick up objects attached
+                  to or detached from objectPool() directly, later calls compare the revision of the pool (see Observer::subjectsRevision())
+                  with the revision the index is in sync with. When they differ, the index is rebuilt.
+
+                  \sa newInterfaceObjectAdded(), interfaceObjectRemoved()
                   */
                 virtual QList<QObject*> registeredInterfaces(const QString& iface) const = 0;
 
@@ -146,6 +154,11 @@ for (int i = 0; i < projectItemObjects.count(); i++) {
                 // ---------------------------------
                 //! Registers a factory interface inside the %Qtilities factory.
                 virtual void registerFactoryInterface(FactoryInterface<QObject>* factory_interface, FactoryItemID iface_tag) = 0;
+                //! Unregisters a factory interface registered inside the %Qtilities factory using registerFactoryInterface().
+                /*!
+                  <i>This function was added in %Qtilities v1.5.</i>
+                  */
+                virtual void unregisterFactoryInterface(const QString& iface_tag) = 0;
 
                 // ---------------------------------
                 // Factory Management Related Functionality
@@ -169,9 +182,44 @@ for (int i = 0; i < projectItemObjects.count(); i++) {
                 */
                 virtual IFactoryProvider* referenceIFactoryProvider(const QString& factory_name) const = 0;
                 //! Provides a list with the names of all the factories registered in the object manager.
+                /*!
+                  Since %Qtilities v1.5 the result comes from the factory catalog, see invalidateFactoryCatalog().
+                  */
                 virtual QStringList allFactoryNames() const = 0;
                 //! Provides a list of all the tags registered in a specific factory.
-                virtual QStringList tagsForFactory(const QString& factory_name) const = 0;
+                /*!
+                  \param factory_name The name of the factory.
+                  \param category_filter When a valid category is provided, only tags in that category are returned. This parameter was added in %Qtilities v1.5.
+
+                  Since %Qtilities v1.5 the result comes from the factory catalog, see invalidateFactoryCatalog().
+                  */
+                virtual QStringList tagsForFactory(const QString& factory_name, const QtilitiesCategory& category_filter = QtilitiesCategory()) const = 0;
+                //! Provides the categories of the tags registered in a specific factory, in the order in which they first appear in tagsForFactory().
+                /*!
+                  <i>This function was added in %Qtilities v1.5.</i>
+                  */
+                virtual QList<QtilitiesCategory> categoriesForFactory(const QString& factory_name) const = 0;
+                //! Invalidates the factory catalog.
+                /*!
+                  The object manager keeps a catalog of the factory names, tags and categories of all registered IFactoryProvider
+                  interfaces. The catalog is built the first time it is used and is used by allFactoryNames(), tagsForFactory()
+                  and categoriesForFactory() until it is invalidated. It is invalidated automatically when registerIFactoryProvider(),
+                  registerFactoryInterface() or unregisterFactoryInterface() is called. IFactoryProvider implementations whose tags change after they were
+                  registered must call this function.
+
+                  <i>This function was added in %Qtilities v1.5.</i>
+                  */
+                virtual void invalidateFactoryCatalog() = 0;
+                //! Returns the number of factory catalog lookups which were answered without querying the registered IFactoryProvider interfaces.
+                /*!
+                  <i>This function was added in %Qtilities v1.5.</i>
+                  */
+                virtual int factoryCatalogHitCount() const = 0;
+                //! Returns the number of times the factory catalog was built by querying the registered IFactoryProvider interfaces.
+                /*!
+                  <i>This function was added in %Qtilities v1.5.</i>
+                  */
+                virtual int factoryCatalogBuildCount() const = 0;
 
                 // ---------------------------------
                 // Global Active Objects Functionality
@@ -200,6 +248,20 @@ for (int i = 0; i < projectItemObjects.count(); i++) {
                 void newObjectAdded(QObject* obj);
                 //! Signal which is emitted when an object is removed from the global object pool.
                 void objectRemoved(QObject* obj);
+                //! Signal which is emitted when an object implementing \p iface is added to the global object pool using registerObject().
+                /*!
+                  This signal is only emitted for interfaces which were passed to registeredInterfaces() before.
+
+                  <i>This signal was added in %Qtilities v1.5.</i>
+                  */
+                void newInterfaceObjectAdded(const QString& iface, QObject* obj);
+                //! Signal which is emitted when an object implementing \p iface is removed from the global object pool using removeObject(), or when it is deleted.
+                /*!
+                  This signal is only emitted for interfaces which were passed to registeredInterfaces() before.
+
+                  <i>This signal was added in %Qtilities v1.5.</i>
+                  */
+                void interfaceObjectRemoved(const QString& iface, QObject* obj);
             };
 
             Q_DECLARE_OPERATORS_FOR_FLAGS(IObjectManager::PropertyTypeFlags)
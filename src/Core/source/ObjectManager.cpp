@@ -34,10 +34,29 @@ using namespace Qtilities::Core::Constants;
 using namespace Qtilities::Core::Properties;
 using namespace Qtilities::Core::Interfaces;
 
+namespace {
+    // The catalog of a single factory, see ObjectManager::updateFactoryCatalog().
+    struct qti_private_FactoryCatalogEntry {
+        QStringList                             tags;
+        QList<QtilitiesCategory>                categories;
+        QHash<QtilitiesCategory,QStringList>    category_tags;
+    };
+
+    // The objects in the object pool which implement a specific interface, see ObjectManager::registeredInterfaces().
+    struct qti_private_InterfaceIndexEntry {
+        QByteArray                  iface;
+        QList<QPointer<QObject> >   objects;
+    };
+}
+
 struct Qtilities::Core::ObjectManagerPrivateData {
     ObjectManagerPrivateData() : object_pool(qti_def_GLOBAL_OBJECT_POOL,QObject::tr("Pool of exposed global objects.")),
       id(1),
-      itr_id(1) { }
+      itr_id(1),
+      factory_catalog_valid(false),
+      factory_catalog_hits(0),
+      factory_catalog_builds(0),
+      indexed_pool_revision(0) { }
 
     QHash<int,QPointer<Observer> >              context_map;
     QMap<QString, IFactoryProvider*>            factory_map;
@@ -46,6 +65,20 @@ struct Qtilities::Core::ObjectManagerPrivateData {
     int                                         id;
     int                                         itr_id;
     Factory<QObject>                            qtilities_factory;
+
+    bool                                                    factory_catalog_valid;
+    QStringList                                             factory_catalog_names;
+    QHash<QString,qti_private_FactoryCatalogEntry>          factory_catalog;
+    int                                                     factory_catalog_hits;
+    int                                                     factory_catalog_builds;
+
+    QHash<QString,qti_private_InterfaceIndexEntry>          interface_index;
+    //! The indexed interfaces implemented by each object in the pool.
+    QHash<const QObject*,QStringList>                       object_interfaces;
+    //! The objects in the pool which are known to the interface index.
+    QSet<const QObject*>                                    indexed_objects;
+    //! The revision of the object pool which the interface index is in sync with, see Observer::subjectsRevision().
+    int                                                     indexed_pool_revision;
 };
 
 Qtilities::Core::ObjectManager::ObjectManager(QObject* parent) : IObjectManager(parent)
@@ -53,6 +86,7 @@ Qtilities::Core::ObjectManager::ObjectManager(QObject* parent) : IObjectManager(
     d = new ObjectManagerPrivateData;
     d->object_pool.startProcessingCycle();
     connect(&d->object_pool,SIGNAL(subjectDeleted(QObject*)),SIGNAL(objectRemoved(QObject*)));
+    connect(&d->object_pool,SIGNAL(subjectDeleted(QObject*)),SLOT(handleObjectPoolSubjectDeleted(QObject*)));
 
     setObjectName(tr("Object Manager"));
 
@@ -183,78 +217,99 @@ bool Qtilities::Core::ObjectManager::moveSubjects(QList<QObject*> objects, int s
     if (!source_observer || !destination_observer)
         return false;
 
-    bool none_failed = true;
-
-    // For now we discard objects that cause problems during attachment and detachment
+    // Remove invalid and duplicate objects:
+    QList<QObject*> valid_objects;
+    QSet<QObject*> seen_objects;
     for (int i = 0; i < objects.count(); ++i) {
-        // Check if the destination observer will accept it
-        Observer::EvaluationResult result = destination_observer->canAttach(objects.at(i),Observer::ManualOwnership,error_msg,silent);
-        if (result == Observer::Rejected) {           
+        QObject* obj = objects.at(i);
+        if (obj && !seen_objects.contains(obj)) {
+            seen_objects.insert(obj);
+            valid_objects << obj;
+        }
+    }
+    if (valid_objects.isEmpty())
+        return true;
+
+    // Validate the complete move before changing anything:
+    for (int i = 0; i < valid_objects.count(); ++i) {
+        QObject* obj = valid_objects.at(i);
+        if (destination_observer->canAttach(obj,Observer::ManualOwnership,error_msg,silent) == Observer::Rejected) {
+            QString error_msg_int;
+            if (error_msg)
+                error_msg_int = QString("The move operation could not be completed. Object \"%1\" cannot be attached to the destination observer. Error message: %2").arg(obj->objectName()).arg(*error_msg);
+            else
+                error_msg_int = QString("The move operation could not be completed. Object \"%1\" cannot be attached to the destination observer. Calling ObjectManager::moveSubjects() with a valid error message argument will add an error message to this message.").arg(obj->objectName());
+            LOG_ERROR(error_msg_int);
+            if (error_msg)
+                *error_msg = error_msg_int;
+            return false;
+        }
+
+        Observer::EvaluationResult result = source_observer->canDetach(obj);
+        if (result == Observer::Rejected) {
+            QString error_msg_int = "The move operation could not be completed. Detachment of the object(s) you are trying to move was rejected by the source observer. Check the session log for more details.";
+            LOG_ERROR(error_msg_int);
+            if (error_msg)
+                *error_msg = error_msg_int;
+            return false;
+        } else if (result == Observer::IsParentObserver) {
+            QString error_msg_int = "The move operation could not be completed. The object(s) you are trying to move cannot be removed from the source observer which is defined to be their owner.\n\nTry to share with (copy to) the destination observer instead.";
+            LOG_ERROR(error_msg_int);
+            if (error_msg)
+                *error_msg = error_msg_int;
+            return false;
+        }
+    }
+
+    // Apply the move in processing cycles, thus each observer only notifies its views once. Objects are attached to the
+    // destination before they are detached from the source. Objects therefore never go out of scope during the move,
+    // their ownership is kept, and the source observer is left untouched when any attachment fails:
+    source_observer->startProcessingCycle();
+    destination_observer->startProcessingCycle();
+
+    bool success = true;
+    QList<QObject*> attached_objects;
+    QList<QObject*> detached_objects;
+    QString error_msg_int;
+    for (int i = 0; i < valid_objects.count(); ++i) {
+        QString reject_msg;
+        if (!destination_observer->attachSubject(valid_objects.at(i),Observer::ManualOwnership,&reject_msg)) {
+            error_msg_int = QString("The move operation could not be completed. Object \"%1\" cannot be attached to the destination observer. Error message: %2").arg(valid_objects.at(i)->objectName()).arg(reject_msg);
+            success = false;
             break;
-        } else {
-            // Detach from source
-            result = source_observer->canDetach(objects.at(i));
-            if (result == Observer::Rejected) {
-                QString error_msg_int = "The move operation could not be completed. Detachment of the object(s) you are trying to move was rejected by the destination observer. Check the session log for more details.";
-                LOG_ERROR(error_msg_int);
-                if (error_msg)
-                    *error_msg = error_msg_int;
-                none_failed = false;
-                break;
-            } else if (result == Observer::IsParentObserver) {              
-                QString error_msg_int = "The move operation could not be completed. The object(s) you are trying to move cannot be removed from the source observer which is defined to be their owner.\n\nTry to share with (copy to) the destination observer instead.";
-                LOG_ERROR(error_msg_int);
-                if (error_msg)
-                    *error_msg = error_msg_int;
-                none_failed = false;
+        }
+        attached_objects << valid_objects.at(i);
+    }
+
+    if (success) {
+        for (int i = 0; i < valid_objects.count(); ++i) {
+            QString reject_msg;
+            if (!source_observer->detachSubject(valid_objects.at(i),&reject_msg)) {
+                error_msg_int = QString("The move operation could not be completed. Object \"%1\" cannot be removed from the source observer. Error message: %2").arg(valid_objects.at(i)->objectName()).arg(reject_msg);
+                success = false;
                 break;
-            } else if (result == Observer::LastScopedObserver) {
-                destination_observer->setMultiContextPropertyValue(objects.at(i),qti_prop_OWNERSHIP,QVariant(Observer::ManualOwnership));
-                if (!source_observer->detachSubject(objects.at(i))) {
-                    QString error_msg_int = "The move operation could not be completed. The object(s) you are trying to move cannot be removed from the source observer where LastScopedObserver was detected. Check the session log for more details.";
-                    LOG_ERROR(error_msg_int);
-                    if (error_msg)
-                        *error_msg = error_msg_int;
-                    destination_observer->setMultiContextPropertyValue(objects.at(i),qti_prop_OWNERSHIP,QVariant(Observer::ObserverScopeOwnership));
-                    none_failed = false;
-                    break;
-                } else {
-                    if (!destination_observer->attachSubject(objects.at(i),Observer::ObserverScopeOwnership)) {
-                        source_observer->attachSubject(objects.at(i),Observer::ObserverScopeOwnership,error_msg);
-                        QString error_msg_int;
-                        if (error_msg)
-                            error_msg_int = "The move operation could not be completed. The object(s) you are trying to move cannot be attached to the destination observer. Error message: " + *error_msg;
-                        else
-                            error_msg_int = "The move operation could not be completed. The object(s) you are trying to move cannot be attached to the destination observer. Calling ObjectManager::moveSubjects() with a valid error message argument will add an error message to this message.";
-                        LOG_ERROR(error_msg_int);
-                        if (error_msg)
-                            *error_msg = error_msg_int;
-                    }
-                }
-            } else {
-                if (!source_observer->detachSubject(objects.at(i))) {
-                    QString error_msg_int = "The move operation could not be completed. The object(s) you are trying to move cannot be removed from the source observer. Check the session log for more details.";
-                    LOG_ERROR(error_msg_int);
-                    if (error_msg)
-                        *error_msg = error_msg_int;
-                    none_failed = false;
-                    break;
-                } else {
-                    if (!destination_observer->attachSubject(objects.at(i))) {
-                        source_observer->attachSubject(objects.at(i));
-                        QString error_msg_int;
-                        if (error_msg)
-                            error_msg_int = "The move operation could not be completed. The object(s) you are trying to move cannot be attached to the destination observer. Error message: " + *error_msg;
-                        else
-                            error_msg_int = "The move operation could not be completed. The object(s) you are trying to move cannot be attached to the destination observer. Calling ObjectManager::moveSubjects() with a valid error message argument will add an error message to this message.";
-                        LOG_ERROR(error_msg_int);
-                    }
-                }
             }
+            detached_objects << valid_objects.at(i);
         }
     }
 
-    return none_failed;
+    // Roll back to the state before the move. Objects are still attached to the destination while they are
+    // attached to the source again, thus they can't go out of scope:
+    if (!success) {
+        for (int i = 0; i < detached_objects.count(); ++i)
+            source_observer->attachSubject(detached_objects.at(i),Observer::ManualOwnership);
+        for (int i = 0; i < attached_objects.count(); ++i)
+            destination_observer->detachSubject(attached_objects.at(i));
+
+        LOG_ERROR(error_msg_int);
+        if (error_msg)
+            *error_msg = error_msg_int;
+    }
+
+    destination_observer->endProcessingCycle();
+    source_observer->endProcessingCycle();
+
+    return success;
 }
 
 bool Qtilities::Core::ObjectManager::moveSubjects(QList<QPointer<QObject> > objects, int source_observer_id, int destination_observer_id, QString* error_msg, bool silent) {
@@ -278,17 +333,78 @@ void Qtilities::Core::ObjectManager::registerObject(QObject* obj, QtilitiesCateg
             }
         }
     }
-    if (d->object_pool.attachSubject(obj))
+    if (d->object_pool.attachSubject(obj)) {
+        indexRegisteredObject(obj);
+        updateIndexedPoolRevision();
         emit newObjectAdded(obj);
+    }
 }
 
 void Qtilities::Core::ObjectManager::removeObject(QObject* obj) {
-    if (d->object_pool.detachSubject(obj))
+    if (d->object_pool.detachSubject(obj)) {
+        if (unindexRegisteredObject(obj))
+            updateIndexedPoolRevision();
         emit objectRemoved(obj);
+    }
+}
+
+void Qtilities::Core::ObjectManager::handleObjectPoolSubjectDeleted(QObject* obj) {
+    if (unindexRegisteredObject(obj))
+        updateIndexedPoolRevision();
+}
+
+void Qtilities::Core::ObjectManager::updateIndexedPoolRevision() {
+    // The index only stays in sync when the change it just handled is the only change since it was last in sync:
+    if (d->indexed_pool_revision + 1 == d->object_pool.subjectsRevision())
+        d->indexed_pool_revision = d->object_pool.subjectsRevision();
+}
+
+void Qtilities::Core::ObjectManager::indexRegisteredObject(QObject* obj) {
+    d->indexed_objects.insert(obj);
+
+    QStringList ifaces;
+    QHash<QString,qti_private_InterfaceIndexEntry>::iterator itr;
+    for (itr = d->interface_index.begin(); itr != d->interface_index.end(); ++itr) {
+        if (obj->inherits(itr.value().iface.constData())) {
+            itr.value().objects << obj;
+            ifaces << itr.key();
+        }
+    }
+    if (ifaces.isEmpty())
+        return;
+
+    d->object_interfaces[obj] = ifaces;
+    for (int i = 0; i < ifaces.count(); ++i)
+        emit newInterfaceObjectAdded(ifaces.at(i),obj);
+}
+
+bool Qtilities::Core::ObjectManager::unindexRegisteredObject(QObject* obj) {
+    if (!d->indexed_objects.remove(obj))
+        return false;
+
+    // Deleted objects are already null in the entries, thus compare raw pointers:
+    const QStringList ifaces = d->object_interfaces.take(obj);
+    for (int i = 0; i < ifaces.count(); ++i) {
+        QList<QPointer<QObject> >& objects = d->interface_index[ifaces.at(i)].objects;
+        for (int j = 0; j < objects.count(); ++j) {
+            if (objects.at(j).data() == obj || objects.at(j).isNull()) {
+                objects.removeAt(j);
+                break;
+            }
+        }
+        emit interfaceObjectRemoved(ifaces.at(i),obj);
+    }
+    return true;
 }
 
 void Qtilities::Core::ObjectManager::registerFactoryInterface(FactoryInterface<QObject>* factory_interface, FactoryItemID iface_tag) {
-    d->qtilities_factory.registerFactoryInterface(factory_interface,iface_tag);
+    if (d->qtilities_factory.registerFactoryInterface(factory_interface,iface_tag))
+        invalidateFactoryCatalog();
+}
+
+void Qtilities::Core::ObjectManager::unregisterFactoryInterface(const QString& iface_tag) {
+    d->qtilities_factory.unregisterFactoryInterface(iface_tag);
+    invalidateFactoryCatalog();
 }
 
 bool Qtilities::Core::ObjectManager::registerIFactoryProvider(IFactoryProvider* factory_iface) {
@@ -309,6 +425,7 @@ bool Qtilities::Core::ObjectManager::registerIFactoryProvider(IFactoryProvider*
         }
     }
 
+    invalidateFactoryCatalog();
     return true;
 }
 
@@ -320,39 +437,120 @@ Qtilities::Core::Interfaces::IFactoryProvider* Qtilities::Core::ObjectManager::r
 }
 
 QStringList Qtilities::Core::ObjectManager::allFactoryNames() const {
-    QStringList names;
-    QStringList ifactory_keys = d->factory_map.keys();
+    updateFactoryCatalog();
+    return d->factory_catalog_names;
+}
 
-    foreach (const QString& ifactory_key, ifactory_keys) {
-        IFactoryProvider* ifactory = referenceIFactoryProvider(ifactory_key);
-        if (ifactory)
-            names << ifactory->providedFactories();
-    }
+QStringList Qtilities::Core::ObjectManager::tagsForFactory(const QString& factory_name, const QtilitiesCategory& category_filter) const {
+    updateFactoryCatalog();
+    QHash<QString,qti_private_FactoryCatalogEntry>::const_iterator itr = d->factory_catalog.constFind(factory_name);
+    if (itr == d->factory_catalog.constEnd())
+        return QStringList();
 
-    return names;
+    if (category_filter.isValid())
+        return itr.value().category_tags.value(category_filter);
+    else
+        return itr.value().tags;
 }
 
-QStringList Qtilities::Core::ObjectManager::tagsForFactory(const QString& factory_name) const {
-    QStringList tags;
-    QStringList ifactory_keys = d->factory_map.keys();
-
-    foreach (const QString& ifactory_key, ifactory_keys) {
-        IFactoryProvider* ifactory = referenceIFactoryProvider(ifactory_key);
-        if (ifactory) {
-            foreach (const QString& factory_name_int, ifactory->providedFactories()) {
-                if (factory_name_int == factory_name) {
-                    tags << ifactory->providedFactoryTags(factory_name);
-                    break;
-                }
+QList<QtilitiesCategory> Qtilities::Core::ObjectManager::categoriesForFactory(const QString& factory_name) const {
+    updateFactoryCatalog();
+    return d->factory_catalog.value(factory_name).categories;
+}
+
+void Qtilities::Core::ObjectManager::invalidateFactoryCatalog() {
+    d->factory_catalog_valid = false;
+}
+
+int Qtilities::Core::ObjectManager::factoryCatalogHitCount() const {
+    return d->factory_catalog_hits;
+}
+
+int Qtilities::Core::ObjectManager::factoryCatalogBuildCount() const {
+    return d->factory_catalog_builds;
+}
+
+void Qtilities::Core::ObjectManager::updateFactoryCatalog() const {
+    if (d->factory_catalog_valid) {
+        ++d->factory_catalog_hits;
+        return;
+    }
+
+    d->factory_catalog.clear();
+    d->factory_catalog_names = d->factory_map.keys();
+
+    QMap<QString, IFactoryProvider*>::const_iterator itr;
+    for (itr = d->factory_map.constBegin(); itr != d->factory_map.constEnd(); ++itr) {
+        IFactoryProvider* ifactory = itr.value();
+        if (!ifactory)
+            continue;
+
+        qti_private_FactoryCatalogEntry entry;
+        entry.tags = ifactory->providedFactoryTags(itr.key());
+        QMap<QString, QtilitiesCategory> tag_category_map = ifactory->tagCategoryMap(itr.key());
+        for (int i = 0; i < entry.tags.count(); ++i) {
+            const QString& tag = entry.tags.at(i);
+            QtilitiesCategory category = tag_category_map.value(tag);
+            QHash<QtilitiesCategory,QStringList>::iterator category_itr = entry.category_tags.find(category);
+            if (category_itr == entry.category_tags.end()) {
+                entry.categories << category;
+                category_itr = entry.category_tags.insert(category,QStringList());
             }
+            category_itr.value() << tag;
         }
+        d->factory_catalog[itr.key()] = entry;
     }
 
-    return tags;
+    d->factory_catalog_valid = true;
+    ++d->factory_catalog_builds;
 }
 
 QList<QObject*> Qtilities::Core::ObjectManager::registeredInterfaces(const QString& iface) const {
-    return d->object_pool.subjectReferences(iface);
+    if (iface.isEmpty())
+        return d->object_pool.subjectReferences(iface);
+
+    // Objects attached to or detached from the pool directly through objectPool() are not known to the index. When the
+    // pool changed in ways the index did not follow, rebuild the index from the pool:
+    if (d->indexed_pool_revision != d->object_pool.subjectsRevision()) {
+        d->indexed_pool_revision = d->object_pool.subjectsRevision();
+        d->object_interfaces.clear();
+        d->indexed_objects.clear();
+        const QList<QObject*> pool_objects = d->object_pool.subjectReferences();
+        for (int i = 0; i < pool_objects.count(); ++i)
+            d->indexed_objects.insert(pool_objects.at(i));
+
+        QHash<QString,qti_private_InterfaceIndexEntry>::iterator index_itr;
+        for (index_itr = d->interface_index.begin(); index_itr != d->interface_index.end(); ++index_itr) {
+            const QList<QObject*> objects = d->object_pool.subjectReferences(index_itr.key());
+            index_itr.value().objects.clear();
+            for (int i = 0; i < objects.count(); ++i) {
+                index_itr.value().objects << objects.at(i);
+                d->object_interfaces[objects.at(i)] << index_itr.key();
+            }
+        }
+    }
+
+    QHash<QString,qti_private_InterfaceIndexEntry>::const_iterator itr = d->interface_index.constFind(iface);
+    if (itr == d->interface_index.constEnd()) {
+        // First lookup of this interface, search the pool once:
+        const QList<QObject*> objects = d->object_pool.subjectReferences(iface);
+        qti_private_InterfaceIndexEntry& entry = d->interface_index[iface];
+        entry.iface = iface.toUtf8();
+        for (int i = 0; i < objects.count(); ++i) {
+            entry.objects << objects.at(i);
+            d->object_interfaces[objects.at(i)] << iface;
+        }
+        return objects;
+    }
+
+    QList<QObject*> objects;
+    const QList<QPointer<QObject> >& indexed_objects = itr.value().objects;
+    objects.reserve(indexed_objects.count());
+    for (int i = 0; i < indexed_objects.count(); ++i) {
+        if (indexed_objects.at(i))
+            objects << indexed_objects.at(i);
+    }
+    return objects;
 }
 
 void Qtilities::Core::ObjectManager::setMetaTypeActiveObjects(QList<QObject*> objects, const QString& meta_type) {
@@ -903,222 +1101,243 @@ bool Qtilities::Core::ObjectManager::removeDynamicProperties(QObject* obj, Prope
     return true;
 }
 
-bool Qtilities::Core::ObjectManager::compareDynamicProperties(const QObject* obj1, const QObject* obj2, PropertyTypeFlags property_types, PropertyDiffInfo* property_diff_info, QStringList ignore_list) {
-    if (!obj1 || !obj2)
-        return false;
+namespace {
+    //! The kinds of dynamic properties distinguished when comparing properties.
+    enum qti_private_PropertyKind {
+        qti_private_NormalProperty,
+        qti_private_SharedProperty,
+        qti_private_MultiContextProperty
+    };
 
-    // Get a list of properties on obj1 which must be used in comparison:
-    QMap<QString, QVariant> to_be_compared_normal1;
-    QMap<QString, SharedProperty> to_be_compared_shared1;
-    QMap<QString, MultiContextProperty> to_be_compared_multi1;
-    for (int i = 0; i < obj1->dynamicPropertyNames().count(); ++i) {
-        QString property_name = QString(obj1->dynamicPropertyNames().at(i).constData());
+    //! A dynamic property which must be compared.
+    struct qti_private_PropertyEntry {
+        qti_private_PropertyEntry() : kind(qti_private_NormalProperty) {}
 
-        // Check if the property is in the ignore list:
-        if (ignore_list.contains(property_name))
-            continue;
+        bool operator<(const qti_private_PropertyEntry& other) const {
+            return name < other.name;
+        }
 
-        // Check if its a Qtilities property:
-        if (!(property_types & ObjectManager::QtilitiesInternalProperties) && property_name.startsWith("qti."))
-            continue;
+        QByteArray  name;
+        QVariant    value;
+        int         kind;
+    };
 
-        // Now check the property types:
-        QVariant prop = obj1->property(obj1->dynamicPropertyNames().at(i).constData());
-        if (prop.isValid() && prop.canConvert<SharedProperty>() && (property_types & ObjectManager::SharedProperties))
-            to_be_compared_shared1[QString(obj1->dynamicPropertyNames().at(i).constData())] = prop.value<SharedProperty>();
-        else if (prop.isValid() && prop.canConvert<MultiContextProperty>() && (property_types & ObjectManager::MultiContextProperties))
-            to_be_compared_multi1[QString(obj1->dynamicPropertyNames().at(i).constData())] = prop.value<MultiContextProperty>();
-        else if (prop.isValid() && !prop.canConvert<SharedProperty>() && !prop.canConvert<MultiContextProperty>() && property_types & ObjectManager::NonQtilitiesProperties) {
-            to_be_compared_normal1[QString(obj1->dynamicPropertyNames().at(i).constData())] = prop;
-        }
-    }
+    //! Returns the properties on \p obj which must be compared, sorted by name.
+    QList<qti_private_PropertyEntry> qti_private_comparableProperties(const QObject* obj, ObjectManager::PropertyTypeFlags property_types, const QSet<QByteArray>& ignore_set) {
+        QList<qti_private_PropertyEntry> entries;
+        const int shared_type = qMetaTypeId<SharedProperty>();
+        const int multi_context_type = qMetaTypeId<MultiContextProperty>();
 
-    // Get a list of properties on obj2 which must be used in comparison:
-    QMap<QString, QVariant> to_be_compared_normal2;
-    QMap<QString, SharedProperty> to_be_compared_shared2;
-    QMap<QString, MultiContextProperty> to_be_compared_multi2;
-    for (int i = 0; i < obj2->dynamicPropertyNames().count(); ++i) {
-        QString property_name = QString(obj2->dynamicPropertyNames().at(i).constData());
+        const QList<QByteArray> property_names = obj->dynamicPropertyNames();
+        for (int i = 0; i < property_names.count(); ++i) {
+            const QByteArray& property_name = property_names.at(i);
 
-        // Check if the property is in the ignore list:
-        if (ignore_list.contains(property_name))
-            continue;
+            // Check if the property is in the ignore list:
+            if (!ignore_set.isEmpty() && ignore_set.contains(property_name))
+                continue;
 
-        // Check if its a Qtilities property:
-        if (!(property_types & ObjectManager::QtilitiesInternalProperties) && property_name.startsWith("qti."))
-            continue;
+            // Check if its a Qtilities property:
+            if (!(property_types & ObjectManager::QtilitiesInternalProperties) && property_name.startsWith("qti."))
+                continue;
 
-        // Now check the property types:
-        QVariant prop = obj2->property(obj2->dynamicPropertyNames().at(i).constData());
-        if (prop.isValid() && prop.canConvert<SharedProperty>() && (property_types & ObjectManager::SharedProperties))
-            to_be_compared_shared2[QString(obj2->dynamicPropertyNames().at(i).constData())] = prop.value<SharedProperty>();
-        else if (prop.isValid() && prop.canConvert<MultiContextProperty>() && (property_types & ObjectManager::MultiContextProperties))
-            to_be_compared_multi2[QString(obj2->dynamicPropertyNames().at(i).constData())] = prop.value<MultiContextProperty>();
-        else if (prop.isValid() && !prop.canConvert<SharedProperty>() && !prop.canConvert<MultiContextProperty>() && property_types & ObjectManager::NonQtilitiesProperties) {
-            to_be_compared_normal2[QString(obj2->dynamicPropertyNames().at(i).constData())] = prop;
+            // Now check the property types:
+            qti_private_PropertyEntry entry;
+            entry.value = obj->property(property_name.constData());
+            if (!entry.value.isValid())
+                continue;
+
+            if (entry.value.userType() == shared_type) {
+                if (!(property_types & ObjectManager::SharedProperties))
+                    continue;
+                entry.kind = qti_private_SharedProperty;
+            } else if (entry.value.userType() == multi_context_type) {
+                if (!(property_types & ObjectManager::MultiContextProperties))
+                    continue;
+                entry.kind = qti_private_MultiContextProperty;
+            } else {
+                if (!(property_types & ObjectManager::NonQtilitiesProperties))
+                    continue;
+                entry.kind = qti_private_NormalProperty;
+            }
+
+            entry.name = property_name;
+            entries << entry;
         }
+
+        qSort(entries);
+        return entries;
     }
 
-    bool is_equal = true;
-    // Compare lists of objects to compare:
-    if (to_be_compared_normal1 != to_be_compared_normal2) {
-        LOG_TRACE(QString("Comparing dynamic properties on object %1 with object %2. Comparison found that normal QVariant properties differ.").arg(obj1->objectName()).arg(obj2->objectName()));
-        is_equal = false;
+    //! Compares the typed payloads of two properties with the same name.
+    bool qti_private_propertyEntriesEqual(const qti_private_PropertyEntry& entry1, const qti_private_PropertyEntry& entry2) {
+        if (entry1.kind != entry2.kind)
+            return false;
+
+        if (entry1.kind == qti_private_SharedProperty)
+            return entry1.value.value<SharedProperty>() == entry2.value.value<SharedProperty>();
+        else if (entry1.kind == qti_private_MultiContextProperty)
+            return entry1.value.value<MultiContextProperty>() == entry2.value.value<MultiContextProperty>();
+        else
+            return entry1.value == entry2.value;
     }
-    if (to_be_compared_shared1 != to_be_compared_shared2) {
-        LOG_TRACE(QString("Comparing dynamic properties on object %1 with object %2. Comparison found that shared properties differ.").arg(obj1->objectName()).arg(obj2->objectName()));
-        is_equal = false;
+
+    //! Returns the string used to represent the value of a property in a PropertyDiffInfo.
+    QString qti_private_propertyDiffString(const qti_private_PropertyEntry& entry) {
+        if (entry.kind == qti_private_MultiContextProperty)
+            return "(" + entry.value.value<MultiContextProperty>().valueString() + ")";
+
+        QVariant value;
+        if (entry.kind == qti_private_SharedProperty)
+            value = entry.value.value<SharedProperty>().value();
+        else
+            value = entry.value;
+
+        if (!QtilitiesProperty::isExportableVariant(value))
+            return "Non-exportable variant";
+        else
+            return value.toString();
     }
-    if (to_be_compared_multi1 != to_be_compared_multi2) {
-        LOG_TRACE(QString("Comparing dynamic properties on object %1 with object %2. Comparison found that multi context properties differ.").arg(obj1->objectName()).arg(obj2->objectName()));
-        is_equal = false;
+
+    //! Pairs the subjects of two observers by object name, in the order in which they appear in the observers.
+    QList<QPair<QObject*,QObject*> > qti_private_pairSubjects(const QList<QObject*>& subjects1, const QList<QObject*>& subjects2) {
+        QHash<QString,QList<QObject*> > unpaired_subjects2;
+        for (int i = 0; i < subjects2.count(); ++i)
+            unpaired_subjects2[subjects2.at(i)->objectName()] << subjects2.at(i);
+
+        QList<QPair<QObject*,QObject*> > pairs;
+        for (int i = 0; i < subjects1.count(); ++i) {
+            QObject* subject2 = 0;
+            QHash<QString,QList<QObject*> >::iterator itr = unpaired_subjects2.find(subjects1.at(i)->objectName());
+            if (itr != unpaired_subjects2.end() && !itr.value().isEmpty())
+                subject2 = itr.value().takeFirst();
+            pairs << qMakePair(subjects1.at(i),subject2);
+        }
+
+        // The subjects which were not paired appear only in the second observer:
+        for (int i = 0; i < subjects2.count(); ++i) {
+            QHash<QString,QList<QObject*> >::const_iterator itr = unpaired_subjects2.constFind(subjects2.at(i)->objectName());
+            if (itr.value().contains(subjects2.at(i)))
+                pairs << qMakePair((QObject*) 0,subjects2.at(i));
+        }
+
+        return pairs;
     }
+}
+
+bool Qtilities::Core::ObjectManager::compareDynamicProperties(const QObject* obj1, const QObject* obj2, PropertyTypeFlags property_types, PropertyDiffInfo* property_diff_info, QStringList ignore_list) {
+    if (!obj1 || !obj2)
+        return false;
+
+    QSet<QByteArray> ignore_set;
+    for (int i = 0; i < ignore_list.count(); ++i)
+        ignore_set.insert(ignore_list.at(i).toUtf8());
+
+    const QList<qti_private_PropertyEntry> entries1 = qti_private_comparableProperties(obj1,property_types,ignore_set);
+    const QList<qti_private_PropertyEntry> entries2 = qti_private_comparableProperties(obj2,property_types,ignore_set);
 
-    if (!is_equal && property_diff_info) {
+    if (property_diff_info)
         property_diff_info->clear();
 
-        // Get the differences in normal properties:
-        if (property_types & NonQtilitiesProperties) {
-            bool is_changed = true;
-            // Check for added properties:
-            for (int i = 0; i < to_be_compared_normal1.count(); ++i) {
-                QString name1 = to_be_compared_normal1.keys().at(i);
-
-                if (!to_be_compared_normal2.contains(name1)) {
-                    if (!QtilitiesProperty::isExportableVariant(to_be_compared_normal1[name1]))
-                        property_diff_info->d_added_properties[name1] = "Non-exportable variant";
-                    else
-                        property_diff_info->d_added_properties[name1] = to_be_compared_normal1[name1].toString();
-                    is_changed = false;
-                }
-            }
-            // Check for removed properties:
-            for (int i = 0; i < to_be_compared_normal2.count(); ++i) {
-                QString name2 = to_be_compared_normal2.keys().at(i);
-
-                if (!to_be_compared_normal1.contains(name2)) {
-                    if (!QtilitiesProperty::isExportableVariant(to_be_compared_normal2[name2]))
-                        property_diff_info->d_removed_properties[name2] = "Non-exportable variant";
-                    else
-                        property_diff_info->d_removed_properties[name2] = to_be_compared_normal2[name2].toString();
-                    is_changed = false;
-                }
-            }
-            // Check for changed properties:
-            if (is_changed) {
-                for (int i = 0; i < to_be_compared_normal1.count(); ++i) {
-                    QString name = to_be_compared_normal1.keys().at(i);
-                    if (to_be_compared_normal2.contains(name)) {
-                        QVariant value1 = to_be_compared_normal1[name];
-                        QVariant value2 = to_be_compared_normal2[name];
-
-                        QString value1_string;
-                        QString value2_string;
-
-                        if (!QtilitiesProperty::isExportableVariant(value1))
-                            value1_string = "Non-exportable variant";
-                        else
-                            value1_string = value1.toString();
-                        if (!QtilitiesProperty::isExportableVariant(value2))
-                            value2_string = "Non-exportable variant";
-                        else
-                            value2_string = value2.toString();
-
-                        if (value2_string != value1_string)
-                            property_diff_info->d_changed_properties[name] = value2_string + "," + value1_string;
-                    }
+    // Walk both sorted lists in a single pass. When no diff is requested we stop at the first difference:
+    bool is_equal = true;
+    int i1 = 0;
+    int i2 = 0;
+    while (i1 < entries1.count() || i2 < entries2.count()) {
+        const qti_private_PropertyEntry* entry1 = (i1 < entries1.count()) ? &entries1.at(i1) : 0;
+        const qti_private_PropertyEntry* entry2 = (i2 < entries2.count()) ? &entries2.at(i2) : 0;
+
+        if (entry1 && (!entry2 || entry1->name < entry2->name)) {
+            // The property only exists on obj1:
+            is_equal = false;
+            if (property_diff_info)
+                property_diff_info->d_added_properties[QString(entry1->name)] = qti_private_propertyDiffString(*entry1);
+            ++i1;
+        } else if (entry2 && (!entry1 || entry2->name < entry1->name)) {
+            // The property only exists on obj2:
+            is_equal = false;
+            if (property_diff_info)
+                property_diff_info->d_removed_properties[QString(entry2->name)] = qti_private_propertyDiffString(*entry2);
+            ++i2;
+        } else {
+            if (!qti_private_propertyEntriesEqual(*entry1,*entry2)) {
+                is_equal = false;
+                if (property_diff_info) {
+                    QString value1_string = qti_private_propertyDiffString(*entry1);
+                    QString value2_string = qti_private_propertyDiffString(*entry2);
+                    if (value2_string != value1_string)
+                        property_diff_info->d_changed_properties[QString(entry1->name)] = value2_string + "," + value1_string;
                 }
             }
+            ++i1;
+            ++i2;
         }
 
-        if (property_types & SharedProperties) {
-            bool is_changed = true;
-            // Check for added properties:
-            for (int i = 0; i < to_be_compared_shared1.count(); ++i) {
-                QString name1 = to_be_compared_shared1.keys().at(i);
-
-                if (!to_be_compared_shared2.contains(name1)) {
-                    if (!QtilitiesProperty::isExportableVariant(to_be_compared_shared1[name1].value()))
-                        property_diff_info->d_added_properties[name1] = "Non-exportable variant";
-                    else
-                        property_diff_info->d_added_properties[name1] = to_be_compared_shared1[name1].value().toString();
-                    is_changed = false;
-                }
-            }
-            // Check for removed properties:
-            for (int i = 0; i < to_be_compared_shared2.count(); ++i) {
-                QString name2 = to_be_compared_shared2.keys().at(i);
-
-                if (!to_be_compared_shared1.contains(name2)) {
-                    if (!QtilitiesProperty::isExportableVariant(to_be_compared_shared2[name2].value()))
-                        property_diff_info->d_removed_properties[name2] = "Non-exportable variant";
-                    else
-                        property_diff_info->d_removed_properties[name2] = to_be_compared_shared2[name2].value().toString();
-                    is_changed = false;
-                }
-            }
-            // Check for changed properties:
-            if (is_changed) {
-                for (int i = 0; i < to_be_compared_shared1.count(); ++i) {
-                    QString name = to_be_compared_shared1.keys().at(i);
-                    if (to_be_compared_shared2.contains(name)) {
-                        QVariant value1 = to_be_compared_shared1[name].value();
-                        QVariant value2 = to_be_compared_shared2[name].value();
-
-                        QString value1_string;
-                        QString value2_string;
-
-                        if (!QtilitiesProperty::isExportableVariant(value1))
-                            value1_string = "Non-exportable variant";
-                        else
-                            value1_string = value1.toString();
-                        if (!QtilitiesProperty::isExportableVariant(value2))
-                            value2_string = "Non-exportable variant";
-                        else
-                            value2_string = value2.toString();
-
-                        if (value2_string != value1_string)
-                            property_diff_info->d_changed_properties[name] = value2_string + "," + value1_string;
-                    }
-                }
-            }
+        if (!is_equal && !property_diff_info)
+            break;
+    }
+
+    if (!is_equal)
+        LOG_TRACE(QString("Comparing dynamic properties on object %1 with object %2. Comparison found that the properties differ.").arg(obj1->objectName()).arg(obj2->objectName()));
+
+    return is_equal;
+}
+
+bool Qtilities::Core::ObjectManager::compareObserverTrees(const Observer* observer1, const Observer* observer2, PropertyTypeFlags property_types, QList<ObjectDiffInfo>* object_diff_infos, QStringList ignore_list) {
+    if (!observer1 || !observer2)
+        return false;
+
+    if (object_diff_infos)
+        object_diff_infos->clear();
+
+    // Breadth first walk over pairs of objects in the two trees, together with their paths:
+    QList<QPair<const QObject*,const QObject*> > queue;
+    QStringList paths;
+    queue << qMakePair((const QObject*) observer1,(const QObject*) observer2);
+    paths << observer1->objectName();
+
+    bool is_equal = true;
+    for (int i = 0; i < queue.count(); ++i) {
+        const QObject* obj1 = queue.at(i).first;
+        const QObject* obj2 = queue.at(i).second;
+        const QString path = paths.at(i);
+
+        PropertyDiffInfo property_diff_info;
+        if (!compareDynamicProperties(obj1,obj2,property_types,object_diff_infos ? &property_diff_info : 0,ignore_list)) {
+            is_equal = false;
+            if (!object_diff_infos)
+                return false;
+            ObjectDiffInfo object_diff_info;
+            object_diff_info.d_diff_type = ObjectDiffInfo::PropertiesChanged;
+            object_diff_info.d_path = path;
+            object_diff_info.d_property_diff_info = property_diff_info;
+            *object_diff_infos << object_diff_info;
         }
 
-        if (property_types & MultiContextProperties) {
-            bool is_changed = true;
-            // Check for added properties:
-            QList<QString> to_be_compared_multi1_keys = to_be_compared_multi1.keys();
-            for (int i = 0; i < to_be_compared_multi1.count(); ++i) {
-                QString name1 = to_be_compared_multi1_keys.at(i);
+        const Observer* obs1 = qobject_cast<const Observer*> (obj1);
+        const Observer* obs2 = qobject_cast<const Observer*> (obj2);
+        if (!obs1 || !obs2)
+            continue;
 
-                if (!to_be_compared_multi2.contains(name1)) {
-                    property_diff_info->d_added_properties[name1] = "(" + to_be_compared_multi1[name1].valueString() + ")";
-                    is_changed = false;
-                }
-            }
-            // Check for removed properties:
-            QList<QString> to_be_compared_multi2_keys = to_be_compared_multi2.keys();
-            for (int i = 0; i < to_be_compared_multi2.count(); ++i) {
-                QString name2 = to_be_compared_multi2_keys.at(i);
-
-                if (!to_be_compared_multi1.contains(name2)) {
-                    property_diff_info->d_removed_properties[name2] = "(" + to_be_compared_multi2[name2].valueString() + ")";
-                    is_changed = false;
-                }
+        QList<QPair<QObject*,QObject*> > pairs = qti_private_pairSubjects(obs1->subjectReferences(),obs2->subjectReferences());
+        for (int p = 0; p < pairs.count(); ++p) {
+            if (pairs.at(p).first && pairs.at(p).second) {
+                queue << qMakePair((const QObject*) pairs.at(p).first,(const QObject*) pairs.at(p).second);
+                paths << path + "/" + pairs.at(p).first->objectName();
+                continue;
             }
-            // Check for changed properties:
-            if (is_changed) {
-                for (int i = 0; i < to_be_compared_multi1.count(); ++i) {
-                    QString name = to_be_compared_multi1_keys.at(i);
-                    if (to_be_compared_multi2.contains(name)) {
-                        QString value1_string = to_be_compared_multi1[name].valueString();
-                        QString value2_string = to_be_compared_multi2[name].valueString();
-
-                        if (value2_string != value1_string)
-                            property_diff_info->d_changed_properties[name] = "(" + value2_string + "),(" + value1_string + ")";
-                    }
-                }
+
+            is_equal = false;
+            if (!object_diff_infos)
+                return false;
+            ObjectDiffInfo object_diff_info;
+            if (pairs.at(p).first) {
+                object_diff_info.d_diff_type = ObjectDiffInfo::SubjectAdded;
+                object_diff_info.d_path = path + "/" + pairs.at(p).first->objectName();
+            } else {
+                object_diff_info.d_diff_type = ObjectDiffInfo::SubjectRemoved;
+                object_diff_info.d_path = path + "/" + pairs.at(p).second->objectName();
             }
+            *object_diff_infos << object_diff_info;
         }
     }
 
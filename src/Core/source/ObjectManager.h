@@ -125,6 +125,44 @@ namespace Qtilities {
             QMap<QString,QString> d_changed_properties;
         };
 
+        /*!
+          \class ObjectDiffInfo
+          \brief The ObjectDiffInfo class describes a difference between two observer trees found by ObjectManager::compareObserverTrees().
+
+          <i>This class was added in %Qtilities v1.5.</i>
+         */
+        class QTILIITES_CORE_SHARED_EXPORT ObjectDiffInfo {
+        public:
+            //! The types of differences between two observer trees.
+            enum DiffType {
+                PropertiesChanged,  /*!< The object exists in both trees, but its dynamic properties differ. */
+                SubjectAdded,       /*!< The object only exists in the first tree. */
+                SubjectRemoved      /*!< The object only exists in the second tree. */
+            };
+
+            ObjectDiffInfo() : d_diff_type(PropertiesChanged) {}
+            bool operator==(const ObjectDiffInfo& ref) const {
+                if (d_diff_type != ref.d_diff_type)
+                    return false;
+                if (d_path != ref.d_path)
+                    return false;
+                if (d_property_diff_info != ref.d_property_diff_info)
+                    return false;
+
+                return true;
+            }
+            bool operator!=(const ObjectDiffInfo& ref) const {
+                return !(*this==ref);
+            }
+
+            //! The type of the difference.
+            DiffType d_diff_type;
+            //! The path to the object, consisting of the object names from the top level observer to the object separated by "/".
+            QString d_path;
+            //! The property differences on the object when d_diff_type is PropertiesChanged.
+            PropertyDiffInfo d_property_diff_info;
+        };
+
         /*!
           \struct ObjectManagerPrivateData
           \brief The ObjectManagerPrivateData struct stores data used by the ObjectManager class.
@@ -169,10 +207,15 @@ namespace Qtilities {
             void registerObject(QObject* obj, QtilitiesCategory category = QtilitiesCategory());
             void removeObject(QObject* obj);
             void registerFactoryInterface(FactoryInterface<QObject>* factory_interface, FactoryItemID iface_tag);
+            void unregisterFactoryInterface(const QString& iface_tag);
             bool registerIFactoryProvider(IFactoryProvider* factory_iface);
             IFactoryProvider* referenceIFactoryProvider(const QString& factory_name) const;
             QStringList allFactoryNames() const;
-            QStringList tagsForFactory(const QString& factory_name) const;
+            QStringList tagsForFactory(const QString& factory_name, const QtilitiesCategory& category_filter = QtilitiesCategory()) const;
+            QList<QtilitiesCategory> categoriesForFactory(const QString& factory_name) const;
+            void invalidateFactoryCatalog();
+            int factoryCatalogHitCount() const;
+            int factoryCatalogBuildCount() const;
             QList<QObject*> registeredInterfaces(const QString& iface) const;
             QList<QPointer<QObject> > metaTypeActiveObjects(const QString& meta_type) const;
             void setMetaTypeActiveObjects(QList<QObject*> objects, const QString& meta_type);
@@ -281,6 +324,8 @@ if (ObjectManager::propertyExists(iface->objectBase(),qti_prop_CATEGORY_MAP)) {
             //! Convenience function to compare all properties that match the PropertyTypeFlags on two objects.
             /*!
               This function checks each property using the == overload of the QVariant property type and returns true if they match exactly, false otherwise.
+              Shared and multi context properties are compared using their own == overloads. The properties on both objects are sorted by name and compared
+              in a single pass, and when \p property_diff_info is not specified the comparison stops at the first difference.
 
               \param obj1 The first object to use in the comparison. The results will be relative to this object, for example if a property exists on \p obj1 and not on \p obj2, the diff result will show that the property was added. Also, when a property exists on both objects and the value changed, the old value will be the value on \p obj2 and the new value the value on \p obj1.
               \param obj2 The second object to use in the comparison.
@@ -289,6 +334,23 @@ if (ObjectManager::propertyExists(iface->objectBase(),qti_prop_CATEGORY_MAP)) {
               \param ignore_list A list of property names which should be ignored in the comparison.
               */
             static bool compareDynamicProperties(const QObject* obj1, const QObject* obj2, PropertyTypeFlags property_types = AllPropertyTypes, PropertyDiffInfo* property_diff_info = 0, QStringList ignore_list = QStringList());
+            //! Convenience function to compare the dynamic properties of all objects in two observer trees.
+            /*!
+              Subjects of the two trees are paired by object name, in the order in which they appear in their observers. The properties of
+              each pair of objects are compared using compareDynamicProperties(), and child observers are compared recursively.
+
+              Internal %Qtilities properties are not compared by default, since they contain the observer IDs of the trees.
+
+              \param observer1 The top level observer of the first tree. The results will be relative to this tree, in the same way as compareDynamicProperties().
+              \param observer2 The top level observer of the second tree.
+              \param property_types The property types which must be compared.
+              \param object_diff_infos Information about all differences between the trees. By default the differences will not be calculated and the comparison stops at the first difference.
+              \param ignore_list A list of property names which should be ignored in the comparison.
+              \returns True if the trees match exactly, false otherwise.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            static bool compareObserverTrees(const Observer* observer1, const Observer* observer2, PropertyTypeFlags property_types = PropertyTypeFlags(MultiContextProperties | SharedProperties | NonQtilitiesProperties), QList<ObjectDiffInfo>* object_diff_infos = 0, QStringList ignore_list = QStringList());
 
             //! Convenience function to allow construction of all properties specified by IAvailablePropertyProvider interfaces in the global object pool on the given object.
             /*!
@@ -333,7 +395,23 @@ if (ObjectManager::propertyExists(iface->objectBase(),qti_prop_CATEGORY_MAP)) {
             QObject* objectBase() { return this; }
             const QObject* objectBase() const { return this; }
 
+        private slots:
+            //! Removes a deleted object from the interface index.
+            void handleObjectPoolSubjectDeleted(QObject* obj);
+
         private:
+            //! Builds the factory catalog when it was invalidated.
+            void updateFactoryCatalog() const;
+            //! Adds \p obj to the entries in the interface index for the interfaces it implements.
+            void indexRegisteredObject(QObject* obj);
+            //! Removes \p obj from the interface index.
+            /*!
+              \returns True if \p obj was known to the interface index.
+              */
+            bool unindexRegisteredObject(QObject* obj);
+            //! Marks the interface index as in sync with the object pool after it handled a single change to the pool.
+            void updateIndexedPoolRevision();
+
             ObjectManagerPrivateData* d;
         };
     }
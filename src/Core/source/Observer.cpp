@@ -30,6 +30,8 @@
 #include <QMutableListIterator>
 #include <QDomElement>
 #include <QDomDocument>
+#include <QAtomicInt>
+#include <QSet>
 
 using namespace Qtilities::Core::Constants;
 using namespace Qtilities::Core::Interfaces;
@@ -41,6 +43,12 @@ namespace Qtilities {
     }
 }
 
+namespace {
+    // The number of tree processing cycles which are active in the application. Observers only look for
+    // tree processing cycles on their ancestors while this is not zero.
+    QAtomicInt qti_private_active_tree_processing_cycles;
+}
+
 Qtilities::Core::Observer::Observer(const QString& observer_name, const QString& observer_description, QObject* parent) : QObject(parent) {
     // Initialize observer data
     observerData = new ObserverData(this,observer_name);
@@ -50,7 +58,7 @@ Qtilities::Core::Observer::Observer(const QString& observer_name, const QString&
     observerData->access_mode = FullAccess;
     observerData->object_deletion_policy = DeleteImmediately;
     observerData->filter_subject_events_enabled = true;
-    connect(&observerData->subject_list,SIGNAL(objectDestroyed(QObject*)),SLOT(handle_deletedSubject(QObject*)));
+    connect(&observerData->subject_list,SIGNAL(objectDestroyedAt(QObject*,int)),SLOT(handle_deletedSubject(QObject*,int)));
 
     // Register this observer with the observer manager
     if (observer_name != QString(qti_def_GLOBAL_OBJECT_POOL))
@@ -68,7 +76,7 @@ Qtilities::Core::Observer::Observer(const Observer &other) : QObject(other.paren
     observerData = new ObserverData(*other.observerData);
     setObjectName(other.objectName());
 
-    connect(&observerData->subject_list,SIGNAL(objectDestroyed(QObject*)),SLOT(handle_deletedSubject(QObject*)));
+    connect(&observerData->subject_list,SIGNAL(objectDestroyedAt(QObject*,int)),SLOT(handle_deletedSubject(QObject*,int)));
 
     // Register this observer with the observer manager
     if (other.objectName() != QString(qti_def_GLOBAL_OBJECT_POOL))
@@ -78,6 +86,23 @@ Qtilities::Core::Observer::Observer(const Observer &other) : QObject(other.paren
 }
 
 Qtilities::Core::Observer::~Observer() {
+    if (observerData->tree_processing_cycle_count > 0) {
+        qti_private_active_tree_processing_cycles.fetchAndAddOrdered(-observerData->tree_processing_cycle_count);
+        observerData->tree_processing_cycle_count = 0;
+
+        // End the processing cycles of observers which joined the tree processing cycle. Their layoutChanged() signals
+        // can't be left to this observer anymore, thus they are ended as if they were not members:
+        QList<QPointer<Observer> > members = observerData->tree_processing_cycle_members;
+        observerData->tree_processing_cycle_members.clear();
+        for (int i = 0; i < members.count(); ++i) {
+            Observer* member = members.at(i);
+            if (member && member->observerData->tree_processing_cycle_member) {
+                member->observerData->tree_processing_cycle_member = false;
+                member->endProcessingCycle();
+            }
+        }
+    }
+
     startProcessingCycle();
 
     emit aboutToBeDeleted();
@@ -289,25 +314,36 @@ bool Observer::setMonitorSubjectModificationState(QObject *obj, bool monitor) {
     if (!mod_iface)
         return false;
 
-    if (monitor)
-        connect(obj,SIGNAL(modificationStateChanged(bool)),this,SLOT(setModificationState(bool)),Qt::UniqueConnection);
-    else
-        disconnect(obj,SIGNAL(modificationStateChanged(bool)),this,SLOT(setModificationState(bool)));
+    // Subjects can emit modificationStateChanged() from another object, see IModificationNotifier::objectBase():
+    QObject* notifier = mod_iface->objectBase();
+    if (notifier) {
+        if (monitor)
+            connect(notifier,SIGNAL(modificationStateChanged(bool)),this,SLOT(handleSubjectModificationStateChanged(bool)),Qt::UniqueConnection);
+        else
+            disconnect(notifier,SIGNAL(modificationStateChanged(bool)),this,SLOT(handleSubjectModificationStateChanged(bool)));
+    }
 
+    bool success = false;
     MultiContextProperty ignore_modification_state_prop = ObjectManager::getMultiContextProperty(obj,qti_prop_SUBJECT_IGNORE_MODIFICATION_STATE);
     if (ignore_modification_state_prop.isValid()) {
         // Thus, the property already exists
         ignore_modification_state_prop.addContext(!monitor,observerID());
-        return ObjectManager::setMultiContextProperty(obj,ignore_modification_state_prop);
+        success = ObjectManager::setMultiContextProperty(obj,ignore_modification_state_prop);
     } else {
         // We need to create the property and add it to the object.
         MultiContextProperty new_ignore_modification_state_prop(qti_prop_SUBJECT_IGNORE_MODIFICATION_STATE);
         new_ignore_modification_state_prop.addContext(!monitor,observerID());
-        return ObjectManager::setMultiContextProperty(obj,new_ignore_modification_state_prop);
+        success = ObjectManager::setMultiContextProperty(obj,new_ignore_modification_state_prop);
     }
 
-    // Should never get here:
-    return false;
+    if (monitor)
+        observerData->unmonitored_subjects.remove(obj);
+    else
+        observerData->unmonitored_subjects.insert(obj);
+    updateModifiedSubject(obj);
+    updateTrackedModificationState();
+
+    return success;
 }
 
 bool Observer::monitorSubjectModificationState(QObject *obj) {
@@ -332,23 +368,36 @@ bool Qtilities::Core::Observer::isModified() const {
     if (observerData->is_modified)
         return true;
 
-    // Check if any subjects are modified.
-    int count = observerData->subject_list.count();
-    for (int i = 0; i < count; ++i) {
-        IModificationNotifier* mod_iface = qobject_cast<IModificationNotifier*> (observerData->subject_list.at(i));
-        if (mod_iface) {
-            // Check if this subject must be monitored:
-            MultiContextProperty ignore_modification_state_prop = ObjectManager::getMultiContextProperty(observerData->subject_list.at(i),qti_prop_SUBJECT_IGNORE_MODIFICATION_STATE);
-            if (ignore_modification_state_prop.isValid()) {
-                if (ignore_modification_state_prop.hasContext(observerID())) {
-                    if (ignore_modification_state_prop.value(observerID()).toBool())
-                        continue;
-                }
+    // Subject observers report changes to their modification states, thus only the ones which are modified are tracked. Subject
+    // observers of which the modification states are not monitored are never added to modified_subjects:
+    if (!observerData->modified_subjects.isEmpty())
+        return true;
+
+    // Other subjects are not guaranteed to report all changes, thus they are checked directly:
+    QSet<QObject*>::const_iterator it = observerData->notifier_subjects.constBegin();
+    while (it != observerData->notifier_subjects.constEnd()) {
+        if (!observerData->unmonitored_subjects.contains(*it)) {
+            IModificationNotifier* mod_iface = qobject_cast<IModificationNotifier*> (*it);
+            if (mod_iface) {
+                if (mod_iface->isModified())
+                    return true;
             }
+        }
+        ++it;
+    }
 
-            if (mod_iface->isModified())
-                return true;
+    // Subject observers with such subjects in their trees can become modified without reporting it, thus they are queried as well.
+    // Only the paths in the tree leading to such subjects are followed:
+    it = observerData->unreported_state_subjects.constBegin();
+    while (it != observerData->unreported_state_subjects.constEnd()) {
+        if (!observerData->modified_subjects.contains(*it)) {
+            Observer* obs = qobject_cast<Observer*> (*it);
+            if (obs) {
+                if (obs->isModified())
+                    return true;
+            }
         }
+        ++it;
     }
 
     // Check if any subject filters were modified.
@@ -375,14 +424,23 @@ void Qtilities::Core::Observer::setModificationState(bool new_state, IModificati
         return;
 
     if (notification_targets & IModificationNotifier::NotifySubjects) {
-        // First notify all objects in this context.
-        int count = observerData->subject_list.count();
-        for (int i = 0; i < count; ++i) {
-            IModificationNotifier* mod_iface = qobject_cast<IModificationNotifier*> (observerData->subject_list.at(i));
+        // First notify objects in this context. When clearing the modification state, only subject observers which are modified
+        // must be visited, thus only dirty paths in the tree are followed. Other subjects and unmonitored subjects are always visited:
+        QList<QObject*> subjects;
+        if (new_state)
+            subjects = observerData->subject_list.toQList();
+        else
+            subjects = (observerData->modified_subjects + observerData->notifier_subjects + observerData->unmonitored_subjects + observerData->unreported_state_subjects).toList();
+        bool previous_notifying_subjects = observerData->notifying_subjects;
+        observerData->notifying_subjects = true;
+        for (int i = 0; i < subjects.count(); ++i) {
+            IModificationNotifier* mod_iface = qobject_cast<IModificationNotifier*> (subjects.at(i));
             if (mod_iface) {
                 mod_iface->setModificationState(new_state,notification_targets);
+                updateModifiedSubject(subjects.at(i));
             }
         }
+        observerData->notifying_subjects = previous_notifying_subjects;
         // Also notify all subject filters.
         for (int i = 0; i < observerData->subject_filters.count(); ++i) {
             IModificationNotifier* mod_iface = qobject_cast<IModificationNotifier*> (observerData->subject_filters.at(i));
@@ -398,6 +456,7 @@ void Qtilities::Core::Observer::setModificationState(bool new_state, IModificati
 
     // For observers we only notify targets if the actual state changed:
     if (observerData->is_modified != new_state || force_notifications) {
+        joinTreeProcessingCycle();
         observerData->is_modified = new_state;
         if (!observerData->process_cycle_active) {
             if (notification_targets & IModificationNotifier::NotifyListeners)
@@ -409,19 +468,114 @@ void Qtilities::Core::Observer::setModificationState(bool new_state, IModificati
             }
         }
     }
+
+    updateTrackedModificationState();
+}
+
+void Qtilities::Core::Observer::handleSubjectModificationStateChanged(bool is_modified) {
+    // Map the sender back to the subject when the subject emits the signal from another object, see IModificationNotifier::objectBase():
+    QObject* obj = sender();
+    if (obj && observerData->notifier_subject_bases.contains(obj))
+        obj = observerData->notifier_subject_bases.value(obj);
+    updateModifiedSubject(obj);
+
+    // When this observer is setting the modification states of its subjects, its own state is updated afterwards:
+    if (!observerData->notifying_subjects)
+        setModificationState(is_modified);
+}
+
+void Qtilities::Core::Observer::updateModifiedSubject(QObject* obj) {
+    // Only subject observers are tracked, other subjects are checked directly in isModified():
+    Observer* obs = qobject_cast<Observer*> (obj);
+    if (!obs)
+        return;
+
+    bool is_modified = false;
+    bool has_unreported_states = false;
+    if (!observerData->unmonitored_subjects.contains(obj)) {
+        is_modified = obs->isModified();
+        has_unreported_states = obs->hasUnreportedModificationStates();
+    }
+
+    bool changed = false;
+    if (is_modified) {
+        if (!observerData->modified_subjects.contains(obj)) {
+            observerData->modified_subjects.insert(obj);
+            changed = true;
+        }
+    } else if (observerData->modified_subjects.remove(obj)) {
+        changed = true;
+    }
+
+    if (has_unreported_states) {
+        if (!observerData->unreported_state_subjects.contains(obj)) {
+            observerData->unreported_state_subjects.insert(obj);
+            changed = true;
+        }
+    } else if (observerData->unreported_state_subjects.remove(obj)) {
+        changed = true;
+    }
+
+    if (changed)
+        updateTrackedModificationState();
+}
+
+bool Qtilities::Core::Observer::hasUnreportedModificationStates() const {
+    return !observerData->notifier_subjects.isEmpty() || !observerData->unreported_state_subjects.isEmpty();
+}
+
+void Qtilities::Core::Observer::forgetSubjectModificationState(QObject* obj) {
+    observerData->unmonitored_subjects.remove(obj);
+    bool changed = observerData->modified_subjects.remove(obj);
+    if (observerData->unreported_state_subjects.remove(obj))
+        changed = true;
+    if (observerData->notifier_subjects.remove(obj)) {
+        if (!observerData->notifier_subject_bases.isEmpty()) {
+            QObject* notifier = observerData->notifier_subject_bases.key(obj);
+            if (notifier) {
+                observerData->notifier_subject_bases.remove(notifier);
+                disconnect(notifier,SIGNAL(modificationStateChanged(bool)),this,SLOT(handleSubjectModificationStateChanged(bool)));
+            }
+        }
+        // Removing a subject can only clear the modification state of this observer, or its last subject which does not report all changes:
+        changed = changed || observerData->tracked_modification_state || !hasUnreportedModificationStates();
+    }
+    if (changed)
+        updateTrackedModificationState();
+}
+
+void Qtilities::Core::Observer::updateTrackedModificationState() {
+    bool is_modified = isModified();
+    bool has_unreported_states = hasUnreportedModificationStates();
+    if (is_modified == observerData->tracked_modification_state && has_unreported_states == observerData->tracked_unreported_state)
+        return;
+    observerData->tracked_modification_state = is_modified;
+    observerData->tracked_unreported_state = has_unreported_states;
+
+    QList<Observer*> parents = parentReferences(this);
+    for (int i = 0; i < parents.count(); ++i)
+        parents.at(i)->updateModifiedSubject(this);
 }
 
 void Qtilities::Core::Observer::refreshViewsLayout(QList<QPointer<QObject> > new_selection, bool force) {
+    if (!force)
+        joinTreeProcessingCycle();
     if (!observerData->process_cycle_active || force)
         emit layoutChanged(new_selection);
 }
 
 void Qtilities::Core::Observer::refreshViewsData(bool force) {
+    if (!force)
+        joinTreeProcessingCycle();
     if (!observerData->process_cycle_active || force)
         emit dataChanged(this);
 }
 
 void Qtilities::Core::Observer::startProcessingCycle() {
+    // Processing cycles started inside a tree processing cycle of an ancestor must not end it for this observer:
+    if (observerData->start_processing_cycle_count == 0)
+        joinTreeProcessingCycle();
+
     int previous_start_processing_cycle_count = observerData->start_processing_cycle_count;
 
     ++observerData->start_processing_cycle_count;
@@ -430,6 +584,8 @@ void Qtilities::Core::Observer::startProcessingCycle() {
 //        qDebug() << "startProcessingCycle" << observerName() << observerData->start_processing_cycle_count;
 
     if (previous_start_processing_cycle_count == 0 && observerData->start_processing_cycle_count == 1) {
+        // Report deletions which happened before the processing cycle started:
+        flushDeletedSubjects();
         observerData->number_of_subjects_start_of_proc_cycle = observerData->subject_list.count();
         observerData->process_cycle_active = true;
         observerData->modification_state_start_of_proc_cycle = isModified();
@@ -449,8 +605,20 @@ void Qtilities::Core::Observer::endProcessingCycle(bool broadcast) {
 //        qDebug() << "endProcessingCycle" << observerName() << observerData->start_processing_cycle_count;
 
     if (previous_start_processing_cycle_count == 1 && observerData->start_processing_cycle_count == 0) {
+        // Observers which joined a tree processing cycle leave the layoutChanged() signal to the observer on which the
+        // tree processing cycle was started, since layoutChanged() is forwarded to parent observers:
+        bool tree_processing_cycle_member = observerData->tree_processing_cycle_member;
+        observerData->tree_processing_cycle_member = false;
+
         // observerData->number_of_subjects_start_of_proc_cycle set to -1 in destructor.
         if (broadcast && (observerData->number_of_subjects_start_of_proc_cycle != -1)) {
+            // When the cycle is ended without broadcasting, deletions stay pending and are reported with the next broadcast:
+            if (!observerData->deleted_subjects.isEmpty()) {
+                QList<QObject*> deleted_subjects = observerData->deleted_subjects;
+                observerData->deleted_subjects.clear();
+                emit subjectsDeleted(deleted_subjects);
+            }
+
             bool is_modified = isModified();
             if (is_modified != observerData->modification_state_start_of_proc_cycle)
                 emit modificationStateChanged(is_modified);
@@ -465,7 +633,8 @@ void Qtilities::Core::Observer::endProcessingCycle(bool broadcast) {
                 emit numberOfSubjectsChanged(Observer::SubjectRemoved);
             else if (observerData->number_of_subjects_start_of_proc_cycle < observerData->subject_list.count())
                 emit numberOfSubjectsChanged(Observer::SubjectAdded);
-            emit layoutChanged();
+            if (!tree_processing_cycle_member)
+                emit layoutChanged();
         }
 
         // TODO: Send processing cycle end to subject filters in order for activity filter to emit the active subjects after the processing cycle if they changed. Note that TreeNode does this already.
@@ -484,31 +653,89 @@ void Observer::resetProcessingCycleCount(bool broadcast) {
 }
 
 bool Qtilities::Core::Observer::isProcessingCycleActive() const {
-    return observerData->process_cycle_active;
+    if (observerData->process_cycle_active)
+        return true;
+
+    return (treeProcessingCycleAncestor() != 0);
 }
 
 void Qtilities::Core::Observer::startTreeProcessingCycle() {
-    QList<QObject*> obj_list = treeChildren();
-    for (int i = 0; i < obj_list.count(); ++i) {
-        Observer* obs = qobject_cast<Observer*> (obj_list.at(i));
-        if (obs)
-            obs->startProcessingCycle();
-    }
+    // Observers in the tree join the cycle when they change, see joinTreeProcessingCycle():
+    ++observerData->tree_processing_cycle_count;
+    qti_private_active_tree_processing_cycles.fetchAndAddOrdered(1);
 
     startProcessingCycle();
 }
 
 void Qtilities::Core::Observer::endTreeProcessingCycle(bool broadcast) {
-    QList<QObject*> obj_list = treeChildren();
-    for (int i = 0; i < obj_list.count(); ++i) {
-        Observer* obs = qobject_cast<Observer*> (obj_list.at(i));
-        if (obs)
-            obs->endProcessingCycle(false);
+    if (observerData->tree_processing_cycle_count > 0) {
+        --observerData->tree_processing_cycle_count;
+        qti_private_active_tree_processing_cycles.fetchAndAddOrdered(-1);
+    } else
+        qWarning() << "endTreeProcessingCycle() called too many times on observer: " << observerName();
+
+    if (observerData->tree_processing_cycle_count == 0) {
+        QList<QPointer<Observer> > members = observerData->tree_processing_cycle_members;
+        observerData->tree_processing_cycle_members.clear();
+        for (int i = 0; i < members.count(); ++i) {
+            Observer* member = members.at(i);
+            if (member && member->observerData->tree_processing_cycle_member)
+                member->endProcessingCycle(broadcast);
+        }
     }
 
     endProcessingCycle(broadcast);
 }
 
+Qtilities::Core::Observer* Qtilities::Core::Observer::treeProcessingCycleAncestor() const {
+    if (qti_private_active_tree_processing_cycles.fetchAndAddOrdered(0) == 0)
+        return 0;
+
+    // Walk up through the parents of this observer, nearest ancestors first. Observers contained in
+    // other objects are part of the tree through the observers in which their parent objects are attached:
+    QList<const QObject*> objects_to_check;
+    objects_to_check << this;
+    QSet<quint32> checked_ids;
+    while (!objects_to_check.isEmpty()) {
+        const QObject* obj = objects_to_check.takeFirst();
+        MultiContextProperty observer_map = ObjectManager::getMultiContextProperty(obj,qti_prop_OBSERVER_MAP);
+        if (!observer_map.isValid() && obj->parent())
+            observer_map = ObjectManager::getMultiContextProperty(obj->parent(),qti_prop_OBSERVER_MAP);
+        if (!observer_map.isValid())
+            continue;
+
+        QList<quint32> parent_ids = observer_map.contextMap().keys();
+        for (int i = 0; i < parent_ids.count(); ++i) {
+            if (checked_ids.contains(parent_ids.at(i)))
+                continue;
+            checked_ids.insert(parent_ids.at(i));
+
+            Observer* parent = OBJECT_MANAGER->observerReference(parent_ids.at(i));
+            if (!parent || parent == this)
+                continue;
+            if (parent->observerData->tree_processing_cycle_count > 0)
+                return parent;
+            objects_to_check << parent;
+        }
+    }
+
+    return 0;
+}
+
+bool Qtilities::Core::Observer::joinTreeProcessingCycle() {
+    if (observerData->process_cycle_active || observerData->tree_processing_cycle_member)
+        return false;
+
+    Observer* ancestor = treeProcessingCycleAncestor();
+    if (!ancestor)
+        return false;
+
+    observerData->tree_processing_cycle_member = true;
+    ancestor->observerData->tree_processing_cycle_members << QPointer<Observer>(this);
+    startProcessingCycle();
+    return true;
+}
+
 void Qtilities::Core::Observer::setFactoryData(Qtilities::Core::InstanceFactoryInfo factory_data) {
     if (factory_data.isValid())
         observerData->factory_data = factory_data;
@@ -527,6 +754,7 @@ bool Qtilities::Core::Observer::attachSubject(QObject* obj, Observer::ObjectOwne
     #endif
 
     QPointer<QObject> safe_obj = obj;
+    joinTreeProcessingCycle();
 
     // If objectName() is empty, set the object name using the objects meta type info:
     if (obj->objectName().isEmpty())
@@ -561,6 +789,9 @@ bool Qtilities::Core::Observer::attachSubject(QObject* obj, Observer::ObjectOwne
         return false;
     }
 
+    // The position at which the subject was added:
+    int attach_position = -1;
+
     // Details of the global object pool observer is not added to any objects:
     if (objectName() != QString(qti_def_GLOBAL_OBJECT_POOL)) {
         // Now, add observer details to needed properties
@@ -580,6 +811,9 @@ bool Qtilities::Core::Observer::attachSubject(QObject* obj, Observer::ObjectOwne
 
         // Now that the object has the properties needed, we add it:
         observerData->subject_list.append(obj);
+        ++observerData->subjects_revision;
+        attach_position = observerData->subject_list.count() - 1;
+        invalidateTreeCount();
 
         // Handle object ownership
         #ifndef QT_NO_DEBUG
@@ -727,7 +961,7 @@ bool Qtilities::Core::Observer::attachSubject(QObject* obj, Observer::ObjectOwne
         Observer* obs = qobject_cast<Observer*> (obj);
         if (obs) {
             has_mod_iface = true;
-            connect(obs,SIGNAL(modificationStateChanged(bool)),SLOT(setModificationState(bool)));
+            connect(obs,SIGNAL(modificationStateChanged(bool)),SLOT(handleSubjectModificationStateChanged(bool)));
             connect(obs,SIGNAL(dataChanged(Observer*)),SIGNAL(dataChanged(Observer*)));
             connect(obs,SIGNAL(layoutChanged(QList<QPointer<QObject> >)),SIGNAL(layoutChanged(QList<QPointer<QObject> >)));
 
@@ -737,13 +971,29 @@ bool Qtilities::Core::Observer::attachSubject(QObject* obj, Observer::ObjectOwne
             // to the modification changed signals:
             IModificationNotifier* mod_iface = qobject_cast<IModificationNotifier*> (obj);
             if (mod_iface) {
-                if (mod_iface->objectBase()) {
-                    connect(mod_iface->objectBase(),SIGNAL(modificationStateChanged(bool)),SLOT(setModificationState(bool)));
+                QObject* notifier = mod_iface->objectBase();
+                if (notifier) {
+                    connect(notifier,SIGNAL(modificationStateChanged(bool)),SLOT(handleSubjectModificationStateChanged(bool)));
                     has_mod_iface = true;
+                    if (notifier != obj)
+                        observerData->notifier_subject_bases[notifier] = obj;
                 }
+                observerData->notifier_subjects.insert(obj);
+                if (!monitorSubjectModificationState(obj))
+                    observerData->unmonitored_subjects.insert(obj);
+                // Parent observers must query this observer directly from now on:
+                if (!observerData->tracked_unreported_state)
+                    updateTrackedModificationState();
             }
         }
 
+        // Track the modification state of the new subject observer:
+        if (obs) {
+            if (!monitorSubjectModificationState(obj))
+                observerData->unmonitored_subjects.insert(obj);
+            updateModifiedSubject(obj);
+        }
+
         // Emit neccesarry signals
         setModificationState(true);
 
@@ -758,6 +1008,8 @@ bool Qtilities::Core::Observer::attachSubject(QObject* obj, Observer::ObjectOwne
     } else {
         // If it is the global object manager it will get here.
         observerData->subject_list.append(obj);
+        ++observerData->subjects_revision;
+        invalidateTreeCount();
 
         Observer* obs = qobject_cast<Observer*> (obj);
         if (obs)
@@ -793,6 +1045,7 @@ bool Qtilities::Core::Observer::attachSubject(QObject* obj, Observer::ObjectOwne
         // Change layout only after finalzeAttachment() in all filters since they might add properties
         // used by views (activity policy filter for example)
         if (!observerData->process_cycle_active) {
+            emitSubjectsChanged(ObserverChangeSet::SubjectsInserted,attach_position,safe_obj);
             emit numberOfSubjectsChanged(Observer::SubjectAdded, objects);
             emit layoutChanged(objects);
         }
@@ -957,7 +1210,7 @@ Qtilities::Core::Observer::EvaluationResult Qtilities::Core::Observer::canAttach
     }
 }
 
-void Qtilities::Core::Observer::handle_deletedSubject(QObject* obj) {
+void Qtilities::Core::Observer::handle_deletedSubject(QObject* obj, int position) {
     #ifndef QT_NO_DEBUG
         Q_ASSERT(obj != 0);
     #endif
@@ -966,6 +1219,15 @@ void Qtilities::Core::Observer::handle_deletedSubject(QObject* obj) {
             return;
     #endif
 
+    // The object was already removed from subject_list, thus it must be counted when joining a tree processing cycle:
+    if (joinTreeProcessingCycle())
+        ++observerData->number_of_subjects_start_of_proc_cycle;
+    ++observerData->subjects_revision;
+    forgetSubjectModificationState(obj);
+    invalidateTreeCount();
+    if (position != -1)
+        emitSubjectsChanged(ObserverChangeSet::SubjectsRemoved,position,0);
+
     if (!observerData->observer_mutex.tryLock())
         return;
 
@@ -987,16 +1249,47 @@ void Qtilities::Core::Observer::handle_deletedSubject(QObject* obj) {
 
     emit subjectDeleted(obj);
 
-    // Emit neccesarry signals
+    // Emit neccesarry signals. Views are notified about deletions in batches, since many subjects are often deleted
+    // one after the other and tree models rebuild completely on every layoutChanged() signal:
     setModificationState(true);
-    if (!observerData->process_cycle_active) {
-        emit numberOfSubjectsChanged(SubjectRemoved, QList<QPointer<QObject> >());
-        emit layoutChanged(QList<QPointer<QObject> >());
+    observerData->deleted_subjects << obj;
+    if (!observerData->process_cycle_active && observerData->subject_deletion_batch_count == 0 && !observerData->deleted_subjects_flush_queued) {
+        observerData->deleted_subjects_flush_queued = true;
+        QMetaObject::invokeMethod(this,"flushDeletedSubjects",Qt::QueuedConnection);
     }
 
     observerData->observer_mutex.unlock();
 }
 
+void Qtilities::Core::Observer::flushDeletedSubjects() {
+    observerData->deleted_subjects_flush_queued = false;
+    if (observerData->process_cycle_active || observerData->subject_deletion_batch_count > 0)
+        return;
+    if (observerData->deleted_subjects.isEmpty())
+        return;
+
+    QList<QObject*> deleted_subjects = observerData->deleted_subjects;
+    observerData->deleted_subjects.clear();
+
+    emit subjectsDeleted(deleted_subjects);
+    emit numberOfSubjectsChanged(SubjectRemoved, QList<QPointer<QObject> >());
+    emit layoutChanged(QList<QPointer<QObject> >());
+}
+
+void Qtilities::Core::Observer::beginSubjectDeletionBatch() {
+    ++observerData->subject_deletion_batch_count;
+}
+
+void Qtilities::Core::Observer::endSubjectDeletionBatch() {
+    if (observerData->subject_deletion_batch_count > 0)
+        --observerData->subject_deletion_batch_count;
+    else
+        qWarning() << "endSubjectDeletionBatch() called too many times on observer: " << observerName();
+
+    if (observerData->subject_deletion_batch_count == 0)
+        flushDeletedSubjects();
+}
+
 bool Qtilities::Core::Observer::detachSubject(QObject* obj, QString* rejectMsg) {
     #ifndef QT_NO_DEBUG
         Q_ASSERT(obj != 0);
@@ -1014,6 +1307,7 @@ bool Qtilities::Core::Observer::detachSubject(QObject* obj, QString* rejectMsg)
     if (canDetach(obj,rejectMsg) == Rejected)
         return false;
 
+    joinTreeProcessingCycle();
     bool currrent_filter_subject_events_enabled = observerData->filter_subject_events_enabled;
     observerData->filter_subject_events_enabled = false;
 
@@ -1059,8 +1353,7 @@ bool Qtilities::Core::Observer::detachSubject(QObject* obj, QString* rejectMsg)
                 lost_scope = true;
             } else {
                 removeQtilitiesProperties(obj);
-                observerData->subject_list.removeOne(obj);
-                observerData->subject_observer_list.removeOne(obj);
+                removeSubject(obj);
             }
         } else if (ownership_variant.isValid() && ((ObjectOwnership) ownership_variant.toInt() == SpecificObserverOwnership)) {
             QVariant observer_parent = getMultiContextPropertyValue(obj,qti_prop_PARENT_ID);
@@ -1071,13 +1364,11 @@ bool Qtilities::Core::Observer::detachSubject(QObject* obj, QString* rejectMsg)
                 lost_scope = true;
             } else {
                 removeQtilitiesProperties(obj);
-                observerData->subject_list.removeOne(obj);
-                observerData->subject_observer_list.removeOne(obj);
+                removeSubject(obj);
             }
         } else {
             removeQtilitiesProperties(obj);
-            observerData->subject_list.removeOne(obj);
-            observerData->subject_observer_list.removeOne(obj);
+            removeSubject(obj);
         }
 
         #ifndef QT_NO_DEBUG
@@ -1207,9 +1498,22 @@ void Qtilities::Core::Observer::detachAll() {
     bool current_broadcast = broadcastModificationStateChangesEnabled();
     toggleBroadcastModificationStateChanges(false);
 
-    // Updating is done in detachSubjects().
-    detachSubjects(subjectReferences());
+    startProcessingCycle();
 
+    // Subjects which can't be detached stay attached, exactly as they would in detachSubjects():
+    QList<QObject*> objects;
+    for (int i = 0; i < start_count; ++i) {
+        QObject* obj = observerData->subject_list.at(i);
+        if (canDetach(obj) != Rejected)
+            objects << obj;
+    }
+
+    if (!detachSubjectsInBatch(objects)) {
+        LOG_DEBUG(QString("Observer (%1): Subject filter rejected the detachment of all subjects as a batch, subjects will be detached one at a time.").arg(objectName()));
+        detachSubjects(objects);
+    }
+
+    endProcessingCycle();
     toggleBroadcastModificationStateChanges(current_broadcast);
 
     int end_count = observerData->subject_list.count();
@@ -1230,20 +1534,49 @@ void Qtilities::Core::Observer::deleteAll(const QString& base_class_name, bool r
     toggleBroadcastModificationStateChanges(false);
 
     startProcessingCycle();
+
+    // Select the subjects to delete. The categories of subjects are only needed when access modes are category specific:
+    const bool check_class = (base_class_name != QString("QObject"));
+    const QByteArray class_name = base_class_name.toUtf8();
+    const bool check_category = (observerData->access_mode_scope == CategorizedScope);
     QList<QObject*> objects_to_delete;
-    for (int i = 0; i < total; ++i) {
-        if (observerData->subject_list.at(i)->inherits(base_class_name.toUtf8().data())) {
-            // Validate operation against access mode if access mode scope is category:
-            QVariant category_variant = getMultiContextPropertyValue(observerData->subject_list.at(i),qti_prop_CATEGORY_MAP);
-            QtilitiesCategory category = category_variant.value<QtilitiesCategory>();
-            if (!isConst(category))
-                objects_to_delete << observerData->subject_list.at(i);
+    if (check_category || !isConst(QtilitiesCategory())) {
+        for (int i = 0; i < total; ++i) {
+            QObject* obj = observerData->subject_list.at(i);
+            if (check_class && !obj->inherits(class_name.constData()))
+                continue;
+            if (check_category) {
+                QVariant category_variant = getMultiContextPropertyValue(obj,qti_prop_CATEGORY_MAP);
+                if (isConst(category_variant.value<QtilitiesCategory>()))
+                    continue;
+            }
+            objects_to_delete << obj;
+        }
+    }
+
+    if (!objects_to_delete.isEmpty()) {
+        bool currrent_filter_subject_events_enabled = observerData->filter_subject_events_enabled;
+        observerData->filter_subject_events_enabled = false;
+
+        // Subject filters are notified once about all subjects, after the subjects were removed but before they are deleted:
+        bool passed_filters = true;
+        for (int i = 0; i < observerData->subject_filters.count(); ++i) {
+            if (!observerData->subject_filters.at(i)->initializeBatchDetachment(objects_to_delete,0,true))
+                passed_filters = false;
+        }
+
+        if (!passed_filters) {
+            LOG_DEBUG(QString("Observer (%1): Error: Subject filter rejected detachment of deleted objects.").arg(objectName()));
         }
+
+        removeSubjects(objects_to_delete);
+        for (int i = 0; i < observerData->subject_filters.count(); ++i)
+            observerData->subject_filters.at(i)->finalizeBatchDetachment(objects_to_delete,passed_filters,true);
+
+        observerData->filter_subject_events_enabled = currrent_filter_subject_events_enabled;
+        deleteDetachedSubjects(objects_to_delete);
     }
-    for (int i = 0; i < objects_to_delete.count(); i++)
-        deleteObject(objects_to_delete.at(i));
 
-    QCoreApplication::processEvents();
     toggleBroadcastModificationStateChanges(current_broadcast);
 
     int end_count = observerData->subject_list.count();
@@ -1332,6 +1665,13 @@ void Qtilities::Core::Observer::removeQtilitiesProperties(QObject* obj) {
             return;
     #endif
 
+    removeQtilitiesProperties(QList<QObject*>() << obj);
+}
+
+void Qtilities::Core::Observer::removeQtilitiesProperties(const QList<QObject*>& objects) {
+    if (objects.isEmpty())
+        return;
+
     bool currrent_filter_subject_events_enabled = observerData->filter_subject_events_enabled;
     bool currrent_deliver_qtilities_property_changed_events = observerData->deliver_qtilities_property_changed_events;
     observerData->filter_subject_events_enabled = false;
@@ -1340,26 +1680,36 @@ void Qtilities::Core::Observer::removeQtilitiesProperties(QObject* obj) {
     // This is usefull when you are adding properties and you encounter an error, in that case this function
     // can be used as sort of a rollback, removing the property changes that have been made up to that point.
 
-    // Build up string list with all properties:
+    // Build up list with all properties once for all objects:
     QStringList added_properties;
     added_properties.append(monitoredProperties());
     added_properties.append(reservedProperties());
+    QList<QByteArray> property_names;
+    foreach (const QString& property_name, added_properties)
+        property_names << property_name.toUtf8();
+    const QByteArray name_property(qti_prop_NAME);
 
-    // Remove all the contexts first.
-    foreach (const QString& property_name, added_properties) {
-        MultiContextProperty prop = ObjectManager::getMultiContextProperty(obj, property_name.toStdString().data());
-        if (prop.isValid()) {
-            // If it exists, we remove this observer context:
-            prop.removeContext(observerData->observer_id);
-            ObjectManager::setMultiContextProperty(obj, prop);
+    for (int i = 0; i < objects.count(); ++i) {
+        QObject* obj = objects.at(i);
+        if (!obj)
+            continue;
+
+        // Remove all the contexts first.
+        for (int p = 0; p < property_names.count(); ++p) {
+            MultiContextProperty prop = ObjectManager::getMultiContextProperty(obj, property_names.at(p).constData());
+            if (prop.isValid()) {
+                // If it exists, we remove this observer context:
+                prop.removeContext(observerData->observer_id);
+                ObjectManager::setMultiContextProperty(obj, prop);
+            }
         }
-    }
 
-    // If the count is zero after removing the contexts, remove all properties:
-    if (parentCount(obj) == 0) {
-        foreach (const QString& property_name, added_properties) {
-            if (property_name != QString(qti_prop_NAME))
-                obj->setProperty(property_name.toStdString().data(),QVariant());
+        // If the count is zero after removing the contexts, remove all properties:
+        if (parentCount(obj) == 0) {
+            for (int p = 0; p < property_names.count(); ++p) {
+                if (property_names.at(p) != name_property)
+                    obj->setProperty(property_names.at(p).constData(),QVariant());
+            }
         }
     }
 
@@ -1604,12 +1954,17 @@ int Qtilities::Core::Observer::treeCount(const QString& base_class_name) {
     time.start();
     #endif
 
+    QHash<QString,int>::const_iterator cached = observerData->tree_count_cache.constFind(base_class_name);
+    if (cached != observerData->tree_count_cache.constEnd())
+        return cached.value();
+
     int count = subjectCount(base_class_name);
     QList<QPointer<Observer> > observers = subjectObserverReferences();
     for (int i = 0; i < observers.count(); ++i) {
         if (observers.at(i))
             count += observers.at(i)->treeCount(base_class_name);
     }
+    observerData->tree_count_cache.insert(base_class_name,count);
 
     #ifdef QTILITIES_BENCHMARKING
     QTime ref_time(0,0);
@@ -1620,6 +1975,19 @@ int Qtilities::Core::Observer::treeCount(const QString& base_class_name) {
     return count;
 }
 
+void Qtilities::Core::Observer::invalidateTreeCount() {
+    // Parents can only have cached counts if this observer has cached counts since treeCount()
+    // on a parent caches the counts of all its children. Thus we can stop as soon as we find an
+    // observer without cached counts.
+    if (observerData->tree_count_cache.isEmpty())
+        return;
+
+    observerData->tree_count_cache.clear();
+    QList<Observer*> parents = parentReferences(this);
+    for (int i = 0; i < parents.count(); ++i)
+        parents.at(i)->invalidateTreeCount();
+}
+
 int Qtilities::Core::Observer::subjectCount(const QString& base_class_name) const {
     if (base_class_name.isEmpty())
         return observerData->subject_list.count();
@@ -1627,6 +1995,10 @@ int Qtilities::Core::Observer::subjectCount(const QString& base_class_name) cons
         return subjectReferences(base_class_name).count();
 }
 
+int Qtilities::Core::Observer::subjectsRevision() const {
+    return observerData->subjects_revision;
+}
+
 QObject* Qtilities::Core::Observer::treeAt(int i) const {
     if (i < 0)
         return 0;
@@ -1839,18 +2211,18 @@ Qtilities::Core::Observer::AccessMode Qtilities::Core::Observer::categoryAccessM
 
 QList<Qtilities::Core::QtilitiesCategory> Qtilities::Core::Observer::subjectCategories() const {
     QList<QtilitiesCategory> subject_categories;
+    QSet<QtilitiesCategory> found_categories;
 
     int count = observerData->subject_list.count();
     for (int i = 0; i < count; ++i) {
         QVariant category_variant = getMultiContextPropertyValue(subjectAt(i),qti_prop_CATEGORY_MAP);
         // Check if a category property exists:
-        if (category_variant.isValid()) {
-            QtilitiesCategory current_category = category_variant.value<QtilitiesCategory>();
-            if (!subject_categories.contains(current_category))
-                subject_categories << current_category;
-        } else {
-            if (!subject_categories.contains(QtilitiesCategory()))
-                subject_categories << QtilitiesCategory();
+        QtilitiesCategory current_category;
+        if (category_variant.isValid())
+            current_category = category_variant.value<QtilitiesCategory>();
+        if (!found_categories.contains(current_category)) {
+            found_categories.insert(current_category);
+            subject_categories << current_category;
         }
     }
 
@@ -1920,6 +2292,22 @@ QList<QObject*> Qtilities::Core::Observer::subjectReferencesByCategory(const Qti
     return list;
 }
 
+QHash<Qtilities::Core::QtilitiesCategory, QList<QPointer<QObject> > > Qtilities::Core::Observer::subjectReferenceCategoryHash() const {
+    QHash<QtilitiesCategory, QList<QPointer<QObject> > > hash;
+
+    int count = observerData->subject_list.count();
+    for (int i = 0; i < count; ++i) {
+        QObject* obj = subjectAt(i);
+        QVariant category_variant = getMultiContextPropertyValue(obj,qti_prop_CATEGORY_MAP);
+        if (category_variant.isValid())
+            hash[category_variant.value<QtilitiesCategory>()] << obj;
+        else
+            hash[QtilitiesCategory()] << obj;
+    }
+
+    return hash;
+}
+
 QMap<QPointer<QObject>, QString> Observer::subjectReferenceCategoryMap() const {
     QMap<QPointer<QObject>, QString> map;
 
@@ -2121,6 +2509,7 @@ bool Qtilities::Core::Observer::eventFilter(QObject *object, QEvent *event) {
             }
 
             observerData->filter_subject_events_enabled = false;
+            joinTreeProcessingCycle();
 
             // We now route the event that changed to the subject filter responsible for this property to validate the change.
             // If no subject filter is responsible, the observer needs to handle it itself.
@@ -2166,6 +2555,7 @@ bool Qtilities::Core::Observer::eventFilter(QObject *object, QEvent *event) {
                 QList<QObject*> changed_objects;
                 changed_objects << object;
                 emit monitoredPropertyChanged(propertyChangeEvent->propertyName(),changed_objects);
+                bool change_set_emitted = emitSubjectsChanged(ObserverChangeSet::SubjectsDataChanged,-1,object,QString(propertyChangeEvent->propertyName().data()));
 
                 // 3. For specific role properties, we need to notify views that the data changed:
                 if ((!qstrcmp(propertyChangeEvent->propertyName().data(),qti_prop_DECORATION)) ||
@@ -2175,7 +2565,14 @@ bool Qtilities::Core::Observer::eventFilter(QObject *object, QEvent *event) {
                     (!qstrcmp(propertyChangeEvent->propertyName().data(),qti_prop_FONT)) ||
                     (!qstrcmp(propertyChangeEvent->propertyName().data(),qti_prop_SIZE_HINT))) {
 
-                    refreshViewsData();
+                    if (change_set_emitted) {
+                        // Views of this observer update the affected row from the change set. Views of parent observers
+                        // still need to be notified, thus we emit on the parents what the forwarding connections would:
+                        QList<Observer*> parents = parentReferences(this);
+                        for (int i = 0; i < parents.count(); ++i)
+                            emit parents.at(i)->dataChanged(this);
+                    } else
+                        refreshViewsData();
                 }
 
                 // 4. For specific role properties, we need to notify views that layout changed:
@@ -2361,6 +2758,141 @@ bool Qtilities::Core::Observer::isSupportedType(const QString& meta_type, Observ
     return false;
 }
 
+void Qtilities::Core::Observer::removeSubject(QObject* obj) {
+    int position = -1;
+    if (!observerData->process_cycle_active)
+        position = observerData->subject_list.indexOf(obj);
+
+    observerData->subject_list.removeOne(obj);
+    ++observerData->subjects_revision;
+    observerData->subject_observer_list.removeOne(obj);
+    forgetSubjectModificationState(obj);
+    invalidateTreeCount();
+
+    if (position != -1)
+        emitSubjectsChanged(ObserverChangeSet::SubjectsRemoved,position,obj);
+}
+
+void Qtilities::Core::Observer::removeSubjects(const QList<QObject*>& objects) {
+    // Only used during processing cycles, thus no change sets are emitted:
+    observerData->subject_list.removeObjects(objects);
+    observerData->subjects_revision += objects.count();
+    observerData->subject_observer_list.removeObjects(objects);
+    for (int i = 0; i < objects.count(); ++i) {
+        observerData->modified_subjects.remove(objects.at(i));
+        observerData->notifier_subjects.remove(objects.at(i));
+        observerData->unmonitored_subjects.remove(objects.at(i));
+        observerData->unreported_state_subjects.remove(objects.at(i));
+    }
+    if (!observerData->notifier_subject_bases.isEmpty()) {
+        QSet<QObject*> removed_objects = objects.toSet();
+        QMutableHashIterator<QObject*,QObject*> itr(observerData->notifier_subject_bases);
+        while (itr.hasNext()) {
+            itr.next();
+            if (removed_objects.contains(itr.value())) {
+                disconnect(itr.key(),SIGNAL(modificationStateChanged(bool)),this,SLOT(handleSubjectModificationStateChanged(bool)));
+                itr.remove();
+            }
+        }
+    }
+    updateTrackedModificationState();
+    invalidateTreeCount();
+}
+
+bool Qtilities::Core::Observer::detachSubjectsInBatch(const QList<QObject*>& objects) {
+    if (objects.isEmpty())
+        return true;
+
+    bool currrent_filter_subject_events_enabled = observerData->filter_subject_events_enabled;
+    observerData->filter_subject_events_enabled = false;
+
+    // Pass the batch through all installed subject filters
+    bool passed_filters = true;
+    for (int i = 0; i < observerData->subject_filters.count(); ++i) {
+        passed_filters = observerData->subject_filters.at(i)->initializeBatchDetachment(objects);
+        if (!passed_filters)
+            break;
+    }
+
+    if (!passed_filters) {
+        for (int i = 0; i < observerData->subject_filters.count(); ++i)
+            observerData->subject_filters.at(i)->finalizeBatchDetachment(objects,false);
+        observerData->filter_subject_events_enabled = currrent_filter_subject_events_enabled;
+        return false;
+    } else {
+        for (int i = 0; i < observerData->subject_filters.count(); ++i)
+            observerData->subject_filters.at(i)->finalizeBatchDetachment(objects,true);
+    }
+
+    // Objects which go out of scope are deleted, the properties of all other objects are removed in a single sweep:
+    QList<QObject*> objects_to_delete;
+    QList<QObject*> objects_to_release;
+    if (objectName() != QString(qti_def_GLOBAL_OBJECT_POOL)) {
+        for (int i = 0; i < objects.count(); ++i) {
+            QObject* obj = objects.at(i);
+            bool lost_scope = false;
+            QVariant ownership_variant = getMultiContextPropertyValue(obj,qti_prop_OWNERSHIP);
+            if (ownership_variant.isValid() && ((ObjectOwnership) ownership_variant.toInt() == ObserverScopeOwnership)) {
+                lost_scope = (parentCount(obj) == 1);
+            } else if (ownership_variant.isValid() && ((ObjectOwnership) ownership_variant.toInt() == SpecificObserverOwnership)) {
+                QVariant observer_parent = getMultiContextPropertyValue(obj,qti_prop_PARENT_ID);
+                lost_scope = (observer_parent.isValid() && (observer_parent.toInt() == observerID()));
+            }
+
+            if (lost_scope)
+                objects_to_delete << obj;
+            else
+                objects_to_release << obj;
+        }
+        removeQtilitiesProperties(objects_to_release);
+    } else
+        objects_to_release = objects;
+
+    for (int i = 0; i < objects_to_release.count(); ++i) {
+        objects_to_release.at(i)->disconnect(this);
+        objects_to_release.at(i)->removeEventFilter(this);
+    }
+
+    removeSubjects(objects);
+    observerData->filter_subject_events_enabled = currrent_filter_subject_events_enabled;
+    deleteDetachedSubjects(objects_to_delete);
+    return true;
+}
+
+void Qtilities::Core::Observer::deleteDetachedSubjects(const QList<QObject*>& objects) {
+    for (int i = 0; i < objects.count(); ++i) {
+        QObject* obj = objects.at(i);
+        obj->disconnect(this);
+        obj->removeEventFilter(this);
+
+        if ((ObjectDeletionPolicy) observerData->object_deletion_policy == DeleteLater) {
+            obj->deleteLater();
+        } else if ((ObjectDeletionPolicy) observerData->object_deletion_policy == DeleteImmediately) {
+            // The object is not in subject_list anymore, thus report the deletion here:
+            delete obj;
+            observerData->deleted_subjects << obj;
+            emit subjectDeleted(obj);
+        }
+    }
+}
+
+bool Qtilities::Core::Observer::emitSubjectsChanged(ObserverChangeSet::ChangeType change_type, int position, QObject* obj, const QString& property_name) {
+    if (observerData->process_cycle_active)
+        return false;
+
+    if (position == -1)
+        position = observerData->subject_list.indexOf(obj);
+    if (position == -1)
+        return false;
+
+    ObserverChangeSet change_set(change_type,position,position);
+    change_set.d_subjects << obj;
+    if (!property_name.isEmpty())
+        change_set.d_property_names << property_name;
+    emit subjectsChanged(change_set);
+    return true;
+}
+
 void Qtilities::Core::Observer::deleteObject(QObject* object) {
     if (!object)
         return;
@@ -2369,8 +2901,7 @@ void Qtilities::Core::Observer::deleteObject(QObject* object) {
     object->removeEventFilter(this);
 
     if ((ObjectDeletionPolicy) observerData->object_deletion_policy == DeleteLater) {
-        observerData->subject_list.removeOne(object);
-        observerData->subject_observer_list.removeOne(object);
+        removeSubject(object);
         object->deleteLater();
     } else if ((ObjectDeletionPolicy) observerData->object_deletion_policy == DeleteImmediately) {
         // The destroyed() signal on the object will cause it to be removed from the subject_list immediately.
@@ -18,6 +18,7 @@
 #include "PointerList.h"
 #include "QtilitiesProperty.h"
 #include "ObserverData.h"
+#include "ObserverChangeSet.h"
 #include "IExportable.h"
 #include "IFactoryProvider.h"
 #include "IModificationNotifier.h"
@@ -29,6 +30,7 @@
 #include <QString>
 #include <QPointer>
 #include <QList>
+#include <QHash>
 #include <QStringList>
 
 namespace Qtilities {
@@ -642,7 +644,8 @@ obs.endProcessingCycle(); // Internal count = 0;
               \param broadcast If the number of subjects changed during the processing cycle (thus, since startProcessingCycle() was called the first time), this function will
               automatically emit numberOfSubjectsChanged() and refreshLayout() when broadcast is true. When false, none of these signals are emitted. Also,
               if the observer's modification state is true after the processing cycle ended, the modificationStateChanged() signal will automatically be called when broadcast
-              is true, and not when broadcast is false.
+              is true, and not when broadcast is false. Subjects deleted during the processing cycle are reported using subjectsDeleted() when broadcast is true. When
+              false, the deletions stay pending and are reported the next time deletions are reported, for example when the next broadcasting processing cycle ends.
 
               \note When emitting numberOfSubjectsChanged() the objects parameter will be empty even when the number of subjects changed.
 
@@ -655,21 +658,33 @@ obs.endProcessingCycle(); // Internal count = 0;
             void resetProcessingCycleCount(bool broadcast = true);
             //! Indicates if a processing cycle is active.
             /*!
-              \sa startProcessingCycle(), endProcessingCycle()
+              Returns true when a processing cycle was started on this observer, or when a tree processing cycle was started on one of its ancestors.
+
+              \note The result is not cached. When no tree processing cycle is active in the application, or when a processing cycle is active on this observer, this
+              function returns immediately. Otherwise the ancestors of this observer are looked up on every call, thus code which checks it repeatedly while
+              the tree does not change should store the result.
+
+              \sa startProcessingCycle(), endProcessingCycle(), startTreeProcessingCycle()
               */
             bool isProcessingCycleActive() const;
-            //! Starts a processing cycle.
+            //! Starts a processing cycle on the complete tree underneath the observer.
             /*!
-              Same behaviour as startProcessingCyle(), but starts a processing cycle on the complete tree underneath the observer. Thus, processing cycles are started on all observers attached
-              to this observer and those attached to that observer etc. It is important to node that you should use endTreeProcessingCycle() when using this function.
+              Same behaviour as startProcessingCyle(), but the processing cycle applies to the complete tree underneath the observer. Thus, observers attached
+              to this observer and those attached to that observer etc. are in a processing cycle as well. It is important to node that you should use endTreeProcessingCycle() when using this function.
+
+              Observers in the tree are not touched when the tree processing cycle is started. Instead, observers check if one of their ancestors has an active tree processing cycle
+              when they change, in which case they join the cycle by starting a processing cycle on themselves. Thus the cost of this function does not depend on the size of the tree.
+              isProcessingCycleActive() returns true on all observers in the tree while the tree processing cycle is active.
 
               \sa endTreeProcessingCycle(), endProcessingCycle(), subjectEventFilteringEnabled(), toggleSubjectEventFiltering(), isProcessingCycleActive(), processingCycleStarted()
               */
             virtual void startTreeProcessingCycle();
-            //! Starts a processing cycle.
+            //! Ends a processing cycle on the complete tree underneath the observer.
             /*!
-              Same behaviour as startProcessingCyle(), but starts a processing cycle on the complete tree underneath the observer. Thus, processing cycles are started on all observers attached
-              to this observer and those attached to that observer etc. It is important to node that you should use endTreeProcessingCycle() when using this function.
+              Ends a tree processing cycle started with startTreeProcessingCycle(). When the tree processing cycle ends, the processing cycles of observers in the tree which
+              joined the cycle are ended as well. These observers emit numberOfSubjectsChanged() and modificationStateChanged() when their subjects or modification
+              states changed during the cycle. Observers which did not change are not touched. Since layoutChanged() signals of observers in the tree are forwarded to their
+              parents, only this observer emits layoutChanged() for the complete tree.
 
               \sa startTreeProcessingCycle(), endProcessingCycle(), subjectEventFilteringEnabled(), toggleSubjectEventFiltering(), isProcessingCycleActive(), processingCycleStarted()
               */
@@ -774,21 +789,82 @@ obs.endProcessingCycle(); // Internal count = 0;
              * it has SpecificObserverOwnership set to this Observer, or when it has ObserverScopeOwnership and this
              * is the last observer that it is attached to. Note that the deletion method used depends on the
              * objectDeletionPolicy() of this observer.
+             *
+             * Subject filters are notified once for all subjects using AbstractSubjectFilter::initializeBatchDetachment() and
+             * AbstractSubjectFilter::finalizeBatchDetachment(). When a filter rejects the batch, the subjects are detached one at a time.
              */
             virtual void detachAll();
             //! Function to delete all currenlty observed subjects.
             /*!
               \param base_class_name Specifies that only items inheriting the specified base class must be deleted.
               \param refresh_views Indicates if this function must refresh all observer views when done.
+
+              The subjects are removed from the observer and subject filters are notified once for all subjects using AbstractSubjectFilter::initializeBatchDetachment()
+              and AbstractSubjectFilter::finalizeBatchDetachment() before the subjects are deleted. This function does not process events.
               */
             virtual void deleteAll(const QString &base_class_name = "QObject", bool refresh_views = true);
+            //! Starts a subject deletion batch.
+            /*!
+              When subjects are deleted somewhere else in the application, the observer does not notify views about every
+              deletion separately. Deletions are collected and reported once per event loop turn using subjectsDeleted(),
+              numberOfSubjectsChanged() and layoutChanged(). When subjects are deleted in code which does not return to the event
+              loop, or when views must be updated as soon as the deletions are done, the deletions can be wrapped in a batch:
+
+\code
+observer->beginSubjectDeletionBatch();
+qDeleteAll(objects_to_delete);
+observer->endSubjectDeletionBatch(); // Views are notified once here.
+\endcode
+
+              Batches can be nested. The deletions are reported when the outermost batch is ended.
+
+              \sa endSubjectDeletionBatch(), subjectsDeleted()
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void beginSubjectDeletionBatch();
+            //! Ends a subject deletion batch started with beginSubjectDeletionBatch().
+            /*!
+              When the outermost batch is ended, subjects deleted since the last notification are reported immediately.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void endSubjectDeletionBatch();
 
         private slots:
             //! Will handle an object which has been deleted somewhere else in the application.
-            void handle_deletedSubject(QObject* obj);
+            void handle_deletedSubject(QObject* obj, int position = -1);
+            //! Reports subjects which were deleted since the last notification.
+            /*!
+              Does nothing while a processing cycle or a subject deletion batch is active, these report the deletions when they end.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void flushDeletedSubjects();
+            //! Handles modification state changes of monitored subjects.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void handleSubjectModificationStateChanged(bool is_modified);
         signals:
             //! Will be emitted when a subject is deleted.
+            /*!
+              This signal is emitted for every deleted subject, as soon as the deletion is detected. Views should rather
+              use subjectsDeleted() which reports deletions in batches.
+              */
             void subjectDeleted(QObject* obj);
+            //! Will be emitted after subjects were deleted somewhere else in the application.
+            /*!
+              Deletions are collected and reported once per event loop turn, at the end of a subject deletion batch or at the end of a
+              processing cycle. Outside of processing cycles this signal is followed by numberOfSubjectsChanged() and layoutChanged().
+
+              \param objects The deleted objects. The objects were already destroyed, thus the pointers may only be used to identify them.
+
+              \sa beginSubjectDeletionBatch()
+
+              <i>This signal was added in %Qtilities v1.5.</i>
+              */
+            void subjectsDeleted(const QList<QObject*>& objects);
 
             // --------------------------------
             // Observer property related functions
@@ -833,6 +909,11 @@ obs.endProcessingCycle(); // Internal count = 0;
         private:
             //! This function will remove all the properties which this observer might have added to an obj.
             void removeQtilitiesProperties(QObject* obj);
+            //! Removes the properties which this observer might have added to each object in \p objects in a single sweep.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void removeQtilitiesProperties(const QList<QObject*>& objects);
 
         public:
             // --------------------------------
@@ -916,10 +997,22 @@ obs.endProcessingCycle(); // Internal count = 0;
                 This function is different from treeCount() which gets all the children underneath an observer (Thus, children of children etc.).
                 */
             int subjectCount(const QString& base_class_name = QString()) const;
+            //! Returns a number which is incremented for every subject attached to, detached from or deleted in this observer.
+            /*!
+                Unlike the change signals of the observer, the revision is also updated while a processing cycle is active. Comparing
+                it with a previously stored revision is a cheap way to find out if the subjects of the observer changed.
+
+                <i>This function was added in %Qtilities v1.5.</i>
+                */
+            int subjectsRevision() const;
             //! Function to get the number of children under the specified observer.
             /*!
                 This count includes the children of children as well. To get the number of subjects only in this context use subjectCount().
                 \note This observer itself is not counted.
+
+                The count is cached per \p base_class_name. The cache is cleared on this observer and all its parents when subjects are attached
+                to, detached from or deleted in any observer in the tree, thus repeated calls on an unchanged tree (for example from item views
+                displaying child counts) do not walk the tree again.
                 */
             int treeCount(const QString& base_class_name = QString());
             //! Function to get a QObject reference at a specific location in the tree underneath this observer.
@@ -1099,6 +1192,14 @@ QVERIFY(items_verify.count() == 5);
             QList<QObject*> subjectReferencesByCategory(const QtilitiesCategory& category) const;
             //! Returns a QMap with each object in this observer mapped to its category's string representation (using toString("::") function on QtilitiesCategory).
             QMap<QPointer<QObject>,QString> subjectReferenceCategoryMap() const;
+            //! Returns a QHash with the subjects in this observer grouped by their categories, in the order in which they appear in the observer.
+            /*!
+              Subjects without a category are grouped under an empty QtilitiesCategory. The subjects are grouped in a single pass, thus this
+              function is much faster than calling subjectReferencesByCategory() for each category in subjectCategories().
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            QHash<QtilitiesCategory,QList<QPointer<QObject> > > subjectReferenceCategoryHash() const;
 
             // --------------------------------
             // Property related functions
@@ -1184,6 +1285,21 @@ QVERIFY(items_verify.count() == 5);
               the number of subjects changed during the processing cycle. See endProcessingCycle() for more information.
               */
             void numberOfSubjectsChanged(Observer::SubjectChangeIndication change_indication, QList<QPointer<QObject> > objects = QList<QPointer<QObject> >());
+            //! A signal which is emitted with a detailed description of changes to the subjects in this observer context.
+            /*!
+              This signal is emitted when subjects are attached, detached or deleted, and when monitored properties change on subjects. Unlike
+              numberOfSubjectsChanged(), the change set contains the positions of the affected subjects, thus models displaying the subjects of this
+              observer as a flat list can update only the affected rows.
+
+              \note Change sets are not emitted while a processing cycle is active on the observer. Changes made during processing cycles are
+              reported through numberOfSubjectsChanged() and layoutChanged() at the end of the processing cycle, after which models must refresh
+              completely.
+
+              \sa ObserverChangeSet
+
+              <i>This signal was added in %Qtilities v1.5.</i>
+              */
+            void subjectsChanged(const Qtilities::Core::ObserverChangeSet& change_set);
 
             //! A signal which is emitted when the layout of the observer or the tree underneath it changes.
             /*!
@@ -1213,6 +1329,9 @@ QVERIFY(items_verify.count() == 5);
               \param observer When the data that changed is related to a specific observer context, for example if the activity of all subjects inside a context changed, the observer can be passed as the \p observer parameter.
 
               \note When creating models for observers, this signal should be connected to the dataChanged() signal of your model.
+              \note Changes to role properties (for example qti_prop_DECORATION) on subjects which are reported through subjectsChanged() do not
+              cause this signal to be emitted on the observer itself, only on its parent observers. Models showing the subjects of the observer must
+              therefore handle ObserverChangeSet::SubjectsDataChanged change sets. This behavior was added in %Qtilities v1.5.
               */
             void dataChanged(Observer* observer = 0);
             //! Signal which is emitted when this observer enters a processing cycle.
@@ -1223,6 +1342,89 @@ QVERIFY(items_verify.count() == 5);
         private:
             //! Performs a delete on an object in a thread-safe way.
             void deleteObject(QObject* object);
+            //! Clears the cached treeCount() results of this observer and all its parent observers.
+            /*!
+              Must be called whenever subjects are added to or removed from this observer.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void invalidateTreeCount();
+            //! Removes obj from the subject lists of this observer, without doing any ownership or property handling.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void removeSubject(QObject* obj);
+            //! Removes all of \p objects from the subject lists of this observer in a single pass, without doing any ownership or property handling.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void removeSubjects(const QList<QObject*>& objects);
+            //! Detaches \p objects from this observer as a batch, notifying each subject filter once.
+            /*!
+              The objects must have been checked using canDetach(). Returns false without detaching anything when a subject filter
+              rejects the batch.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            bool detachSubjectsInBatch(const QList<QObject*>& objects);
+            //! Deletes \p objects after they were removed from this observer, according to the objectDeletionPolicy() of this observer.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void deleteDetachedSubjects(const QList<QObject*>& objects);
+            //! Returns the nearest ancestor of this observer on which a tree processing cycle is active, or 0 when there is no such ancestor.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            Observer* treeProcessingCycleAncestor() const;
+            //! Joins a tree processing cycle active on an ancestor by starting a processing cycle on this observer, which is ended when the tree processing cycle ends.
+            /*!
+              Must be called before this observer changes. Does nothing when this observer already has an active processing cycle.
+
+              \returns True if this observer joined a tree processing cycle.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            bool joinTreeProcessingCycle();
+            //! Updates the set of modified subject observers of this observer with the current modification state of \p obj.
+            /*!
+              Does nothing when \p obj is not an observer. Such subjects are not guaranteed to report all changes to their modification states,
+              thus isModified() checks them directly.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void updateModifiedSubject(QObject* obj);
+            //! Indicates if the tree underneath this observer contains subjects which are not guaranteed to report changes to their modification states.
+            /*!
+              Parent observers query observers for which this is true directly in isModified(), thus subjects which change their modification
+              states without emitting IModificationNotifier::modificationStateChanged() are still taken into account anywhere in the tree.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            bool hasUnreportedModificationStates() const;
+            //! Removes \p obj from the sets used to track the modification states of subjects.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void forgetSubjectModificationState(QObject* obj);
+            //! Reports changes to the result of isModified() to the parent observers of this observer.
+            /*!
+              Parent observers track the modification states of their subjects incrementally. The modificationStateChanged() signal
+              is only emitted when the modification state of the observer itself changes, thus changes caused by subjects are
+              reported to parent observers directly.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void updateTrackedModificationState();
+            //! Emits subjectsChanged() with the specified change when no processing cycle is active.
+            /*!
+              When \p position is -1, the position of \p obj in this observer is used.
+
+              \returns True if the change set was emitted, false otherwise.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            bool emitSubjectsChanged(ObserverChangeSet::ChangeType change_type, int position, QObject* obj, const QString& property_name = QString());
 
         protected:
             ObserverData* observerData;
@@ -1260,4 +1462,9 @@ QVERIFY(items_verify.count() == 5);
     }
 }
 
+// Qt 5 declares QList<QObject*> itself. Used by Observer::subjectsDeleted():
+#if QT_VERSION < 0x050000
+Q_DECLARE_METATYPE(QList<QObject*>)
+#endif
+
 #endif // ABSTRACTOBSERVER_H
@@ -0,0 +1,106 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#ifndef OBSERVERCHANGESET_H
+#define OBSERVERCHANGESET_H
+
+#include "QtilitiesCore_global.h"
+
+#include <QObject>
+#include <QPointer>
+#include <QStringList>
+#include <QMetaType>
+
+namespace Qtilities {
+    namespace Core {
+        /*!
+          \class ObserverChangeSet
+          \brief The ObserverChangeSet class describes a change to the subjects of an observer.
+
+          Observer emits change sets through Observer::subjectsChanged() whenever subjects are attached, detached or deleted, or when monitored
+          properties on subjects change outside of processing cycles. Change sets contain the positions of the affected subjects in the
+          observer (thus the same positions as used by Observer::subjectAt()), allowing models to update only the rows which are affected.
+
+          Positions of inserted subjects and of subjects of which the data changed refer to the state of the observer directly after the
+          change. Positions of removed subjects refer to the state of the observer directly before the change, thus the positions at which
+          the subjects were before they were removed.
+
+          <i>This class was added in %Qtilities v1.5.</i>
+         */
+        class QTILIITES_CORE_SHARED_EXPORT ObserverChangeSet {
+
+        public:
+            //! The possible types of changes.
+            enum ChangeType {
+                SubjectsInserted,       /*!< Subjects were inserted at positions d_first_position to d_last_position. */
+                SubjectsRemoved,        /*!< Subjects previously at positions d_first_position to d_last_position were removed. */
+                SubjectsDataChanged     /*!< The properties listed in d_property_names changed on the subjects at positions d_first_position to d_last_position. */
+            };
+
+            ObserverChangeSet() {
+                d_change_type = SubjectsDataChanged;
+                d_first_position = -1;
+                d_last_position = -1;
+            }
+            ObserverChangeSet(ChangeType change_type, int first_position, int last_position) {
+                d_change_type = change_type;
+                d_first_position = first_position;
+                d_last_position = last_position;
+            }
+            ObserverChangeSet(const ObserverChangeSet& ref) {
+                d_change_type = ref.d_change_type;
+                d_first_position = ref.d_first_position;
+                d_last_position = ref.d_last_position;
+                d_subjects = ref.d_subjects;
+                d_property_names = ref.d_property_names;
+            }
+            virtual ~ObserverChangeSet() {}
+
+            ObserverChangeSet& operator=(const ObserverChangeSet& ref) {
+                if (this==&ref) return *this;
+
+                d_change_type = ref.d_change_type;
+                d_first_position = ref.d_first_position;
+                d_last_position = ref.d_last_position;
+                d_subjects = ref.d_subjects;
+                d_property_names = ref.d_property_names;
+
+                return *this;
+            }
+
+            //! Returns true if the change set contains valid positions.
+            bool isValid() const {
+                return (d_first_position >= 0 && d_last_position >= d_first_position);
+            }
+            //! Returns the number of positions affected by this change set.
+            int count() const {
+                if (!isValid())
+                    return 0;
+                return d_last_position - d_first_position + 1;
+            }
+
+            //! The type of change.
+            ChangeType d_change_type;
+            //! The first position affected by the change.
+            int d_first_position;
+            //! The last position affected by the change.
+            int d_last_position;
+            //! The affected subjects. For SubjectsRemoved changes, subjects which were deleted are null.
+            QList<QPointer<QObject> > d_subjects;
+            //! The names of the properties which changed. Only used for SubjectsDataChanged changes.
+            QStringList d_property_names;
+        };
+    }
+}
+
+Q_DECLARE_METATYPE(Qtilities::Core::ObserverChangeSet)
+
+#endif // OBSERVERCHANGESET_H
@@ -24,6 +24,8 @@
 #include <QObject>
 #include <QMutex>
 #include <QHash>
+#include <QPointer>
+#include <QSet>
 
 namespace Qtilities {
     namespace Core {
@@ -58,6 +60,7 @@ namespace Qtilities {
 
             ObserverData(Observer* obs, const QString& observer_name) : IObjectBase(), IExportable(), subject_limit(-1),
                 subject_id_counter(0),
+                subjects_revision(0),
                 filter_subject_events_lock(true),
                 filter_subject_events_enabled(false),
                 deliver_qtilities_property_changed_events(false),
@@ -71,7 +74,14 @@ namespace Qtilities {
                 object_deletion_policy(0),
                 number_of_subjects_start_of_proc_cycle(0),
                 broadcast_modification_state_changes(true),
-                modification_state_start_of_proc_cycle(false)
+                modification_state_start_of_proc_cycle(false),
+                deleted_subjects_flush_queued(false),
+                subject_deletion_batch_count(0),
+                tree_processing_cycle_count(0),
+                tree_processing_cycle_member(false),
+                tracked_modification_state(false),
+                tracked_unreported_state(false),
+                notifying_subjects(false)
             {
                 subject_list.setObjectName(observer_name);
             }
@@ -80,6 +90,7 @@ namespace Qtilities {
                 subject_filters(other.subject_filters),
                 subject_limit(other.subject_limit),
                 subject_id_counter(0),
+                subjects_revision(0),
                 filter_subject_events_lock(true),
                 filter_subject_events_enabled(other.filter_subject_events_enabled),
                 deliver_qtilities_property_changed_events(other.deliver_qtilities_property_changed_events),
@@ -95,7 +106,19 @@ namespace Qtilities {
                 object_deletion_policy(other.object_deletion_policy),
                 number_of_subjects_start_of_proc_cycle(0),
                 broadcast_modification_state_changes(true),
-                modification_state_start_of_proc_cycle(false) {}
+                modification_state_start_of_proc_cycle(false),
+                deleted_subjects_flush_queued(false),
+                subject_deletion_batch_count(0),
+                tree_processing_cycle_count(0),
+                tree_processing_cycle_member(false),
+                modified_subjects(other.modified_subjects),
+                notifier_subjects(other.notifier_subjects),
+                notifier_subject_bases(other.notifier_subject_bases),
+                unmonitored_subjects(other.unmonitored_subjects),
+                unreported_state_subjects(other.unreported_state_subjects),
+                tracked_modification_state(other.tracked_modification_state),
+                tracked_unreported_state(other.tracked_unreported_state),
+                notifying_subjects(false) {}
 
             // --------------------------------
             // IObjectBase Implementation
@@ -159,6 +182,8 @@ namespace Qtilities {
             QList<AbstractSubjectFilter*>       subject_filters;
             int                                 subject_limit;
             int                                 subject_id_counter;
+            //! Incremented for every subject added to or removed from subject_list, see Observer::subjectsRevision().
+            int                                 subjects_revision;
             int                                 observer_id;
             QString                             observer_description;
             QMutex                              observer_mutex;
@@ -188,6 +213,59 @@ namespace Qtilities {
             bool                                broadcast_modification_state_changes;
             //! Used during processing cycles to store the modification state of the observer when a processing cycle is started. When different when the processing cycle is stopped, only then will it emit that the modification state changed.
             bool                                modification_state_start_of_proc_cycle;
+            //! Caches the results of Observer::treeCount() for each base class name it was called with.
+            /*!
+              Cleared by Observer::invalidateTreeCount() whenever the tree underneath the observer changes.
+              */
+            QHash<QString,int>                  tree_count_cache;
+            //! Subjects which were deleted since the last time Observer::subjectsDeleted() was emitted.
+            /*!
+              The pointers are dangling and may only be used to identify the deleted objects.
+              */
+            QList<QObject*>                     deleted_subjects;
+            //! Indicates if a call to Observer::flushDeletedSubjects() was queued on the event loop.
+            bool                                deleted_subjects_flush_queued;
+            //! The number of active Observer::beginSubjectDeletionBatch() scopes.
+            int                                 subject_deletion_batch_count;
+            //! The number of times Observer::startTreeProcessingCycle() was called on this observer without a matching Observer::endTreeProcessingCycle().
+            int                                 tree_processing_cycle_count;
+            //! Indicates if this observer joined a tree processing cycle started on one of its ancestors.
+            bool                                tree_processing_cycle_member;
+            //! The descendants which joined a tree processing cycle started on this observer.
+            /*!
+              Descendants only join a tree processing cycle when they change during the cycle, thus unchanged descendants are never touched.
+              */
+            QList<QPointer<Observer> >          tree_processing_cycle_members;
+            //! The subject observers which are modified.
+            /*!
+              Observers report changes to their modification states to their parent observers, see Observer::updateTrackedModificationState(). Thus
+              Observer::isModified() and clearing the modification state only need to visit the subject observers which are modified.
+              */
+            QSet<QObject*>                      modified_subjects;
+            //! The subjects implementing IModificationNotifier which are not observers.
+            /*!
+              These subjects are not guaranteed to emit modificationStateChanged() for every change, thus Observer::isModified() checks them directly.
+              */
+            QSet<QObject*>                      notifier_subjects;
+            //! Maps the objects emitting modificationStateChanged() for subjects in notifier_subjects to these subjects.
+            /*!
+              Only contains subjects of which IModificationNotifier::objectBase() is not the subject itself.
+              */
+            QHash<QObject*,QObject*>            notifier_subject_bases;
+            //! The subjects of which the modification states are not monitored, see Observer::setMonitorSubjectModificationState().
+            QSet<QObject*>                      unmonitored_subjects;
+            //! The subject observers with subjects in their trees which are not guaranteed to report changes to their modification states.
+            /*!
+              Such subject observers can become modified without reporting it, thus Observer::isModified() queries them directly when they
+              are not in modified_subjects. See Observer::hasUnreportedModificationStates().
+              */
+            QSet<QObject*>                      unreported_state_subjects;
+            //! The modification state of the observer which was last reported to its parent observers.
+            bool                                tracked_modification_state;
+            //! The result of Observer::hasUnreportedModificationStates() which was last reported to its parent observers.
+            bool                                tracked_unreported_state;
+            //! Indicates if Observer::setModificationState() is busy setting the modification states of subjects.
+            bool                                notifying_subjects;
         };
 
         Q_DECLARE_OPERATORS_FOR_FLAGS(ObserverData::ExportItemFlags)
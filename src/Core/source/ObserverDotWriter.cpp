@@ -14,6 +14,16 @@
 #include "Observer.h"
 #include "QtilitiesProperty.h"
 
+#include <QBuffer>
+#include <QTextStream>
+
+namespace {
+    // The prefixes of the dynamic properties in which dot node and edge attributes are stored.
+    const char* const qti_private_DOT_NODE_PREFIX = "qti.dot.node.";
+    const char* const qti_private_DOT_EDGE_PREFIX = "qti.dot.edge.";
+    const int qti_private_DOT_PREFIX_LENGTH = 13;
+}
+
 struct Qtilities::Core::ObserverDotWriterPrivateData {
     ObserverDotWriterPrivateData() : observer(0) {}
 
@@ -65,105 +75,124 @@ bool Qtilities::Core::ObserverDotWriter::saveToFile(const QString& fileName) con
     if (!file.open(QFile::WriteOnly))
         return false;
 
-    file.write(generateDotScript().toUtf8());
+    bool success = writeDotScript(&file);
     file.close();
 
-    return true;
+    return success;
 }
 
 QString Qtilities::Core::ObserverDotWriter::generateDotScript() const {
     if (!d->observer)
         return QString();
 
-    // Create the dot string:
-    QString dotString;
-    dotString.append(QString("digraph \"%1\" {\n").arg(d->observer->observerName()));
+    QByteArray dot_script;
+    QBuffer buffer(&dot_script);
+    buffer.open(QIODevice::WriteOnly);
+    writeDotScript(&buffer);
+    buffer.close();
+
+    return QString::fromUtf8(dot_script.constData(),dot_script.size());
+}
+
+bool Qtilities::Core::ObserverDotWriter::writeDotScript(QIODevice* device) const {
+    if (!d->observer || !device || !device->isWritable())
+        return false;
+
+    QTextStream out(device);
+    out.setCodec("UTF-8");
+    out << "digraph \"" << d->observer->observerName() << "\" {\n";
 
     // Add graph attributes:
-    for (int i = 0; i < d->graph_attributes.count(); ++i) {
-        dotString.append("    ");
-        dotString.append(d->graph_attributes.keys().at(i));
-        dotString.append(" = \"");
-        dotString.append(d->graph_attributes.values().at(i));
-        dotString.append("\";\n");
+    QHash<QString,QString>::const_iterator graph_itr = d->graph_attributes.constBegin();
+    while (graph_itr != d->graph_attributes.constEnd()) {
+        out << "    " << graph_itr.key() << " = \"" << graph_itr.value() << "\";\n";
+        ++graph_itr;
     }
 
     // Then do the relationships between items:
     ObserverRelationalTable table(d->observer);
-    for (int i = 0; i < table.count(); ++i) {
+    const int entry_count = table.count();
+
+    // Index the entries on their visitor IDs, and collect the edge attributes of objects once. Edge attributes are stored on
+    // the child object for all its parents, thus objects with multiple parents would otherwise be inspected for each parent:
+    QHash<int,RelationalTableEntry*> entries_by_visitor_id;
+    entries_by_visitor_id.reserve(entry_count);
+    QHash<int,QMap<QString,MultiContextProperty> > edge_attributes_by_visitor_id;
+    for (int i = 0; i < entry_count; ++i) {
+        RelationalTableEntry* entry = table.entryAt(i);
+        entries_by_visitor_id[entry->visitorID()] = entry;
+        if (!entry->object())
+            continue;
+
+        const QList<QByteArray> property_names = entry->object()->dynamicPropertyNames();
+        for (int p = 0; p < property_names.count(); ++p) {
+            const QByteArray& property_name = property_names.at(p);
+            if (!property_name.startsWith(qti_private_DOT_EDGE_PREFIX))
+                continue;
+
+            MultiContextProperty multi_context_property = ObjectManager::getMultiContextProperty(entry->object(),property_name.constData());
+            if (multi_context_property.isValid())
+                edge_attributes_by_visitor_id[entry->visitorID()].insert(QString::fromUtf8(property_name.constData() + qti_private_DOT_PREFIX_LENGTH),multi_context_property);
+        }
+    }
+
+    for (int i = 0; i < entry_count; ++i) {
         RelationalTableEntry* entry = table.entryAt(i);
 
         // Label this entry:
-        QString entry_label = QString("    %1 [label=\"%2\"").arg(entry->visitorID()).arg(entry->name());
+        out << "    " << entry->visitorID() << " [label=\"" << entry->name() << "\"";
         // Add properties to it (node attributes):
         if (entry->object()) {
-            QList<QByteArray> property_names = entry->object()->dynamicPropertyNames();
-            for (int p = 0; p < property_names.count(); p++) {
-                QString property_name(property_names.at(p).data());
-                if (property_name.startsWith("qti.dot.node")) {
-                    // This is a dot node attribute property:
-                    QByteArray ba = property_name.remove(0,13).toUtf8();
-                    const char* char_name = ba.data();
-                    // Get the shared property:
-                    SharedProperty shared_property = ObjectManager::getSharedProperty(entry->object(),property_names.at(p).data());
-                    if (shared_property.isValid()) {
-                        entry_label.append(" " + QString(char_name) + "=" + shared_property.value().toString());
-                    }
-                }
+            const QList<QByteArray> property_names = entry->object()->dynamicPropertyNames();
+            for (int p = 0; p < property_names.count(); ++p) {
+                const QByteArray& property_name = property_names.at(p);
+                if (!property_name.startsWith(qti_private_DOT_NODE_PREFIX))
+                    continue;
+
+                // Get the shared property:
+                SharedProperty shared_property = ObjectManager::getSharedProperty(entry->object(),property_name.constData());
+                if (shared_property.isValid())
+                    out << " " << QString::fromUtf8(property_name.constData() + qti_private_DOT_PREFIX_LENGTH) << "=" << shared_property.value().toString();
             }
         }
-        entry_label.append("];\n");
-        dotString.append(entry_label);
+        out << "];\n";
 
         // Now fill in the relationship data:
-        for (int c = 0; c < entry->children().count(); c++) {
-            QString relationship_string = QString("    %1").arg(entry->visitorID());
-            relationship_string.append(" -> ");
-            RelationalTableEntry* child_entry = table.entryWithVisitorID(entry->children().at(c));
-            relationship_string.append(QString("%1").arg(child_entry->visitorID()));
-            dotString.append(relationship_string);
-
-            QMap<QString,QString> edge_attributes;
-            // Get edge attributes for this relationship:
-            QList<QByteArray> property_names = child_entry->object()->dynamicPropertyNames();
-            for (int p = 0; p < property_names.count(); p++) {
-                QString property_name(property_names.at(p).data());
-                if (property_name.startsWith("qti.dot.edge")) {
-                    // This is a dot note attribute property:
-                    QByteArray ba = property_name.remove(0,13).toUtf8();
-                    const char* char_name = ba.data();
-                    // Get the shared property:
-                    MultiContextProperty multi_context_property = ObjectManager::getMultiContextProperty(child_entry->object(),property_names.at(p).data());
-                    if (multi_context_property.isValid()) {
-                        // Now check if this multi_context_property has a value for our context:
-                        if (multi_context_property.hasContext(entry->sessionID())) {
-                            edge_attributes[QString(char_name)] = multi_context_property.value(entry->sessionID()).toString();
-                        }
+        const QList<int> children = entry->children();
+        for (int c = 0; c < children.count(); ++c) {
+            RelationalTableEntry* child_entry = entries_by_visitor_id.value(children.at(c));
+            if (!child_entry)
+                continue;
+
+            out << "    " << entry->visitorID() << " -> " << child_entry->visitorID();
+
+            // Now add all attributes of the child for this edge:
+            QHash<int,QMap<QString,MultiContextProperty> >::const_iterator edge_itr = edge_attributes_by_visitor_id.constFind(child_entry->visitorID());
+            if (edge_itr != edge_attributes_by_visitor_id.constEnd()) {
+                bool first_attribute = true;
+                QMap<QString,MultiContextProperty>::const_iterator attribute_itr = edge_itr.value().constBegin();
+                while (attribute_itr != edge_itr.value().constEnd()) {
+                    // Check if this attribute has a value for our context:
+                    if (attribute_itr.value().hasContext(entry->sessionID())) {
+                        out << (first_attribute ? " [" : ",") << attribute_itr.key() << "=" << attribute_itr.value().value(entry->sessionID()).toString();
+                        first_attribute = false;
                     }
+                    ++attribute_itr;
                 }
-            }
-
-            // Now add all found attributes for this edge:
-            for (int e = 0; e < edge_attributes.count(); e++) {
-                if (e == 0)
-                    dotString.append(" [");
-                dotString.append(edge_attributes.keys().at(e) + "=" + edge_attributes.values().at(e));
-                if (edge_attributes.count() > 1 && e != edge_attributes.count()-1)
-                    dotString.append(",");
-                if (e == edge_attributes.count()-1)
-                    dotString.append("]");
+                if (!first_attribute)
+                    out << "]";
             }
 
             // Finally add the new end line character and the new line:
-            dotString.append(";\n");
+            out << ";\n";
         }
     }
 
     // Append the closing } character:
-    dotString.append("}");
-    LOG_INFO(dotString);
+    out << "}";
+    out.flush();
 
-    return dotString;
+    return out.status() == QTextStream::Ok;
 }
 
 bool Qtilities::Core::ObserverDotWriter::addNodeAttribute(QObject* node, const QString& attribute, const QString& value) {
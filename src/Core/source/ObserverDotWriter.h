@@ -18,6 +18,8 @@
 #include <QString>
 #include <QHash>
 
+class QIODevice;
+
 namespace Qtilities {
     namespace Core {  
         class Observer;
@@ -267,16 +269,32 @@ digraph "Root Node" {
 
             //! Saves the dot script to a file.
             /*!
-              Function which will write the dot script generated using the generateDotScript() function to the specified file.
+              Function which will write the dot script for the observer context to the specified file. The script is
+              streamed to the file using writeDotScript(), thus the complete script is never held in memory.
 
               \note If no observer context have been specified, this function will return false.
               */
             virtual bool saveToFile(const QString& fileName) const;
             //! Function which will generate the dot script for the specified observer context.
             /*!
+              For large trees, use writeDotScript() or saveToFile() which stream the script instead of building it in memory.
+
               \note If no observer context have been specified, this function will return QString().
               */
             QString generateDotScript() const;
+            //! Function which will write the dot script for the specified observer context to an open device.
+            /*!
+              The script is written in UTF-8 while the tree is traversed. The dot attributes of each object are collected once,
+              regardless of the number of parents it has, and the children of nodes are resolved through a hash of the visitor IDs
+              in the relational table of the tree. Thus the time taken is linear in the size of the tree.
+
+              \param device The device to write to. It must be open for writing.
+
+              \returns True if successful, false if no observer context have been specified or if the device is not writable.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            bool writeDotScript(QIODevice* device) const;
 
             //! Adds a node attribute to a node in the graph.
             /*!
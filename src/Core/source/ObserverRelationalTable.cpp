@@ -312,16 +312,29 @@ Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::Rel
 struct Qtilities::Core::ObserverRelationalTablePrivateData {
     ObserverRelationalTablePrivateData() : observer(0),
     visitor_id_count(0),
-    exportable_subjects_only(false) {}
+    exportable_subjects_only(false),
+    entry_list_valid(false) {}
     ~ObserverRelationalTablePrivateData() {
-        for (int i = 0; i < entries.count(); ++i)
-            delete entries.values().at(i);
+        qDeleteAll(entries);
+    }
+
+    //! Returns the entries in the order of their visitor IDs, building the list when entries changed.
+    const QList<RelationalTableEntry*>& entryList() const {
+        if (!entry_list_valid) {
+            entry_list = entries.values();
+            entry_list_valid = true;
+        }
+        return entry_list;
     }
 
     Observer*                           observer;
+    //! The entries in the table. Key = visitor ID. entry_list_valid must be cleared whenever entries are added or removed.
     QMap<int, RelationalTableEntry*>    entries;
     int                                 visitor_id_count;
     bool                                exportable_subjects_only;
+    //! Cached values of entries, in order to provide indexed access to entries in constant time.
+    mutable QList<RelationalTableEntry*> entry_list;
+    mutable bool                        entry_list_valid;
 };
 
 Qtilities::Core::ObserverRelationalTable::ObserverRelationalTable(Observer* observer, bool exportable_subjects_only) {
@@ -346,6 +359,7 @@ Qtilities::Core::ObserverRelationalTable::ObserverRelationalTable(const Observer
         entry_ptr->setSessionID(-1);
         d->entries[other_entry_ptr->visitorID()] = entry_ptr;
     }
+    d->entry_list_valid = false;
 }
 
 Qtilities::Core::ObserverRelationalTable::ObserverRelationalTable() {
@@ -356,10 +370,8 @@ Qtilities::Core::ObserverRelationalTable::~ObserverRelationalTable() {
     removeRelationalProperties(d->observer);
 
     // Delete all entries
-    for (int i = 0; i < d->entries.count(); ++i) {
-        delete d->entries.values().at(i);
-        d->entries[d->entries.keys().at(i)] = 0;
-    }
+    qDeleteAll(d->entries);
+    d->entries.clear();
     delete d;
 }
 
@@ -367,11 +379,9 @@ void Qtilities::Core::ObserverRelationalTable::refresh() {
     // Clear up everything:
     removeRelationalProperties(d->observer);
     // Delete all entries
-    for (int i = 0; i < d->entries.count(); ++i) {
-        delete d->entries.values().at(i);
-        d->entries[d->entries.keys().at(i)] = 0;
-    }
+    qDeleteAll(d->entries);
     d->entries.clear();
+    d->entry_list_valid = false;
     d->visitor_id_count = 0;
 
     // Now construct the table again:
@@ -385,9 +395,9 @@ bool Qtilities::Core::ObserverRelationalTable::compare(ObserverRelationalTable o
     if (d->entries.count() != other.count()) {
         LOG_TRACE(QString("ObserverRelationalTable::compare() failed. Number of entries in table (%1) does not match the number of entries in the table to check (%2).").arg(d->entries.count()).arg(other.count()));
         LOG_TRACE("Items in table:");
-        for (int i = 0; i < d->entries.count(); ++i) {
-            if (d->entries.values().at(i))
-                LOG_TRACE(d->entries.values().at(i)->name());
+        for (int i = 0; i < d->entryList().count(); ++i) {
+            if (d->entryList().at(i))
+                LOG_TRACE(d->entryList().at(i)->name());
         }
         LOG_TRACE("Items in comparison table:");
         for (int i = 0; i < other.count(); ++i) {
@@ -398,8 +408,8 @@ bool Qtilities::Core::ObserverRelationalTable::compare(ObserverRelationalTable o
     }
 
     // We compare by looking up each item in table in this table and compare each item individially.
-    for (int i = 0; i < d->entries.count(); ++i) {
-        if (!d->entries.values().at(i)) {
+    for (int i = 0; i < d->entryList().count(); ++i) {
+        if (!d->entryList().at(i)) {
             LOG_FATAL(QObject::tr("Null entry found in current observer in method ObserverRelationalTable::compare()."));
             return false;
         }
@@ -407,7 +417,7 @@ bool Qtilities::Core::ObserverRelationalTable::compare(ObserverRelationalTable o
             LOG_FATAL(QObject::tr("Null entry found in other observer in method ObserverRelationalTable::compare()."));
             return false;
         }
-        if (*d->entries.values().at(i) != *other.entryAt(i)) {
+        if (*d->entryList().at(i) != *other.entryAt(i)) {
             return false;
         }
     }
@@ -420,27 +430,35 @@ int Qtilities::Core::ObserverRelationalTable::count() const {
 }
 
 Qtilities::Core::RelationalTableEntry* Qtilities::Core::ObserverRelationalTable::entryWithVisitorID(int visitor_id) const {
-    for (int i = 0; i < d->entries.count(); ++i) {
-        if (d->entries.values().at(i)->visitorID() == visitor_id)
-            return d->entries.values().at(i);
+    // Entries are keyed on their visitor IDs, thus we look the entry up directly:
+    RelationalTableEntry* entry = d->entries.value(visitor_id);
+    if (entry && entry->visitorID() == visitor_id)
+        return entry;
+
+    const QList<RelationalTableEntry*>& entry_list = d->entryList();
+    for (int i = 0; i < entry_list.count(); ++i) {
+        if (entry_list.at(i)->visitorID() == visitor_id)
+            return entry_list.at(i);
     }
 
     return 0;
 }
 
 Qtilities::Core::RelationalTableEntry* Qtilities::Core::ObserverRelationalTable::entryWithSessionID(int session_id) const {
-    for (int i = 0; i < d->entries.count(); ++i) {
-        if (d->entries.values().at(i)->sessionID() == session_id)
-            return d->entries.values().at(i);
+    const QList<RelationalTableEntry*>& entry_list = d->entryList();
+    for (int i = 0; i < entry_list.count(); ++i) {
+        if (entry_list.at(i)->sessionID() == session_id)
+            return entry_list.at(i);
     }
 
     return 0;
 }
 
 Qtilities::Core::RelationalTableEntry* Qtilities::Core::ObserverRelationalTable::entryWithPreviousSessionID(int session_id) const {
-    for (int i = 0; i < d->entries.count(); ++i) {
-        if (d->entries.values().at(i)->previousSessionID() == session_id)
-            return d->entries.values().at(i);
+    const QList<RelationalTableEntry*>& entry_list = d->entryList();
+    for (int i = 0; i < entry_list.count(); ++i) {
+        if (entry_list.at(i)->previousSessionID() == session_id)
+            return entry_list.at(i);
     }
 
     return 0;
@@ -450,7 +468,7 @@ Qtilities::Core::RelationalTableEntry* Qtilities::Core::ObserverRelationalTable:
     if (index < 0 || index >= d->entries.count())
         return 0;
 
-    return d->entries.values().at(index);
+    return d->entryList().at(index);
 }
 
 int Qtilities::Core::ObserverRelationalTable::getVisitorID(QObject* obj) {
@@ -526,7 +544,7 @@ bool Qtilities::Core::ObserverRelationalTable::compareObjects(QList<QPointer<QOb
         LOG_ERROR(QString("ObserverRelationalTable::compareObjects() failed. Number of entries in table (%1) does not match the number of objects in list to check (%2).").arg(d->entries.count()).arg(objects.count()));
         LOG_TRACE("Items in relational table:");
         for (int i = 0; i < d->entries.count(); ++i) {
-            LOG_TRACE(d->entries.values().at(i)->name());
+            LOG_TRACE(d->entryList().at(i)->name());
         }
         LOG_TRACE("Items in object list:");
         for (int i = 0; i < objects.count(); ++i) {
@@ -555,7 +573,7 @@ Qtilities::Core::RelationalTableEntry* Qtilities::Core::ObserverRelationalTable:
     if (index < 0 || index >= d->entries.count())
         return 0;
 
-    return d->entries.values().at(index);
+    return d->entryList().at(index);
 }
 
 void Qtilities::Core::ObserverRelationalTable::dumpTableInfo() const {
@@ -570,7 +588,7 @@ void Qtilities::Core::ObserverRelationalTable::dumpTableInfo() const {
         LOG_INFO(QObject::tr("Observer Relational Table Dump For Readback Table:"));
     LOG_INFO("-------------------------------------");
     for (int i = 0; i < d->entries.count(); ++i) {
-        RelationalTableEntry* entry = d->entries.values().at(i);
+        RelationalTableEntry* entry = d->entryList().at(i);
         if (!entry) {
             LOG_INFO(QObject::tr("Null entry found..."));
             break;
@@ -585,7 +603,7 @@ void Qtilities::Core::ObserverRelationalTable::dumpTableInfo() const {
         LOG_INFO(QString("> Owner Visitor ID:       %1").arg(entry->parentVisitorID()));
         LOG_INFO(QString("> Child count:            %1").arg(entry->children().count()));
         for (int c = 0; c < entry->children().count(); c++) {
-            RelationalTableEntry* child = d->entries[entry->children().at(c)];
+            RelationalTableEntry* child = d->entries.value(entry->children().at(c));
             if (child) {
                 LOG_INFO(QString(">> Child No.   %1").arg(c));
                 LOG_INFO(QString(">> Name        %1").arg(child->name()));
@@ -596,7 +614,7 @@ void Qtilities::Core::ObserverRelationalTable::dumpTableInfo() const {
         }
         LOG_INFO(QString("> Parent count: %1").arg(entry->parents().count()));
         for (int c = 0; c < entry->parents().count(); c++) {
-            RelationalTableEntry* parent = d->entries[entry->parents().at(c)];
+            RelationalTableEntry* parent = d->entries.value(entry->parents().at(c));
             if (parent) {
                 LOG_INFO(QString(">> Parent No.  %1").arg(c));
                 LOG_INFO(QString(">> Name        %1").arg(parent->name()));
@@ -697,7 +715,7 @@ Qtilities::Core::RelationalTableEntry* Qtilities::Core::ObserverRelationalTable:
                 // Already existed:
                 // Get the entry
                 subject_id = getVisitorID(obj);
-                subject_entry = d->entries[subject_id];
+                subject_entry = d->entries.value(subject_id);
                 addLimitedExportProperty(obj);
                 // Now add this observer as a parent to the subject
                 if (subject_entry)
@@ -709,6 +727,7 @@ Qtilities::Core::RelationalTableEntry* Qtilities::Core::ObserverRelationalTable:
                 // Add the subject to the table entries map:
                 subject_entry = new RelationalTableEntry(subject_id,-1,observer->subjectNameInContext(obj),subject_ownership,obj);
                 d->entries[subject_id] = subject_entry;
+                d->entry_list_valid = false;
                 // Now add this observer as a parent to the subject
                 subject_entry->addParent(observer_id);
             }
@@ -731,6 +750,7 @@ Qtilities::Core::RelationalTableEntry* Qtilities::Core::ObserverRelationalTable:
     // ADD THE OBSERVER ENTRY
     // ---------------------------------------
     d->entries[observer_id] = observer_entry;
+    d->entry_list_valid = false;
     return observer_entry;
 }
 
@@ -835,6 +855,7 @@ Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::Obs
         if (entry.importBinary(stream,import_list) == IExportable::Complete) {
             RelationalTableEntry* entry_ptr = new RelationalTableEntry(entry);
             d->entries[entry.visitorID()] = entry_ptr;
+            d->entry_list_valid = false;
         }
     }
 
@@ -860,9 +881,9 @@ Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::Obs
     for (int i = 0; i < d->entries.count(); ++i) {
         QDomElement entry = doc->createElement("Entry_" + QString::number(i));
         object_node->appendChild(entry);
-        if (d->entries.values().at(i)) {
-            d->entries.values().at(i)->setExportVersion(exportVersion());
-            d->entries.values().at(i)->exportXml(doc,&entry);
+        if (d->entryList().at(i)) {
+            d->entryList().at(i)->setExportVersion(exportVersion());
+            d->entryList().at(i)->exportXml(doc,&entry);
         }
     }
 
@@ -896,8 +917,10 @@ Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::Obs
         if (child.tagName().startsWith("Entry_")) {
             RelationalTableEntry* new_entry = new RelationalTableEntry;
             new_entry->setExportVersion(exportVersion());
-            if (new_entry->importXml(doc,&child,import_list) == IExportable::Complete)
+            if (new_entry->importXml(doc,&child,import_list) == IExportable::Complete) {
                 d->entries[new_entry->visitorID()] = new_entry;
+                d->entry_list_valid = false;
+            }
             continue;
         }
     }
@@ -11,6 +11,8 @@
 
 #include "PointerList.h"
 
+#include <QSet>
+
 Qtilities::Core::PointerList::PointerList(bool cleanup_when_done, QObject *parent) : PointerListDeleter() {
     Q_UNUSED(parent)
 
@@ -45,8 +47,11 @@ QObject* Qtilities::Core::PointerList::at(int i) const {
 }
 
 void Qtilities::Core::PointerList::removeThisObject(QObject * obj) {
-    list.removeOne(obj);
+    int index = list.indexOf(obj);
+    if (index != -1)
+        list.removeAt(index);
     emit objectDestroyed(obj);
+    emit objectDestroyedAt(obj,index);
 }
 
 void Qtilities::Core::PointerList::removeOne(QObject* obj) {
@@ -54,6 +59,29 @@ void Qtilities::Core::PointerList::removeOne(QObject* obj) {
     list.removeOne(obj);
 }
 
+void Qtilities::Core::PointerList::removeObjects(const QList<QObject*>& objects) {
+    if (objects.isEmpty())
+        return;
+
+    QSet<QObject*> removed_objects;
+    for (int i = 0; i < objects.count(); ++i) {
+        QObject::disconnect(objects.at(i), SIGNAL(destroyed(QObject *)), this, SLOT(removeSender()));
+        removed_objects.insert(objects.at(i));
+    }
+
+    QList<QObject*> remaining_objects;
+    remaining_objects.reserve(list.count());
+    for (int i = 0; i < list.count(); ++i) {
+        if (!removed_objects.contains(list.at(i)))
+            remaining_objects.append(list.at(i));
+    }
+    list = remaining_objects;
+}
+
+int Qtilities::Core::PointerList::indexOf(QObject* obj) const {
+    return list.indexOf(obj);
+}
+
 void Qtilities::Core::PointerList::addThisObject(QObject * obj) {
     QObject::connect(obj, SIGNAL(destroyed(QObject *)), this, SLOT(removeSender()));
 }
@@ -43,6 +43,11 @@ namespace Qtilities {
         signals:
             //! Signal which is emitted when an object is removed.
             void objectDestroyed(QObject* object);
+            //! Signal which is emitted when an object is removed, with the index at which the object was in the list.
+            /*!
+              <i>This signal was added in %Qtilities v1.5.</i>
+              */
+            void objectDestroyedAt(QObject* object, int index);
 
         private Q_SLOTS:
             //! A slot which will remove the sender object. This slot will be connected to the destroyed(QObject *) signal of all objects added to PointerList.
@@ -96,6 +101,16 @@ test_list: Delete object test2 during destruction of test_list. Deleting it will
             void deleteAll();
             int count() const;
             void removeOne(QObject* obj);
+            //! Removes all of the given objects from the list in a single pass.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void removeObjects(const QList<QObject*>& objects);
+            //! Returns the index of obj in the list, or -1 if it is not in the list.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            int indexOf(QObject* obj) const;
             QObject* at(int i) const;
             QMutableListIterator<QObject*> iterator();
             QList<QObject*> toQList() const;
@@ -14,6 +14,9 @@
 #include <Logger.h>
 
 #include <QDomElement>
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
 
 // -----------------------------------------
 // CategoryLevel
@@ -72,18 +75,64 @@ Qtilities::Core::IExportable::ExportResultFlags Qtilities::Core::CategoryLevel::
     return IExportable::Failed;
 }
 
+// -----------------------------------------
+// QtilitiesCategoryPath
+// -----------------------------------------
+struct Qtilities::Core::QtilitiesCategoryPath {
+    QtilitiesCategoryPath(quint32 path_id = 0, const QtilitiesCategoryPath* parent_path = 0, const QString& level_name = QString()) :
+        id(path_id),
+        parent(parent_path),
+        name(level_name),
+        depth(0)
+    {
+        if (parent) {
+            depth = parent->depth + 1;
+            if (parent->depth > 0)
+                path_string = parent->path_string + "::" + name;
+            else
+                path_string = name;
+        }
+    }
+
+    //! The ID of the path, 0 for the root path.
+    quint32                                 id;
+    //! The parent path, 0 for the root path.
+    const QtilitiesCategoryPath*            parent;
+    //! The name of the lowest level in the path.
+    QString                                 name;
+    //! The level names joined with "::". Used for ordering and toString().
+    QString                                 path_string;
+    //! The number of levels in the path.
+    int                                     depth;
+    //! The child paths, keyed by level name. Only accessed while the registry is locked.
+    QHash<QString,QtilitiesCategoryPath*>   children;
+};
+
+namespace {
+    //! The process wide table of interned category paths. Paths are never removed.
+    struct CategoryPathRegistry {
+        CategoryPathRegistry() : next_id(1) {}
+
+        QMutex                          mutex;
+        Qtilities::Core::QtilitiesCategoryPath root;
+        quint32                         next_id;
+    };
+}
+
+Q_GLOBAL_STATIC(CategoryPathRegistry, qti_category_path_registry)
+
 // -----------------------------------------
 // QtilitiesCategory
 // -----------------------------------------
 
-Qtilities::Core::QtilitiesCategory::QtilitiesCategory(const QString& category_level_name) : IExportable()  {
+Qtilities::Core::QtilitiesCategory::QtilitiesCategory(const QString& category_level_name) : IExportable(), d_path(0)  {
     if (!category_level_name.isEmpty())
         addLevel(category_level_name);
     d_access_mode = 3;
     //d_category_icon = 0;
 }
 
-Qtilities::Core::QtilitiesCategory::QtilitiesCategory(const QString& category_levels, const QString& separator) : IExportable() {
+Qtilities::Core::QtilitiesCategory::QtilitiesCategory(const QString& category_levels, const QString& separator) : IExportable(), d_path(0) {
     QStringList category_name_list = category_levels.split(separator,QString::SkipEmptyParts);
     foreach(QString level,category_name_list) {
         if (level.trimmed().length() > 0)
@@ -93,7 +142,7 @@ Qtilities::Core::QtilitiesCategory::QtilitiesCategory(const QString& category_le
     //d_category_icon = 0;
 }
 
-Qtilities::Core::QtilitiesCategory::QtilitiesCategory(const QStringList& category_name_list) : IExportable() {
+Qtilities::Core::QtilitiesCategory::QtilitiesCategory(const QStringList& category_name_list) : IExportable(), d_path(0) {
     foreach(QString level,category_name_list)
         addLevel(level);
     d_access_mode = 3;
@@ -103,8 +152,9 @@ Qtilities::Core::QtilitiesCategory::QtilitiesCategory(const QStringList& categor
 QtilitiesCategory& Qtilities::Core::QtilitiesCategory::operator=(const QtilitiesCategory& other) {
     if (this==&other) return *this;
 
-    d_category_levels = other.categoryLevels();
+    d_category_levels = other.d_category_levels;
     d_access_mode = other.accessMode();
+    d_path = other.d_path;
 //    if (!other.categoryIcon().isNull())
 //        d_category_icon = new QIcon(other.categoryIcon());
 
@@ -112,14 +162,55 @@ QtilitiesCategory& Qtilities::Core::QtilitiesCategory::operator=(const Qtilities
 }
 
 bool Qtilities::Core::QtilitiesCategory::operator==(const QtilitiesCategory& ref) const {
-    return d_category_levels == ref.categoryLevels();
+    // Paths are interned, thus categories with the same levels share the same path:
+    return d_path == ref.d_path;
 }
 
 bool Qtilities::Core::QtilitiesCategory::operator!=(const QtilitiesCategory& ref) const {
     return !(*this==ref);
 }
 
+bool Qtilities::Core::QtilitiesCategory::operator<(const QtilitiesCategory &e1) const {
+    if (d_path == e1.d_path)
+        return false;
+    return toString() < e1.toString();
+}
+
+bool Qtilities::Core::QtilitiesCategory::operator>(const QtilitiesCategory &e1) const {
+    return e1 < *this;
+}
+
+bool Qtilities::Core::QtilitiesCategory::operator<=(const QtilitiesCategory &e1) const {
+    return !(e1 < *this);
+}
+
+bool Qtilities::Core::QtilitiesCategory::operator>=(const QtilitiesCategory &e1) const {
+    return !(*this < e1);
+}
+
+quint32 Qtilities::Core::QtilitiesCategory::pathId() const {
+    if (d_path)
+        return d_path->id;
+    else
+        return 0;
+}
+
+Qtilities::Core::QtilitiesCategory Qtilities::Core::QtilitiesCategory::parentCategory() const {
+    QtilitiesCategory parent_category;
+    parent_category.setAccessMode(d_access_mode);
+    if (d_category_levels.count() > 1) {
+        parent_category.d_category_levels = d_category_levels.mid(0,d_category_levels.count() - 1);
+        parent_category.d_path = d_path->parent;
+    }
+    return parent_category;
+}
+
 QString Qtilities::Core::QtilitiesCategory::toString(const QString& join_string) const {
+    if (!d_path)
+        return QString();
+    if (join_string == QLatin1String("::"))
+        return d_path->path_string;
+
     QString category_string;
     int count = d_category_levels.count();
     for (int i = 0; i < count; ++i) {
@@ -150,10 +241,29 @@ QStringList Qtilities::Core::QtilitiesCategory::toStringList(int level) const {
 void Qtilities::Core::QtilitiesCategory::addLevel(const QString& name) {
     CategoryLevel category_level(name);
     d_category_levels.push_back(category_level);
+    internLevel(name);
 }
 
 void Qtilities::Core::QtilitiesCategory::addLevel(CategoryLevel category_level) {
     d_category_levels.push_back(category_level);
+    internLevel(category_level.d_name);
+}
+
+void Qtilities::Core::QtilitiesCategory::internLevel(const QString& name) {
+    CategoryPathRegistry* registry = qti_category_path_registry();
+    QMutexLocker locker(&registry->mutex);
+
+    QtilitiesCategoryPath* parent = d_path ? const_cast<QtilitiesCategoryPath*> (d_path) : &registry->root;
+    QtilitiesCategoryPath* path = parent->children.value(name);
+    if (!path) {
+        path = new QtilitiesCategoryPath(registry->next_id++,parent,name);
+        parent->children.insert(name,path);
+    }
+    d_path = path;
+}
+
+uint Qtilities::Core::qHash(const QtilitiesCategory& category) {
+    return category.pathId();
 }
 
 void Qtilities::Core::QtilitiesCategory::setExportVersion(Qtilities::ExportVersion version) {
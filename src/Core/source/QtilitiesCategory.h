@@ -83,6 +83,15 @@ namespace Qtilities {
             QString                 d_name;
         };
 
+        /*!
+        \struct QtilitiesCategoryPath
+        \brief An interned category path used by QtilitiesCategory.
+
+        Every distinct category path is interned once in a process wide table. Each path knows its parent path, thus categories
+        only need to store a reference to their interned path.
+          */
+        struct QtilitiesCategoryPath;
+
 /*!
 \class Qtilities::Core::QtilitiesCategory
 \brief A QtilitiesCategory object represents a category in %Qtilities.
@@ -114,6 +123,10 @@ The category depth is available through categoryDepth() and the top and bottom l
 available through categoryTop() and categoryBottom() respectively. The category can be converted to a string using
 toString() or to a string list using toStringList().
 
+Category paths are interned: all categories with the same levels share a single QtilitiesCategoryPath which is identified by pathId().
+Comparing, ordering and hashing categories therefore does not require the category levels to be compared one by one, thus categories
+can be used efficiently as keys in a QHash or QMap.
+
 It is possible to set the access mode of a category using setAccessMode() and the access mode can be accessed
 using accessMode(). A QtilitiesCategory object supports streaming to a QDataStream or saving its data
 to a XML QDomElement node. This is made possible by the implementation of Qtilities::Core::Interfaces::IExportable.
@@ -168,7 +181,7 @@ sure that categories are handled the same way everywhere. Some usages in %Qtilit
             QtilitiesCategory(const QString& category_levels, const QString& separator);
             //! Creates a QtilitiesCategory object from a QStringList.
             QtilitiesCategory(const QStringList& category_name_list);
-            QtilitiesCategory(QDataStream &ds, Qtilities::ExportVersion version) : IObjectBase(), IExportable() {
+            QtilitiesCategory(QDataStream &ds, Qtilities::ExportVersion version) : IObjectBase(), IExportable(), d_path(0) {
                 QList<QPointer<QObject> > import_list;
                 setExportVersion(version);
                 importBinary(ds,import_list);
@@ -176,6 +189,7 @@ sure that categories are handled the same way everywhere. Some usages in %Qtilit
             QtilitiesCategory(const QtilitiesCategory& category) : IObjectBase(), IExportable() {
                 d_category_levels = category.d_category_levels;
                 d_access_mode = category.d_access_mode;
+                d_path = category.d_path;
             }
             virtual ~QtilitiesCategory() {}
             QtilitiesCategory& operator=(const QtilitiesCategory& other);
@@ -196,25 +210,16 @@ sure that categories are handled the same way everywhere. Some usages in %Qtilit
                return *this;
             }
             //! Overload < operator so that we can use QtilitiesCategory in a QMap.
-            inline bool operator<(const QtilitiesCategory &e1) const
-            {
-                return toString() < e1.toString();
-            }
+            /*!
+              Categories are ordered by their toString() representations.
+              */
+            bool operator<(const QtilitiesCategory &e1) const;
             //! Overload > operator.
-            inline bool operator>(const QtilitiesCategory &e1) const
-            {
-                return toString() > e1.toString();
-            }
+            bool operator>(const QtilitiesCategory &e1) const;
             //! Overload <= operator.
-            inline bool operator<=(const QtilitiesCategory &e1) const
-            {
-                return toString() <= e1.toString();
-            }
+            bool operator<=(const QtilitiesCategory &e1) const;
             //! Overload >= operator.
-            inline bool operator>=(const QtilitiesCategory &e1) const
-            {
-                return toString() >= e1.toString();
-            }
+            bool operator>=(const QtilitiesCategory &e1) const;
 
             //! Indicates if this category is valid.
             /*!
@@ -224,7 +229,7 @@ sure that categories are handled the same way everywhere. Some usages in %Qtilit
             //! Indicates if this category is empty. Thus no levels have been added to it.
             inline bool isEmpty() const { return (d_category_levels.count() == 0); }
             //! Clears the category.
-            inline void clear() { d_category_levels.clear(); }
+            inline void clear() { d_category_levels.clear(); d_path = 0; }
 
             //! Returns the category as a QString.
             /*!
@@ -250,6 +255,22 @@ sure that categories are handled the same way everywhere. Some usages in %Qtilit
             void addLevel(const QString& name);
             //! Adds a level to the category by providing a ready to use CategoryLevel structure.
             void addLevel(CategoryLevel category_level);
+            //! Returns the ID of the interned path of this category.
+            /*!
+              Categories with the same levels have the same path ID, and the path ID of an empty category is always 0. Path IDs
+              are only valid during the current session, thus they must never be exported.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            quint32 pathId() const;
+            //! Returns the category one level up from this category.
+            /*!
+              The access mode of the returned category is the same as the access mode of this category. When this category has
+              a single level, or is empty, an empty category is returned.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            QtilitiesCategory parentCategory() const;
             //! Returns the category levels where the first item in the list is always the top level category and the last item is the bottom level.
             inline QList<CategoryLevel> categoryLevels() const { return d_category_levels; }
             //! Returns the top level category in this category object.
@@ -301,10 +322,21 @@ sure that categories are handled the same way everywhere. Some usages in %Qtilit
             IExportable::ExportResultFlags importXml(QDomDocument* doc, QDomElement* object_node, QList<QPointer<QObject> >& import_list);
 
         protected:
-            QList<CategoryLevel>    d_category_levels;
-            int                     d_access_mode;
+            //! Updates d_path after \p name was added as a level to the category.
+            void internLevel(const QString& name);
+
+            QList<CategoryLevel>            d_category_levels;
+            int                             d_access_mode;
             //QIcon*                  d_category_icon;
+            //! The interned path of the category, 0 when the category is empty.
+            const QtilitiesCategoryPath*    d_path;
         };
+
+        //! Returns a hash value for \p category, allowing QtilitiesCategory to be used as a key in a QHash.
+        /*!
+          <i>This function was added in %Qtilities v1.5.</i>
+          */
+        QTILIITES_CORE_SHARED_EXPORT uint qHash(const QtilitiesCategory& category);
     }
 }
 
@@ -58,6 +58,8 @@ Qtilities::Core::QtilitiesCoreApplicationPrivate::QtilitiesCoreApplicationPrivat
 
     // Register QList<QPointer<QObject> > in Meta Object System.
     qRegisterMetaType<QList<QPointer<QObject> > >("QList<QPointer<QObject> >");
+    // Register QList<QObject*> in Meta Object System, used by Observer::subjectsDeleted().
+    qRegisterMetaType<QList<QObject*> >("QList<QObject*>");
 
     d_application_session_path = applicationSessionPathDefault();
 
@@ -87,6 +87,7 @@ HEADERS += \
     source/ObjectHierarchyNavigator.h \
     source/ObjectScopeWidget.h \
     source/ObserverTableModel.h \
+    source/ObserverSearchIndex.h \
     source/ObserverTableModelProxyFilter.h \
     source/ObserverTreeItem.h \
     source/ObserverTreeModelBuilder.h \
@@ -145,6 +146,7 @@ SOURCES += \
     source/ObjectHierarchyNavigator.cpp \
     source/ObjectScopeWidget.cpp \
     source/ObserverTableModel.cpp \
+    source/ObserverSearchIndex.cpp \
     source/ObserverTableModelProxyFilter.cpp \
     source/ObserverTreeItem.cpp \
     source/ObserverTreeModelBuilder.cpp \
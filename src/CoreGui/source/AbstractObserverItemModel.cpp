@@ -114,3 +114,53 @@ void Qtilities::CoreGui::AbstractObserverItemModel::setColumnChildCountLimit(int
 int Qtilities::CoreGui::AbstractObserverItemModel::columnChildCountLimit() const {
     return model->child_count_limit;
 }
+
+Qtilities::CoreGui::AbstractObserverItemModel::ColumnID Qtilities::CoreGui::AbstractObserverItemModel::columnHandler(int column) const {
+    ObserverHints* hints = activeHints();
+    int flags = hints ? (int) hints->itemViewColumnHint() : (int) ObserverHints::ColumnAllHints;
+
+    if (model->column_handlers.isEmpty() || model->column_handlers_hints != hints || model->column_handlers_flags != flags) {
+        model->column_handlers.fill(ColumnLast,columnPosition(ColumnLast) + 1);
+        for (int i = 0; i < ColumnLast; ++i) {
+            ColumnID column_id = (ColumnID) i;
+            int position = columnPosition(column_id);
+            if (position < 0 || position >= model->column_handlers.count())
+                continue;
+
+            int hint = 0;
+            if (column_id == ColumnName)
+                hint = ObserverHints::ColumnNameHint;
+            else if (column_id == ColumnChildCount)
+                hint = ObserverHints::ColumnChildCountHint;
+            else if (column_id == ColumnAccess)
+                hint = ObserverHints::ColumnAccessHint;
+            else if (column_id == ColumnTypeInfo)
+                hint = ObserverHints::ColumnTypeInfoHint;
+            else if (column_id == ColumnCategory)
+                hint = ObserverHints::ColumnCategoryHint;
+
+            if (hint == 0 || (flags & hint))
+                model->column_handlers[position] = column_id;
+        }
+        model->column_handlers_hints = hints;
+        model->column_handlers_flags = flags;
+    }
+
+    if (column < 0 || column >= model->column_handlers.count())
+        return ColumnLast;
+    return (ColumnID) model->column_handlers.at(column);
+}
+
+QString Qtilities::CoreGui::AbstractObserverItemModel::typeInfoString(const QObject* obj) const {
+    if (!obj || !obj->metaObject())
+        return QString();
+
+    const QMetaObject* meta_object = obj->metaObject();
+    QHash<const QMetaObject*,QString>::const_iterator itr = model->type_info_strings.constFind(meta_object);
+    if (itr != model->type_info_strings.constEnd())
+        return itr.value();
+
+    QString type_info = QString(QLatin1String(meta_object->className())).split("::").last();
+    model->type_info_strings.insert(meta_object,type_info);
+    return type_info;
+}
@@ -20,6 +20,8 @@
 #include <ActivityPolicyFilter>
 
 #include <QModelIndex>
+#include <QVector>
+#include <QHash>
 
 namespace Qtilities {
     namespace CoreGui {
@@ -32,7 +34,8 @@ namespace Qtilities {
         struct AbstractObserverItemModelData {
             AbstractObserverItemModelData() : respond_to_observer_changes(true),
                 child_count_base("QObject"),
-                child_count_limit(-1) { }
+                child_count_limit(-1),
+                column_handlers_flags(-1) { }
 
             //! Used to store default observer hints to be used with this widget.
             QPointer<ObserverHints>         hints_default;
@@ -58,6 +61,14 @@ namespace Qtilities {
             int                             child_count_limit;
             //! Indicates if lazy initialization is enabled for this mode.
             bool                            lazy_init;
+            //! Maps column positions to the column IDs handling them. See AbstractObserverItemModel::columnHandler().
+            QVector<int>                    column_handlers;
+            //! The hints for which column_handlers was built.
+            QPointer<ObserverHints>         column_handlers_hints;
+            //! The item view column hint for which column_handlers was built.
+            int                             column_handlers_flags;
+            //! Cache of the type info strings displayed in ColumnTypeInfo, stored per class.
+            QHash<const QMetaObject*,QString> type_info_strings;
         };
 
         /*!
@@ -113,6 +124,25 @@ namespace Qtilities {
               \note ColumnLast must return the number of columns you use in your model.
               */
             virtual int columnPosition(ColumnID column_id) const = 0;
+            //! Returns the column ID which provides the data of the column at the specified position.
+            /*!
+              When the column at \p column is hidden by the item view column hint of activeHints(), or when \p column is not a valid column,
+              ColumnLast is returned. ColumnSubjectID is never hidden since models use it internally to identify subjects.
+
+              The positions of all columns are looked up once using columnPosition() and stored in a table which is only rebuilt when the
+              active hints or their item view column hint changes. Models should use this function in their data() implementations instead
+              of comparing the column against columnPosition() for each column ID.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            ColumnID columnHandler(int column) const;
+            //! Returns the type information displayed for \p obj in the ColumnTypeInfo column.
+            /*!
+              This is the class name of the object without any namespaces. The string is constructed once per class.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            QString typeInfoString(const QObject* obj) const;
 
             //! Abstract function which must be implemented to get the subject ID of the object at the given index.
             virtual int getSubjectID(const QModelIndex &index) const = 0;
@@ -25,6 +25,7 @@
 #include <QMainWindow>
 #include <QList>
 #include <QHash>
+#include <QBitArray>
 #include <QApplication>
 #include <QDomDocument>
 #include <QDomElement>
@@ -41,13 +42,64 @@ using namespace Qtilities::Logging::Constants;
 
 bool Qtilities::CoreGui::ActionManager::showed_warning;
 
+namespace {
+    // Returns true when any bit is set in both masks. The masks can have different sizes.
+    bool qti_private_masksIntersect(const QBitArray& first, const QBitArray& second) {
+        const int size = qMin(first.size(),second.size());
+        for (int i = 0; i < size; ++i) {
+            if (first.testBit(i) && second.testBit(i))
+                return true;
+        }
+        return false;
+    }
+
+    // Returns true when at least two bits are set in both masks. The masks can have different sizes.
+    bool qti_private_masksIntersectMultiple(const QBitArray& first, const QBitArray& second) {
+        const int size = qMin(first.size(),second.size());
+        int count = 0;
+        for (int i = 0; i < size; ++i) {
+            if (first.testBit(i) && second.testBit(i)) {
+                if (++count == 2)
+                    return true;
+            }
+        }
+        return false;
+    }
+
+    // Returns true when the contexts which appear in both lists are ordered differently in the lists.
+    bool qti_private_orderChanged(const QList<int>& previous, const QList<int>& current) {
+        QList<int> previous_common;
+        for (int i = 0; i < previous.count(); ++i) {
+            if (current.contains(previous.at(i)))
+                previous_common << previous.at(i);
+        }
+        QList<int> current_common;
+        for (int i = 0; i < current.count(); ++i) {
+            if (previous.contains(current.at(i)))
+                current_common << current.at(i);
+        }
+        return previous_common != current_common;
+    }
+}
+
 struct Qtilities::CoreGui::ActionManagerPrivateData {
     ActionManagerPrivateData() : observer_commands("Registered Commands"),
-      observer_action_container("Registered Action Containers") { }
+      observer_action_container("Registered Action Containers"),
+      context_update_queued(false),
+      contexts_applied(false) { }
 
     QPointer<CommandEditor> command_editor;
     TreeNode observer_commands;
     TreeNode observer_action_container;
+    //! The latest contexts received in handleContextChanged() which still needs to be applied.
+    QList<int> pending_contexts;
+    //! The contexts applied to the commands during the last applyContextChange() call.
+    QBitArray applied_contexts;
+    //! The ordered list of contexts applied to the commands during the last applyContextChange() call.
+    QList<int> applied_context_list;
+    bool context_update_queued;
+    //! Indicates if contexts were applied before. The first change is applied to all commands.
+    bool contexts_applied;
 };
 
 Qtilities::CoreGui::ActionManager::ActionManager(QObject* parent) : IActionManager(parent)
@@ -304,18 +356,53 @@ Qtilities::CoreGui::Command *Qtilities::CoreGui::ActionManager::command(const QS
 }
 
 void Qtilities::CoreGui::ActionManager::handleContextChanged(QList<int> new_contexts) {
-    if (d->observer_commands.subjectCount() == 0)
+    d->pending_contexts = new_contexts;
+    if (d->context_update_queued)
         return;
 
-    Command* command = qobject_cast<Command*> (d->observer_commands.subjectAt(0));
-    SubjectIterator<Qtilities::CoreGui::Command> command_itr(command,
-                                                             &d->observer_commands);
+    d->context_update_queued = true;
+    QMetaObject::invokeMethod(this,"applyContextChange",Qt::QueuedConnection);
+}
 
-    if (command_itr.current())
-        command_itr.current()->setCurrentContext(new_contexts);
+void Qtilities::CoreGui::ActionManager::applyContextChange() {
+    d->context_update_queued = false;
 
-    while (command_itr.hasNext()) {
-        command_itr.next()->setCurrentContext(new_contexts);
+    int size = 0;
+    for (int i = 0; i < d->pending_contexts.count(); ++i) {
+        if (d->pending_contexts.at(i) >= size)
+            size = d->pending_contexts.at(i) + 1;
+    }
+    QBitArray new_contexts(size);
+    for (int i = 0; i < d->pending_contexts.count(); ++i) {
+        if (d->pending_contexts.at(i) >= 0)
+            new_contexts.setBit(d->pending_contexts.at(i));
+    }
+
+    // Find the contexts which were activated or deactivated since the last change:
+    QBitArray changed_contexts = new_contexts;
+    QBitArray applied_contexts = d->applied_contexts;
+    if (changed_contexts.size() < applied_contexts.size())
+        changed_contexts.resize(applied_contexts.size());
+    else
+        applied_contexts.resize(changed_contexts.size());
+    changed_contexts ^= applied_contexts;
+
+    // Commands use the backend of the first active context in the list in which they have a backend. Thus when the order of the
+    // contexts changed, commands with backends in more than one active context must be updated as well:
+    const bool update_all = !d->contexts_applied;
+    const bool order_changed = !update_all && qti_private_orderChanged(d->applied_context_list,d->pending_contexts);
+    d->applied_contexts = new_contexts;
+    d->applied_context_list = d->pending_contexts;
+    d->contexts_applied = true;
+
+    const int command_count = d->observer_commands.subjectCount();
+    for (int i = 0; i < command_count; ++i) {
+        Command* command = qobject_cast<Command*> (d->observer_commands.subjectAt(i));
+        if (!command)
+            continue;
+        if (update_all || qti_private_masksIntersect(command->contextMask(),changed_contexts) ||
+                (order_changed && qti_private_masksIntersectMultiple(command->contextMask(),new_contexts)))
+            command->setCurrentContext(d->pending_contexts);
     }
 }
 
@@ -80,8 +80,19 @@ namespace Qtilities {
 
         public slots:
             void unregisterCommandsForContext(int context);
+            //! Handles context changes in the application.
+            /*!
+              Since %Qtilities v1.5 the commands are not updated immediately. Context changes made within the same call stack are
+              coalesced and applied once control returns to the event loop, and only commands which have a backend in one of the
+              contexts whose state changed are updated. When the order of the active contexts changed, commands which have backends in more
+              than one active context are updated as well since the order determines which backend is used.
+              */
             void handleContextChanged(QList<int> new_contexts);
 
+        private slots:
+            //! Applies the context change queued by handleContextChanged() to the affected commands.
+            void applyContextChange();
+
         private:
             ActionManagerPrivateData* d;
             static bool showed_warning;
@@ -12,14 +12,36 @@
 
 #include <QSyntaxHighlighter>
 #include <QPainter>
+#include <QTextBlock>
+#include <QRegExp>
 #include <QtDebug>
 
+static bool longerWordFirst(const QString& word1, const QString& word2) {
+    return word1.length() > word2.length();
+}
+
 struct Qtilities::CoreGui::CodeEditorPrivateData {
     CodeEditorPrivateData() : lineNumberArea(0),
-    syntaxHighlighter(0) {}
+    syntaxHighlighter(0),
+    highlighted_first_block(-1),
+    highlighted_last_block(-1),
+    highlighted_revision(-1) {}
 
     QWidget *lineNumberArea;
     QSyntaxHighlighter* syntaxHighlighter;
+
+    //! The current line highlighting selection set in highlightLine(), if any.
+    QList<QTextEdit::ExtraSelection> line_selections;
+    //! The combined pattern of all words set in highlightWords(), empty when no words are highlighted.
+    QRegExp word_pattern;
+    //! The brush used to highlight words.
+    QBrush word_brush;
+    //! The word highlighting selections in the currently visible blocks.
+    QList<QTextEdit::ExtraSelection> word_selections;
+    //! The visible block range and document revision for which word_selections were calculated.
+    int highlighted_first_block;
+    int highlighted_last_block;
+    int highlighted_revision;
 };
 
 Qtilities::CoreGui::CodeEditor::CodeEditor(QWidget* parent) : QPlainTextEdit(parent) {
@@ -32,6 +54,7 @@ Qtilities::CoreGui::CodeEditor::CodeEditor(QWidget* parent) : QPlainTextEdit(par
     connect(this, SIGNAL(blockCountChanged(int)), this, SLOT(updateLineNumberAreaWidth(int)));
     connect(this, SIGNAL(updateRequest(const QRect &, int)), this, SLOT(updateLineNumberArea(const QRect &, int)));
     connect(this, SIGNAL(cursorPositionChanged()), this, SLOT(highlightCurrentLine()));
+    connect(this, SIGNAL(updateRequest(const QRect &, int)), this, SLOT(updateVisibleWordHighlighting()));
 
     updateLineNumberAreaWidth(0);
     highlightCurrentLine();
@@ -89,7 +112,8 @@ void Qtilities::CoreGui::CodeEditor::highlightCurrentLine() {
 }
 
 void Qtilities::CoreGui::CodeEditor::highlightLine(QTextCursor cursor) {
-    QList<QTextEdit::ExtraSelection> extraSelections;
+    QList<QTextEdit::ExtraSelection>& extraSelections = d->line_selections;
+    extraSelections.clear();
 
     if (!isReadOnly()) {
         QTextEdit::ExtraSelection selection;
@@ -103,7 +127,7 @@ void Qtilities::CoreGui::CodeEditor::highlightLine(QTextCursor cursor) {
         extraSelections.append(selection);
     }
 
-    setExtraSelections(extraSelections);
+    applyExtraSelections();
 }
 
 void Qtilities::CoreGui::CodeEditor::updateLineNumberArea(const QRect& rect, int dy) {
@@ -121,31 +145,101 @@ void Qtilities::CoreGui::CodeEditor::resizeEvent(QResizeEvent *e) {
 
     QRect cr = contentsRect();
     d->lineNumberArea->setGeometry(QRect(cr.left(), cr.top(), lineNumberAreaWidth(), cr.height()));
+
+    updateVisibleWordHighlighting();
 }
 
 void Qtilities::CoreGui::CodeEditor::highlightWords(const QStringList& words, const QBrush& brush) {
-    QTextCursor cursor = textCursor();
-    cursor.movePosition(QTextCursor::Start);
-    setTextCursor(cursor);
-
-    foreach (const QString& current_string, words) {
-        while (find(current_string)) {
-            QTextCursor find_cursor = document()->find(current_string,cursor);
-            QTextCharFormat format(find_cursor.charFormat());
-            format.setBackground(brush);
-            find_cursor.mergeCharFormat(format);
-        }
-        cursor.movePosition(QTextCursor::Start);
-        setTextCursor(cursor);
+    // Combine all words into a single pattern. Longer words are placed first so that they take
+    // precedence over shorter words which they start with:
+    QStringList escaped_words;
+    foreach (const QString& word, words) {
+        if (word.isEmpty())
+            continue;
+        QString escaped_word = QRegExp::escape(word);
+        if (!escaped_words.contains(escaped_word))
+            escaped_words << escaped_word;
     }
 
-    cursor.movePosition(QTextCursor::Start);
-    setTextCursor(cursor);
+    if (escaped_words.isEmpty()) {
+        removeWordHighlighting();
+        return;
+    }
+
+    qStableSort(escaped_words.begin(),escaped_words.end(),longerWordFirst);
+
+    d->word_pattern = QRegExp(escaped_words.join("|"),Qt::CaseInsensitive);
+    d->word_brush = brush;
+    d->highlighted_revision = -1;
+    updateVisibleWordHighlighting();
 }
 
 void Qtilities::CoreGui::CodeEditor::removeWordHighlighting() {
-    QString tmp = document()->toPlainText();
-    document()->clear();
-    document()->setPlainText(tmp);
+    if (d->word_pattern.isEmpty() && d->word_selections.isEmpty())
+        return;
+
+    d->word_pattern = QRegExp();
+    d->word_selections.clear();
+    d->highlighted_first_block = -1;
+    d->highlighted_last_block = -1;
+    d->highlighted_revision = -1;
+    applyExtraSelections();
+}
+
+void Qtilities::CoreGui::CodeEditor::updateVisibleWordHighlighting() {
+    if (d->word_pattern.isEmpty())
+        return;
+
+    // Find the range of visible blocks:
+    QTextBlock first_block = firstVisibleBlock();
+    QTextBlock last_block = first_block;
+    QTextBlock block = first_block;
+    int top = (int) blockBoundingGeometry(block).translated(contentOffset()).top();
+    const int viewport_bottom = viewport()->rect().bottom();
+    while (block.isValid() && top <= viewport_bottom) {
+        last_block = block;
+        top += (int) blockBoundingRect(block).height();
+        block = block.next();
+    }
+
+    // Nothing to do when neither the visible blocks nor the document changed, this is the case for most update requests:
+    if (first_block.blockNumber() == d->highlighted_first_block &&
+        last_block.blockNumber() == d->highlighted_last_block &&
+        document()->revision() == d->highlighted_revision)
+        return;
+
+    d->highlighted_first_block = first_block.blockNumber();
+    d->highlighted_last_block = last_block.blockNumber();
+    d->highlighted_revision = document()->revision();
+
+    d->word_selections.clear();
+    QTextCharFormat format;
+    format.setBackground(d->word_brush);
+
+    block = first_block;
+    while (block.isValid() && block.blockNumber() <= d->highlighted_last_block) {
+        const QString text = block.text();
+        int index = d->word_pattern.indexIn(text);
+        while (index >= 0) {
+            int length = d->word_pattern.matchedLength();
+            if (length <= 0)
+                break;
+
+            QTextEdit::ExtraSelection selection;
+            selection.format = format;
+            selection.cursor = QTextCursor(document());
+            selection.cursor.setPosition(block.position() + index);
+            selection.cursor.setPosition(block.position() + index + length,QTextCursor::KeepAnchor);
+            d->word_selections << selection;
+
+            index = d->word_pattern.indexIn(text,index + length);
+        }
+        block = block.next();
+    }
+
+    applyExtraSelections();
 }
 
+void Qtilities::CoreGui::CodeEditor::applyExtraSelections() {
+    setExtraSelections(d->line_selections + d->word_selections);
+}
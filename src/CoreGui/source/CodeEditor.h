@@ -54,14 +54,33 @@ namespace Qtilities {
             //! Slot to highlight the line specified  by the cursor.
             void highlightLine(QTextCursor cursor);
             //! Function which highlights the specified word in the document using the brush.
+            /*!
+              From %Qtilities v1.5 onwards the highlighting is done using extra selections, thus the document itself is not modified.
+              All words are combined into a single case insensitive pattern and only blocks which are visible in the editor are searched
+              for matches. The highlighting is updated automatically when the editor is scrolled or when its contents change.
+
+              \sa removeWordHighlighting()
+              */
             void highlightWords(const QStringList& words, const QBrush& brush);
         public:
             //! Function which removes highlighted words set using highlightWords().
+            /*!
+              From %Qtilities v1.5 onwards this function does not reload the document anymore, thus the undo history of the document
+              is not affected.
+              */
             void removeWordHighlighting();
 
         protected:
             void resizeEvent(QResizeEvent *e);
 
+        private slots:
+            //! Updates the word highlighting when the visible part of the document or the document itself changed.
+            void updateVisibleWordHighlighting();
+
+        private:
+            //! Applies the current line and word highlighting selections to the editor.
+            void applyExtraSelections();
+
         private:
             CodeEditorPrivateData* d;
         };
@@ -19,6 +19,7 @@
 #include "ConfigurationWidget.h"
 
 #include <FileUtils>
+#include <FileWatchService>
 
 #include <QFileInfo>
 #include <QtGui>
@@ -99,9 +100,7 @@ struct Qtilities::CoreGui::CodeEditorWidgetPrivateData {
     //! The central widget layout.
     QBoxLayout* central_widget_layout;
 
-    //! A file system watcher monitoring the open file.
-    QFileSystemWatcher watcher;
-    //! Mutex on watcher hanlders.
+    //! Mutex on watcher hanlders. The open file is monitored through FileWatchService.
     QMutex watcher_mutex;
     //! FileRemovedOutsideHandlingPolicy
     CodeEditorWidget::FileRemovedOutsideHandlingPolicy removed_outside_policy;
@@ -122,8 +121,6 @@ Qtilities::CoreGui::CodeEditorWidget::CodeEditorWidget(ActionFlags action_flags,
     setCentralWidget(d->central_widget);
     d->default_path = QtilitiesApplication::applicationSessionPath();
 
-    connect(&d->watcher,SIGNAL(fileChanged(QString)),SLOT(handleFileChangedNotification(QString)));
-
     // Create the code editor:
     d->codeEditor = new CodeEditor();
     d->codeEditor->installEventFilter(this);
@@ -171,6 +168,7 @@ Qtilities::CoreGui::CodeEditorWidget::CodeEditorWidget(ActionFlags action_flags,
 Qtilities::CoreGui::CodeEditorWidget::~CodeEditorWidget() {
     CONTEXT_MANAGER->unregisterContext(d->global_meta_type);
     maybeSave();
+    FileWatchService::instance()->unwatchAll(this);
     delete d;
     delete ui;
 }
@@ -308,16 +306,15 @@ bool Qtilities::CoreGui::CodeEditorWidget::loadFile(const QString &file_name) {
     d->current_file = file_name;
     emit fileNameChanged(d->current_file);
 
-    if (d->watcher.files().contains(prev_file))
-        d->watcher.removePath(prev_file);
-    d->watcher.addPath(d->current_file);
+    if (!prev_file.isEmpty())
+        FileWatchService::instance()->unwatchFile(prev_file,this);
+    FileWatchService::instance()->watchFile(d->current_file,this,SLOT(handleWatchedFilesChanged(QStringList)));
 
     return true;
 }
 
 void Qtilities::CoreGui::CodeEditorWidget::closeFile() {
-    if (d->watcher.files().contains(d->current_file))
-        d->watcher.removePath(d->current_file);
+    FileWatchService::instance()->unwatchFile(d->current_file,this);
 
     d->current_file.clear();
     emit fileNameChanged(tr("Untitled"));
@@ -333,8 +330,7 @@ bool Qtilities::CoreGui::CodeEditorWidget::saveFile(QString file_name) {
     if (file_name.isEmpty())
         return false;
 
-    if (d->watcher.files().contains(d->current_file))
-        d->watcher.removePath(d->current_file);
+    FileWatchService::instance()->unwatchFile(d->current_file,this);
 
     QFile file(file_name);
     if (!file.open(QFile::WriteOnly))
@@ -347,7 +343,7 @@ bool Qtilities::CoreGui::CodeEditorWidget::saveFile(QString file_name) {
     d->current_file = file_name;
     emit fileNameChanged(d->current_file);
 
-    d->watcher.addPath(d->current_file);
+    FileWatchService::instance()->watchFile(d->current_file,this,SLOT(handleWatchedFilesChanged(QStringList)));
 
     updateSaveAction();
     return true;
@@ -550,6 +546,11 @@ void Qtilities::CoreGui::CodeEditorWidget::updateSaveAction() {
         d->actionSave->setEnabled(false);
 }
 
+void Qtilities::CoreGui::CodeEditorWidget::handleWatchedFilesChanged(const QStringList &paths) {
+    foreach (const QString& path, paths)
+        handleFileChangedNotification(path);
+}
+
 void Qtilities::CoreGui::CodeEditorWidget::handleFileChangedNotification(const QString &path) {
     if (!d->watcher_mutex.tryLock())
         return;
@@ -272,6 +272,7 @@ code_editor.codeEditor()->setReadOnly(true);
         private slots:
             void updateSaveAction();
             void handleFileChangedNotification(const QString& path);
+            void handleWatchedFilesChanged(const QStringList& paths);
 
         protected:
             void constructActions();
@@ -81,6 +81,24 @@ void Qtilities::CoreGui::Command::setCategory(Qtilities::Core::QtilitiesCategory
     }
 }
 
+QBitArray Qtilities::CoreGui::Command::contextMask() const {
+    return c->context_mask;
+}
+
+void Qtilities::CoreGui::Command::setContextMask(const QList<int>& context_ids) {
+    int size = 0;
+    for (int i = 0; i < context_ids.count(); ++i) {
+        if (context_ids.at(i) >= size)
+            size = context_ids.at(i) + 1;
+    }
+
+    c->context_mask = QBitArray(size);
+    for (int i = 0; i < context_ids.count(); ++i) {
+        if (context_ids.at(i) >= 0)
+            c->context_mask.setBit(context_ids.at(i));
+    }
+}
+
 Qtilities::Core::QtilitiesCategory Qtilities::CoreGui::Command::category() const {
     Observer* obs = OBJECT_MANAGER->observerReference(d_category_context);
     if (obs) {
@@ -184,6 +202,8 @@ void Qtilities::CoreGui::ProxyAction::addAction(QAction* action, QList<int> cont
         }
     }
 
+    setContextMask(d->id_action_map.keys());
+
     // If any of the context_ids are active, we need to update the active backend action:
     setCurrentContext(CONTEXT_MANAGER->activeContexts());
     //qDebug() << "Adding action to proxy action:" << defaultText() << activeBackendAction() << CONTEXT_MANAGER->activeContexts();
@@ -398,6 +418,7 @@ void Qtilities::CoreGui::ProxyAction::unregisterContext(int context_id) {
         LOG_TRACE("Context backend removed on command (action): " + defaultText());
         #endif
         d->id_action_map.remove(context_id);
+        setContextMask(d->id_action_map.keys());
 
         if (d->active_contexts.contains(context_id)) {
             d->active_contexts.removeOne(context_id);
@@ -439,6 +460,7 @@ Qtilities::CoreGui::ShortcutCommand::ShortcutCommand(const QString& user_text,
     d->user_text = user_text;
     d->shortcut = shortcut;
     d->active_contexts = active_contexts;
+    setContextMask(active_contexts);
     d->shortcut->setEnabled(false);
 }
 
@@ -501,6 +523,7 @@ void Qtilities::CoreGui::ShortcutCommand::unregisterContext(int context_id) {
         #endif
 
         d->active_contexts.removeOne(context_id);
+        setContextMask(d->active_contexts);
         setCurrentContext(d->active_contexts); // Needed to update d->is_active
     }
 }
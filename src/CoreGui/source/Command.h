@@ -17,6 +17,7 @@
 #include <QShortcut>
 #include <QAction>
 #include <QPointer>
+#include <QBitArray>
 #include <QtilitiesCategory>
 
 #include "QtilitiesCoreGui_global.h"
@@ -31,6 +32,7 @@ namespace Qtilities {
             QKeySequence default_key_sequence;
             QKeySequence current_key_sequence;
             QString default_text;
+            QBitArray context_mask;
         };
 
         /*!
@@ -101,11 +103,24 @@ namespace Qtilities {
             void setCategory(Qtilities::Core::QtilitiesCategory category);
             //! Gets the command's category.
             Qtilities::Core::QtilitiesCategory category() const;
+            //! Returns the contexts for which this command has a backend as a bit array indexed by context ID.
+            /*!
+              The ActionManager uses this mask to only update commands which have a backend in contexts whose state changed.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            QBitArray contextMask() const;
 
         signals:
             void keySequenceChanged();
 
         protected:
+            //! Sets the context mask returned by contextMask() from a list of context IDs. Implementations must call this whenever their contexts change.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void setContextMask(const QList<int>& context_ids);
+
             static int d_category_context;
             CommandPrivateData* c;
         };
@@ -20,6 +20,8 @@
 #include <QScrollArea>
 #include <QAction>
 #include <QToolBar>
+#include <QTimer>
+#include <QSet>
 
 #include <qtvariantproperty.h>
 #include <qtgroupboxpropertybrowser.h>
@@ -51,13 +53,54 @@ struct Qtilities::CoreGui::qti_private_MultiContextPropertyData {
     //! The type of this sub property.
     SubPropertyType             type;
     //! The name of the property on the active object.
-    const char*                 name;
+    QByteArray                  name;
     //! The observer ID for which the value changed in the case of MultiContextProperty properties.
     int                         observer_id;
 };
 
+namespace {
+    //! Describes how a dynamic property is displayed, allowing its value to be updated without inspecting the object again.
+    struct DynamicPropertyRecord {
+        DynamicPropertyRecord() : property(0),
+            type(qti_private_MultiContextPropertyData::Shared),
+            is_normal(true),
+            is_enabled(true) { }
+
+        QtProperty*                                         property;
+        qti_private_MultiContextPropertyData::SubPropertyType type;
+        //! True for properties which are not SharedProperty or MultiContextProperty properties, in which case type is not used.
+        bool                                                is_normal;
+        bool                                                is_enabled;
+        //! The observer IDs of the contexts of MultiContextProperty properties, in the order of context_properties.
+        QList<quint32>                                      context_ids;
+        QList<QtProperty*>                                  context_properties;
+    };
+
+    //! Returns the value displayed for a SharedProperty. Observer IDs of some %Qtilities properties are displayed as observer names.
+    QVariant sharedPropertyDisplayValue(const char* property_name, const QVariant& value) {
+        if (strcmp(property_name,qti_prop_PARENT_ID) && strcmp(property_name,qti_prop_NAME_MANAGER_ID))
+            return value;
+
+        int observer_id = value.toInt();
+        if (observer_id == -1)
+            return QLatin1String("None");
+
+        Observer* obs = OBJECT_MANAGER->observerReference(observer_id);
+        if (obs)
+            return obs->observerName();
+        else
+            return QLatin1String("< Unregistered Observer >");
+    }
+}
+
 struct Qtilities::CoreGui::ObjectDynamicPropertyBrowserPrivateData {
     QList<QtProperty*>                      top_level_properties;
+    //! The displayed dynamic properties, by property name.
+    QMap<QString, DynamicPropertyRecord>    property_records;
+    //! Changes collected since the last processPendingChanges() call:
+    QSet<QByteArray>                        pending_property_names;
+    bool                                    pending_all_properties;
+    bool                                    update_scheduled;
     QMap<QtProperty*, qti_private_MultiContextPropertyData> multi_context_properties;
 
     QtAbstractPropertyBrowser*              property_browser;
@@ -99,6 +142,8 @@ Qtilities::CoreGui::ObjectDynamicPropertyBrowser::ObjectDynamicPropertyBrowser(B
     d->toolbar = 0;
     d->new_property_type = ObjectManager::NonQtilitiesProperties;
     d->read_only = false;
+    d->pending_all_properties = false;
+    d->update_scheduled = false;
 
     if (browser_type == TreeBrowser) {
         QtTreePropertyBrowser* property_browser = new QtTreePropertyBrowser(this);
@@ -150,6 +195,8 @@ void Qtilities::CoreGui::ObjectDynamicPropertyBrowser::clear() {
         d->property_browser->removeProperty(it.next());
     }
     d->top_level_properties.clear();
+    d->property_records.clear();
+    d->multi_context_properties.clear();
 }
 
 void Qtilities::CoreGui::ObjectDynamicPropertyBrowser::setNewPropertyType(ObjectManager::PropertyTypes new_property_type) {
@@ -199,8 +246,10 @@ bool Qtilities::CoreGui::ObjectDynamicPropertyBrowser::eventFilter(QObject *obje
         if (event->type() == QEvent::DynamicPropertyChange) {
             QDynamicPropertyChangeEvent* property_change_event = static_cast<QDynamicPropertyChangeEvent*> (event);
             if (property_change_event) {
-                if (!d->ignore_property_changes_from_object_side)
-                    inspectObject(d->obj);
+                if (!d->ignore_property_changes_from_object_side) {
+                    d->pending_property_names.insert(property_change_event->propertyName());
+                    scheduleUpdate();
+                }
             }
         }
     }
@@ -208,6 +257,112 @@ bool Qtilities::CoreGui::ObjectDynamicPropertyBrowser::eventFilter(QObject *obje
     return false;
 }
 
+void Qtilities::CoreGui::ObjectDynamicPropertyBrowser::scheduleUpdate() {
+    // Bursts of changes are handled once the event loop is reached:
+    if (d->update_scheduled)
+        return;
+
+    d->update_scheduled = true;
+    QTimer::singleShot(0,this,SLOT(processPendingChanges()));
+}
+
+void Qtilities::CoreGui::ObjectDynamicPropertyBrowser::processPendingChanges() {
+    d->update_scheduled = false;
+    QSet<QByteArray> property_names = d->pending_property_names;
+    bool all_properties = d->pending_all_properties;
+    d->pending_property_names.clear();
+    d->pending_all_properties = false;
+
+    if (!d->obj)
+        return;
+
+    if (all_properties) {
+        property_names.clear();
+        QList<QByteArray> dynamic_property_names = d->obj->dynamicPropertyNames();
+        for (int i = 0; i < dynamic_property_names.count(); ++i)
+            property_names.insert(dynamic_property_names.at(i));
+
+        // Properties which were removed do not show up in the list of names:
+        QMapIterator<QString, DynamicPropertyRecord> it(d->property_records);
+        while (it.hasNext()) {
+            it.next();
+            property_names.insert(it.key().toUtf8());
+        }
+    }
+
+    QSetIterator<QByteArray> it(property_names);
+    while (it.hasNext()) {
+        QByteArray property_name = it.next();
+        if (property_name.startsWith("qti.") && !d->show_qtilities_properties)
+            continue;
+
+        // Properties were added or removed, thus the browser must be populated again:
+        if (!updateDynamicProperty(property_name)) {
+            inspectObject(d->obj);
+            return;
+        }
+    }
+}
+
+bool Qtilities::CoreGui::ObjectDynamicPropertyBrowser::updateDynamicProperty(const QByteArray& property_name) {
+    QString name = QString(property_name.constData());
+    QVariant property_variant = d->obj->property(property_name.constData());
+    if (!d->property_records.contains(name))
+        return !property_variant.isValid();
+    if (!property_variant.isValid())
+        return false;
+
+    const DynamicPropertyRecord& record = d->property_records[name];
+    bool updated = true;
+    d->ignore_property_changes_from_browser_side = true;
+    if (property_variant.canConvert<SharedProperty>()) {
+        SharedProperty shared_property = (property_variant.value<SharedProperty>());
+        bool is_enabled = !(shared_property.isReserved() || shared_property.isReadOnly() || d->read_only);
+        if (record.is_normal || record.type != qti_private_MultiContextPropertyData::Shared || record.is_enabled != is_enabled)
+            updated = false;
+        else
+            updated = setPropertyValue(record.property,sharedPropertyDisplayValue(property_name.constData(),shared_property.value()));
+    } else if (property_variant.canConvert<MultiContextProperty>()) {
+        MultiContextProperty multi_context_property = (property_variant.value<MultiContextProperty>());
+        bool is_enabled = !(multi_context_property.isReserved() || multi_context_property.isReadOnly() || d->read_only);
+        QMap<quint32,QVariant> context_map = multi_context_property.contextMap();
+        if (record.is_normal || record.type != qti_private_MultiContextPropertyData::Mixed || record.is_enabled != is_enabled || record.context_ids != context_map.keys())
+            updated = false;
+        else {
+            int s = 0;
+            QMapIterator<quint32,QVariant> context_it(context_map);
+            while (context_it.hasNext() && updated) {
+                context_it.next();
+                QtProperty* sub_property = record.context_properties.at(s++);
+                if (sub_property)
+                    updated = setPropertyValue(sub_property,context_it.value());
+            }
+        }
+    } else {
+        if (!record.is_normal || record.is_enabled != !d->read_only)
+            updated = false;
+        else
+            updated = setPropertyValue(record.property,property_variant);
+    }
+    d->ignore_property_changes_from_browser_side = false;
+
+    return updated;
+}
+
+bool Qtilities::CoreGui::ObjectDynamicPropertyBrowser::setPropertyValue(QtProperty* property, const QVariant& value) {
+    QtVariantPropertyManager* manager = qobject_cast<QtVariantPropertyManager*> (property->propertyManager());
+    if (!manager)
+        return false;
+
+    if (manager->propertyType(property) == value.userType()) {
+        manager->setValue(property,value);
+        return true;
+    }
+
+    // Properties of unsupported types are displayed as "< Unknown Type >", which stays valid as long as the type is unsupported:
+    return !d->property_manager->isPropertyTypeSupported(value.userType());
+}
+
 void Qtilities::CoreGui::ObjectDynamicPropertyBrowser::toggleQtilitiesProperties(bool show_qtilities_properties) {
     if (d->show_qtilities_properties != show_qtilities_properties) {
         d->show_qtilities_properties = show_qtilities_properties;
@@ -248,6 +403,8 @@ void Qtilities::CoreGui::ObjectDynamicPropertyBrowser::setObject(QObject *object
 
     d->obj = object;
     d->monitor_changes = monitor_changes;
+    d->pending_property_names.clear();
+    d->pending_all_properties = false;
     if (!d->obj)
         return;
 
@@ -312,7 +469,7 @@ void Qtilities::CoreGui::ObjectDynamicPropertyBrowser::propertyChangedFromBrowse
                 }
             }
         } else if (prop_data.type == qti_private_MultiContextPropertyData::Mixed) {
-            MultiContextProperty multi_context_property = ObjectManager::getMultiContextProperty(d->obj,prop_data.name);
+            MultiContextProperty multi_context_property = ObjectManager::getMultiContextProperty(d->obj,prop_data.name.constData());
             multi_context_property.setValue(value,prop_data.observer_id);
             if (ObjectManager::setMultiContextProperty(d->obj,multi_context_property) && d->monitor_changes) {
                 // Connect to the IModificationNotifier interface if it exists:
@@ -337,7 +494,7 @@ void Qtilities::CoreGui::ObjectDynamicPropertyBrowser::propertyChangedFromBrowse
         }
     }
 
-    d->ignore_property_changes_from_object_side = true;
+    d->ignore_property_changes_from_object_side = false;
 }
 
 void Qtilities::CoreGui::ObjectDynamicPropertyBrowser::propertyChangedFromObjectSide(bool modified) {
@@ -347,7 +504,8 @@ void Qtilities::CoreGui::ObjectDynamicPropertyBrowser::propertyChangedFromObject
     if (d->ignore_property_changes_from_object_side)
         return;
 
-    refresh();
+    d->pending_all_properties = true;
+    scheduleUpdate();
 }
 
 void Qtilities::CoreGui::ObjectDynamicPropertyBrowser::handleObjectDeleted() {
@@ -378,27 +536,16 @@ void Qtilities::CoreGui::ObjectDynamicPropertyBrowser::inspectObject(const QObje
 
         bool is_enabled = !d->read_only;
         QtProperty *dynamic_property = 0;
+        DynamicPropertyRecord record;
         // If it is MultiContextProperty or SharedProperty then we need to handle it:
         if (property_variant.isValid() && property_variant.canConvert<SharedProperty>()) {
             SharedProperty shared_property = (property_variant.value<SharedProperty>());
             if (shared_property.isReserved() || shared_property.isReadOnly() || d->read_only)
                 is_enabled = false;
-            property_value = shared_property.value();
-
             // We handle some specific Qtilities properties in a special way:
-            if (!strcmp(property_names.at(i).data(),qti_prop_PARENT_ID) ||
-                !strcmp(property_names.at(i).data(),qti_prop_NAME_MANAGER_ID)) {
-                    int observer_id = property_value.toInt();
-                    if (observer_id == -1) {
-                        property_value = QLatin1String("None");
-                    } else {
-                        Observer* obs = OBJECT_MANAGER->observerReference(observer_id);
-                        if (obs)
-                            property_value = obs->observerName();
-                        else
-                            property_value = QLatin1String("< Unregistered Observer >");
-                    }
-            }
+            property_value = sharedPropertyDisplayValue(property_names.at(i).data(),shared_property.value());
+            record.is_normal = false;
+            record.type = qti_private_MultiContextPropertyData::Shared;
 
             // Now add the property:
             if (is_enabled) {
@@ -446,6 +593,8 @@ void Qtilities::CoreGui::ObjectDynamicPropertyBrowser::inspectObject(const QObje
             MultiContextProperty multi_context_property = (property_variant.value<MultiContextProperty>());
             if (multi_context_property.isReserved() || multi_context_property.isReadOnly() || d->read_only)
                 is_enabled = false;
+            record.is_normal = false;
+            record.type = qti_private_MultiContextPropertyData::Mixed;
 
             // Now make a group property with the values for all the different contexts under it:
             dynamic_property = d->property_manager->addProperty(QtVariantPropertyManager::groupTypeId(), property_name);
@@ -484,6 +633,8 @@ void Qtilities::CoreGui::ObjectDynamicPropertyBrowser::inspectObject(const QObje
 
                     }
 
+                    record.context_ids << keys.at(s);
+                    record.context_properties << sub_property;
                     if (sub_property) {
                         dynamic_property->addSubProperty(sub_property);
                         qti_private_MultiContextPropertyData prop_data;
@@ -505,7 +656,10 @@ void Qtilities::CoreGui::ObjectDynamicPropertyBrowser::inspectObject(const QObje
                 else
                     dynamic_property = d->property_manager_read_only->addProperty(property_value.type(), property_name);
                 if (dynamic_property) {
-                    d->property_manager->setValue(dynamic_property,property_value);
+                    if (is_enabled)
+                        d->property_manager->setValue(dynamic_property,property_value);
+                    else
+                        d->property_manager_read_only->setValue(dynamic_property,property_value);
                     d->top_level_properties.append(dynamic_property);
                     d->property_browser->addProperty(dynamic_property);
                 }
@@ -517,6 +671,12 @@ void Qtilities::CoreGui::ObjectDynamicPropertyBrowser::inspectObject(const QObje
                 d->property_browser->addProperty(dynamic_property);
             }
         }
+
+        if (dynamic_property) {
+            record.property = dynamic_property;
+            record.is_enabled = is_enabled;
+            d->property_records[property_name] = record;
+        }
     }
 
     d->ignore_property_changes_from_browser_side = false;
@@ -558,7 +718,7 @@ void Qtilities::CoreGui::ObjectDynamicPropertyBrowser::handleRemoveProperty() {
         // This is an observer property:
         qti_private_MultiContextPropertyData prop_data = d->multi_context_properties[property];
         if (prop_data.type == qti_private_MultiContextPropertyData::Shared) {
-            SharedProperty shared_property = ObjectManager::getSharedProperty(d->obj,prop_data.name);
+            SharedProperty shared_property = ObjectManager::getSharedProperty(d->obj,prop_data.name.constData());
             if (shared_property.isReserved()) {
                 QMessageBox msgBox;
                 msgBox.setIcon(QMessageBox::Information);
@@ -572,12 +732,12 @@ void Qtilities::CoreGui::ObjectDynamicPropertyBrowser::handleRemoveProperty() {
                 msgBox.setText(tr("The selected property is not removable, thus you can't delete it."));
                 msgBox.exec();
             } else {
-                d->obj->setProperty(prop_data.name,QVariant());
+                d->obj->setProperty(prop_data.name.constData(),QVariant());
                 refresh();
                 emit propertyRemoved(property->propertyName());
             }
         } else if (prop_data.type == qti_private_MultiContextPropertyData::Mixed) {
-            MultiContextProperty multi_context_property = ObjectManager::getMultiContextProperty(d->obj,prop_data.name);
+            MultiContextProperty multi_context_property = ObjectManager::getMultiContextProperty(d->obj,prop_data.name.constData());
             if (multi_context_property.isReserved()) {
                 QMessageBox msgBox;
                 msgBox.setIcon(QMessageBox::Information);
@@ -591,7 +751,7 @@ void Qtilities::CoreGui::ObjectDynamicPropertyBrowser::handleRemoveProperty() {
                 msgBox.setText(tr("The selected property is not removable, thus you can't delete it."));
                 msgBox.exec();
             } else {
-                d->obj->setProperty(prop_data.name,QVariant());
+                d->obj->setProperty(prop_data.name.constData(),QVariant());
                 refresh();
                 emit propertyRemoved(property->propertyName());
             }
@@ -142,6 +142,10 @@ namespace Qtilities {
         public slots:
             //! Refresh function which gets all properties on the current object and refreshes the property editor.
             /*!
+              This function populates the browser from scratch. Changes to dynamic properties of monitored objects do not call it: the changed
+              properties are collected and their values are updated the next time the event loop is reached. The browser is only populated
+              again when properties were added or removed.
+
               \sa setObject()
               */
             void refresh();
@@ -182,6 +186,11 @@ namespace Qtilities {
             void handleObjectDeleted();
             void handleAddProperty();
             void handleRemoveProperty();
+            //! Applies all changes collected since the last event loop iteration.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void processPendingChanges();
 
         signals:
             void propertyAdded(const QString& property_name);
@@ -190,6 +199,12 @@ namespace Qtilities {
         private:
             //! Inspect the dynamic properties of an object and add these properties to the property browser.
             void inspectObject(const QObject* obj);
+            //! Schedules processPendingChanges() for the next event loop iteration, unless it is already scheduled.
+            void scheduleUpdate();
+            //! Updates the displayed value of a dynamic property. Returns false when the property must be added, removed or displayed differently, thus when the object must be inspected again.
+            bool updateDynamicProperty(const QByteArray& property_name);
+            //! Sets the value of a displayed property. Returns false when the type of the property does not match the value.
+            bool setPropertyValue(QtProperty* property, const QVariant& value);
 
             ObjectDynamicPropertyBrowserPrivateData* d;
         };
@@ -19,6 +19,9 @@
 
 #include <QMetaObject>
 #include <QMetaProperty>
+#include <QTimer>
+#include <QHash>
+#include <QSet>
 #include <QVBoxLayout>
 #include <QScrollArea>
 #include <qtvariantproperty.h>
@@ -53,12 +56,28 @@ struct Qtilities::CoreGui::ObjectPropertyBrowserPrivateData {
     bool                                    filter_list_inversed;
 
     bool                                    ignore_property_changes;
+
+    //! The browser property of each displayed property of the current object, by property name.
+    QHash<QString, QtVariantProperty *>     map_name_property;
+    //! The indexes of the properties notified by each notify signal of the current object, by signal index.
+    QMultiHash<int, int>                    map_notify_signal_properties;
+    //! Indicates if the QObject class was hidden because the current object has a name manager.
+    bool                                    name_manager_present;
+    //! Changes collected since the last processPendingChanges() call:
+    QSet<int>                               pending_property_indexes;
+    bool                                    pending_unnotified_properties;
+    bool                                    pending_all_properties;
+    bool                                    update_scheduled;
 };
 
 Qtilities::CoreGui::ObjectPropertyBrowser::ObjectPropertyBrowser(BrowserType browser_type, QWidget *parent) : QWidget(parent)
 {
     d = new ObjectPropertyBrowserPrivateData;
     d->ignore_property_changes = false;
+    d->name_manager_present = false;
+    d->pending_unnotified_properties = false;
+    d->pending_all_properties = false;
+    d->update_scheduled = false;
     d->obj = 0;
     d->filter_list_inversed = false;
     d->read_only_properties_disabled = true;
@@ -109,18 +128,15 @@ QtAbstractPropertyBrowser *Qtilities::CoreGui::ObjectPropertyBrowser::abstractPr
 
 void Qtilities::CoreGui::ObjectPropertyBrowser::refresh(bool has_changes) {
     if (d->obj && has_changes) {
-        if (d->obj) {
-            QListIterator<QtProperty *> it(d->top_level_properties);
-            while (it.hasNext()) {
-                d->property_browser->removeProperty(it.next());
-            }
-            d->top_level_properties.clear();
-            d->obj->disconnect(this);
-        }
+        d->pending_all_properties = true;
+        processPendingChanges();
+    }
+}
 
-        d->ignore_property_changes = true;
-        inspectClass(d->obj->metaObject());
-        d->ignore_property_changes = false;
+void Qtilities::CoreGui::ObjectPropertyBrowser::handleModificationStateChanged(bool is_modified) {
+    if (d->obj && is_modified) {
+        d->pending_all_properties = true;
+        scheduleUpdate();
     }
 }
 
@@ -130,12 +146,10 @@ bool Qtilities::CoreGui::ObjectPropertyBrowser::eventFilter(QObject *object, QEv
             QDynamicPropertyChangeEvent* property_change_event = static_cast<QDynamicPropertyChangeEvent*> (event);
             if (property_change_event) {
                 //qDebug() << "Dynamic change event update in ObjectPropertyBrowser: " << property_change_event->propertyName();
-                d->ignore_property_changes = true;
-                refresh(true);
-//                IModificationNotifier* mod_iface = qobject_cast<IModificationNotifier*> (d->obj);
-//                if (mod_iface)
-//                    mod_iface->setModificationState(true);
-                d->ignore_property_changes = false;
+                // Dynamic properties are not shown here, but values of properties without notify signals might have changed along with it.
+                // The name manager property determines if QObject's properties are shown, which is checked in processPendingChanges().
+                d->pending_unnotified_properties = true;
+                scheduleUpdate();
             }
         }
     }
@@ -143,6 +157,147 @@ bool Qtilities::CoreGui::ObjectPropertyBrowser::eventFilter(QObject *object, QEv
     return false;
 }
 
+void Qtilities::CoreGui::ObjectPropertyBrowser::scheduleUpdate() {
+    // Bursts of changes are handled once the event loop is reached:
+    if (d->update_scheduled)
+        return;
+
+    d->update_scheduled = true;
+    QTimer::singleShot(0,this,SLOT(processPendingChanges()));
+}
+
+void Qtilities::CoreGui::ObjectPropertyBrowser::processPendingChanges() {
+    d->update_scheduled = false;
+    QSet<int> property_indexes = d->pending_property_indexes;
+    bool unnotified_properties = d->pending_unnotified_properties;
+    bool all_properties = d->pending_all_properties;
+    d->pending_property_indexes.clear();
+    d->pending_unnotified_properties = false;
+    d->pending_all_properties = false;
+
+    if (!d->obj)
+        return;
+
+    // Properties are only added or removed when the name manager of the object changes:
+    if (d->obj->property(qti_prop_NAME_MANAGER_ID).isValid() != d->name_manager_present) {
+        rebuild();
+        return;
+    }
+
+    d->ignore_property_changes = true;
+    const QMetaObject* metaObject = d->obj->metaObject();
+    if (all_properties)
+        refreshClass(metaObject,true);
+    else {
+        if (unnotified_properties) {
+            for (int idx = 0; idx < metaObject->propertyCount(); ++idx) {
+                if (!metaObject->property(idx).hasNotifySignal())
+                    property_indexes.insert(idx);
+            }
+        }
+
+        QSetIterator<int> it(property_indexes);
+        while (it.hasNext())
+            refreshProperty(metaObject->property(it.next()));
+    }
+    d->ignore_property_changes = false;
+}
+
+void Qtilities::CoreGui::ObjectPropertyBrowser::handlePropertyNotifySignal() {
+    if (sender() != d->obj)
+        return;
+
+    QList<int> property_indexes = d->map_notify_signal_properties.values(senderSignalIndex());
+    if (property_indexes.isEmpty())
+        return;
+
+    for (int i = 0; i < property_indexes.count(); ++i)
+        d->pending_property_indexes.insert(property_indexes.at(i));
+    scheduleUpdate();
+}
+
+void Qtilities::CoreGui::ObjectPropertyBrowser::rebuild() {
+    QListIterator<QtProperty *> it(d->top_level_properties);
+    while (it.hasNext()) {
+        d->property_browser->removeProperty(it.next());
+    }
+    d->top_level_properties.clear();
+
+    if (!d->obj)
+        return;
+
+    d->ignore_property_changes = true;
+    inspectClass(d->obj->metaObject());
+    d->ignore_property_changes = false;
+    updatePropertyMap();
+}
+
+void Qtilities::CoreGui::ObjectPropertyBrowser::updatePropertyMap() {
+    d->map_name_property.clear();
+    if (!d->obj)
+        return;
+
+    d->name_manager_present = d->obj->property(qti_prop_NAME_MANAGER_ID).isValid();
+    const QMetaObject* metaObject = d->obj->metaObject();
+    while (metaObject) {
+        if (d->map_class_property.contains(metaObject) && d->top_level_properties.contains(d->map_class_property.value(metaObject))) {
+            QMap<int, QtVariantProperty *> index_properties = d->map_class_index_property.value(metaObject);
+            QMapIterator<int, QtVariantProperty *> it(index_properties);
+            while (it.hasNext()) {
+                it.next();
+                d->map_name_property[QLatin1String(metaObject->property(it.key()).name())] = it.value();
+            }
+        }
+        metaObject = metaObject->superClass();
+    }
+}
+
+void Qtilities::CoreGui::ObjectPropertyBrowser::connectNotifySignals() {
+    d->map_notify_signal_properties.clear();
+    if (!d->obj)
+        return;
+
+    const QMetaObject* metaObject = d->obj->metaObject();
+    QSet<int> connected_signals;
+    for (int idx = 0; idx < metaObject->propertyCount(); ++idx) {
+        QMetaProperty metaProperty = metaObject->property(idx);
+        if (!metaProperty.hasNotifySignal())
+            continue;
+
+        int signal_index = metaProperty.notifySignalIndex();
+        d->map_notify_signal_properties.insert(signal_index,idx);
+        if (connected_signals.contains(signal_index))
+            continue;
+        connected_signals.insert(signal_index);
+
+        // Notify signals can be emitted from other threads, thus we rely on queued connections in that case:
+        #if QT_VERSION < QT_VERSION_CHECK(5, 0, 0)
+        QByteArray signal_signature = QByteArray::number(QSIGNAL_CODE) + metaProperty.notifySignal().signature();
+        #else
+        QByteArray signal_signature = QByteArray::number(QSIGNAL_CODE) + metaProperty.notifySignal().methodSignature();
+        #endif
+        connect(d->obj,signal_signature.constData(),SLOT(handlePropertyNotifySignal()));
+    }
+}
+
+void Qtilities::CoreGui::ObjectPropertyBrowser::refreshProperty(const QMetaProperty& metaProperty) {
+    if (!metaProperty.isReadable())
+        return;
+
+    QtVariantProperty* subProperty = d->map_name_property.value(QLatin1String(metaProperty.name()));
+    if (!subProperty)
+        return;
+
+    if (metaProperty.isEnumType()) {
+        if (metaProperty.isFlagType())
+            subProperty->setValue(flagToInt(metaProperty.enumerator(), metaProperty.read(d->obj).toInt()));
+        else
+            subProperty->setValue(enumToInt(metaProperty.enumerator(), metaProperty.read(d->obj).toInt()));
+    } else if (d->property_manager->isPropertyTypeSupported(metaProperty.userType())) {
+        subProperty->setValue(metaProperty.read(d->obj));
+    }
+}
+
 void Qtilities::CoreGui::ObjectPropertyBrowser::setObject(QObject *object, bool monitor_changes) {
     if (d->obj == object)
         return;
@@ -154,16 +309,20 @@ void Qtilities::CoreGui::ObjectPropertyBrowser::setObject(QObject *object, bool
         }
         d->top_level_properties.clear();
         d->obj->disconnect(this);
+        d->obj->removeEventFilter(this);
     }
 
     d->obj = object;
+    d->map_name_property.clear();
+    d->map_notify_signal_properties.clear();
+    d->pending_property_indexes.clear();
     if (!d->obj)
         return;
 
     if (monitor_changes) {
         IModificationNotifier* mod_iface = qobject_cast<IModificationNotifier*> (d->obj);
         if (mod_iface)
-            connect(mod_iface->objectBase(),SIGNAL(modificationStateChanged(bool)),SLOT(refresh(bool)));
+            connect(mod_iface->objectBase(),SIGNAL(modificationStateChanged(bool)),SLOT(handleModificationStateChanged(bool)));
 
         // Install an event filter on the object.
         // This will catch property change events as well.
@@ -174,6 +333,9 @@ void Qtilities::CoreGui::ObjectPropertyBrowser::setObject(QObject *object, bool
     d->ignore_property_changes = true;
     inspectClass(d->obj->metaObject());
     d->ignore_property_changes = false;
+    updatePropertyMap();
+    if (monitor_changes)
+        connectNotifySignals();
 }
 
 void Qtilities::CoreGui::ObjectPropertyBrowser::setObject(QPointer<QObject> object, bool monitor_changes) {
@@ -208,8 +370,10 @@ void Qtilities::CoreGui::ObjectPropertyBrowser::setFilterList(QStringList filter
     }
     d->top_level_properties.clear();
 
-    if (d->obj)
+    if (d->obj) {
         inspectClass(d->obj->metaObject());
+        updatePropertyMap();
+    }
 }
 
 QStringList Qtilities::CoreGui::ObjectPropertyBrowser::filterList() const {
@@ -228,8 +392,10 @@ void Qtilities::CoreGui::ObjectPropertyBrowser::clearFilter() {
     }
     d->top_level_properties.clear();
 
-    if (d->obj)
+    if (d->obj) {
         inspectClass(d->obj->metaObject());
+        updatePropertyMap();
+    }
 }
 
 void Qtilities::CoreGui::ObjectPropertyBrowser::setFilterListInversed(bool toggle) {
@@ -247,8 +413,10 @@ void Qtilities::CoreGui::ObjectPropertyBrowser::setFilterListInversed(bool toggl
         }
         d->top_level_properties.clear();
 
-        if (d->obj)
+        if (d->obj) {
             inspectClass(d->obj->metaObject());
+            updatePropertyMap();
+        }
     }
 }
 
@@ -23,6 +23,7 @@
 #include <qtpropertybrowser.h>
 
 class QtProperty;
+class QMetaProperty;
 
 using namespace Qtilities::Core;
 
@@ -114,6 +115,13 @@ namespace Qtilities {
         public slots:
             //! Refresh function which checks all properties on the current object and refreshes the property editor.
             /*!
+              The values of all properties are refreshed before this function returns, together with any changes which were still pending.
+              Properties are only removed and inspected again when the set of properties shown for the object changed.
+
+              Changes notified by the object itself are applied the next time the event loop is reached, thus bursts of notifications are coalesced.
+              Properties with notify signals are refreshed individually when the signals are emitted, and properties without notify signals
+              are refreshed whenever a dynamic property changes on the object.
+
               \sa setObject()
               */
             void refresh(bool has_changes = true);
@@ -151,11 +159,36 @@ namespace Qtilities {
         private slots:
             void handle_property_changed(QtProperty *, const QVariant &);
             void handleObjectDeleted();
+            //! Applies all changes collected since the last event loop iteration.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void processPendingChanges();
+            //! Schedules a refresh of all properties when the object monitored through setObject() became modified.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void handleModificationStateChanged(bool is_modified);
+            //! Collects the property notified by the notify signal which invoked this slot.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void handlePropertyNotifySignal();
 
         private:
             //! Inspect the meta object of a class to see which properties must be added, then add these properties
             void inspectClass(const QMetaObject *metaObject);
             void refreshClass(const QMetaObject *metaObject, bool recursive);
+            //! Schedules processPendingChanges() for the next event loop iteration, unless it is already scheduled.
+            void scheduleUpdate();
+            //! Removes all properties and inspects the current object again.
+            void rebuild();
+            //! Updates the map of displayed properties of the current object after it was inspected.
+            void updatePropertyMap();
+            //! Connects to the notify signals of the properties of the current object.
+            void connectNotifySignals();
+            //! Refreshes the value of a single property of the current object.
+            void refreshProperty(const QMetaProperty& metaProperty);
             int enumToInt(const QMetaEnum &metaEnum, int enumValue) const;
             int intToEnum(const QMetaEnum &metaEnum, int intValue) const;
             int flagToInt(const QMetaEnum &metaEnum, int flagValue) const;
@@ -0,0 +1,619 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#include "ObserverSearchIndex.h"
+#include "ObserverTreeModel.h"
+#include "ObserverTableModel.h"
+#include "ObserverTreeItem.h"
+
+#include <QtilitiesCoreConstants>
+#include <QtilitiesCategory>
+#include <Observer>
+
+#include <QAbstractItemModel>
+#include <QPointer>
+#include <QVector>
+#include <QHash>
+#include <QSet>
+#include <QTimer>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QThreadPool>
+#include <QRunnable>
+#include <QRegExp>
+#include <QAtomicInt>
+#include <QtAlgorithms>
+
+using namespace Qtilities::Core::Properties;
+using namespace Qtilities::Core;
+using namespace Qtilities::CoreGui;
+
+namespace {
+    //! The number of items evaluated by a search job between checks for cancellation and progress reports.
+    const int search_chunk_size = 8192;
+
+    //! A single item in the index.
+    struct ObserverSearchEntry {
+        ObserverSearchEntry() : key(0) { }
+
+        quintptr    key;
+        QString     name;
+        QString     folded_name;
+        QString     category;
+        QString     folded_category;
+    };
+
+    //! A query evaluated against index entries.
+    struct ObserverSearchQuery {
+        ObserverSearchQuery() : match_mode(ObserverSearchIndex::SubstringMatch),
+            case_sensitivity(Qt::CaseInsensitive),
+            search_fields(ObserverSearchIndex::SearchNames) { }
+
+        //! Prepares the query for matching. Must be called on the thread which calls matches() since QRegExp is not thread safe.
+        void prepare() {
+            folded_text = text.toLower();
+            if (match_mode == ObserverSearchIndex::WildcardMatch)
+                reg_exp = QRegExp(text,case_sensitivity,QRegExp::Wildcard);
+            else if (match_mode == ObserverSearchIndex::RegExpMatch)
+                reg_exp = QRegExp(text,case_sensitivity,QRegExp::RegExp);
+            else
+                reg_exp = QRegExp();
+        }
+
+        bool matchesText(const QString& value, const QString& folded_value) const {
+            if (match_mode == ObserverSearchIndex::PrefixMatch) {
+                if (case_sensitivity == Qt::CaseSensitive)
+                    return value.startsWith(text);
+                return folded_value.startsWith(folded_text);
+            } else if (match_mode == ObserverSearchIndex::SubstringMatch) {
+                if (case_sensitivity == Qt::CaseSensitive)
+                    return value.contains(text);
+                return folded_value.contains(folded_text);
+            }
+            return reg_exp.indexIn(value) != -1;
+        }
+
+        bool matches(const ObserverSearchEntry& entry) const {
+            if ((search_fields & ObserverSearchIndex::SearchNames) && matchesText(entry.name,entry.folded_name))
+                return true;
+            if ((search_fields & ObserverSearchIndex::SearchCategories) && matchesText(entry.category,entry.folded_category))
+                return true;
+            return false;
+        }
+
+        //! Returns true when every item matching this query is guaranteed to match \p previous as well.
+        bool narrows(const ObserverSearchQuery& previous) const {
+            if (previous.text.isEmpty() || match_mode != previous.match_mode || case_sensitivity != previous.case_sensitivity || search_fields != previous.search_fields)
+                return false;
+
+            const QString& current_text = (case_sensitivity == Qt::CaseSensitive) ? text : folded_text;
+            const QString& previous_text = (case_sensitivity == Qt::CaseSensitive) ? previous.text : previous.folded_text;
+            if (match_mode == ObserverSearchIndex::PrefixMatch)
+                return current_text.startsWith(previous_text);
+            else if (match_mode == ObserverSearchIndex::SubstringMatch)
+                return current_text.contains(previous_text);
+            else if (match_mode == ObserverSearchIndex::WildcardMatch) {
+                // A match of a pattern extended at its end always contains a match of the original pattern, except
+                // when the original pattern ended inside a set.
+                return previous.reg_exp.isValid() && !previous_text.contains(QLatin1Char('[')) && current_text.startsWith(previous_text);
+            }
+            return false;
+        }
+
+        QString                                 text;
+        QString                                 folded_text;
+        ObserverSearchIndex::MatchMode          match_mode;
+        Qt::CaseSensitivity                     case_sensitivity;
+        ObserverSearchIndex::SearchFields       search_fields;
+        QRegExp                                 reg_exp;
+    };
+
+    //! Results handed from a search job to the index. Everything is protected by lock.
+    struct ObserverSearchOutput {
+        ObserverSearchOutput() : generation(0),
+            processed_count(0),
+            finished(false) { }
+
+        QMutex              lock;
+        int                 generation;
+        QVector<quintptr>   matches;
+        int                 processed_count;
+        bool                finished;
+    };
+
+    //! Evaluates a query against a snapshot of the index on the index's thread pool.
+    class ObserverSearchJob : public QRunnable {
+    public:
+        ObserverSearchJob(QObject* receiver, QAtomicInt* current_generation, ObserverSearchOutput* output, int generation,
+                          const ObserverSearchQuery& query, const QVector<ObserverSearchEntry>& entries,
+                          const QVector<int>& candidates, bool use_candidates) : d_receiver(receiver),
+            d_current_generation(current_generation),
+            d_output(output),
+            d_generation(generation),
+            d_query(query),
+            d_entries(entries),
+            d_candidates(candidates),
+            d_use_candidates(use_candidates) { }
+
+        void run() {
+            // Work on a local copy: QRegExp stores match state and is not safe to share between threads.
+            ObserverSearchQuery query;
+            query.text = d_query.text;
+            query.match_mode = d_query.match_mode;
+            query.case_sensitivity = d_query.case_sensitivity;
+            query.search_fields = d_query.search_fields;
+            query.prepare();
+
+            const int total = d_use_candidates ? d_candidates.count() : d_entries.count();
+            QVector<quintptr> chunk_matches;
+            int processed = 0;
+            do {
+                const int chunk_end = qMin(total,processed + search_chunk_size);
+                for (int i = processed; i < chunk_end; ++i) {
+                    const ObserverSearchEntry& entry = d_entries.at(d_use_candidates ? d_candidates.at(i) : i);
+                    if (query.matches(entry))
+                        chunk_matches << entry.key;
+                }
+                processed = chunk_end;
+
+                // Stop when a newer query was started or the query was cancelled:
+                if (d_current_generation->fetchAndAddOrdered(0) != d_generation)
+                    return;
+
+                {
+                    QMutexLocker locker(&d_output->lock);
+                    if (d_output->generation != d_generation)
+                        return;
+                    d_output->matches += chunk_matches;
+                    d_output->processed_count = processed;
+                    d_output->finished = (processed == total);
+                }
+                chunk_matches.clear();
+                QMetaObject::invokeMethod(d_receiver,"handleSearchProgress",Qt::QueuedConnection,Q_ARG(int,d_generation));
+            } while (processed < total);
+        }
+
+    private:
+        QObject*                        d_receiver;
+        QAtomicInt*                     d_current_generation;
+        ObserverSearchOutput*           d_output;
+        int                             d_generation;
+        ObserverSearchQuery             d_query;
+        QVector<ObserverSearchEntry>    d_entries;
+        QVector<int>                    d_candidates;
+        bool                            d_use_candidates;
+    };
+}
+
+struct Qtilities::CoreGui::ObserverSearchIndexPrivateData {
+    ObserverSearchIndexPrivateData() : observer_model(0),
+        tree_model(0),
+        table_model(0),
+        search_fields(ObserverSearchIndex::SearchNames),
+        dirty(true),
+        stale(false),
+        results_indexed(false),
+        search_running(false) { }
+
+    QPointer<QAbstractItemModel>        model;
+    AbstractObserverItemModel*          observer_model;
+    ObserverTreeModel*                  tree_model;
+    ObserverTableModel*                 table_model;
+    ObserverSearchIndex::SearchFields   search_fields;
+
+    QVector<ObserverSearchEntry>        entries;
+    QHash<quintptr,int>                 entry_slots;
+    //! Indicates that the index was not built yet. Incremental updates are skipped until it is built.
+    bool                                dirty;
+    //! Indicates that entries might contain items which are no longer in the model, or lack categories.
+    bool                                stale;
+
+    //! The query requested through search(), evaluated once the debounce timer fires.
+    ObserverSearchQuery                 requested_query;
+    //! The query evaluated by the running search job.
+    ObserverSearchQuery                 running_query;
+    QSet<quintptr>                      running_results;
+    //! Keys of entries which changed while a search job was running.
+    QSet<quintptr>                      changed_while_running;
+    //! The query of which the results are available through matches().
+    ObserverSearchQuery                 results_query;
+    QSet<quintptr>                      results;
+    //! Indicates if results contains the matches of results_query for all indexed entries.
+    bool                                results_indexed;
+    bool                                search_running;
+
+    QTimer                              debounce_timer;
+    QThreadPool                         pool;
+    QAtomicInt                          generation;
+    ObserverSearchOutput                output;
+};
+
+namespace {
+    //! Creates the index entry for the item at \p index, which must be in the name column.
+    ObserverSearchEntry createSearchEntry(ObserverSearchIndexPrivateData* d, const QModelIndex& index, quintptr key, bool include_category) {
+        ObserverSearchEntry entry;
+        entry.key = key;
+        entry.name = d->model->data(index,Qt::DisplayRole).toString();
+        entry.folded_name = entry.name.toLower();
+        if (!include_category)
+            return entry;
+
+        if (d->tree_model) {
+            // Items get the category of the category item they are grouped under:
+            ObserverTreeItem* item = d->tree_model->getItem(index);
+            while (item) {
+                if (item->itemType() == ObserverTreeItem::CategoryItem) {
+                    entry.category = item->category().toString();
+                    break;
+                }
+                item = item->parentItem();
+                if (item && item->itemType() == ObserverTreeItem::TreeNode)
+                    break;
+            }
+        } else if (d->table_model && d->table_model->observerContext() && key) {
+            QVariant category_variant = d->table_model->observerContext()->getMultiContextPropertyValue(reinterpret_cast<QObject*> (key),qti_prop_CATEGORY_MAP);
+            entry.category = category_variant.value<QtilitiesCategory>().toString();
+        }
+        entry.folded_category = entry.category.toLower();
+        return entry;
+    }
+}
+
+Qtilities::CoreGui::ObserverSearchIndex::ObserverSearchIndex(QObject* parent) : QObject(parent) {
+    d = new ObserverSearchIndexPrivateData;
+
+    // Queries must be evaluated in order, a single thread is enough:
+    d->pool.setMaxThreadCount(1);
+    d->debounce_timer.setSingleShot(true);
+    d->debounce_timer.setInterval(150);
+    connect(&d->debounce_timer,SIGNAL(timeout()),SLOT(startSearch()));
+}
+
+Qtilities::CoreGui::ObserverSearchIndex::~ObserverSearchIndex() {
+    cancel();
+    d->pool.waitForDone();
+    delete d;
+}
+
+void Qtilities::CoreGui::ObserverSearchIndex::setSourceModel(QAbstractItemModel* model) {
+    if (d->model == model)
+        return;
+
+    cancel();
+    if (d->model)
+        d->model->disconnect(this);
+
+    d->model = model;
+    d->observer_model = dynamic_cast<AbstractObserverItemModel*> (model);
+    d->tree_model = qobject_cast<ObserverTreeModel*> (model);
+    d->table_model = qobject_cast<ObserverTableModel*> (model);
+    d->entries.clear();
+    d->entry_slots.clear();
+    d->dirty = true;
+    d->results.clear();
+    d->results_indexed = false;
+
+    if (model) {
+        connect(model,SIGNAL(rowsInserted(QModelIndex,int,int)),SLOT(handleRowsInserted(QModelIndex,int,int)));
+        connect(model,SIGNAL(rowsRemoved(QModelIndex,int,int)),SLOT(handleRowsRemoved()));
+        connect(model,SIGNAL(dataChanged(QModelIndex,QModelIndex)),SLOT(handleDataChanged(QModelIndex,QModelIndex)));
+        connect(model,SIGNAL(layoutChanged()),SLOT(handleLayoutChanged()));
+        connect(model,SIGNAL(modelReset()),SLOT(handleLayoutChanged()));
+        connect(model,SIGNAL(destroyed()),SLOT(handleLayoutChanged()));
+    }
+
+    // Evaluate the active query against the new model:
+    if (!d->results_query.text.isEmpty()) {
+        d->requested_query = d->results_query;
+        d->debounce_timer.start();
+    }
+}
+
+QAbstractItemModel* Qtilities::CoreGui::ObserverSearchIndex::sourceModel() const {
+    return d->model;
+}
+
+void Qtilities::CoreGui::ObserverSearchIndex::setSearchFields(SearchFields search_fields) {
+    if (d->search_fields == search_fields)
+        return;
+
+    d->search_fields = search_fields;
+    // Categories are only indexed when they are searched:
+    if (search_fields & SearchCategories)
+        d->stale = true;
+}
+
+Qtilities::CoreGui::ObserverSearchIndex::SearchFields Qtilities::CoreGui::ObserverSearchIndex::searchFields() const {
+    return d->search_fields;
+}
+
+void Qtilities::CoreGui::ObserverSearchIndex::setDebounceInterval(int msec) {
+    d->debounce_timer.setInterval(msec);
+}
+
+int Qtilities::CoreGui::ObserverSearchIndex::debounceInterval() const {
+    return d->debounce_timer.interval();
+}
+
+void Qtilities::CoreGui::ObserverSearchIndex::search(const QString& query, MatchMode match_mode, Qt::CaseSensitivity case_sensitivity) {
+    ObserverSearchQuery new_query;
+    new_query.text = query;
+    new_query.match_mode = match_mode;
+    new_query.case_sensitivity = case_sensitivity;
+    new_query.search_fields = d->search_fields;
+    new_query.prepare();
+    d->requested_query = new_query;
+
+    if (query.isEmpty()) {
+        cancel();
+        d->results_query = new_query;
+        d->results.clear();
+        d->results_indexed = false;
+        emit searchCompleted(0);
+        return;
+    }
+
+    d->debounce_timer.start();
+}
+
+void Qtilities::CoreGui::ObserverSearchIndex::cancel() {
+    d->debounce_timer.stop();
+    d->generation.fetchAndAddOrdered(1);
+    d->search_running = false;
+    d->running_results.clear();
+    d->changed_while_running.clear();
+}
+
+bool Qtilities::CoreGui::ObserverSearchIndex::isSearchActive() const {
+    return !d->results_query.text.isEmpty();
+}
+
+bool Qtilities::CoreGui::ObserverSearchIndex::isSearching() const {
+    return d->search_running || d->debounce_timer.isActive();
+}
+
+QString Qtilities::CoreGui::ObserverSearchIndex::currentQuery() const {
+    return d->results_query.text;
+}
+
+int Qtilities::CoreGui::ObserverSearchIndex::matchCount() const {
+    return d->results.count();
+}
+
+int Qtilities::CoreGui::ObserverSearchIndex::indexedCount() const {
+    return d->entries.count();
+}
+
+bool Qtilities::CoreGui::ObserverSearchIndex::matches(const QModelIndex& source_index) const {
+    if (d->results_query.text.isEmpty())
+        return true;
+
+    const quintptr key = keyForIndex(source_index);
+    if (d->results_indexed) {
+        if (d->results.contains(key))
+            return true;
+        if (d->entry_slots.contains(key))
+            return false;
+    }
+
+    // The item is not indexed yet, thus we match it directly:
+    QModelIndex name_index = source_index.sibling(source_index.row(),d->observer_model ? qMax(0,d->observer_model->columnPosition(AbstractObserverItemModel::ColumnName)) : 0);
+    return d->results_query.matches(createSearchEntry(d,name_index,key,d->results_query.search_fields & SearchCategories));
+}
+
+void Qtilities::CoreGui::ObserverSearchIndex::startSearch() {
+    d->generation.fetchAndAddOrdered(1);
+    d->running_results.clear();
+    d->changed_while_running.clear();
+
+    if (!d->model) {
+        d->search_running = false;
+        d->results_query = d->requested_query;
+        d->results.clear();
+        d->results_indexed = true;
+        emit searchCompleted(0);
+        return;
+    }
+
+    rebuild();
+
+    // Narrow from the previous results when possible:
+    QVector<int> candidates;
+    bool use_candidates = false;
+    if (d->results_indexed && d->requested_query.narrows(d->results_query)) {
+        use_candidates = true;
+        candidates.reserve(d->results.count());
+        QSet<quintptr>::const_iterator it = d->results.constBegin();
+        while (it != d->results.constEnd()) {
+            int slot = d->entry_slots.value(*it,-1);
+            if (slot != -1)
+                candidates << slot;
+            ++it;
+        }
+        qSort(candidates);
+    }
+
+    const int generation = d->generation.fetchAndAddOrdered(1) + 1;
+    {
+        QMutexLocker locker(&d->output.lock);
+        d->output.generation = generation;
+        d->output.matches.clear();
+        d->output.processed_count = 0;
+        d->output.finished = false;
+    }
+
+    d->running_query = d->requested_query;
+    d->search_running = true;
+    d->pool.start(new ObserverSearchJob(this,&d->generation,&d->output,generation,d->running_query,d->entries,candidates,use_candidates));
+}
+
+void Qtilities::CoreGui::ObserverSearchIndex::handleSearchProgress(int generation) {
+    if (generation != d->generation.fetchAndAddOrdered(0))
+        return;
+
+    QVector<quintptr> new_matches;
+    int processed_count = 0;
+    bool finished = false;
+    {
+        QMutexLocker locker(&d->output.lock);
+        if (d->output.generation != generation)
+            return;
+        new_matches = d->output.matches;
+        d->output.matches.clear();
+        processed_count = d->output.processed_count;
+        finished = d->output.finished;
+        // Progress notifications which are still queued must not complete the search again:
+        if (finished)
+            d->output.generation = 0;
+    }
+
+    for (int i = 0; i < new_matches.count(); ++i)
+        d->running_results.insert(new_matches.at(i));
+
+    if (!finished) {
+        emit partialResultsAvailable(processed_count,d->running_results.count());
+        return;
+    }
+
+    d->results = d->running_results;
+    d->results_query = d->running_query;
+    d->results_indexed = true;
+    d->running_results.clear();
+    d->search_running = false;
+
+    // Entries which changed while the job was running were evaluated against an outdated snapshot:
+    QSet<quintptr>::const_iterator it = d->changed_while_running.constBegin();
+    while (it != d->changed_while_running.constEnd()) {
+        int slot = d->entry_slots.value(*it,-1);
+        if (slot != -1 && d->results_query.matches(d->entries.at(slot)))
+            d->results.insert(*it);
+        else
+            d->results.remove(*it);
+        ++it;
+    }
+    d->changed_while_running.clear();
+
+    emit searchCompleted(d->results.count());
+}
+
+void Qtilities::CoreGui::ObserverSearchIndex::handleLayoutChanged() {
+    // Items in the model might be completely different, thus we start over:
+    d->entries.clear();
+    d->entry_slots.clear();
+    d->dirty = true;
+    d->stale = false;
+    d->results.clear();
+    d->results_indexed = false;
+
+    if (d->search_running || !d->results_query.text.isEmpty()) {
+        if (!d->debounce_timer.isActive())
+            d->requested_query = d->search_running ? d->running_query : d->results_query;
+        d->generation.fetchAndAddOrdered(1);
+        d->search_running = false;
+        d->debounce_timer.start();
+    }
+}
+
+void Qtilities::CoreGui::ObserverSearchIndex::handleRowsInserted(const QModelIndex& parent, int first, int last) {
+    // The index is built lazily, nothing to do until then:
+    if (d->dirty)
+        return;
+
+    if (indexRows(parent,first,last,true))
+        emit matchesChanged(parent,first,last);
+}
+
+void Qtilities::CoreGui::ObserverSearchIndex::handleRowsRemoved() {
+    // We cannot rely on the removed items being accessible at this point (ObserverTableModel for example
+    // removes rows after the subjects were removed from its observer). Entries of removed items do no harm
+    // until the index is rebuilt before the next query.
+    if (!d->dirty)
+        d->stale = true;
+}
+
+void Qtilities::CoreGui::ObserverSearchIndex::handleDataChanged(const QModelIndex& top_left, const QModelIndex& bottom_right) {
+    if (d->dirty || !top_left.isValid() || !bottom_right.isValid())
+        return;
+
+    if (indexRows(top_left.parent(),top_left.row(),bottom_right.row(),false))
+        emit matchesChanged(top_left.parent(),top_left.row(),bottom_right.row());
+}
+
+quintptr Qtilities::CoreGui::ObserverSearchIndex::keyForIndex(const QModelIndex& index) const {
+    // Rows in table models shift, thus we identify them by their objects:
+    if (d->table_model)
+        return (quintptr) d->table_model->getObject(index.row());
+    return (quintptr) index.internalId();
+}
+
+bool Qtilities::CoreGui::ObserverSearchIndex::indexRows(const QModelIndex& parent, int first, int last, bool recursive) {
+    if (!d->model)
+        return false;
+
+    const int name_column = d->observer_model ? d->observer_model->columnPosition(AbstractObserverItemModel::ColumnName) : 0;
+    const bool update_results = d->results_indexed && !d->results_query.text.isEmpty();
+    bool matches_changed = false;
+
+    for (int row = first; row <= last; ++row) {
+        QModelIndex index = d->model->index(row,qMax(0,name_column),parent);
+        if (!index.isValid())
+            continue;
+
+        ObserverSearchEntry entry = createSearchEntry(d,index,keyForIndex(index),d->search_fields & SearchCategories);
+
+        int slot = d->entry_slots.value(entry.key,-1);
+        if (slot == -1) {
+            d->entry_slots[entry.key] = d->entries.count();
+            d->entries.append(entry);
+        } else
+            d->entries[slot] = entry;
+
+        if (update_results) {
+            const bool was_match = d->results.contains(entry.key);
+            const bool is_match = d->results_query.matches(entry);
+            if (was_match != is_match) {
+                if (is_match)
+                    d->results.insert(entry.key);
+                else
+                    d->results.remove(entry.key);
+                matches_changed = true;
+            }
+        }
+        if (d->search_running)
+            d->changed_while_running.insert(entry.key);
+
+        if (recursive) {
+            QModelIndex child_parent = index.sibling(row,0);
+            int child_count = d->model->rowCount(child_parent);
+            if (child_count > 0 && indexRows(child_parent,0,child_count - 1,true))
+                matches_changed = true;
+        }
+    }
+
+    return matches_changed;
+}
+
+void Qtilities::CoreGui::ObserverSearchIndex::rebuild() {
+    if ((!d->dirty && !d->stale) || !d->model)
+        return;
+
+    d->entries.clear();
+    d->entry_slots.clear();
+    // Results are kept: they are only used for items which are still in the model.
+    const bool results_indexed = d->results_indexed;
+    d->results_indexed = false;
+    int row_count = d->model->rowCount();
+    if (row_count > 0)
+        indexRows(QModelIndex(),0,row_count - 1,true);
+    d->results_indexed = results_indexed;
+    d->dirty = false;
+    d->stale = false;
+}
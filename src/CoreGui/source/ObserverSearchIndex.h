@@ -0,0 +1,160 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#ifndef OBSERVER_SEARCH_INDEX_H
+#define OBSERVER_SEARCH_INDEX_H
+
+#include "QtilitiesCoreGui_global.h"
+
+#include <QObject>
+#include <QModelIndex>
+
+class QAbstractItemModel;
+
+namespace Qtilities {
+    namespace CoreGui {
+        /*!
+        \struct ObserverSearchIndexPrivateData
+        \brief Structure used by ObserverSearchIndex to store private data.
+          */
+        struct ObserverSearchIndexPrivateData;
+
+        /*!
+        \class ObserverSearchIndex
+        \brief The ObserverSearchIndex class provides an incremental search index over the items shown by ObserverTreeModel and ObserverTableModel.
+
+        Filtering large observer trees by setting a pattern on a QSortFilterProxyModel means that every key stroke matches the pattern against
+        the display string of every row on the GUI thread. ObserverSearchIndex avoids this by:
+        - Keeping an index of the display names (and optionally the categories) of all items in a source model. The index is updated
+          incrementally when rows are inserted or their data changes, and rebuilt lazily when the layout of the model changes.
+        - Running queries on a background thread. Query changes are debounced (see setDebounceInterval()), and starting a new query
+          cancels a query which is still running.
+        - Narrowing the previous result when a query extends the previous query, for example when typing more characters of a prefix or
+          substring query. Only the items which matched the previous query are evaluated in that case.
+
+        The proxy filters used by ObserverWidget (ObserverTreeModelProxyFilter and ObserverTableModelProxyFilter) use an index when one is set
+        on them through their setSearchIndex() functions. The filters consult matches() for each row, which is a hash lookup. Once a query
+        completed, searchCompleted() is emitted and the proxy filter must be invalidated. While a query runs, partialResultsAvailable()
+        reports the progress of the query, and matches() keeps returning the results of the previous completed query. When the matches of
+        indexed items change through incremental updates, matchesChanged() reports the affected rows and the proxy filters filter only those
+        rows again.
+
+        <i>This class was added in %Qtilities v1.5.</i>
+          */
+        class QTILITIES_CORE_GUI_SHARED_EXPORT ObserverSearchIndex : public QObject
+        {
+            Q_OBJECT
+            Q_ENUMS(MatchMode)
+            Q_FLAGS(SearchFields)
+
+        public:
+            //! The ways in which queries can be matched against indexed items.
+            enum MatchMode {
+                PrefixMatch,        /*!< Items starting with the query match. */
+                SubstringMatch,     /*!< Items containing the query match. */
+                WildcardMatch,      /*!< Items containing a match of the query as a wildcard pattern match. */
+                RegExpMatch         /*!< Items containing a match of the query as a regular expression match. Results are never narrowed for this mode. */
+            };
+            //! The fields of items which are searched.
+            enum SearchField {
+                SearchNames         = 1, /*!< The display names of items are searched. */
+                SearchCategories    = 2  /*!< The categories of items are searched. */
+            };
+            Q_DECLARE_FLAGS(SearchFields, SearchField)
+
+            ObserverSearchIndex(QObject* parent = 0);
+            virtual ~ObserverSearchIndex();
+
+            //! Sets the source model to index. This should be the source model of the proxy filter using the index.
+            /*!
+              Setting the model which is already indexed does nothing.
+              */
+            void setSourceModel(QAbstractItemModel* model);
+            //! Gets the source model which is indexed.
+            QAbstractItemModel* sourceModel() const;
+            //! Sets the fields which are searched. By default only SearchNames is searched.
+            void setSearchFields(SearchFields search_fields);
+            //! Gets the fields which are searched.
+            SearchFields searchFields() const;
+            //! Sets the debounce interval used by search() in milliseconds. The default is 150 ms.
+            void setDebounceInterval(int msec);
+            //! Gets the debounce interval used by search() in milliseconds.
+            int debounceInterval() const;
+
+            //! Starts a query after the debounce interval passed.
+            /*!
+              Calling this function again within the debounce interval restarts the interval. An empty \p query clears the current
+              query immediately, in which case searchCompleted() is emitted directly.
+              */
+            void search(const QString& query, MatchMode match_mode = SubstringMatch, Qt::CaseSensitivity case_sensitivity = Qt::CaseInsensitive);
+            //! Cancels any pending or running query. The results of the previous completed query remain available.
+            void cancel();
+            //! Indicates if a non-empty query is set.
+            bool isSearchActive() const;
+            //! Indicates if a query is pending or running.
+            bool isSearching() const;
+            //! Returns the query of which the results are currently available through matches().
+            QString currentQuery() const;
+            //! Returns the number of items matching the last completed query.
+            int matchCount() const;
+            //! Returns the number of items in the index.
+            int indexedCount() const;
+
+            //! Indicates if the item at \p source_index in the source model matches the last completed query.
+            /*!
+              When no query is active, all items match. Items which are not in the index yet are matched directly.
+              */
+            bool matches(const QModelIndex& source_index) const;
+
+        signals:
+            //! Signal which is emitted while a query runs.
+            /*!
+              \param processed_count The number of items evaluated so far.
+              \param match_count The number of matches found so far.
+              */
+            void partialResultsAvailable(int processed_count, int match_count);
+            //! Signal which is emitted when a query completed, or when it was cleared. Proxy filters using this index must be invalidated.
+            void searchCompleted(int match_count);
+            //! Signal which is emitted when incremental index updates changed which items match the current query.
+            /*!
+              \param source_parent The parent in the source model of the rows of which the matches changed.
+              \param first The first row of which the matches might have changed.
+              \param last The last row of which the matches might have changed.
+
+              Only these rows must be filtered again by proxy filters using this index. Children of rows inserted in the source model
+              are matched directly until they are indexed, thus proxy filters get their matches right when the rows are inserted.
+              */
+            void matchesChanged(const QModelIndex& source_parent, int first, int last);
+
+        private slots:
+            void startSearch();
+            void handleSearchProgress(int generation);
+            void handleLayoutChanged();
+            void handleRowsInserted(const QModelIndex& parent, int first, int last);
+            void handleRowsRemoved();
+            void handleDataChanged(const QModelIndex& top_left, const QModelIndex& bottom_right);
+
+        private:
+            //! Returns the key used to identify the item at \p index in the index.
+            quintptr keyForIndex(const QModelIndex& index) const;
+            //! Adds or updates the rows \p first to \p last under \p parent, and all their children when \p recursive is true. Returns true if the matches changed.
+            bool indexRows(const QModelIndex& parent, int first, int last, bool recursive);
+            //! Rebuilds the complete index when it is out of date.
+            void rebuild();
+
+            ObserverSearchIndexPrivateData* d;
+        };
+
+        Q_DECLARE_OPERATORS_FOR_FLAGS(ObserverSearchIndex::SearchFields)
+    }
+}
+
+#endif // OBSERVER_SEARCH_INDEX_H
@@ -28,15 +28,32 @@ using namespace Qtilities::Core::Properties;
 using namespace Qtilities::Core;
 using namespace Qtilities::Core::Constants;
 
+struct Qtilities::CoreGui::ObserverTableModelRowRecord {
+    ObserverTableModelRowRecord() : subject_id(-1),
+        valid(false) { }
+
+    QPointer<QObject>   object;
+    int                 subject_id;
+    QString             type_info;
+    bool                valid;
+};
+
 struct Qtilities::CoreGui::ObserverTableModelData {
     ObserverTableModelData() : type_grouping_name(QString()),
         read_only(false),
-        fetch_count(0) { }
+        fetch_count(0),
+        missed_changes(false) { }
 
     QString     type_grouping_name;
     bool        read_only;
     int         fetch_count;
     QList<QPointer<QObject> > selected_objects;
+    //! Records of rows, built on demand in rowRecord().
+    QVector<ObserverTableModelRowRecord> row_records;
+    //! The subjects in the observer context according to the changes handled by this model.
+    QList<QPointer<QObject> > tracked_subjects;
+    //! Indicates if change sets were received which the model could not apply.
+    bool        missed_changes;
 };
 
 #define fetch_limit 1000
@@ -67,9 +84,14 @@ bool Qtilities::CoreGui::ObserverTableModel::setObserverContext(Observer* observ
         return false;
 
     d->fetch_count = 0;
-    connect(d_observer,SIGNAL(numberOfSubjectsChanged(Observer::SubjectChangeIndication, QList<QPointer<QObject> >)),SLOT(handleLayoutChanged()));
+    connect(d_observer,SIGNAL(numberOfSubjectsChanged(Observer::SubjectChangeIndication, QList<QPointer<QObject> >)),SLOT(handleNumberOfSubjectsChanged()));
+    connect(d_observer,SIGNAL(processingCycleEnded()),SLOT(handleProcessingCycleEnded()));
+    if (!connect(d_observer,SIGNAL(subjectsChanged(Qtilities::Core::ObserverChangeSet)),SLOT(handleSubjectsChanged(Qtilities::Core::ObserverChangeSet))))
+        qWarning() << "ObserverTableModel failed to connect to the subjectsChanged() signal of observer" << d_observer->observerName() << ". The model will only refresh completely on changes.";
     connect(d_observer,SIGNAL(destroyed()),SLOT(handleLayoutChanged()));
     connect(d_observer,SIGNAL(dataChanged()),SLOT(handleDataChanged()));
+    // The layoutChanged() signal of the observer is deliberately not connected: layout refreshes such as category
+    // changes do not change the rows of a flat table, and the affected rows are updated from change sets.
 
     // Check if this observer has a subject type filter installed
     for (int i = 0; i < observer->subjectFilters().count(); ++i) {
@@ -169,70 +191,51 @@ QVariant Qtilities::CoreGui::ObserverTableModel::data(const QModelIndex &index,
         return QVariant();
 
     // ------------------------------------
-    // Return nothing for columns which should not be displayed
+    // Columns which should not be displayed are mapped to ColumnLast by columnHandler().
     // We hide them in Observer Widget, but during initialize
     // the model is built before we get to a place where we can hide the
     // columns. Thus, the info is called on all models at least once
-    // before we can hide it. Thus we filter it here:
+    // before we can hide it.
     // ------------------------------------
-    if (index.column() == columnPosition(AbstractObserverItemModel::ColumnName)) {
-        if (!(activeHints()->itemViewColumnHint() & ObserverHints::ColumnNameHint))
-            return QVariant();
-    }
-    if (index.column() == columnPosition(AbstractObserverItemModel::ColumnChildCount)) {
-        if (!(activeHints()->itemViewColumnHint() & ObserverHints::ColumnChildCountHint))
-            return QVariant();
-    }
-    if (index.column() == columnPosition(AbstractObserverItemModel::ColumnAccess)) {
-        if (!(activeHints()->itemViewColumnHint() & ObserverHints::ColumnAccessHint))
-            return QVariant();
-    }
-    if (index.column() == columnPosition(AbstractObserverItemModel::ColumnTypeInfo)) {
-        if (!(activeHints()->itemViewColumnHint() & ObserverHints::ColumnTypeInfoHint))
-            return QVariant();
-    }
-    if (index.column() == columnPosition(AbstractObserverItemModel::ColumnCategory)) {
-        if (!(activeHints()->itemViewColumnHint() & ObserverHints::ColumnCategoryHint))
-            return QVariant();
-    }
+    AbstractObserverItemModel::ColumnID column_id = columnHandler(index.column());
+    if (column_id == AbstractObserverItemModel::ColumnLast)
+        return QVariant();
+
+    const ObserverTableModelRowRecord& record = rowRecord(index.row());
 
     // ------------------------------------
     // Handle Subject ID Column
     // ------------------------------------
-    if (index.column() == columnPosition(ColumnSubjectID)) {
+    if (column_id == ColumnSubjectID) {
         // We need EditRole here, its used in subjectID()
         if (role == Qt::DisplayRole || role == Qt::EditRole)
-            return d_observer->subjectID(index.row());
+            return record.subject_id;
     // ------------------------------------
     // Handle Name Column: We need to inspect all role properties here:
     // ------------------------------------
-    } else if (index.column() == columnPosition(ColumnName)) {
+    } else if (column_id == ColumnName) {
+        QObject* obj = record.object;
+        if (!obj)
+            return QVariant();
+
         // ------------------------------------
         // Qt::DisplayRole and Qt::EditRole
         // ------------------------------------
         if (role == Qt::DisplayRole || role == Qt::EditRole) {
-            // Check the modification state of the object if it implements IModificationNotifier:
-            bool is_modified = false;
-            QObject* obj = d_observer->subjectAt(index.row());
+            // Names and modification states change without structural changes, thus they are not cached in the row record:
+            QString name = d_observer->subjectDisplayedNameInContext(obj);
             if (activeHints()->modificationStateDisplayHint() == ObserverHints::CharacterModificationStateDisplay) {
                 IModificationNotifier* mod_iface = qobject_cast<IModificationNotifier*> (obj);
-                if (mod_iface)
-                    is_modified = mod_iface->isModified();
+                if (mod_iface && mod_iface->isModified())
+                    name.append("*");
             }
-
-            QString return_string = d_observer->subjectDisplayedNameInContext(obj);
-            if (is_modified)
-                return return_string + "*";
-            else
-                return return_string;
-
+            return name;
         // ------------------------------------
         // Qt::CheckStateRole
         // ------------------------------------
         } else if (role == Qt::CheckStateRole) {
             if (model->activity_filter) {
                 if (activeHints()->activityDisplayHint() == ObserverHints::CheckboxActivityDisplay || activeHints()->activityControlHint() == ObserverHints::CheckboxTriggered) {
-                    QObject* obj = d_observer->subjectReference(getSubjectID(index));
                     QVariant subject_activity = d_observer->getMultiContextPropertyValue(obj,qti_prop_ACTIVITY_MAP);
 
                     if (subject_activity.isValid()) {
@@ -248,7 +251,6 @@ QVariant Qtilities::CoreGui::ObserverTableModel::data(const QModelIndex &index,
         // Qt::DecorationRole
         // ------------------------------------
         } else if (role == Qt::DecorationRole) {
-            QObject* obj = d_observer->subjectReference(getSubjectID(index));
             SharedProperty icon_property = ObjectManager::getSharedProperty(obj,qti_prop_DECORATION);
             if (icon_property.isValid()) {
                 return icon_property.value();
@@ -257,7 +259,6 @@ QVariant Qtilities::CoreGui::ObserverTableModel::data(const QModelIndex &index,
         // Qt::ForegroundRole
         // ------------------------------------
         } else if (role == Qt::ForegroundRole) {
-            QObject* obj = d_observer->subjectReference(getSubjectID(index));
             SharedProperty icon_property = ObjectManager::getSharedProperty(obj,qti_prop_FOREGROUND);
             if (icon_property.isValid()) {
                 return icon_property.value();
@@ -266,7 +267,6 @@ QVariant Qtilities::CoreGui::ObserverTableModel::data(const QModelIndex &index,
         // Qt::BackgroundRole
         // ------------------------------------
         } else if (role == Qt::BackgroundRole) {
-            QObject* obj = d_observer->subjectReference(getSubjectID(index));
             SharedProperty icon_property = ObjectManager::getSharedProperty(obj,qti_prop_BACKGROUND);
             if (icon_property.isValid()) {
                 return icon_property.value();
@@ -275,7 +275,6 @@ QVariant Qtilities::CoreGui::ObserverTableModel::data(const QModelIndex &index,
         // Qt::TextAlignmentRole
         // ------------------------------------
         } else if (role == Qt::TextAlignmentRole) {
-            QObject* obj = d_observer->subjectReference(getSubjectID(index));
             SharedProperty icon_property = ObjectManager::getSharedProperty(obj,qti_prop_TEXT_ALIGNMENT);
             if (icon_property.isValid()) {
                 return icon_property.value();
@@ -284,7 +283,6 @@ QVariant Qtilities::CoreGui::ObserverTableModel::data(const QModelIndex &index,
         // Qt::FontRole
         // ------------------------------------
         } else if (role == Qt::FontRole) {
-            QObject* obj = d_observer->subjectReference(getSubjectID(index));
             SharedProperty icon_property = ObjectManager::getSharedProperty(obj,qti_prop_FONT);
             if (icon_property.isValid()) {
                 return icon_property.value();
@@ -293,7 +291,6 @@ QVariant Qtilities::CoreGui::ObserverTableModel::data(const QModelIndex &index,
         // Qt::SizeHintRole
         // ------------------------------------
         } else if (role == Qt::SizeHintRole) {
-            QObject* obj = d_observer->subjectReference(getSubjectID(index));
             SharedProperty size_property = ObjectManager::getSharedProperty(obj,qti_prop_SIZE_HINT);
             if (size_property.isValid()) {
                 if (size_property.value().toSize().isValid())
@@ -303,7 +300,6 @@ QVariant Qtilities::CoreGui::ObserverTableModel::data(const QModelIndex &index,
         // Qt::WhatsThisRole
         // ------------------------------------
         } else if (role == Qt::WhatsThisRole) {
-            QObject* obj = d_observer->subjectReference(getSubjectID(index));
             SharedProperty icon_property = ObjectManager::getSharedProperty(obj,qti_prop_WHATS_THIS);
             if (icon_property.isValid()) {
                 return icon_property.value();
@@ -312,7 +308,6 @@ QVariant Qtilities::CoreGui::ObserverTableModel::data(const QModelIndex &index,
         // Qt::ToolTipRole
         // ------------------------------------
         } else if (role == Qt::ToolTipRole) {
-            QObject* obj = d_observer->subjectReference(getSubjectID(index));
             SharedProperty tooltip = ObjectManager::getSharedProperty(obj,qti_prop_TOOLTIP);
             if (tooltip.isValid()) {
                 return tooltip.value();
@@ -321,29 +316,22 @@ QVariant Qtilities::CoreGui::ObserverTableModel::data(const QModelIndex &index,
     // ------------------------------------
     // Handle Category Column
     // ------------------------------------
-    } else if (index.column() == columnPosition(ColumnCategory)) {
+    } else if (column_id == ColumnCategory) {
         if (role == Qt::DisplayRole) {
-            // Get the qti_prop_CATEGORY_MAP property.
-            QObject* obj = d_observer->subjectReference(getSubjectID(index));
-            QVariant category_variant = d_observer->getMultiContextPropertyValue(obj,qti_prop_CATEGORY_MAP);
+            QVariant category_variant = d_observer->getMultiContextPropertyValue(record.object,qti_prop_CATEGORY_MAP);
             if (category_variant.isValid()) {
                 QtilitiesCategory category = category_variant.value<QtilitiesCategory>();
-                if (!category.isEmpty()) {
+                if (!category.isEmpty())
                     return category.toString();
-                }
             }
             return QString();
         }
     // ------------------------------------
     // Handle Child Count Column
     // ------------------------------------
-    } else if (index.column() == columnPosition(ColumnChildCount)) {
+    } else if (column_id == ColumnChildCount) {
         if (role == Qt::DisplayRole) {
-            QObject* obj = d_observer->subjectReference(getSubjectID(index));
-            if (!obj)
-                return QVariant();
-
-            Observer* observer = qobject_cast<Observer*> (obj);
+            Observer* observer = qobject_cast<Observer*> (record.object);
             if (observer) {
                 int count = observer->treeCount(columnChildCountBaseClass());
                 if ((count > columnChildCountLimit() - 1) && (columnChildCountLimit() != -1))
@@ -355,37 +343,26 @@ QVariant Qtilities::CoreGui::ObserverTableModel::data(const QModelIndex &index,
     // ------------------------------------
     // Handle Subject Type Info Column
     // ------------------------------------
-    } else if (index.column() == columnPosition(ColumnTypeInfo)) {
+    } else if (column_id == ColumnTypeInfo) {
         if (role == Qt::DisplayRole) {
-            QObject* obj = d_observer->subjectReference(getSubjectID(index));
-            if (!obj)
+            if (!record.object)
                 return QVariant();
-
-            if (obj->metaObject()) {
-                return QString(QLatin1String(obj->metaObject()->className())).split("::").last();
-            }
-            return QVariant();
+            return record.type_info;
         }
     // ------------------------------------
     // Handle Access Column
     // ------------------------------------
-    } else if (index.column() == columnPosition(ColumnAccess)) {
+    } else if (column_id == ColumnAccess) {
         if (role == Qt::DecorationRole) {
-            QObject* obj = d_observer->subjectReference(getSubjectID(index));
-            if (!obj)
-                return QVariant();
-
-            Observer* observer = qobject_cast<Observer*> (obj);
+            Observer* observer = qobject_cast<Observer*> (record.object);
             if (observer) {
-                if (observer->accessMode() == Observer::FullAccess)
-                    return QVariant();
                 if (observer->accessMode() == Observer::ReadOnlyAccess)
                     return QIcon(qti_icon_READ_ONLY_16x16);
-                if (observer->accessMode() == Observer::LockedAccess)
+                else if (observer->accessMode() == Observer::LockedAccess)
                     return QIcon(qti_icon_LOCKED_16x16);
-            } else {
+            } else if (record.object) {
                 // Inspect the object to see if it has the qti_prop_ACCESS_MODE observer property.
-                QVariant mode = d_observer->getMultiContextPropertyValue(obj,qti_prop_ACCESS_MODE);
+                QVariant mode = d_observer->getMultiContextPropertyValue(record.object,qti_prop_ACCESS_MODE);
                 if (mode.toInt() == (int) Observer::ReadOnlyAccess)
                     return QIcon(qti_icon_READ_ONLY_16x16);
             }
@@ -395,6 +372,41 @@ QVariant Qtilities::CoreGui::ObserverTableModel::data(const QModelIndex &index,
     return QVariant();
 }
 
+const Qtilities::CoreGui::ObserverTableModelRowRecord& Qtilities::CoreGui::ObserverTableModel::rowRecord(int row) const {
+    if (d->row_records.count() != d_observer->subjectCount()) {
+        // Subjects were added or removed without the model being notified yet:
+        d->row_records.clear();
+        d->row_records.resize(d_observer->subjectCount());
+    }
+
+    // The subject at the row is compared as well since subjects can be replaced during processing cycles
+    // without the number of subjects changing:
+    QObject* obj = d_observer->subjectAt(row);
+    ObserverTableModelRowRecord& record = d->row_records[row];
+    if (record.valid && record.object == obj)
+        return record;
+
+    record = ObserverTableModelRowRecord();
+    record.object = obj;
+    record.subject_id = d_observer->subjectID(row);
+    record.valid = true;
+    record.type_info = typeInfoString(obj);
+
+    return record;
+}
+
+void Qtilities::CoreGui::ObserverTableModel::invalidateRowRecords(int first_row, int last_row) {
+    if (first_row < 0) {
+        d->row_records.clear();
+        return;
+    }
+
+    if (last_row >= d->row_records.count())
+        last_row = d->row_records.count() - 1;
+    for (int i = first_row; i <= last_row; ++i)
+        d->row_records[i].valid = false;
+}
+
 Qt::ItemFlags Qtilities::CoreGui::ObserverTableModel::flags(const QModelIndex &index) const {
      if (!index.isValid())
          return Qt::ItemIsEnabled;
@@ -621,11 +633,104 @@ void Qtilities::CoreGui::ObserverTableModel::handleLayoutChanged() {
     }
 
     d->fetch_count = qMin(fetch_limit, d_observer->subjectCount());
+    d->missed_changes = false;
+    d->tracked_subjects.clear();
+    QList<QObject*> subjects = d_observer->subjectReferences();
+    for (int i = 0; i < subjects.count(); ++i)
+        d->tracked_subjects << subjects.at(i);
+    invalidateRowRecords();
     emit layoutAboutToBeChanged();
     emit layoutChanged();
     emit layoutChangeCompleted();
 }
 
+void Qtilities::CoreGui::ObserverTableModel::handleNumberOfSubjectsChanged() {
+    if (!d_observer)
+        return;
+
+    // Outside of processing cycles all changes are reported through change sets, thus we only
+    // need to refresh when change sets were missed:
+    if (d->missed_changes)
+        handleLayoutChanged();
+}
+
+void Qtilities::CoreGui::ObserverTableModel::handleProcessingCycleEnded() {
+    if (!d_observer)
+        return;
+
+    // No change sets are emitted during processing cycles. Subjects can be added and removed during a
+    // processing cycle without the number of subjects changing, thus the subjects themselves are compared:
+    QList<QObject*> subjects = d_observer->subjectReferences();
+    bool in_sync = (subjects.count() == d->tracked_subjects.count());
+    for (int i = 0; in_sync && i < subjects.count(); ++i)
+        in_sync = (d->tracked_subjects.at(i).data() == subjects.at(i));
+    if (in_sync && !d->missed_changes)
+        return;
+
+    handleLayoutChanged();
+}
+
+void Qtilities::CoreGui::ObserverTableModel::handleSubjectsChanged(const Qtilities::Core::ObserverChangeSet& change_set) {
+    if (!d_observer)
+        return;
+
+    if (!respondToObserverChanges() || !change_set.isValid()) {
+        d->missed_changes = true;
+        return;
+    }
+
+    int first = change_set.d_first_position;
+    int last = change_set.d_last_position;
+    int count = change_set.count();
+    int tracked_subject_count = d->tracked_subjects.count();
+
+    if (change_set.d_change_type == ObserverChangeSet::SubjectsInserted) {
+        if (first > tracked_subject_count || change_set.d_subjects.count() != count) {
+            // We missed changes somewhere, refresh completely:
+            handleLayoutChanged();
+            return;
+        }
+
+        // Records are only kept in sync when they were in sync before the change:
+        if (d->row_records.count() == tracked_subject_count)
+            d->row_records.insert(first,count,ObserverTableModelRowRecord());
+        else
+            d->row_records.clear();
+
+        // Rows which are not fetched yet will be fetched in fetchMore():
+        bool all_fetched = (d->fetch_count == tracked_subject_count);
+        for (int i = 0; i < count; ++i)
+            d->tracked_subjects.insert(first + i,change_set.d_subjects.at(i));
+        if (first < d->fetch_count || (first == d->fetch_count && all_fetched)) {
+            beginInsertRows(QModelIndex(),first,last);
+            d->fetch_count += count;
+            endInsertRows();
+        }
+    } else if (change_set.d_change_type == ObserverChangeSet::SubjectsRemoved) {
+        if (last >= tracked_subject_count) {
+            handleLayoutChanged();
+            return;
+        }
+
+        if (d->row_records.count() == tracked_subject_count)
+            d->row_records.remove(first,count);
+        else
+            d->row_records.clear();
+
+        for (int i = 0; i < count; ++i)
+            d->tracked_subjects.removeAt(first);
+        if (first < d->fetch_count) {
+            int last_fetched = qMin(last,d->fetch_count - 1);
+            beginRemoveRows(QModelIndex(),first,last_fetched);
+            d->fetch_count -= last_fetched - first + 1;
+            endRemoveRows();
+        }
+    } else if (change_set.d_change_type == ObserverChangeSet::SubjectsDataChanged) {
+        if (first < d->fetch_count)
+            emit dataChanged(createIndex(first,0),createIndex(qMin(last,d->fetch_count - 1),columnCount() - 1));
+    }
+}
+
 int Qtilities::CoreGui::ObserverTableModel::getSubjectID(const QModelIndex &index) const {
     QModelIndex id_index = createIndex(index.row(),0);
     bool ok;
@@ -651,13 +756,7 @@ void Qtilities::CoreGui::ObserverTableModel::setSelectedObjects(QList<QPointer<Q
 }
 
 QObject* Qtilities::CoreGui::ObserverTableModel::getObject(const QModelIndex &index) const {
-    QModelIndex id_index = createIndex(index.row(),0);
-    bool ok;
-    int id = data(id_index, Qt::EditRole).toInt(&ok);
-    if (ok && d_observer)
-        return d_observer->subjectReference(id);
-    else
-        return 0;
+    return getObject(index.row());
 }
 
 void Qtilities::CoreGui::ObserverTableModel::refresh() {
@@ -665,13 +764,12 @@ void Qtilities::CoreGui::ObserverTableModel::refresh() {
 }
 
 QObject* Qtilities::CoreGui::ObserverTableModel::getObject(int row) const {
-    QModelIndex id_index = createIndex(row,0);
-    bool ok;
-    int id = data(id_index, Qt::EditRole).toInt(&ok);
-    if (ok && d_observer)
-        return d_observer->subjectReference(id);
-    else
+    if (!d_observer)
+        return 0;
+    if (row < 0 || row >= d_observer->subjectCount())
         return 0;
+
+    return rowRecord(row).object;
 }
 
 QModelIndex Qtilities::CoreGui::ObserverTableModel::getIndex(QObject* obj, int column) const {
@@ -22,6 +22,7 @@
 #include "AbstractObserverItemModel.h"
 
 #include <Observer.h>
+#include <ObserverChangeSet.h>
 #include <ActivityPolicyFilter.h>
 
 namespace Qtilities {
@@ -34,6 +35,11 @@ namespace Qtilities {
         \brief Structure used by ObserverTableModel to store private data.
           */
         struct ObserverTableModelData;
+        /*!
+        \struct ObserverTableModelRowRecord
+        \brief Structure used by ObserverTableModel to cache the subject, subject ID and type of a row.
+          */
+        struct ObserverTableModelRowRecord;
 
         //! The ObserverTableModel class provides an ready-to-use model that can be used to show the contents of an Qtilities::Core::Observer in a QTableView.
         /*!
@@ -125,6 +131,31 @@ namespace Qtilities {
               This slot will automatically be connected to the layoutChanged() signal on the observer context displayed.
               */
             virtual void handleLayoutChanged();
+            //! Slot which refreshes the layout of the model when change sets received through Observer::subjectsChanged() could not be applied.
+            /*!
+              This slot is connected to the numberOfSubjectsChanged() signal on the observer context. Changes outside of processing cycles are
+              applied from change sets, thus this slot does nothing unless change sets were missed, for example while respondToObserverChanges() was false.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void handleNumberOfSubjectsChanged();
+            //! Slot which refreshes the layout of the model when the subjects changed during a processing cycle.
+            /*!
+              This slot is connected to the processingCycleEnded() signal on the observer context. Change sets are not emitted during processing
+              cycles, thus the subjects in the observer context are compared with the subjects known to the model. Changes which left the number
+              of subjects the same are detected as well.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void handleProcessingCycleEnded();
+            //! Slot which updates only the rows affected by a change set received from the observer context.
+            /*!
+              Inserted and removed subjects are translated into row insertions and removals, and data changes into dataChanged() signals for the
+              affected rows. Thus, selections, the scroll position in views and the number of rows already fetched are kept.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void handleSubjectsChanged(const Qtilities::Core::ObserverChangeSet& change_set);
 
         signals:
             //! Signal which is emitted when more data is fetched from the model.
@@ -137,6 +168,23 @@ namespace Qtilities {
             //! This signal will be handled by a slot in the ObserverWidget parent of this model and the objects will be selected. The signal is emitted when grouped activity changes completed.
             void selectObjects(QList<QPointer<QObject> > objects) const;
 
+        private:
+            //! Returns the cached record of a row, building it when needed.
+            /*!
+              Only data which cannot change without a structural change in the observer context is cached. Names, categories and access modes are
+              looked up when they are displayed since they can change without the model being notified.
+
+              \note \p row must be a valid row in the observer context.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            const ObserverTableModelRowRecord& rowRecord(int row) const;
+            //! Invalidates the cached records of the specified rows. When \p first_row is -1, all records are invalidated.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void invalidateRowRecords(int first_row = -1, int last_row = -1);
+
         protected:
             ObserverTableModelData* d;
         };
@@ -55,12 +55,53 @@ ObserverHints *Qtilities::CoreGui::ObserverTableModelProxyFilter::customHints()
     return hints_default;
 }
 
-bool Qtilities::CoreGui::ObserverTableModelProxyFilter::filterAcceptsRow(int sourceRow, const QModelIndex &sourceParent) const {
-    ObserverTableModel* table_model = dynamic_cast<ObserverTableModel*> (sourceModel());
+void Qtilities::CoreGui::ObserverTableModelProxyFilter::setSourceModel(QAbstractItemModel* source_model) {
+    table_model = qobject_cast<ObserverTableModel*> (source_model);
+    QSortFilterProxyModel::setSourceModel(source_model);
+}
+
+void Qtilities::CoreGui::ObserverTableModelProxyFilter::setSearchIndex(ObserverSearchIndex* search_index) {
+    if (this->search_index == search_index)
+        return;
+
+    if (this->search_index)
+        this->search_index->disconnect(this);
+    this->search_index = search_index;
+    if (search_index)
+        connect(search_index,SIGNAL(matchesChanged(QModelIndex,int,int)),SLOT(handleSearchMatchesChanged(QModelIndex,int,int)));
+}
+
+void Qtilities::CoreGui::ObserverTableModelProxyFilter::handleSearchMatchesChanged(const QModelIndex& source_parent, int first, int last) {
+    if (!sourceModel() || !search_index || search_index->sourceModel() != sourceModel())
+        return;
+
+    // Only refilter when the acceptance of one of the affected rows differs from what is shown:
+    for (int row = first; row <= last; ++row) {
+        QModelIndex source_index = sourceModel()->index(row,0,source_parent);
+        if (!source_index.isValid())
+            continue;
+        if (filterAcceptsRow(row,source_parent) != mapFromSource(source_index).isValid()) {
+            invalidateFilter();
+            return;
+        }
+    }
+}
 
+Qtilities::CoreGui::ObserverSearchIndex* Qtilities::CoreGui::ObserverTableModelProxyFilter::searchIndex() const {
+    return search_index;
+}
+
+void Qtilities::CoreGui::ObserverTableModelProxyFilter::invalidateSearchFilter() {
+    invalidateFilter();
+}
+
+bool Qtilities::CoreGui::ObserverTableModelProxyFilter::filterAcceptsRow(int sourceRow, const QModelIndex &sourceParent) const {
     if (table_model) {
         QModelIndex name_index = sourceModel()->index(sourceRow, table_model->columnPosition(AbstractObserverItemModel::ColumnName), sourceParent);
-        if (!sourceModel()->data(name_index).toString().contains(filterRegExp()))
+        if (search_index && search_index->sourceModel() == sourceModel()) {
+            if (!search_index->matches(name_index))
+                return false;
+        } else if (!sourceModel()->data(name_index).toString().contains(filterRegExp()))
             return false;
 
         Observer* observer = table_model->observerContext();
@@ -100,8 +141,6 @@ bool Qtilities::CoreGui::ObserverTableModelProxyFilter::filterAcceptsRow(int sou
 }
 
 bool Qtilities::CoreGui::ObserverTableModelProxyFilter::lessThan(const QModelIndex &left, const QModelIndex &right) const {
-    ObserverTableModel* table_model = dynamic_cast<ObserverTableModel*> (sourceModel());
-
     if (table_model) {
         QModelIndex left_name_index = sourceModel()->index(left.row(), table_model->columnPosition(AbstractObserverItemModel::ColumnName), left.parent());
         QModelIndex right_name_index = sourceModel()->index(right.row(), table_model->columnPosition(AbstractObserverItemModel::ColumnName), right.parent());
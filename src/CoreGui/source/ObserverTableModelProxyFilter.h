@@ -13,6 +13,8 @@
 #define OBSERVER_TABLE_MODEL_PROXY_FILTER_H
 
 #include "Observer.h"
+#include "ObserverTableModel.h"
+#include "ObserverSearchIndex.h"
 #include "QtilitiesCoreGui_global.h"
 
 #include <ObserverHints>
@@ -64,6 +66,33 @@ namespace Qtilities {
               <i>This function was added in %Qtilities v1.2.</i>
               */
             ObserverHints* customHints() const;
+            //! Sets the search index used to filter rows.
+            /*!
+              When a search index is set, filterAcceptsRow() uses ObserverSearchIndex::matches() instead of matching the filter regular
+              expression against the name of each row. The filter must be invalidated through invalidateSearchFilter() when the index completed a query. Changes to the
+              matches of individual rows reported through ObserverSearchIndex::matchesChanged() are handled by the filter itself.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void setSearchIndex(ObserverSearchIndex* search_index);
+            //! Gets the search index used to filter rows.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            ObserverSearchIndex* searchIndex() const;
+            //! Filters all rows again using the current matches of the search index.
+            /*!
+              Unlike QSortFilterProxyModel::invalidate(), the rows are not sorted again.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void invalidateSearchFilter();
+
+            virtual void setSourceModel(QAbstractItemModel* source_model);
+
+        private slots:
+            //! Filters the rows of which the matches changed in the search index again.
+            void handleSearchMatchesChanged(const QModelIndex& source_parent, int first, int last);
 
         protected:
             virtual bool filterAcceptsRow(int sourceRow, const QModelIndex &sourceParent) const;
@@ -72,6 +101,8 @@ namespace Qtilities {
         private:
             QPointer<ObserverHints>         hints_default;
             bool                            use_observer_hints;
+            QPointer<ObserverTableModel>    table_model;
+            QPointer<ObserverSearchIndex>   search_index;
         };
     }
 }
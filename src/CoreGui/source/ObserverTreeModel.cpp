@@ -131,6 +131,7 @@ bool Qtilities::CoreGui::ObserverTreeModel::setObserverContext(Observer* observe
     connect(d_observer,SIGNAL(destroyed()),SLOT(handleObserverContextDeleted()));
     connect(d_observer,SIGNAL(layoutChanged(QList<QPointer<QObject> >)),SLOT(recordObserverChange(QList<QPointer<QObject> >)));
     connect(d_observer,SIGNAL(dataChanged(Observer*)),SLOT(handleContextDataChanged(Observer*)));
+    connect(d_observer,SIGNAL(subjectsChanged(Qtilities::Core::ObserverChangeSet)),SLOT(handleSubjectsChanged(Qtilities::Core::ObserverChangeSet)));
 
     // If a selection parent does not exist, we set observer as the selection parent:
     if (!d->selection_parent)
@@ -248,41 +249,20 @@ QVariant Qtilities::CoreGui::ObserverTreeModel::data(const QModelIndex &index, i
         return QVariant();
 
     // ------------------------------------
-    // Return nothing for columns which should not be displayed
+    // Columns which should not be displayed are mapped to ColumnLast by columnHandler().
     // We hide them in Observer Widget, but during initialize
     // the model is built before we get to a place where we can hide the
     // columns. Thus, the info is called on all models at least once
-    // before we can hide it. Thus we filter it here:
+    // before we can hide it.
     // ------------------------------------
-    if (index.column() == columnPosition(AbstractObserverItemModel::ColumnSubjectID)) {
-        if (!(activeHints()->itemViewColumnHint() & ObserverHints::ColumnIDHint))
-            return QVariant();
-    }
-    if (index.column() == columnPosition(AbstractObserverItemModel::ColumnName)) {
-        if (!(activeHints()->itemViewColumnHint() & ObserverHints::ColumnNameHint))
-            return QVariant();
-    }
-    if (index.column() == columnPosition(AbstractObserverItemModel::ColumnChildCount)) {
-        if (!(activeHints()->itemViewColumnHint() & ObserverHints::ColumnChildCountHint))
-            return QVariant();
-    }
-    if (index.column() == columnPosition(AbstractObserverItemModel::ColumnAccess)) {
-        if (!(activeHints()->itemViewColumnHint() & ObserverHints::ColumnAccessHint))
-            return QVariant();
-    }
-    if (index.column() == columnPosition(AbstractObserverItemModel::ColumnTypeInfo)) {
-        if (!(activeHints()->itemViewColumnHint() & ObserverHints::ColumnTypeInfoHint))
-            return QVariant();
-    }
-    if (index.column() == columnPosition(AbstractObserverItemModel::ColumnCategory)) {
-        if (!(activeHints()->itemViewColumnHint() & ObserverHints::ColumnCategoryHint))
-            return QVariant();
-    }
+    AbstractObserverItemModel::ColumnID column_id = columnHandler(index.column());
+    if (column_id == AbstractObserverItemModel::ColumnLast)
+        return QVariant();
 
     // ------------------------------------
     // Handle Name Column
     // ------------------------------------
-    if (index.column() == columnPosition(ColumnName)) {
+    if (column_id == ColumnName) {
         // ------------------------------------
         // Qt::DisplayRole and Qt::EditRole
         // ------------------------------------
@@ -535,7 +515,7 @@ QVariant Qtilities::CoreGui::ObserverTreeModel::data(const QModelIndex &index, i
     // ------------------------------------
     // Handle Child Count Column
     // ------------------------------------
-    } else if (index.column() == columnPosition(ColumnChildCount)) {
+    } else if (column_id == ColumnChildCount) {
         if (role == Qt::DisplayRole) {
             // Check if it is an observer, in that case we return treeCount() on the observer
             Observer* observer = qobject_cast<Observer*> (getItem(index)->getObject());
@@ -550,21 +530,17 @@ QVariant Qtilities::CoreGui::ObserverTreeModel::data(const QModelIndex &index, i
     // ------------------------------------
     // Handle Subject Type Info Column
     // ------------------------------------
-    } else if (index.column() == columnPosition(ColumnTypeInfo)) {
+    } else if (column_id == ColumnTypeInfo) {
         if (role == Qt::DisplayRole) {
-            QObject* obj = getObject(index);
-            if (obj) {
-                if (obj->metaObject()) {
-                    if (QString(QLatin1String(obj->metaObject()->className())).split("::").last() != "QObject")
-                        return QString(QLatin1String(obj->metaObject()->className())).split("::").last();
-                }
-            }
+            QString type_info = typeInfoString(getObject(index));
+            if (!type_info.isEmpty() && type_info != QLatin1String("QObject"))
+                return type_info;
             return QVariant();
         }
     // ------------------------------------
     // Handle Access Column
     // ------------------------------------
-    } else if (index.column() == columnPosition(ColumnAccess)) {
+    } else if (column_id == ColumnAccess) {
         if (role == Qt::DecorationRole) {
             // First handle categories:
             ObserverTreeItem* item = getItem(index);
@@ -1402,6 +1378,12 @@ Qtilities::Core::Observer* Qtilities::CoreGui::ObserverTreeModel::parentOfIndex(
     return local_selection_parent;  
 }
 
+void Qtilities::CoreGui::ObserverTreeModel::handleSubjectsChanged(const Qtilities::Core::ObserverChangeSet& change_set) {
+    // Role property changes on subjects of the top level observer are only reported through change sets:
+    if (change_set.d_change_type == ObserverChangeSet::SubjectsDataChanged)
+        handleContextDataChanged(d_observer);
+}
+
 void Qtilities::CoreGui::ObserverTreeModel::handleContextDataChanged(Observer* observer) {
     if (!observer)
         return;
@@ -240,6 +240,11 @@ namespace Qtilities {
             void rebuildTreeStructure();
             //! Slot which receives ready-built ObserverTreeItem from ObserverTreeModelBuilder.
             void receiveBuildObserverTreeItem(ObserverTreeItem* item);
+            //! Handles change sets of the top level observer, refreshing its context when the data of its subjects changed.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void handleSubjectsChanged(const Qtilities::Core::ObserverChangeSet& change_set);
 
         protected:
             //! Recursive function used by findObject() to traverse through the tree trying to find an object.
@@ -132,13 +132,12 @@ void Qtilities::CoreGui::ObserverTreeModelBuilder::buildRecursive(ObserverTreeIt
             }
 
             if (use_categorized) {
-                // Get the object / category hash:
-                QMap<QPointer<QObject>, QString> category_map = observer->subjectReferenceCategoryMap();
-                QSet<QString> categories = category_map.values().toSet();
+                // Get the subjects grouped by category:
+                QHash<QtilitiesCategory, QList<QPointer<QObject> > > category_hash = observer->subjectReferenceCategoryHash();
+                QList<QtilitiesCategory> categories = category_hash.keys();
 
-                foreach (const QString& category_string, categories) {
+                foreach (const QtilitiesCategory& category, categories) {
                     //QApplication::processEvents();
-                    QtilitiesCategory category = QtilitiesCategory(category_string,"::");
                     // Check the category against the displayed category list:
                     bool valid_category = true;
                     if (hints_to_use) {
@@ -203,8 +202,7 @@ void Qtilities::CoreGui::ObserverTreeModelBuilder::buildRecursive(ObserverTreeIt
 
                                 // If this item has locked access, we don't dig into any items underneath it:
                                 if (observer->accessMode(shortened_category) != Observer::LockedAccess) {
-                                    QList<QPointer<QObject> > safe_list = category_map.keys(category_levels.join("::"));
-                                    buildRecursive(new_item,safe_list);
+                                    buildRecursive(new_item,category_hash.value(shortened_category));
                                 } else
                                     break;
                             } else
@@ -30,9 +30,47 @@ Qtilities::CoreGui::ObserverTreeModelProxyFilter::~ObserverTreeModelProxyFilter(
 
 }
 
-bool Qtilities::CoreGui::ObserverTreeModelProxyFilter::filterAcceptsRow(int sourceRow, const QModelIndex &sourceParent) const {
-    ObserverTreeModel* tree_model = dynamic_cast<ObserverTreeModel*> (sourceModel());
+void Qtilities::CoreGui::ObserverTreeModelProxyFilter::setSourceModel(QAbstractItemModel* source_model) {
+    tree_model = qobject_cast<ObserverTreeModel*> (source_model);
+    QSortFilterProxyModel::setSourceModel(source_model);
+}
+
+void Qtilities::CoreGui::ObserverTreeModelProxyFilter::setSearchIndex(ObserverSearchIndex* search_index) {
+    if (this->search_index == search_index)
+        return;
+
+    if (this->search_index)
+        this->search_index->disconnect(this);
+    this->search_index = search_index;
+    if (search_index)
+        connect(search_index,SIGNAL(matchesChanged(QModelIndex,int,int)),SLOT(handleSearchMatchesChanged(QModelIndex,int,int)));
+}
 
+void Qtilities::CoreGui::ObserverTreeModelProxyFilter::handleSearchMatchesChanged(const QModelIndex& source_parent, int first, int last) {
+    if (!sourceModel() || !search_index || search_index->sourceModel() != sourceModel())
+        return;
+
+    // Only refilter when the acceptance of one of the affected rows differs from what is shown:
+    for (int row = first; row <= last; ++row) {
+        QModelIndex source_index = sourceModel()->index(row,0,source_parent);
+        if (!source_index.isValid())
+            continue;
+        if (filterAcceptsRow(row,source_parent) != mapFromSource(source_index).isValid()) {
+            invalidateFilter();
+            return;
+        }
+    }
+}
+
+Qtilities::CoreGui::ObserverSearchIndex* Qtilities::CoreGui::ObserverTreeModelProxyFilter::searchIndex() const {
+    return search_index;
+}
+
+void Qtilities::CoreGui::ObserverTreeModelProxyFilter::invalidateSearchFilter() {
+    invalidateFilter();
+}
+
+bool Qtilities::CoreGui::ObserverTreeModelProxyFilter::filterAcceptsRow(int sourceRow, const QModelIndex &sourceParent) const {
     if (tree_model) {
         // Get the ObserverTreeItem:
         QModelIndex name_index = sourceModel()->index(sourceRow, tree_model->columnPosition(AbstractObserverItemModel::ColumnName), sourceParent);        
@@ -47,6 +85,9 @@ bool Qtilities::CoreGui::ObserverTreeModelProxyFilter::filterAcceptsRow(int sour
             // Filter by type:
             if (!(row_filter_types & tree_item->itemType()))
                 return true;
+
+            if (search_index && search_index->sourceModel() == sourceModel())
+                return search_index->matches(name_index);
         }
     }
     return QSortFilterProxyModel::filterAcceptsRow(sourceRow,sourceParent);
@@ -61,8 +102,6 @@ Qtilities::CoreGui::ObserverTreeItem::TreeItemTypeFlags Qtilities::CoreGui::Obse
 }
 
 bool Qtilities::CoreGui::ObserverTreeModelProxyFilter::lessThan(const QModelIndex &left, const QModelIndex &right) const {
-    ObserverTreeModel* tree_model = dynamic_cast<ObserverTreeModel*> (sourceModel());
-
     if (tree_model) {
         int name_pos = tree_model->columnPosition(AbstractObserverItemModel::ColumnName);
         // Only do this for the name column:
@@ -14,9 +14,12 @@
 
 #include "Observer.h"
 #include "ObserverTreeItem.h"
+#include "ObserverTreeModel.h"
+#include "ObserverSearchIndex.h"
 #include "QtilitiesCoreGui_global.h"
 
 #include <QSortFilterProxyModel>
+#include <QPointer>
 
 namespace Qtilities {
     namespace CoreGui {
@@ -36,6 +39,33 @@ namespace Qtilities {
             void setRowFilterTypes(ObserverTreeItem::TreeItemTypeFlags type_flags);
             //! Gets the tree item types to be filtered in filterAcceptsRow().
             ObserverTreeItem::TreeItemTypeFlags rowFilterTypes() const;
+            //! Sets the search index used to filter rows.
+            /*!
+              When a search index is set, filterAcceptsRow() uses ObserverSearchIndex::matches() instead of matching the filter regular
+              expression against the display string of each row. The filter must be invalidated through invalidateSearchFilter() when the index completed a query. Changes to the
+              matches of individual rows reported through ObserverSearchIndex::matchesChanged() are handled by the filter itself.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void setSearchIndex(ObserverSearchIndex* search_index);
+            //! Gets the search index used to filter rows.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            ObserverSearchIndex* searchIndex() const;
+            //! Filters all rows again using the current matches of the search index.
+            /*!
+              Unlike QSortFilterProxyModel::invalidate(), the rows are not sorted again.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void invalidateSearchFilter();
+
+            virtual void setSourceModel(QAbstractItemModel* source_model);
+
+        private slots:
+            //! Filters the rows of which the matches changed in the search index again.
+            void handleSearchMatchesChanged(const QModelIndex& source_parent, int first, int last);
 
         protected:
             virtual bool filterAcceptsRow(int sourceRow, const QModelIndex &sourceParent) const;
@@ -43,6 +73,8 @@ namespace Qtilities {
 
         private:
             ObserverTreeItem::TreeItemTypeFlags row_filter_types;
+            QPointer<ObserverTreeModel>         tree_model;
+            QPointer<ObserverSearchIndex>       search_index;
         };
     }
 }
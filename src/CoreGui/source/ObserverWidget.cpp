@@ -23,6 +23,7 @@
 #include "SearchBoxWidget.h"
 #include "ObserverTableModelProxyFilter.h"
 #include "ObserverTreeModelProxyFilter.h"
+#include "ObserverSearchIndex.h"
 #include "ActionProvider.h"
 #include "ObserverTreeItem.h"
 #include "QtilitiesMainWindow.h"
@@ -134,7 +135,8 @@ struct Qtilities::CoreGui::ObserverWidgetData {
         disable_proxy_models(false),
         lazy_init(false),
         lazy_refresh(false),
-        search_item_filter_flags(ObserverTreeItem::TreeItem) { }
+        search_item_filter_flags(ObserverTreeItem::TreeItem),
+        search_index(0) { }
     ~ObserverWidgetData() {}
 
     //! The current selection parent observer context, returned using selectionParent().
@@ -304,6 +306,8 @@ struct Qtilities::CoreGui::ObserverWidgetData {
     bool lazy_refresh;
 
     ObserverTreeItem::TreeItemTypeFlags search_item_filter_flags;
+    //! The search index used by our own proxy models, created on the first search.
+    ObserverSearchIndex* search_index;
 };
 
 Qtilities::CoreGui::ObserverWidget::ObserverWidget(DisplayMode display_mode, QWidget * parent, Qt::WindowFlags f) :
@@ -3705,6 +3709,36 @@ void Qtilities::CoreGui::ObserverWidget::handleSearchStringChanged(const QString
     if (proxyModel())
          model = qobject_cast<QSortFilterProxyModel*> (proxyModel());
 
+    // Our own proxy models filter through a search index which is queried off the GUI thread:
+    ObserverTreeModelProxyFilter* tree_proxy = qobject_cast<ObserverTreeModelProxyFilter*> (model);
+    ObserverTableModelProxyFilter* table_proxy = qobject_cast<ObserverTableModelProxyFilter*> (model);
+    if (model && (tree_proxy || table_proxy)) {
+        if (!d->search_index) {
+            d->search_index = new ObserverSearchIndex(this);
+            connect(d->search_index,SIGNAL(searchCompleted(int)),SLOT(handleSearchCompleted()));
+        }
+        d->search_index->setSourceModel(model->sourceModel());
+        if (tree_proxy)
+            tree_proxy->setSearchIndex(d->search_index);
+        else
+            table_proxy->setSearchIndex(d->search_index);
+
+        Qt::CaseSensitivity caseSensitivity = Qt::CaseInsensitive;
+        QRegExp::PatternSyntax syntax = QRegExp::FixedString;
+        if (d->searchBoxWidget) {
+            caseSensitivity = d->searchBoxWidget->caseSensitive() ? Qt::CaseSensitive : Qt::CaseInsensitive;
+            syntax = d->searchBoxWidget->patternSyntax();
+        }
+        ObserverSearchIndex::MatchMode match_mode = ObserverSearchIndex::SubstringMatch;
+        if (syntax == QRegExp::RegExp)
+            match_mode = ObserverSearchIndex::RegExpMatch;
+        else if (syntax == QRegExp::Wildcard)
+            match_mode = ObserverSearchIndex::WildcardMatch;
+
+        d->search_index->search(filter_string,match_mode,caseSensitivity);
+        return;
+    }
+
     // Check if the installed proxy model is a QSortFilterProxyModel:
     if (model) {
         d->current_cursor = cursor();
@@ -3728,6 +3762,20 @@ void Qtilities::CoreGui::ObserverWidget::handleSearchStringChanged(const QString
     }
 }
 
+void Qtilities::CoreGui::ObserverWidget::handleSearchCompleted() {
+    // Only the filter depends on the completed query, thus the rows are not sorted again:
+    ObserverTreeModelProxyFilter* tree_proxy = qobject_cast<ObserverTreeModelProxyFilter*> (proxyModel());
+    ObserverTableModelProxyFilter* table_proxy = qobject_cast<ObserverTableModelProxyFilter*> (proxyModel());
+    if (tree_proxy)
+        tree_proxy->invalidateSearchFilter();
+    else if (table_proxy)
+        table_proxy->invalidateSearchFilter();
+    else
+        return;
+
+    resizeColumns();
+}
+
 void Qtilities::CoreGui::ObserverWidget::resetProxyModel() {
     handleSearchStringChanged("");
 }
@@ -1078,6 +1078,10 @@ categorized_widget->show();
             //! Handles search options changes in the SearchBoxWidget if present.
             void handleSearchOptionsChanged();
             //! Handles search string changes in the SearchBoxWidget if present.
+            /*!
+              When the default proxy models are used, the search is done through an ObserverSearchIndex: it is debounced, runs off the GUI
+              thread and the proxy model is refreshed once it completed. Custom proxy models are filtered directly.
+              */
             void handleSearchStringChanged(const QString& filter_string);
             //! Handle changes to the type of items which must be filtered.
             void handleSearchItemTypesChanged();
@@ -1087,6 +1091,11 @@ categorized_widget->show();
         private slots:
             //! Handle post layout changed actions in table view mode.
             void handleLayoutChangeCompleted();
+            //! Refreshes the proxy model when the search index used by our own proxy models completed a query.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void handleSearchCompleted();
             //! This function is triggered by the Qtilities::Core::ObserverHints::ActionNewItem action.
             virtual void handle_actionNewItem_triggered();
             #ifndef QT_NO_DEBUG
@@ -15,6 +15,8 @@
 
 #include <QMenu>
 #include <QAction>
+#include <QTextCursor>
+#include <QTextDocument>
 
 using namespace Qtilities::CoreGui::Constants;
 using namespace Qtilities::CoreGui::Icons;
@@ -440,59 +442,102 @@ void SearchBoxWidget::handleReplacePrevious() {
 void SearchBoxWidget::handleReplaceAll() {
     if (d->widget_target == ExternalTarget)
         emit btnReplaceAll_clicked();
-    else if (d->widget_target == TextEdit && d->textEdit) {
-        int count = 0;
-
-        QTextCursor cursor = d->textEdit->textCursor();
-        int position = cursor.position();
-        cursor.setPosition(0);
-        cursor.beginEditBlock();
+    else if (d->widget_target == TextEdit && d->textEdit)
+        replaceAllInEditor(d->textEdit,d->textEdit->document());
+    else if (d->widget_target == PlainTextEdit && d->plainTextEdit)
+        replaceAllInEditor(d->plainTextEdit,d->plainTextEdit->document());
+}
+
+void SearchBoxWidget::replaceAllInEditor(QWidget* editor, QTextDocument* document) {
+    // Painting is suspended while replacing, the document is laid out once when the edit block ends:
+    bool updates_enabled = editor->updatesEnabled();
+    editor->setUpdatesEnabled(false);
+    int count = replaceAll(document,currentSearchString(),ui->txtReplaceString->text(),replacePatternSyntax(),findFlags());
+    editor->setUpdatesEnabled(updates_enabled);
+
+    if (count == 1)
+        setMessage(QString("<font color='green'>Replaced 1 occurance.</font>"));
+    else if (count > 1)
+        setMessage(QString("<font color='green'>Replaced %1 occurances.</font>").arg(count));
+    else
+        setMessage(QString("<font color='orange'>No occurance of your search string was found.</font>"));
+}
+
+int SearchBoxWidget::replaceAll(QTextDocument* document, const QString& search_string, const QString& replace_string, QRegExp::PatternSyntax pattern_syntax, QTextDocument::FindFlags find_flags) {
+    if (!document || search_string.isEmpty())
+        return 0;
+
+    Qt::CaseSensitivity cs = (find_flags & QTextDocument::FindCaseSensitively) ? Qt::CaseSensitive : Qt::CaseInsensitive;
+    QRegExp reg_exp(search_string,cs,pattern_syntax);
+    if (!reg_exp.isValid())
+        return 0;
+
+    const bool whole_words = (find_flags & QTextDocument::FindWholeWords);
+    const bool expand_captures = (pattern_syntax == QRegExp::RegExp && replace_string.contains(QLatin1Char('\\')));
+
+    // Positions in the plain text correspond to positions in the document since each
+    // block separator is represented by a single character in both:
+    const QString text = document->toPlainText();
+    QList<int> match_positions;
+    QList<int> match_lengths;
+    QStringList match_replacements;
+
+    int index = reg_exp.indexIn(text);
+    while (index >= 0) {
+        int length = reg_exp.matchedLength();
+        if (length <= 0) {
+            // Zero length matches are never replaced:
+            index = reg_exp.indexIn(text,index + 1);
+            continue;
+        }
 
-        d->textEdit->setTextCursor(cursor);
-        d->textEdit->find(currentSearchString(),findFlags());
-        while (d->textEdit->textCursor().hasSelection()) {
-            d->textEdit->textCursor().insertText(ui->txtReplaceString->text());
-            ++count;
-            d->textEdit->find(currentSearchString(),findFlags());
+        if (whole_words) {
+            bool word_start = (index == 0 || !(text.at(index-1).isLetterOrNumber() || text.at(index-1) == QLatin1Char('_')));
+            int end = index + length;
+            bool word_end = (end >= text.length() || !(text.at(end).isLetterOrNumber() || text.at(end) == QLatin1Char('_')));
+            if (!word_start || !word_end) {
+                index = reg_exp.indexIn(text,index + 1);
+                continue;
+            }
         }
 
-        cursor.endEditBlock();
-        cursor.setPosition(position);
-        d->textEdit->setTextCursor(cursor);
+        match_positions << index;
+        match_lengths << length;
+        if (expand_captures) {
+            QString replacement = replace_string;
+            for (int i = qMin(9,reg_exp.captureCount()); i >= 1; --i)
+                replacement.replace(QString("\\%1").arg(i),reg_exp.cap(i));
+            match_replacements << replacement;
+        }
 
-        if (count == 1)
-            setMessage(QString("<font color='green'>Replaced 1 occurance.</font>"));
-        else if (count > 1)
-            setMessage(QString("<font color='green'>Replaced %1 occurances.</font>").arg(count));
-        else
-            setMessage(QString("<font color='orange'>No occurance of your search string was found.</font>"));
-    } else if (d->widget_target == PlainTextEdit && d->plainTextEdit) {
-        int count = 0;
+        index = reg_exp.indexIn(text,index + length);
+    }
 
-        QTextCursor cursor = d->plainTextEdit->textCursor();
-        int position = cursor.position();
-        cursor.setPosition(0);
-        cursor.beginEditBlock();
+    if (match_positions.isEmpty())
+        return 0;
 
-        d->plainTextEdit->setTextCursor(cursor);
-        d->plainTextEdit->find(currentSearchString(),findFlags());
-        while (d->plainTextEdit->textCursor().hasSelection()) {
-            d->plainTextEdit->textCursor().insertText(ui->txtReplaceString->text());
-            ++count;
-            d->plainTextEdit->find(currentSearchString(),findFlags());
-        }
+    // Replace from the end backwards so that earlier positions stay valid:
+    QTextCursor cursor(document);
+    cursor.beginEditBlock();
+    for (int i = match_positions.count() - 1; i >= 0; --i) {
+        cursor.setPosition(match_positions.at(i));
+        cursor.setPosition(match_positions.at(i) + match_lengths.at(i),QTextCursor::KeepAnchor);
+        cursor.insertText(expand_captures ? match_replacements.at(i) : replace_string);
+    }
+    cursor.endEditBlock();
 
-        cursor.endEditBlock();
-        cursor.setPosition(position);
-        d->plainTextEdit->setTextCursor(cursor);
+    return match_positions.count();
+}
 
-        if (count == 1)
-            setMessage(QString("<font color='green'>Replaced 1 occurance.</font>"));
-        else if (count > 1)
-            setMessage(QString("<font color='green'>Replaced %1 occurances.</font>").arg(count));
-        else
-            setMessage(QString("<font color='orange'>No occurance of your search string was found.</font>"));
-    }
+QRegExp::PatternSyntax SearchBoxWidget::replacePatternSyntax() const {
+    // Only use pattern syntaxes which the user can see in the search options menu. Otherwise the search
+    // string is replaced literally, which is consistent with find next and find previous:
+    QRegExp::PatternSyntax pattern_syntax = patternSyntax();
+    if (pattern_syntax == QRegExp::RegExp && (d->search_options & RegEx))
+        return QRegExp::RegExp;
+    if (pattern_syntax == QRegExp::Wildcard && (d->search_options & RegWildcard))
+        return QRegExp::Wildcard;
+    return QRegExp::FixedString;
 }
 
 QTextDocument::FindFlags SearchBoxWidget::findFlags() const {
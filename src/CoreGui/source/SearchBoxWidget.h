@@ -200,6 +200,27 @@ searchBoxWidget->setPlainTextEditor(myTextEdit);
             void setMessage(const QString& message);
             //! Function which returns the QTextDocument::FindFlags for the current search options.
             QTextDocument::FindFlags findFlags() const;
+            //! Replaces all occurrences of a search string in a document in a single pass.
+            /*!
+              All matches are found in one pass over the document's text, after which they are replaced from the end of the
+              document backwards inside a single edit block. Thus the replacement can be undone in one undo step, and the
+              document is laid out only once.
+
+              \param document The document to operate on.
+              \param search_string The string to search for. It is interpreted according to \p pattern_syntax.
+              \param replace_string The replacement string. When \p pattern_syntax is QRegExp::RegExp, \\1 to \\9 in the replacement string
+              are replaced with the corresponding captured texts.
+              \param pattern_syntax The syntax of the search string.
+              \param find_flags QTextDocument::FindCaseSensitively and QTextDocument::FindWholeWords are supported.
+              \returns The number of replaced occurrences.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            static int replaceAll(QTextDocument* document,
+                                  const QString& search_string,
+                                  const QString& replace_string,
+                                  QRegExp::PatternSyntax pattern_syntax = QRegExp::FixedString,
+                                  QTextDocument::FindFlags find_flags = 0);
 
             //! Sets the information string text.
             void setInfoText(const QString& info_text);
@@ -258,6 +279,11 @@ searchBoxWidget->setPlainTextEditor(myTextEdit);
             void btnReplaceAll_clicked();
 
         private:
+            //! Returns the pattern syntax used by replace all, taking into account which pattern syntax options are available in the widget.
+            QRegExp::PatternSyntax replacePatternSyntax() const;
+            //! Performs replaceAll() on the document of an editor and reports the result in the widget.
+            void replaceAllInEditor(QWidget* editor, QTextDocument* document);
+
             Ui::SearchBoxWidget* ui;
             SearchBoxWidgetPrivateData* d;
         };
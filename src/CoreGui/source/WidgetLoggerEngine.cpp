@@ -24,9 +24,12 @@
 // ------------------------------------
 
 struct Qtilities::CoreGui::WidgetLoggerEnginePrivateData { 
+    WidgetLoggerEnginePrivateData() : maximum_line_count(1000) {}
+
     QPointer<WidgetLoggerEngineFrontend>            widget;
     WidgetLoggerEngine::MessageDisplaysFlag         message_displays_flag;
     Qt::ToolBarArea                                 toolbar_area;
+    int                                             maximum_line_count;
 };
 
 Qtilities::CoreGui::WidgetLoggerEngine::WidgetLoggerEngine(MessageDisplaysFlag message_displays_flag,
@@ -62,6 +65,7 @@ bool Qtilities::CoreGui::WidgetLoggerEngine::initialize() {
     abstractLoggerEngineData->is_initialized = true;
     d->widget = new WidgetLoggerEngineFrontend(d->message_displays_flag,
                                                d->toolbar_area);
+    d->widget->setMaximumLineCount(d->maximum_line_count);
     connect(d->widget,SIGNAL(destroyed(QObject*)),SLOT(deleteLater()));
 
     if (d->widget) {
@@ -115,6 +119,16 @@ void Qtilities::CoreGui::WidgetLoggerEngine::setLineWrapMode(QPlainTextEdit::Lin
         d->widget->setLineWrapMode(mode);
 }
 
+void Qtilities::CoreGui::WidgetLoggerEngine::setMaximumLineCount(int maximum_line_count) {
+    d->maximum_line_count = qMax(0,maximum_line_count);
+    if (d->widget)
+        d->widget->setMaximumLineCount(d->maximum_line_count);
+}
+
+int Qtilities::CoreGui::WidgetLoggerEngine::maximumLineCount() const {
+    return d->maximum_line_count;
+}
+
 QPlainTextEdit* Qtilities::CoreGui::WidgetLoggerEngine::plainTextEdit(MessageDisplaysFlag message_display) const {
     return d->widget->plainTextEdit(message_display);
 }
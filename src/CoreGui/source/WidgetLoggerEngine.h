@@ -47,6 +47,9 @@ namespace Qtilities {
 
         A logger engine which shows logged messages in a widget with a QPlainTextEdit widget.
 
+        Logged messages are buffered by the engine's frontend and shown in one batch per frame, thus logging large numbers of messages
+        does not stall the GUI. The number of lines kept in each message display is limited, see setMaximumLineCount().
+
         \note Clearing the log through clearLog() is supported by this logger engine.
           */
         class QTILITIES_CORE_GUI_SHARED_EXPORT WidgetLoggerEngine : public AbstractLoggerEngine
@@ -118,6 +121,20 @@ namespace Qtilities {
               \note Only available when your MessageDisplayFlags includes MessagesPlainTextEdit.
               */
             QPlainTextEdit* plainTextEdit(MessageDisplaysFlag message_display) const;
+            //! Sets the maximum number of lines shown in each message display. Old lines are removed when more lines are logged.
+            /*!
+              A value of 0 means that the number of lines is not limited. The default is 1000.
+
+              This function can be called before or after the engine was initialized.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void setMaximumLineCount(int maximum_line_count);
+            //! Gets the maximum number of lines shown in each message display.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            int maximumLineCount() const;
 
         public slots:
             void logMessage(const QString& message, Logger::MessageType message_type);
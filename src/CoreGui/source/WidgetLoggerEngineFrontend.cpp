@@ -34,6 +34,11 @@
 #include <QToolBar>
 #include <QDockWidget>
 #include <QTabBar>
+#include <QTextCursor>
+#include <QTextDocument>
+#include <QTimer>
+#include <QQueue>
+#include <QHash>
 
 using namespace Qtilities::Core;
 using namespace Qtilities::CoreGui;
@@ -113,6 +118,8 @@ Qtilities::CoreGui::MessagesPlainTextEditTab::MessagesPlainTextEditTab(QWidget *
     d->txtLog.setReadOnly(true);
     d->txtLog.setFont(QFont("Courier New"));
     d->txtLog.setMaximumBlockCount(1000);
+    // The log is read only, thus there is no need to keep an undo stack which grows with every message:
+    d->txtLog.setUndoRedoEnabled(false);
     d->txtLog.setFrameShape(QFrame::NoFrame);
 
     d->central_widget = new QWidget;
@@ -220,6 +227,33 @@ void Qtilities::CoreGui::MessagesPlainTextEditTab::appendMessage(const QString&
     // Note: d->txtLog.ensureCursorVisible() does not work becuase the log is read only and we don't have a cursor.
 }
 
+void Qtilities::CoreGui::MessagesPlainTextEditTab::appendMessages(const QStringList& messages) {
+    if (messages.isEmpty())
+        return;
+
+    // Messages which will be trimmed by the maximum block count of the document straight away don't need to be inserted:
+    int first = 0;
+    const int maximum_block_count = d->txtLog.maximumBlockCount();
+    if (maximum_block_count > 0 && messages.count() > maximum_block_count)
+        first = messages.count() - maximum_block_count;
+
+    QTextDocument* document = d->txtLog.document();
+    QTextCursor cursor(document);
+    cursor.movePosition(QTextCursor::End);
+    // A single edit block makes sure the document is laid out once for the complete batch:
+    cursor.beginEditBlock();
+    for (int i = first; i < messages.count(); ++i) {
+        // Same as appendHtml(): Each message gets its own block, which does not inherit the formatting of the previous message.
+        if (!document->isEmpty() || i > first)
+            cursor.insertBlock(QTextBlockFormat(),QTextCharFormat());
+        cursor.insertHtml(messages.at(i));
+    }
+    cursor.endEditBlock();
+
+    if (!d->frozen)
+        d->txtLog.verticalScrollBar()->setValue(d->txtLog.verticalScrollBar()->maximum());
+}
+
 void Qtilities::CoreGui::MessagesPlainTextEditTab::handle_FindPrevious() {
     QTextDocument::FindFlags find_flags = 0;
     if (d->searchBoxWidget->caseSensitive())
@@ -506,17 +540,76 @@ void MessagesPlainTextEditTab::clear() {
     d->txtLog.clear();
 }
 
+void MessagesPlainTextEditTab::setMaximumLineCount(int maximum_line_count) {
+    d->txtLog.setMaximumBlockCount(qMax(0,maximum_line_count));
+}
+
+int MessagesPlainTextEditTab::maximumLineCount() const {
+    return d->txtLog.maximumBlockCount();
+}
+
 // ----------------------------------------------
 // WidgetLoggerEngineFrontend
 // ----------------------------------------------
 
 
+namespace {
+    // A message in the message store shared by all message displays.
+    struct LoggedMessage {
+        LoggedMessage() : message_type(Logger::Info), ref_count(0) {}
+
+        QString             message;
+        Logger::MessageType message_type;
+        //! The number of message displays referencing this message.
+        int                 ref_count;
+    };
+
+    // A message display's view on the message store.
+    struct MessageDisplayView {
+        //! The sequence numbers of the messages which were not rendered in the display yet, oldest first.
+        /*!
+          Rendered messages are kept by the document of the display itself, thus they are not referenced by the view anymore.
+          */
+        QQueue<quint64>     pending_sequences;
+    };
+
+    bool displayAcceptsMessage(WidgetLoggerEngine::MessageDisplays message_display, Logger::MessageType message_type) {
+        switch (message_display) {
+        case WidgetLoggerEngine::AllMessagesPlainTextEdit:
+            return true;
+        case WidgetLoggerEngine::IssuesPlainTextEdit:
+            return (message_type & Logger::Warning || message_type & Logger::Error || message_type & Logger::Fatal);
+        case WidgetLoggerEngine::WarningsPlainTextEdit:
+            return (message_type & Logger::Warning);
+        case WidgetLoggerEngine::ErrorsPlainTextEdit:
+            return (message_type & Logger::Error || message_type & Logger::Fatal);
+        default:
+            return false;
+        }
+    }
+
+    // Messages are flushed to the displays once per frame:
+    const int qti_private_LOG_FLUSH_INTERVAL = 16;
+}
+
 struct Qtilities::CoreGui::WidgetLoggerEngineFrontendPrivateData {
-    WidgetLoggerEngineFrontendPrivateData() {}
+    WidgetLoggerEngineFrontendPrivateData() : next_sequence(0),
+        maximum_line_count(1000) {}
 
     WidgetLoggerEngine::MessageDisplaysFlag                         message_displays_flag;
     QMap<WidgetLoggerEngine::MessageDisplaysFlag,QWidget*>          message_displays;
     QMap<WidgetLoggerEngine::MessageDisplaysFlag,QDockWidget*>      message_display_docks;
+
+    //! The message store shared by all message displays, keyed by sequence number.
+    QHash<quint64,LoggedMessage>                                    message_store;
+    //! The views of the message displays on the message store.
+    QMap<WidgetLoggerEngine::MessageDisplays,MessageDisplayView>    message_views;
+    //! The sequence number of the next message.
+    quint64                                                         next_sequence;
+    //! The maximum number of lines shown in each display.
+    int                                                             maximum_line_count;
+    //! The timer used to flush buffered messages once per frame.
+    QTimer                                                          flush_timer;
 };
 
 Qtilities::CoreGui::WidgetLoggerEngineFrontend::WidgetLoggerEngineFrontend(WidgetLoggerEngine::MessageDisplaysFlag message_displays_flag,
@@ -525,6 +618,9 @@ Qtilities::CoreGui::WidgetLoggerEngineFrontend::WidgetLoggerEngineFrontend(Widge
 {
     d = new WidgetLoggerEngineFrontendPrivateData;
     d->message_displays_flag = message_displays_flag;
+    d->flush_timer.setSingleShot(true);
+    d->flush_timer.setInterval(qti_private_LOG_FLUSH_INTERVAL);
+    connect(&d->flush_timer,SIGNAL(timeout()),SLOT(flush()));
 
     // When only one message display is present we don't create it as a tab widget.
     if (message_displays_flag == WidgetLoggerEngine::AllMessagesPlainTextEdit ||
@@ -662,6 +758,12 @@ Qtilities::CoreGui::WidgetLoggerEngineFrontend::WidgetLoggerEngineFrontend(Widge
                 tabBar->setTabIcon(error_index,QIcon(qti_icon_ERROR_12x12));
         }
     }
+
+    QMapIterator<WidgetLoggerEngine::MessageDisplaysFlag,QWidget*> itr(d->message_displays);
+    while (itr.hasNext()) {
+        itr.next();
+        d->message_views[(WidgetLoggerEngine::MessageDisplays) (int) itr.key()] = MessageDisplayView();
+    }
 }
 
 Qtilities::CoreGui::WidgetLoggerEngineFrontend::~WidgetLoggerEngineFrontend() {
@@ -678,24 +780,127 @@ QPlainTextEdit* Qtilities::CoreGui::WidgetLoggerEngineFrontend::plainTextEdit(Wi
 }
 
 void WidgetLoggerEngineFrontend::appendMessage(const QString &message, Logger::MessageType message_type) {
-    MessagesPlainTextEditTab* plain_text_edit_tab = plainTextEditTab(WidgetLoggerEngine::AllMessagesPlainTextEdit);
+    const quint64 sequence = d->next_sequence++;
+    LoggedMessage logged_message;
+    logged_message.message = message;
+    logged_message.message_type = message_type;
+
+    // Add the message to the views of all displays accepting it. The message itself is stored only once:
+    QList<WidgetLoggerEngine::MessageDisplays> trimmed_views;
+    QMutableMapIterator<WidgetLoggerEngine::MessageDisplays,MessageDisplayView> itr(d->message_views);
+    while (itr.hasNext()) {
+        itr.next();
+        if (!displayAcceptsMessage(itr.key(),message_type))
+            continue;
+
+        MessageDisplayView& view = itr.value();
+        view.pending_sequences.enqueue(sequence);
+        ++logged_message.ref_count;
+        if (d->maximum_line_count > 0 && view.pending_sequences.count() > d->maximum_line_count)
+            trimmed_views << itr.key();
+    }
+
+    if (logged_message.ref_count == 0)
+        return;
+    d->message_store[sequence] = logged_message;
+
+    // Pending messages which would be trimmed by the display straight away are dropped:
+    for (int i = 0; i < trimmed_views.count(); ++i)
+        releaseMessage(d->message_views[trimmed_views.at(i)].pending_sequences.dequeue());
+
+    if (!d->flush_timer.isActive())
+        d->flush_timer.start();
+}
+
+void WidgetLoggerEngineFrontend::flush() {
+    d->flush_timer.stop();
+
+    QMapIterator<WidgetLoggerEngine::MessageDisplays,MessageDisplayView> itr(d->message_views);
+    while (itr.hasNext()) {
+        itr.next();
+        if (itr.value().pending_sequences.isEmpty())
+            continue;
+
+        // Displays in docks which are not visible (for example tabs which are not the current tab) are flushed when they become visible:
+        QDockWidget* dock = d->message_display_docks.value(itr.key());
+        if (dock && !dock->isVisible())
+            continue;
+
+        flushDisplay(itr.key());
+    }
+}
+
+void WidgetLoggerEngineFrontend::flushDisplay(WidgetLoggerEngine::MessageDisplaysFlag message_display) {
+    const WidgetLoggerEngine::MessageDisplays display = (WidgetLoggerEngine::MessageDisplays) (int) message_display;
+    if (!d->message_views.contains(display))
+        return;
+
+    MessageDisplayView& view = d->message_views[display];
+    if (view.pending_sequences.isEmpty())
+        return;
+
+    // Once rendered, the display does not need the messages from the store anymore:
+    QStringList messages;
+    messages.reserve(view.pending_sequences.count());
+    while (!view.pending_sequences.isEmpty()) {
+        const quint64 sequence = view.pending_sequences.dequeue();
+        messages << d->message_store.value(sequence).message;
+        releaseMessage(sequence);
+    }
+
+    MessagesPlainTextEditTab* plain_text_edit_tab = plainTextEditTab(message_display);
     if (plain_text_edit_tab)
-        plain_text_edit_tab->appendMessage(message);
+        plain_text_edit_tab->appendMessages(messages);
+}
 
-    plain_text_edit_tab = plainTextEditTab(WidgetLoggerEngine::IssuesPlainTextEdit);
-    if (plain_text_edit_tab && (message_type & Logger::Warning || message_type & Logger::Error || message_type & Logger::Fatal))
-        plain_text_edit_tab->appendMessage(message);
+void WidgetLoggerEngineFrontend::releaseMessage(quint64 sequence) {
+    QHash<quint64,LoggedMessage>::iterator itr = d->message_store.find(sequence);
+    if (itr == d->message_store.end())
+        return;
 
-    plain_text_edit_tab = plainTextEditTab(WidgetLoggerEngine::WarningsPlainTextEdit);
-    if (plain_text_edit_tab && (message_type & Logger::Warning))
-        plain_text_edit_tab->appendMessage(message);
+    if (--itr.value().ref_count <= 0)
+        d->message_store.erase(itr);
+}
 
-    plain_text_edit_tab = plainTextEditTab(WidgetLoggerEngine::ErrorsPlainTextEdit);
-    if (plain_text_edit_tab && (message_type & Logger::Error || message_type & Logger::Fatal))
-        plain_text_edit_tab->appendMessage(message);
+void WidgetLoggerEngineFrontend::setMaximumLineCount(int maximum_line_count) {
+    if (maximum_line_count < 0)
+        maximum_line_count = 0;
+    if (d->maximum_line_count == maximum_line_count)
+        return;
+    d->maximum_line_count = maximum_line_count;
+
+    QMutableMapIterator<WidgetLoggerEngine::MessageDisplays,MessageDisplayView> itr(d->message_views);
+    while (itr.hasNext()) {
+        itr.next();
+        MessageDisplayView& view = itr.value();
+        if (maximum_line_count > 0) {
+            while (view.pending_sequences.count() > maximum_line_count)
+                releaseMessage(view.pending_sequences.dequeue());
+        }
+
+        MessagesPlainTextEditTab* plain_text_edit_tab = plainTextEditTab((WidgetLoggerEngine::MessageDisplaysFlag) itr.key());
+        if (plain_text_edit_tab)
+            plain_text_edit_tab->setMaximumLineCount(maximum_line_count);
+    }
+}
+
+int WidgetLoggerEngineFrontend::maximumLineCount() const {
+    return d->maximum_line_count;
+}
+
+int WidgetLoggerEngineFrontend::storedMessageCount() const {
+    return d->message_store.count();
 }
 
 void WidgetLoggerEngineFrontend::clear() {
+    d->flush_timer.stop();
+    d->message_store.clear();
+    QMutableMapIterator<WidgetLoggerEngine::MessageDisplays,MessageDisplayView> itr(d->message_views);
+    while (itr.hasNext()) {
+        itr.next();
+        itr.setValue(MessageDisplayView());
+    }
+
     MessagesPlainTextEditTab* plain_text_edit_tab = plainTextEditTab(WidgetLoggerEngine::AllMessagesPlainTextEdit);
     if (plain_text_edit_tab)
         plain_text_edit_tab->clear();
@@ -727,6 +932,16 @@ void WidgetLoggerEngineFrontend::handle_dockVisibilityChanged(bool visible) {
         if (front_end) {
             CONTEXT_MANAGER->setNewContext(front_end->contextString(),true);
         }
+
+        // Render the messages which were buffered while the dock was hidden:
+        QMapIterator<WidgetLoggerEngine::MessageDisplaysFlag,QDockWidget*> itr(d->message_display_docks);
+        while (itr.hasNext()) {
+            itr.next();
+            if (itr.value() == dock) {
+                flushDisplay(itr.key());
+                break;
+            }
+        }
     }
 }
 
@@ -21,6 +21,7 @@
 #include <QMainWindow>
 #include <QPointer>
 #include <QPrinter>
+#include <QStringList>
 
 namespace Ui {
     class WidgetLoggerEngineFrontend;
@@ -93,9 +94,29 @@ namespace Qtilities {
 
             //! Clears the log.
             void clear();
+            //! Sets the maximum number of lines shown in the log. Old lines are removed when more lines are appended.
+            /*!
+              A value of 0 or less means that the number of lines is not limited. The default is 1000.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void setMaximumLineCount(int maximum_line_count);
+            //! Gets the maximum number of lines shown in the log.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            int maximumLineCount() const;
 
         public slots:
             void appendMessage(const QString& message);
+            //! Appends a batch of messages to the log.
+            /*!
+              All messages are inserted in a single edit operation on the document of the log and the log is scrolled only once, which
+              is much cheaper than calling appendMessage() for each message.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void appendMessages(const QStringList& messages);
 
             // Slots to respond to signals from GUI elements
             void handle_FindPrevious();
@@ -125,6 +146,14 @@ namespace Qtilities {
         /*!
         \class WidgetLoggerEngineFrontend
         \brief The visual frontend of a widget logger engine.
+
+        Messages appended to the frontend are kept in a single message store which is shared by all message displays. Each display is a
+        filtered view on this store, which references the messages it did not render yet. Messages are not rendered in the displays directly: they
+        are buffered and flushed to the displays in one batch per frame (see flush()). Displays which are not visible, for example tabs which are
+        not the current tab, are only updated when they become visible.
+
+        The number of lines shown in each display is limited by maximumLineCount(). A message is removed from the message store as soon as
+        all displays accepting it rendered it, thus the store only holds pending messages and each message is kept only once while it is pending.
           */
         class QTILITIES_CORE_GUI_SHARED_EXPORT WidgetLoggerEngineFrontend : public QMainWindow {
             Q_OBJECT
@@ -156,14 +185,46 @@ namespace Qtilities {
                 */
             QPlainTextEdit* plainTextEdit(WidgetLoggerEngine::MessageDisplaysFlag message_display) const;
 
+            //! Sets the maximum number of lines shown in each message display. Old lines are removed when more lines are appended.
+            /*!
+              A value of 0 or less means that the number of lines is not limited. The default is 1000.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void setMaximumLineCount(int maximum_line_count);
+            //! Gets the maximum number of lines shown in each message display.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            int maximumLineCount() const;
+            //! Returns the number of messages in the message store shared by the message displays.
+            /*!
+              Only messages which were not rendered by all displays accepting them yet are stored.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            int storedMessageCount() const;
+
         public slots:
             void appendMessage(const QString& message, Logger::MessageType message_type = Logger::Info);
             void clear();
             void handle_dockVisibilityChanged(bool visible);
             void setLineWrapMode(QPlainTextEdit::LineWrapMode mode);
+            //! Renders all buffered messages in the visible message displays immediately.
+            /*!
+              Buffered messages are flushed automatically once per frame. Call this function when the contents of the displays must be
+              up to date right away, for example before accessing them through plainTextEdit().
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void flush();
 
         private:
             MessagesPlainTextEditTab* plainTextEditTab(WidgetLoggerEngine::MessageDisplaysFlag message_display);
+            //! Renders the buffered messages of a single message display.
+            void flushDisplay(WidgetLoggerEngine::MessageDisplaysFlag message_display);
+            //! Releases a reference to a message in the message store, removing the message when it is not referenced anymore.
+            void releaseMessage(quint64 sequence);
             WidgetLoggerEngineFrontendPrivateData* d;
         };
     }
@@ -34,6 +34,8 @@ UI_DIR = $$QTILITIES_TEMP/Logging
 HEADERS += \
     source/AbstractFormattingEngine.h \
     source/AbstractLoggerEngine.h \
+    source/BinaryLoggerEngine.h \
+    source/BinaryLogReader.h \
     source/FormattingEngines.h \
     source/ILoggerExportable.h \
     source/LoggerEngines.h \
@@ -43,7 +45,10 @@ HEADERS += \
     source/Logging_global.h \
 
 SOURCES += \
+    source/AbstractFormattingEngine.cpp \
     source/AbstractLoggerEngine.cpp \
+    source/BinaryLoggerEngine.cpp \
+    source/BinaryLogReader.cpp \
     source/FormattingEngines.cpp \
     source/Logger.cpp \
     source/LoggerEngines.cpp \
@@ -0,0 +1,184 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#include "AbstractFormattingEngine.h"
+
+#include <QDateTime>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QVector>
+
+using namespace Qtilities::Logging;
+
+namespace {
+    // A color formatting hint prepared for matching.
+    struct CompiledFormattingHint {
+        CompiledFormattingHint() : match_type(MatchRegExp),
+            case_sensitivity(Qt::CaseSensitive) {}
+
+        enum MatchType {
+            MatchExact,         // The pattern does not contain any wildcards.
+            MatchPrefix,        // The pattern only contains a trailing '*' wildcard.
+            MatchRegExp         // The pattern is matched using regexp.
+        };
+
+        MatchType                   match_type;
+        QString                     text;
+        Qt::CaseSensitivity         case_sensitivity;
+        QRegExp                     regexp;
+        QString                     hint;
+        Logger::MessageTypeFlags    message_type_flags;
+    };
+
+    CompiledFormattingHint compileFormattingHint(const CustomFormattingHint& custom_hint) {
+        CompiledFormattingHint compiled_hint;
+        compiled_hint.hint = custom_hint.d_hint;
+        compiled_hint.message_type_flags = custom_hint.d_message_type_flags;
+        compiled_hint.case_sensitivity = custom_hint.d_regexp.caseSensitivity();
+        compiled_hint.regexp = custom_hint.d_regexp;
+
+        const QRegExp::PatternSyntax syntax = custom_hint.d_regexp.patternSyntax();
+        QString pattern = custom_hint.d_regexp.pattern();
+        bool fixed_string = (syntax == QRegExp::FixedString);
+        if (syntax == QRegExp::Wildcard || syntax == QRegExp::WildcardUnix) {
+            bool prefix = pattern.endsWith(QLatin1Char('*'));
+            if (prefix)
+                pattern.chop(1);
+            if (!pattern.contains(QLatin1Char('*')) && !pattern.contains(QLatin1Char('?')) && !pattern.contains(QLatin1Char('['))
+                    && !pattern.contains(QLatin1Char('\\'))) {
+                compiled_hint.match_type = prefix ? CompiledFormattingHint::MatchPrefix : CompiledFormattingHint::MatchExact;
+                compiled_hint.text = pattern;
+            }
+        } else if (fixed_string) {
+            compiled_hint.match_type = CompiledFormattingHint::MatchExact;
+            compiled_hint.text = pattern;
+        }
+
+        return compiled_hint;
+    }
+}
+
+struct Qtilities::Logging::AbstractFormattingEnginePrivateData {
+    AbstractFormattingEnginePrivateData() : cached_message_type(Logger::None),
+        cached_second(-1),
+        cache_hits(0),
+        compiled_hints_dirty(false) {}
+
+    //! The type of the message cached by formatMessageCached().
+    Logger::MessageType             cached_message_type;
+    //! The second (since epoch) during which the cached message was formatted.
+    qint64                          cached_second;
+    //! The contents of the cached message.
+    QList<QVariant>                 cached_messages;
+    //! The formatted cached message.
+    QString                         cached_result;
+    //! The number of cache hits in formatMessageCached().
+    int                             cache_hits;
+    //! Mutex protecting the cache.
+    QMutex                          cache_mutex;
+
+    //! The compiled color formatting hints, in the same order as color_formatting_hints.
+    QVector<CompiledFormattingHint> compiled_hints;
+    //! Indicates that compiled_hints must be compiled again.
+    bool                            compiled_hints_dirty;
+    //! Mutex protecting compiled_hints. QRegExp matching is not thread safe.
+    QMutex                          hints_mutex;
+};
+
+Qtilities::Logging::AbstractFormattingEngine::AbstractFormattingEngine() : QObject() {
+    d = new AbstractFormattingEnginePrivateData;
+}
+
+Qtilities::Logging::AbstractFormattingEngine::~AbstractFormattingEngine() {
+    delete d;
+}
+
+QString Qtilities::Logging::AbstractFormattingEngine::formatMessageCached(Logger::MessageType message_type, const QList<QVariant>& messages) const {
+    if (!isFormattingCacheable())
+        return formatMessage(message_type,messages);
+
+    const qint64 second = QDateTime::currentMSecsSinceEpoch() / 1000;
+
+    QMutexLocker locker(&d->cache_mutex);
+    // QList::operator==() returns directly when both lists share the same data, which is the case when the message is the same:
+    if (d->cached_second == second && d->cached_message_type == message_type && d->cached_messages == messages) {
+        ++d->cache_hits;
+        return d->cached_result;
+    }
+
+    d->cached_result = formatMessage(message_type,messages);
+    d->cached_message_type = message_type;
+    d->cached_messages = messages;
+    d->cached_second = second;
+    return d->cached_result;
+}
+
+int Qtilities::Logging::AbstractFormattingEngine::formattingCacheHits() const {
+    QMutexLocker locker(&d->cache_mutex);
+    return d->cache_hits;
+}
+
+bool Qtilities::Logging::AbstractFormattingEngine::addColorFormattingHint(CustomFormattingHint color_formatting_hint) {
+    if (!color_formatting_hint.d_regexp.isValid())
+        return false;
+
+    QMutexLocker locker(&d->hints_mutex);
+    color_formatting_hints.append(color_formatting_hint);
+    d->compiled_hints_dirty = true;
+    return true;
+}
+
+void Qtilities::Logging::AbstractFormattingEngine::clearColorFormattingHints() {
+    QMutexLocker locker(&d->hints_mutex);
+    color_formatting_hints.clear();
+    d->compiled_hints_dirty = true;
+}
+
+void Qtilities::Logging::AbstractFormattingEngine::removeColorFormattingHint(CustomFormattingHint custom_formatting_hint) {
+    QMutexLocker locker(&d->hints_mutex);
+    color_formatting_hints.removeOne(custom_formatting_hint);
+    d->compiled_hints_dirty = true;
+}
+
+QString Qtilities::Logging::AbstractFormattingEngine::matchColorFormattingHint(const QString& message, Logger::MessageTypeFlags message_type_flags) const {
+    QMutexLocker locker(&d->hints_mutex);
+    // Subclasses can change color_formatting_hints directly, in which case we detect the change through the count:
+    if (d->compiled_hints_dirty || d->compiled_hints.count() != color_formatting_hints.count()) {
+        d->compiled_hints.clear();
+        d->compiled_hints.reserve(color_formatting_hints.count());
+        for (int i = 0; i < color_formatting_hints.count(); ++i)
+            d->compiled_hints.append(compileFormattingHint(color_formatting_hints.at(i)));
+        d->compiled_hints_dirty = false;
+    }
+
+    for (int i = 0; i < d->compiled_hints.count(); ++i) {
+        CompiledFormattingHint& hint = d->compiled_hints[i];
+        if (!(hint.message_type_flags & message_type_flags))
+            continue;
+
+        switch (hint.match_type) {
+        case CompiledFormattingHint::MatchExact:
+            if (message.compare(hint.text,hint.case_sensitivity) == 0)
+                return hint.hint;
+            break;
+        case CompiledFormattingHint::MatchPrefix:
+            if (message.startsWith(hint.text,hint.case_sensitivity))
+                return hint.hint;
+            break;
+        case CompiledFormattingHint::MatchRegExp:
+            if (hint.regexp.exactMatch(message))
+                return hint.hint;
+            break;
+        }
+    }
+
+    return QString();
+}
@@ -21,6 +21,12 @@
 
 namespace Qtilities {
     namespace Logging {
+        /*!
+        \struct AbstractFormattingEnginePrivateData
+        \brief Structure used by AbstractFormattingEngine to store private data.
+          */
+        struct AbstractFormattingEnginePrivateData;
+
         /*!
           \struct CustomFormattingHint
           \brief The CustomFormattingHint structure is used to define custom formatting hints for logger formatting engines.
@@ -116,6 +122,16 @@ if (rich_text_engine) {
         Note that previous versions of %Qtilities had the above rule built in to FormattingEngine_Rich_Text in order to match successfull messages.
         Since that design was flawed because it depended on English as your language, this built in functionality was removed and you must now set the above rule
         manually if you depended on the previous mode of operation.
+
+        Color formatting hints are compiled when they are added. Wildcard expressions which only contain a trailing <tt>*</tt> (such as the example above) or no
+        wildcards at all are matched using plain string comparisons, other expressions are matched using a private copy of their QRegExp.
+
+        \section AbstractFormattingEngine_caching Formatted Message Caching
+
+        All logger engines using the same formatting engine share a single instance of it. Logger engines format messages through formatMessageCached(),
+        which remembers the last message formatted by the engine. Thus, when multiple logger engines (for example three file logger engines) use the same
+        formatting engine, each message is formatted only once. Formatting engines which do not produce the same output for the same message type, message contents
+        and second in which a message is logged must reimplement isFormattingCacheable() to return false.
           */
         class LOGGING_SHARED_EXPORT AbstractFormattingEngine : public QObject
         {
@@ -123,8 +139,8 @@ if (rich_text_engine) {
         Q_PROPERTY(QString FileExtension READ fileExtension)
 
         public:
-            AbstractFormattingEngine() {}
-            virtual ~AbstractFormattingEngine() {}
+            AbstractFormattingEngine();
+            virtual ~AbstractFormattingEngine();
 
             //! Function which is used to provide the initialization string for the logger engine. This string will be sent to the logger engine before any messages.
             virtual QString initializeString() const = 0;
@@ -152,6 +168,31 @@ if (rich_text_engine) {
             }
             //! Function which provides the end of line character used by the formatting engine.
             virtual QString endOfLineChar() const = 0;
+            //! Indicates if the output of formatMessage() may be reused for messages with the same type and contents logged during the same second.
+            /*!
+              The default implementation returns false. All formatting engines provided by %Qtilities return true.
+
+              \sa formatMessageCached()
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            virtual bool isFormattingCacheable() const {
+                return false;
+            }
+            //! Formats a message using formatMessage(), reusing the result of the previous call when the same message is formatted again.
+            /*!
+              When isFormattingCacheable() is true, the result of the last formatted message is kept. It is returned when a message with the same type and
+              contents is formatted during the same second, which is the case when multiple logger engines using this formatting engine receive the same message.
+              Comparing the contents is cheap in that case since the logger engines receive implicitly shared copies of the same message list.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            QString formatMessageCached(Logger::MessageType message_type, const QList<QVariant>& messages) const;
+            //! Returns the number of times formatMessageCached() reused a previously formatted message.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            int formattingCacheHits() const;
 
             // ------------------------------------
             // Custom Formatting Hints Interface
@@ -167,13 +208,7 @@ if (rich_text_engine) {
 
               <i>This function was added in %Qtilities v1.1.</i>
               */
-            bool addColorFormattingHint(CustomFormattingHint color_formatting_hint) {
-                if (!color_formatting_hint.d_regexp.isValid())
-                    return false;
-
-                color_formatting_hints.append(color_formatting_hint);
-                return true;
-            }
+            bool addColorFormattingHint(CustomFormattingHint color_formatting_hint);
             //! Returns all color formatting hint rules specified for this engine.
             /*!
               \returns A QMap with the keys beign the expressions, and the values the CustomFormattingHint describing the format (with the hint being the color, such as "#112233").
@@ -187,16 +222,12 @@ if (rich_text_engine) {
             /*!
               <i>This function was added in %Qtilities v1.1.</i>
               */
-            void clearColorFormattingHints() {
-                color_formatting_hints.clear();
-            }
+            void clearColorFormattingHints();
             //! Removes a specific color formatting hint.
             /*!
               <i>This function was added in %Qtilities v1.1.</i>
               */
-            void removeColorFormattingHint(CustomFormattingHint custom_formatting_hint) {
-                color_formatting_hints.removeOne(custom_formatting_hint);
-            }
+            void removeColorFormattingHint(CustomFormattingHint custom_formatting_hint);
             //! Checks a color formatting hint against a log message to see if they match.
             /*!
               This function will check the message type and the message contents against all color
@@ -206,19 +237,21 @@ if (rich_text_engine) {
 
               <i>This function was added in %Qtilities v1.1.</i>
               */
-            QString matchColorFormattingHint(const QString& message, Logger::MessageTypeFlags message_type_flags) const {
-                for (int i = 0; i < color_formatting_hints.count(); i++) {
-                    CustomFormattingHint hint = color_formatting_hints.at(i);
-                    if (hint.d_message_type_flags & message_type_flags) {
-                        if (hint.d_regexp.exactMatch(message))
-                            return hint.d_hint;
-                    }
-                }
-
-                return "";
-            }
+            QString matchColorFormattingHint(const QString& message, Logger::MessageTypeFlags message_type_flags) const;
             //! Function that does the same as QTextDocument::escape(). Since the Logging module does not depend on QtGui, we cannot use that function directly.
             static QString escape(const QString& plain) {
+                // Most messages contain nothing to escape, in which case the string is returned without copying it:
+                const QChar* data = plain.constData();
+                const int length = plain.length();
+                int i = 0;
+                for (; i < length; ++i) {
+                    const ushort c = data[i].unicode();
+                    if (c == '<' || c == '>' || c == '&' || c == '"')
+                        break;
+                }
+                if (i == length)
+                    return plain;
+
                 // This code is exactly the same as the code found in QTextDocument::escape()
                 QString rich;
                 rich.reserve(int(plain.length() * 1.1));
@@ -239,6 +272,9 @@ if (rich_text_engine) {
 
         protected:
             QList<CustomFormattingHint> color_formatting_hints;
+
+        private:
+            AbstractFormattingEnginePrivateData* d;
         };
     }
 }
@@ -41,6 +41,7 @@ void Qtilities::Logging::AbstractLoggerEngine::setActive(bool is_active) {
         return;
 
     abstractLoggerEngineData->is_enabled = is_active;
+    Log->invalidateAcceptedMessageTypes();
 }
 
 void Qtilities::Logging::AbstractLoggerEngine::setName(const QString& name) {
@@ -50,6 +51,7 @@ void Qtilities::Logging::AbstractLoggerEngine::setName(const QString& name) {
 
 void Qtilities::Logging::AbstractLoggerEngine::setEnabledMessageTypes(Logger::MessageTypeFlags message_types) {
     abstractLoggerEngineData->enabled_message_types = message_types;
+    Log->invalidateAcceptedMessageTypes();
 }
 
 Qtilities::Logging::Logger::MessageTypeFlags Qtilities::Logging::AbstractLoggerEngine::getEnabledMessageTypes() const {
@@ -64,6 +66,7 @@ void Qtilities::Logging::AbstractLoggerEngine::enableAllMessageTypes() {
     abstractLoggerEngineData->enabled_message_types |= Logger::Fatal;
     abstractLoggerEngineData->enabled_message_types |= Logger::Debug;
     abstractLoggerEngineData->enabled_message_types |= Logger::Trace;
+    Log->invalidateAcceptedMessageTypes();
 }
 
 void Qtilities::Logging::AbstractLoggerEngine::installFormattingEngine(AbstractFormattingEngine* engine) {
@@ -110,13 +113,18 @@ void Qtilities::Logging::AbstractLoggerEngine::newMessages(const QString& engine
         if (abstractLoggerEngineData->formatting_engine) {
             //Check if this message type is allowed
             if (abstractLoggerEngineData->enabled_message_types & message_type)
-                logMessage(abstractLoggerEngineData->formatting_engine->formatMessage(message_type,messages),message_type);
+                logMessage(abstractLoggerEngineData->formatting_engine->formatMessageCached(message_type,messages),message_type);
         }
     }
 
     mutex.unlock();
 }
 
+void Qtilities::Logging::AbstractLoggerEngine::setMessageContexts(Logger::MessageContextFlags message_contexts) {
+    abstractLoggerEngineData->message_contexts = message_contexts;
+    Log->invalidateAcceptedMessageTypes();
+}
+
 bool Qtilities::Logging::AbstractLoggerEngine::removable() const {
     return abstractLoggerEngineData->is_removable;
 }
@@ -117,7 +117,7 @@ namespace Qtilities {
             //! Returns the logging contexts for which this engine accepts messages.
             inline Logger::MessageContextFlags messageContexts() const { return abstractLoggerEngineData->message_contexts; }
             //! Sets the logging contexts for which this engine accepts messages.
-            void setMessageContexts(Logger::MessageContextFlags message_contexts) { abstractLoggerEngineData->message_contexts = message_contexts; }
+            void setMessageContexts(Logger::MessageContextFlags message_contexts);
 
         public slots:
             //! Function which is called to finalize the logger engine.
@@ -0,0 +1,472 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#include "BinaryLogReader.h"
+#include "AbstractFormattingEngine.h"
+#include "FormattingEngines.h"
+
+#include <QDataStream>
+#include <QFile>
+#include <QHash>
+#include <QTextStream>
+#include <QVector>
+
+using namespace Qtilities::Logging;
+
+const quint32 Qtilities::Logging::BinaryLogReader::FileMagic = 0x514C4F47; // "QLOG"
+const quint32 Qtilities::Logging::BinaryLogReader::FormatVersion = 1;
+const int Qtilities::Logging::BinaryLogReader::TrailerSize = 17;
+
+namespace {
+    // The size of the header of each block: the block type (quint8) and the size of its contents (quint32).
+    const int qti_private_BLOCK_HEADER_SIZE = 5;
+
+    // A range of blocks in the file, described by the index block following it.
+    struct BinaryLogSegment {
+        BinaryLogSegment() : start(0), end(0), first_msecs(0), last_msecs(0),
+            message_types(0), record_count(0), indexed(false) {}
+
+        qint64  start;
+        qint64  end;
+        qint64  first_msecs;
+        qint64  last_msecs;
+        quint32 message_types;
+        quint32 record_count;
+        // Segments at the end of files which were not finalized are not described by an index block.
+        bool    indexed;
+    };
+
+    // Reads a string field or message part written by BinaryLoggerEngine.
+    QVariant readPart(QDataStream& stream, const QHash<quint32,QString>& strings) {
+        quint8 part_kind;
+        stream >> part_kind;
+        if (part_kind == BinaryLogReader::InternedStringPart) {
+            quint32 id;
+            stream >> id;
+            return strings.value(id);
+        } else if (part_kind == BinaryLogReader::InlineStringPart) {
+            QString string;
+            stream >> string;
+            return string;
+        }
+
+        QVariant part;
+        stream >> part;
+        return part;
+    }
+}
+
+struct Qtilities::Logging::BinaryLogReaderPrivateData {
+    BinaryLogReaderPrivateData() : session_start_msecs(0),
+        finalized(false),
+        data_start(0),
+        data_end(0),
+        from_msecs(Q_INT64_C(-9223372036854775807) - 1),
+        to_msecs(Q_INT64_C(9223372036854775807)),
+        message_types(Logger::AllLogLevels | Logger::None),
+        current_segment(-1),
+        skipped_segments(0) {}
+
+    QFile                       file;
+    QDataStream                 stream;
+    QString                     application_name;
+    qint64                      session_start_msecs;
+    bool                        finalized;
+    //! The position of the first block in the file.
+    qint64                      data_start;
+    //! The position after the last complete block in the file, excluding the trailer.
+    qint64                      data_end;
+    QVector<BinaryLogSegment>   segments;
+    //! The string table of the file.
+    QHash<quint32,QString>      strings;
+
+    qint64                      from_msecs;
+    qint64                      to_msecs;
+    Logger::MessageTypeFlags    message_types;
+
+    //! The segment being read, or -1 before the first segment.
+    int                         current_segment;
+    int                         skipped_segments;
+};
+
+Qtilities::Logging::BinaryLogReader::BinaryLogReader() {
+    d = new BinaryLogReaderPrivateData;
+    d->stream.setVersion(QDataStream::Qt_4_7);
+}
+
+Qtilities::Logging::BinaryLogReader::~BinaryLogReader() {
+    close();
+    delete d;
+}
+
+bool Qtilities::Logging::BinaryLogReader::open(const QString& file_name, QString* errorMsg) {
+    close();
+
+    d->file.setFileName(file_name);
+    if (!d->file.open(QIODevice::ReadOnly)) {
+        if (errorMsg)
+            *errorMsg = QString("The file could not be opened for reading: %1").arg(file_name);
+        return false;
+    }
+    d->stream.setDevice(&d->file);
+
+    quint32 magic;
+    quint32 version;
+    d->stream >> magic;
+    d->stream >> version;
+    if (d->stream.status() != QDataStream::Ok || magic != FileMagic) {
+        if (errorMsg)
+            *errorMsg = QString("The file is not a binary log file: %1").arg(file_name);
+        close();
+        return false;
+    }
+    if (version > FormatVersion) {
+        if (errorMsg)
+            *errorMsg = QString("The binary log file was written by a newer version of the logging module (format version %1): %2").arg(version).arg(file_name);
+        close();
+        return false;
+    }
+    d->stream >> d->session_start_msecs;
+    d->stream >> d->application_name;
+    if (d->stream.status() != QDataStream::Ok) {
+        if (errorMsg)
+            *errorMsg = QString("The header of the binary log file is corrupt: %1").arg(file_name);
+        close();
+        return false;
+    }
+    d->data_start = d->file.pos();
+
+    // Check for the trailer, which is only present when the engine was finalized properly:
+    d->finalized = false;
+    const qint64 file_size = d->file.size();
+    if (file_size >= d->data_start + TrailerSize && d->file.seek(file_size - TrailerSize)) {
+        quint8 block_type;
+        quint32 block_size;
+        qint64 last_index_offset;
+        quint32 end_magic;
+        d->stream >> block_type >> block_size >> last_index_offset >> end_magic;
+        if (d->stream.status() == QDataStream::Ok && block_type == TrailerBlock && block_size == sizeof(qint64) && end_magic == FileMagic) {
+            d->data_end = file_size - TrailerSize;
+            d->finalized = indexFromTrailer(last_index_offset);
+        }
+        d->stream.resetStatus();
+    }
+
+    if (!d->finalized) {
+        d->segments.clear();
+        d->strings.clear();
+        if (!indexByScanning(errorMsg)) {
+            close();
+            return false;
+        }
+    }
+
+    rewind();
+    return true;
+}
+
+void Qtilities::Logging::BinaryLogReader::close() {
+    d->stream.setDevice(0);
+    d->stream.resetStatus();
+    if (d->file.isOpen())
+        d->file.close();
+    d->application_name.clear();
+    d->session_start_msecs = 0;
+    d->finalized = false;
+    d->data_start = 0;
+    d->data_end = 0;
+    d->segments.clear();
+    d->strings.clear();
+    d->current_segment = -1;
+    d->skipped_segments = 0;
+}
+
+bool Qtilities::Logging::BinaryLogReader::isOpen() const {
+    return d->file.isOpen();
+}
+
+QString Qtilities::Logging::BinaryLogReader::fileName() const {
+    return d->file.fileName();
+}
+
+QString Qtilities::Logging::BinaryLogReader::applicationName() const {
+    return d->application_name;
+}
+
+QDateTime Qtilities::Logging::BinaryLogReader::sessionStart() const {
+    return QDateTime::fromMSecsSinceEpoch(d->session_start_msecs);
+}
+
+bool Qtilities::Logging::BinaryLogReader::isFinalized() const {
+    return d->finalized;
+}
+
+int Qtilities::Logging::BinaryLogReader::segmentCount() const {
+    return d->segments.count();
+}
+
+void Qtilities::Logging::BinaryLogReader::setTimeRange(const QDateTime& from, const QDateTime& to) {
+    d->from_msecs = from.isValid() ? from.toMSecsSinceEpoch() : Q_INT64_C(-9223372036854775807) - 1;
+    d->to_msecs = to.isValid() ? to.toMSecsSinceEpoch() : Q_INT64_C(9223372036854775807);
+    rewind();
+}
+
+void Qtilities::Logging::BinaryLogReader::setMessageTypes(Logger::MessageTypeFlags message_types) {
+    d->message_types = message_types;
+    rewind();
+}
+
+Qtilities::Logging::Logger::MessageTypeFlags Qtilities::Logging::BinaryLogReader::messageTypes() const {
+    return d->message_types;
+}
+
+void Qtilities::Logging::BinaryLogReader::rewind() {
+    d->current_segment = -1;
+    d->skipped_segments = 0;
+}
+
+bool Qtilities::Logging::BinaryLogReader::readNext(BinaryLogRecord* record) {
+    if (!isOpen() || !record)
+        return false;
+
+    forever {
+        if (d->current_segment >= 0 && readRecordInSegment(record))
+            return true;
+        if (!nextSegment())
+            return false;
+    }
+}
+
+int Qtilities::Logging::BinaryLogReader::skippedSegmentCount() const {
+    return d->skipped_segments;
+}
+
+int Qtilities::Logging::BinaryLogReader::convert(QIODevice* device, AbstractFormattingEngine* formatting_engine) {
+    if (!isOpen() || !device || !formatting_engine || !device->isWritable())
+        return -1;
+
+    rewind();
+    QTextStream out(device);
+    out << formatting_engine->initializeString() << "\n";
+
+    int count = 0;
+    BinaryLogRecord record;
+    FormattingEngineTimeStampOverride time_stamp_override;
+    while (readNext(&record)) {
+        time_stamp_override.setTimeStamp(record.timestamp());
+        out << formatting_engine->formatMessage(record.d_message_type,record.d_message_parts) << "\n";
+        ++count;
+    }
+
+    out << formatting_engine->finalizeString() << "\n";
+    out.flush();
+    rewind();
+    return count;
+}
+
+int Qtilities::Logging::BinaryLogReader::convert(const QString& output_file_name, AbstractFormattingEngine* formatting_engine, QString* errorMsg) {
+    QFile file(output_file_name);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        if (errorMsg)
+            *errorMsg = QString("The output file could not be opened for writing: %1").arg(output_file_name);
+        return -1;
+    }
+
+    int count = convert(&file,formatting_engine);
+    file.close();
+    if (count < 0 && errorMsg)
+        *errorMsg = QString("No binary log file is open, or the formatting engine is invalid.");
+    return count;
+}
+
+bool Qtilities::Logging::BinaryLogReader::nextSegment() {
+    ++d->current_segment;
+    while (d->current_segment < d->segments.count()) {
+        const BinaryLogSegment& segment = d->segments.at(d->current_segment);
+        if (!segment.indexed)
+            break;
+        if (segment.record_count > 0 && (segment.message_types & d->message_types) && segment.last_msecs >= d->from_msecs && segment.first_msecs <= d->to_msecs)
+            break;
+
+        ++d->skipped_segments;
+        ++d->current_segment;
+    }
+
+    if (d->current_segment >= d->segments.count())
+        return false;
+
+    d->stream.resetStatus();
+    return d->file.seek(d->segments.at(d->current_segment).start);
+}
+
+bool Qtilities::Logging::BinaryLogReader::readRecordInSegment(BinaryLogRecord* record) {
+    const qint64 segment_end = d->segments.at(d->current_segment).end;
+
+    qint64 block_start = d->file.pos();
+    while (block_start + qti_private_BLOCK_HEADER_SIZE <= segment_end) {
+        quint8 block_type;
+        quint32 block_size;
+        d->stream >> block_type >> block_size;
+        const qint64 block_end = block_start + qti_private_BLOCK_HEADER_SIZE + block_size;
+        if (d->stream.status() != QDataStream::Ok || block_end > segment_end)
+            return false;
+
+        if (block_type == StringBlock) {
+            quint32 id;
+            QString string;
+            d->stream >> id >> string;
+            d->strings.insert(id,string);
+        } else if (block_type == RecordBlock) {
+            qint64 msecs;
+            quint32 message_type;
+            d->stream >> msecs >> message_type;
+
+            // Only decode the rest of the record when it matches:
+            if ((d->message_types & message_type) && msecs >= d->from_msecs && msecs <= d->to_msecs) {
+                quint32 message_context;
+                quint32 part_count;
+                d->stream >> message_context >> record->d_thread_id;
+                record->d_thread_name = readPart(d->stream,d->strings).toString();
+                record->d_engine_name = readPart(d->stream,d->strings).toString();
+                d->stream >> part_count;
+                record->d_message_parts.clear();
+                for (quint32 i = 0; i < part_count && d->stream.status() == QDataStream::Ok; ++i)
+                    record->d_message_parts.append(readPart(d->stream,d->strings));
+
+                if (d->stream.status() != QDataStream::Ok)
+                    return false;
+
+                record->d_msecs_since_epoch = msecs;
+                record->d_message_type = (Logger::MessageType) message_type;
+                record->d_message_context = (Logger::MessageContextFlags) message_context;
+                d->file.seek(block_end);
+                return true;
+            }
+        }
+
+        // Skip the remainder of the block. Index blocks inside segments are only found in files which were indexed by scanning.
+        if (!d->file.seek(block_end))
+            return false;
+        block_start = block_end;
+    }
+
+    return false;
+}
+
+bool Qtilities::Logging::BinaryLogReader::indexByScanning(QString* errorMsg) {
+    const qint64 file_size = d->file.size();
+    qint64 segment_start = d->data_start;
+    qint64 block_start = d->data_start;
+
+    d->stream.resetStatus();
+    d->file.seek(block_start);
+    while (block_start + qti_private_BLOCK_HEADER_SIZE <= file_size) {
+        quint8 block_type;
+        quint32 block_size;
+        d->stream >> block_type >> block_size;
+        const qint64 block_end = block_start + qti_private_BLOCK_HEADER_SIZE + block_size;
+        // The last block in a file which was not finalized may be incomplete:
+        if (d->stream.status() != QDataStream::Ok || block_end > file_size)
+            break;
+
+        if (block_type == StringBlock) {
+            quint32 id;
+            QString string;
+            d->stream >> id >> string;
+            d->strings.insert(id,string);
+        } else if (block_type == IndexBlock) {
+            BinaryLogSegment segment;
+            qint64 previous_index_offset;
+            d->stream >> segment.start >> previous_index_offset >> segment.first_msecs >> segment.last_msecs;
+            d->stream >> segment.message_types >> segment.record_count;
+            segment.start = segment_start;
+            segment.end = block_start;
+            segment.indexed = true;
+            d->segments.append(segment);
+            segment_start = block_end;
+        } else if (block_type == TrailerBlock) {
+            break;
+        }
+
+        if (d->stream.status() != QDataStream::Ok || !d->file.seek(block_end))
+            break;
+        block_start = block_end;
+    }
+
+    if (block_start == d->data_start && block_start + qti_private_BLOCK_HEADER_SIZE <= file_size) {
+        if (errorMsg)
+            *errorMsg = QString("The binary log file is corrupt: %1").arg(d->file.fileName());
+        return false;
+    }
+
+    // Messages after the last index block are not described by an index block:
+    d->data_end = block_start;
+    if (segment_start < d->data_end) {
+        BinaryLogSegment segment;
+        segment.start = segment_start;
+        segment.end = d->data_end;
+        d->segments.append(segment);
+    }
+
+    d->stream.resetStatus();
+    return true;
+}
+
+bool Qtilities::Logging::BinaryLogReader::indexFromTrailer(qint64 last_index_offset) {
+    QVector<BinaryLogSegment> segments;
+    qint64 data_end = d->data_end;
+
+    // Follow the chain of index blocks backwards:
+    qint64 index_offset = last_index_offset;
+    qint64 indexed_end = d->data_start;
+    while (index_offset >= d->data_start) {
+        if (!d->file.seek(index_offset))
+            return false;
+
+        quint8 block_type;
+        quint32 block_size;
+        d->stream >> block_type >> block_size;
+        if (d->stream.status() != QDataStream::Ok || block_type != IndexBlock)
+            return false;
+        if (index_offset == last_index_offset)
+            indexed_end = index_offset + qti_private_BLOCK_HEADER_SIZE + block_size;
+
+        BinaryLogSegment segment;
+        qint64 previous_index_offset;
+        quint32 string_count;
+        d->stream >> segment.start >> previous_index_offset >> segment.first_msecs >> segment.last_msecs;
+        d->stream >> segment.message_types >> segment.record_count >> string_count;
+        for (quint32 i = 0; i < string_count && d->stream.status() == QDataStream::Ok; ++i) {
+            quint32 id;
+            QString string;
+            d->stream >> id >> string;
+            d->strings.insert(id,string);
+        }
+        // Index blocks must point backwards, otherwise the file is corrupt:
+        if (d->stream.status() != QDataStream::Ok || segment.start > index_offset || previous_index_offset >= index_offset)
+            return false;
+
+        segment.end = index_offset;
+        segment.indexed = true;
+        segments.prepend(segment);
+        index_offset = previous_index_offset;
+    }
+
+    if (indexed_end < data_end) {
+        BinaryLogSegment segment;
+        segment.start = indexed_end;
+        segment.end = data_end;
+        segments.append(segment);
+    }
+
+    d->segments = segments;
+    return true;
+}
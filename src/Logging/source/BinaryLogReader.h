@@ -0,0 +1,203 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#ifndef BINARYLOGREADER_H
+#define BINARYLOGREADER_H
+
+#include "Logging_global.h"
+#include "Logger.h"
+
+#include <QDateTime>
+#include <QList>
+#include <QString>
+#include <QVariant>
+
+class QIODevice;
+
+namespace Qtilities {
+    namespace Logging {
+        class AbstractFormattingEngine;
+
+        /*!
+        \struct BinaryLogRecord
+        \brief A message read from a binary log file by BinaryLogReader.
+
+        <i>This struct was added in %Qtilities v1.5.</i>
+          */
+        struct LOGGING_SHARED_EXPORT BinaryLogRecord {
+            BinaryLogRecord() : d_msecs_since_epoch(0),
+                d_message_type(Logger::None),
+                d_message_context(Logger::SystemWideMessages),
+                d_thread_id(0) {}
+
+            //! The time at which the message was logged.
+            QDateTime timestamp() const { return QDateTime::fromMSecsSinceEpoch(d_msecs_since_epoch); }
+
+            //! The time at which the message was logged, in milliseconds since epoch.
+            qint64                      d_msecs_since_epoch;
+            //! The type of the message.
+            Logger::MessageType         d_message_type;
+            //! The context in which the message was logged.
+            Logger::MessageContextFlags d_message_context;
+            //! The id of the thread from which the message was logged.
+            quint64                     d_thread_id;
+            //! The object name of the thread from which the message was logged. Empty when the thread did not have a name.
+            QString                     d_thread_name;
+            //! The name of the logger engine to which the message was sent. Empty for messages which were not sent to a specific engine.
+            QString                     d_engine_name;
+            //! The parts of the message, as passed to the Logger.
+            QList<QVariant>             d_message_parts;
+        };
+
+        /*!
+        \struct BinaryLogReaderPrivateData
+        \brief Structure used by BinaryLogReader to store private data.
+          */
+        struct BinaryLogReaderPrivateData;
+
+        /*!
+        \class BinaryLogReader
+        \brief The BinaryLogReader class reads log files written by BinaryLoggerEngine.
+
+        The reader makes it possible to analyze large session logs without reading through the complete file. BinaryLoggerEngine
+        writes an index block after every segment of messages, which describes the time range and the message types in the segment.
+        When a time range and/or message types are set on the reader, segments which can't contain matching messages are skipped,
+        and messages which don't match are skipped without decoding their contents.
+
+        \code
+        BinaryLogReader reader;
+        if (reader.open("session.qlog")) {
+            reader.setTimeRange(QDateTime::currentDateTime().addSecs(-3600),QDateTime());
+            reader.setMessageTypes(Logger::Warning | Logger::Error | Logger::Fatal);
+
+            BinaryLogRecord record;
+            while (reader.readNext(&record))
+                qDebug() << record.timestamp() << record.d_message_parts;
+        }
+        \endcode
+
+        Messages can be converted to any of the text formats provided by the formatting engines of the logger using convert().
+
+        Log files which were not finalized, for example when the application crashed, do not contain a trailer. The index of
+        such files is rebuilt by open() by stepping over all blocks in the file, which does not require messages to be decoded.
+
+        <i>This class was added in %Qtilities v1.5.</i>
+
+        \sa BinaryLoggerEngine
+          */
+        class LOGGING_SHARED_EXPORT BinaryLogReader
+        {
+        public:
+            //! The types of blocks in a binary log file.
+            /*!
+              Each block starts with its type as a quint8, followed by the size of the block contents in bytes as a quint32.
+              */
+            enum BlockType {
+                StringBlock     = 1,    /*!< Defines an interned string: the string id (quint32) and the string (QString). */
+                RecordBlock     = 2,    /*!< A logged message. */
+                IndexBlock      = 3,    /*!< Describes the segment of blocks preceding it, and repeats the strings defined in that segment. */
+                TrailerBlock    = 4     /*!< The last block in a finalized file. Contains the position of the last index block (qint64). */
+            };
+            //! The ways in which message parts are stored in a RecordBlock.
+            enum PartKind {
+                InternedStringPart  = 0,    /*!< A string stored as an id in the string table. */
+                InlineStringPart    = 1,    /*!< A string which was too long to be interned. */
+                VariantPart         = 2     /*!< Any other QVariant. */
+            };
+
+            //! The magic number at the start of binary log files, and at the end of finalized files.
+            static const quint32 FileMagic;
+            //! The version of the binary log format written by BinaryLoggerEngine.
+            static const quint32 FormatVersion;
+            //! The size in bytes of the trailer at the end of finalized files, including the block header and the closing magic number.
+            static const int TrailerSize;
+
+            BinaryLogReader();
+            virtual ~BinaryLogReader();
+
+            //! Opens a binary log file and loads its index.
+            /*!
+              \param file_name The binary log file.
+              \param errorMsg When valid, it will be populated with the reason if the file could not be opened.
+              \returns True if the file was opened successfully.
+              */
+            bool open(const QString& file_name, QString* errorMsg = 0);
+            //! Closes the file.
+            void close();
+            //! Indicates if a file is open.
+            bool isOpen() const;
+            //! The name of the open file.
+            QString fileName() const;
+            //! The application name stored in the header of the open file.
+            QString applicationName() const;
+            //! The time at which the log session in the open file started.
+            QDateTime sessionStart() const;
+            //! Indicates if the open file was finalized properly. When false, the index was rebuilt by open().
+            bool isFinalized() const;
+            //! The number of indexed segments in the open file.
+            int segmentCount() const;
+
+            //! Limits the messages returned to messages logged between \p from and \p to (inclusive). Invalid times leave that end of the range open.
+            /*!
+              Changing the filter rewinds the reader.
+              */
+            void setTimeRange(const QDateTime& from, const QDateTime& to);
+            //! Limits the messages returned to the given message types. By default all message types are returned.
+            /*!
+              Changing the filter rewinds the reader.
+              */
+            void setMessageTypes(Logger::MessageTypeFlags message_types);
+            //! Returns the message types returned by the reader.
+            Logger::MessageTypeFlags messageTypes() const;
+            //! Moves the reader back to the first message in the file.
+            void rewind();
+
+            //! Reads the next message matching the filters into \p record.
+            /*!
+              \returns True if a message was read, false when the end of the file was reached or the file is corrupt.
+              */
+            bool readNext(BinaryLogRecord* record);
+            //! Returns the number of segments which were skipped since the last rewind() using the index.
+            int skippedSegmentCount() const;
+
+            //! Converts all messages matching the filters to text using \p formatting_engine, and writes it to \p device.
+            /*!
+              The output is the same as a FileLoggerEngine using the same formatting engine would have produced. When the formatting
+              engine is one of the engines provided by the logging module, messages are stamped with the time at which they were logged
+              (see FormattingEngineTimeStampOverride). The session header and footer are generated at the time of the conversion.
+
+              The reader is rewound before and after the conversion.
+
+              \returns The number of messages converted, or -1 when the file is not open or the device is not writable.
+              */
+            int convert(QIODevice* device, AbstractFormattingEngine* formatting_engine);
+            //! Converts all messages matching the filters to text and writes it to \p output_file_name.
+            /*!
+              \sa convert(QIODevice*, AbstractFormattingEngine*)
+              */
+            int convert(const QString& output_file_name, AbstractFormattingEngine* formatting_engine, QString* errorMsg = 0);
+
+        private:
+            //! Moves to the next segment which can contain matching messages. Returns false when no segments are left.
+            bool nextSegment();
+            //! Reads the block at the current position, handling string definitions. Returns false at the end of the segment or on errors.
+            bool readRecordInSegment(BinaryLogRecord* record);
+            //! Indexes the file by stepping over all blocks. Used when the file was not finalized.
+            bool indexByScanning(QString* errorMsg);
+            //! Indexes the file by following the chain of index blocks backwards, starting at \p last_index_offset.
+            bool indexFromTrailer(qint64 last_index_offset);
+
+            BinaryLogReaderPrivateData* d;
+        };
+    }
+}
+
+#endif // BINARYLOGREADER_H
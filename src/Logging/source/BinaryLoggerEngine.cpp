@@ -0,0 +1,381 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#include "BinaryLoggerEngine.h"
+#include "BinaryLogReader.h"
+#include "LoggingConstants.h"
+
+#include <QBuffer>
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QPair>
+#include <QThread>
+#include <QVarLengthArray>
+
+using namespace Qtilities::Logging;
+using namespace Qtilities::Logging::Constants;
+using namespace Qtilities::Logging::Interfaces;
+
+// Strings longer than this are written inline, they are unlikely to be repeated.
+#define qti_private_BINARY_LOG_MAX_INTERNED_LENGTH 256
+// The maximum number of strings tracked for a file, including message parts which were only seen once. Further strings are written inline.
+#define qti_private_BINARY_LOG_MAX_INTERNED_COUNT 65536
+
+namespace Qtilities {
+    namespace Logging {
+        LoggerFactoryItem<AbstractLoggerEngine, BinaryLoggerEngine> BinaryLoggerEngine::factory;
+    }
+}
+
+struct Qtilities::Logging::BinaryLoggerEnginePrivateData {
+    BinaryLoggerEnginePrivateData() : interned_count(0),
+        next_string_id(1),
+        index_interval(1024),
+        previous_index_offset(-1),
+        segment_start(-1),
+        segment_first_msecs(0),
+        segment_last_msecs(0),
+        segment_message_types(0),
+        segment_record_count(0) {}
+
+    //! The file name to which the engine logs.
+    QString                         file_name;
+    //! The open log file.
+    QFile                           file;
+    //! The stream writing to file.
+    QDataStream                     file_stream;
+    //! The buffer in which the contents of blocks are prepared. Its capacity is reused between blocks.
+    QByteArray                      block_buffer;
+    //! The device writing to block_buffer.
+    QBuffer                         block_device;
+    //! The stream writing to block_device.
+    QDataStream                     block_stream;
+    //! The ids of the strings in the string table. Message parts which were only logged once have id 0.
+    QHash<QString,quint32>          string_ids;
+    //! The number of strings in the string table.
+    int                             interned_count;
+    //! The id which will be given to the next interned string.
+    quint32                         next_string_id;
+    //! The strings defined in the current segment, which are repeated in the index block of the segment.
+    QList<QPair<quint32,QString> >  segment_strings;
+    //! The number of messages between index blocks.
+    int                             index_interval;
+    //! The position of the last index block written, or -1.
+    qint64                          previous_index_offset;
+    //! The position of the first block in the current segment.
+    qint64                          segment_start;
+    //! The time of the earliest message in the current segment.
+    qint64                          segment_first_msecs;
+    //! The time of the latest message in the current segment.
+    qint64                          segment_last_msecs;
+    //! The types of the messages in the current segment.
+    quint32                         segment_message_types;
+    //! The number of messages in the current segment.
+    quint32                         segment_record_count;
+    //! Mutex protecting the file and the string table.
+    QMutex                          mutex;
+};
+
+Qtilities::Logging::BinaryLoggerEngine::BinaryLoggerEngine() : AbstractLoggerEngine()
+{
+    d = new BinaryLoggerEnginePrivateData;
+    d->file_stream.setVersion(QDataStream::Qt_4_7);
+    d->block_device.setBuffer(&d->block_buffer);
+    d->block_device.open(QIODevice::WriteOnly);
+    d->block_stream.setDevice(&d->block_device);
+    d->block_stream.setVersion(QDataStream::Qt_4_7);
+
+    abstractLoggerEngineData->formatting_engine = 0;
+    setName("Binary Logger Engine");
+}
+
+Qtilities::Logging::BinaryLoggerEngine::~BinaryLoggerEngine()
+{
+    finalize();
+    delete d;
+}
+
+bool Qtilities::Logging::BinaryLoggerEngine::initialize() {
+    if (d->file_name.isEmpty()) {
+        LOG_ERROR(QString("Failed to initialize binary logger engine (%1): File name is empty...").arg(objectName()));
+        return false;
+    }
+
+    QMutexLocker locker(&d->mutex);
+    if (d->file.isOpen())
+        return true;
+
+    QFileInfo fi(d->file_name);
+    QDir dir(fi.path());
+    if (!dir.exists()) {
+        dir.mkpath(fi.path());
+    }
+
+    d->file.setFileName(d->file_name);
+    if (!d->file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        locker.unlock();
+        LOG_ERROR(QString("Failed to initialize binary logger engine (%1): Can't open the specified file (%2) for writing...").arg(objectName()).arg(d->file_name));
+        return false;
+    }
+    d->file_stream.setDevice(&d->file);
+
+    d->string_ids.clear();
+    d->interned_count = 0;
+    d->next_string_id = 1;
+    d->segment_strings.clear();
+    d->previous_index_offset = -1;
+    d->segment_message_types = 0;
+    d->segment_record_count = 0;
+
+    d->file_stream << BinaryLogReader::FileMagic;
+    d->file_stream << BinaryLogReader::FormatVersion;
+    d->file_stream << QDateTime::currentMSecsSinceEpoch();
+    d->file_stream << QCoreApplication::applicationName();
+    d->segment_start = d->file.pos();
+
+    abstractLoggerEngineData->is_initialized = true;
+    return true;
+}
+
+void Qtilities::Logging::BinaryLoggerEngine::finalize() {
+    QMutexLocker locker(&d->mutex);
+    if (!d->file.isOpen())
+        return;
+
+    if (d->segment_record_count > 0 || !d->segment_strings.isEmpty())
+        writeIndexBlock();
+
+    // The trailer has a fixed size (BinaryLogReader::TrailerSize) which allows the reader to find it from the end of the file:
+    d->block_device.seek(0);
+    d->block_stream << d->previous_index_offset;
+    writeBlock(BinaryLogReader::TrailerBlock);
+    d->file_stream << BinaryLogReader::FileMagic;
+
+    d->file_stream.setDevice(0);
+    d->file.close();
+    abstractLoggerEngineData->is_initialized = false;
+}
+
+QString Qtilities::Logging::BinaryLoggerEngine::description() const {
+    return "Writes log messages to an indexed binary file.";
+}
+
+QString Qtilities::Logging::BinaryLoggerEngine::status() const {
+    if (abstractLoggerEngineData->is_initialized) {
+        if (abstractLoggerEngineData->is_enabled)
+            return QString("Logging in progress to binary output file: %1").arg(d->file_name);
+        else
+            return "Ready but inactive.";
+    } else
+        return "Not initialized.";
+}
+
+void Qtilities::Logging::BinaryLoggerEngine::clearLog() {
+    if (!abstractLoggerEngineData->is_initialized)
+        return;
+
+    // Start a new file. The previous file is finalized first in order for it to stay readable should truncating fail:
+    finalize();
+    initialize();
+}
+
+void Qtilities::Logging::BinaryLoggerEngine::logMessage(const QString& message, Logger::MessageType message_type) {
+    QMutexLocker locker(&d->mutex);
+    if (!d->file.isOpen())
+        return;
+
+    writeRecord(QString(),message_type,Logger::SystemWideMessages,QList<QVariant>() << message);
+}
+
+void Qtilities::Logging::BinaryLoggerEngine::newMessages(const QString& engine_name, Logger::MessageType message_type, Logger::MessageContextFlags message_context, const QList<QVariant>& messages) {
+    if ((!engine_name.isEmpty()) && (engine_name != name()))
+        return;
+
+    // Check the message context:
+    if (!(abstractLoggerEngineData->message_contexts & message_context))
+        return;
+
+    // Check if active and if this message type is allowed:
+    if (!abstractLoggerEngineData->is_enabled || !(abstractLoggerEngineData->enabled_message_types & message_type))
+        return;
+
+    QMutexLocker locker(&d->mutex);
+    if (!d->file.isOpen())
+        return;
+
+    writeRecord(engine_name,message_type,message_context,messages);
+}
+
+void Qtilities::Logging::BinaryLoggerEngine::writeRecord(const QString& engine_name, Logger::MessageType message_type, Logger::MessageContextFlags message_context, const QList<QVariant>& messages) {
+    const qint64 msecs = QDateTime::currentMSecsSinceEpoch();
+    QThread* thread = QThread::currentThread();
+
+    // Intern strings first, their definitions must precede the record:
+    const quint32 thread_name_id = thread ? internString(thread->objectName(),true) : 0;
+    const quint32 engine_name_id = internString(engine_name,true);
+    QVarLengthArray<quint32,10> part_ids(messages.count());
+    for (int i = 0; i < messages.count(); ++i) {
+        if (messages.at(i).type() == QVariant::String)
+            part_ids[i] = internString(messages.at(i).toString(),false);
+        else
+            part_ids[i] = 0;
+    }
+
+    d->block_device.seek(0);
+    d->block_stream << msecs;
+    d->block_stream << (quint32) message_type;
+    d->block_stream << (quint32) message_context;
+    d->block_stream << (quint64) (quintptr) QThread::currentThreadId();
+    if (thread_name_id != 0)
+        d->block_stream << (quint8) BinaryLogReader::InternedStringPart << thread_name_id;
+    else
+        d->block_stream << (quint8) BinaryLogReader::InlineStringPart << (thread ? thread->objectName() : QString());
+    if (engine_name_id != 0)
+        d->block_stream << (quint8) BinaryLogReader::InternedStringPart << engine_name_id;
+    else
+        d->block_stream << (quint8) BinaryLogReader::InlineStringPart << engine_name;
+
+    d->block_stream << (quint32) messages.count();
+    for (int i = 0; i < messages.count(); ++i) {
+        if (part_ids[i] != 0)
+            d->block_stream << (quint8) BinaryLogReader::InternedStringPart << part_ids[i];
+        else if (messages.at(i).type() == QVariant::String)
+            d->block_stream << (quint8) BinaryLogReader::InlineStringPart << messages.at(i).toString();
+        else
+            d->block_stream << (quint8) BinaryLogReader::VariantPart << messages.at(i);
+    }
+    writeBlock(BinaryLogReader::RecordBlock);
+
+    // Messages from different threads are not strictly ordered, thus the segment's time range is widened as needed:
+    if (d->segment_record_count == 0) {
+        d->segment_first_msecs = msecs;
+        d->segment_last_msecs = msecs;
+    } else {
+        d->segment_first_msecs = qMin(d->segment_first_msecs,msecs);
+        d->segment_last_msecs = qMax(d->segment_last_msecs,msecs);
+    }
+    d->segment_message_types |= (quint32) message_type;
+    ++d->segment_record_count;
+
+    if ((int) d->segment_record_count >= d->index_interval)
+        writeIndexBlock();
+    else if (message_type == Logger::Fatal)
+        d->file.flush();
+}
+
+quint32 Qtilities::Logging::BinaryLoggerEngine::internString(const QString& string, bool intern_on_first_use) {
+    if (string.isEmpty() || string.length() > qti_private_BINARY_LOG_MAX_INTERNED_LENGTH)
+        return 0;
+
+    QHash<QString,quint32>::iterator itr = d->string_ids.find(string);
+    if (itr != d->string_ids.end()) {
+        if (itr.value() != 0)
+            return itr.value();
+    } else {
+        if (d->string_ids.count() >= qti_private_BINARY_LOG_MAX_INTERNED_COUNT)
+            return 0;
+        // Most message parts are unique, thus they are only interned when they are logged a second time:
+        itr = d->string_ids.insert(string,0);
+        if (!intern_on_first_use)
+            return 0;
+    }
+
+    const quint32 id = d->next_string_id++;
+    itr.value() = id;
+    ++d->interned_count;
+    d->segment_strings.append(qMakePair(id,string));
+
+    d->block_device.seek(0);
+    d->block_stream << id;
+    d->block_stream << string;
+    writeBlock(BinaryLogReader::StringBlock);
+    return id;
+}
+
+void Qtilities::Logging::BinaryLoggerEngine::writeBlock(quint8 block_type) {
+    const quint32 size = (quint32) d->block_device.pos();
+    d->file_stream << block_type;
+    d->file_stream << size;
+    d->file_stream.writeRawData(d->block_buffer.constData(),size);
+}
+
+void Qtilities::Logging::BinaryLoggerEngine::writeIndexBlock() {
+    const qint64 index_offset = d->file.pos();
+
+    d->block_device.seek(0);
+    d->block_stream << d->segment_start;
+    d->block_stream << d->previous_index_offset;
+    d->block_stream << d->segment_first_msecs;
+    d->block_stream << d->segment_last_msecs;
+    d->block_stream << d->segment_message_types;
+    d->block_stream << d->segment_record_count;
+    d->block_stream << (quint32) d->segment_strings.count();
+    for (int i = 0; i < d->segment_strings.count(); ++i)
+        d->block_stream << d->segment_strings.at(i).first << d->segment_strings.at(i).second;
+    writeBlock(BinaryLogReader::IndexBlock);
+
+    d->previous_index_offset = index_offset;
+    d->segment_start = d->file.pos();
+    d->segment_strings.clear();
+    d->segment_message_types = 0;
+    d->segment_record_count = 0;
+    d->file.flush();
+}
+
+Qtilities::Logging::Interfaces::ILoggerExportable::ExportModeFlags Qtilities::Logging::BinaryLoggerEngine::supportedFormats() const {
+    ILoggerExportable::ExportModeFlags flags = 0;
+    flags |= ILoggerExportable::Binary;
+    return flags;
+}
+
+bool Qtilities::Logging::BinaryLoggerEngine::exportBinary(QDataStream& stream) const {
+    stream << d->file_name;
+    stream << (quint32) d->index_interval;
+    return true;
+}
+
+bool Qtilities::Logging::BinaryLoggerEngine::importBinary(QDataStream& stream) {
+    quint32 index_interval;
+    stream >> d->file_name;
+    stream >> index_interval;
+    setIndexInterval(index_interval);
+    return true;
+}
+
+void Qtilities::Logging::BinaryLoggerEngine::setFileName(const QString& fileName) {
+    if (!abstractLoggerEngineData->is_initialized)
+        d->file_name = fileName;
+}
+
+QString Qtilities::Logging::BinaryLoggerEngine::getFileName() {
+    return d->file_name;
+}
+
+void Qtilities::Logging::BinaryLoggerEngine::setIndexInterval(int message_count) {
+    QMutexLocker locker(&d->mutex);
+    d->index_interval = qMax(1,message_count);
+}
+
+int Qtilities::Logging::BinaryLoggerEngine::indexInterval() const {
+    QMutexLocker locker(&d->mutex);
+    return d->index_interval;
+}
+
+int Qtilities::Logging::BinaryLoggerEngine::internedStringCount() const {
+    QMutexLocker locker(&d->mutex);
+    return d->interned_count;
+}
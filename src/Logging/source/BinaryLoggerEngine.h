@@ -0,0 +1,139 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#ifndef BINARYLOGGERENGINE_H
+#define BINARYLOGGERENGINE_H
+
+#include "Logging_global.h"
+#include "AbstractLoggerEngine.h"
+#include "LoggingConstants.h"
+#include "LoggerFactory.h"
+#include "ILoggerExportable.h"
+
+#include <QList>
+#include <QVariant>
+
+namespace Qtilities {
+    namespace Logging {
+        using namespace Qtilities::Logging::Constants;
+        using namespace Qtilities::Logging::Interfaces;
+
+        /*!
+        \struct BinaryLoggerEnginePrivateData
+        \brief Structure used by BinaryLoggerEngine to store private data.
+          */
+        struct BinaryLoggerEnginePrivateData;
+
+        /*!
+        \class BinaryLoggerEngine
+        \brief A logger engine which writes messages to a compact binary file.
+
+        The text based logger engines format every message before writing it, which makes large session logs slow to write and slow
+        to search. BinaryLoggerEngine writes the unformatted parts of each message together with the time, type and context of the
+        message and the thread from which it was logged. Strings which are logged repeatedly, like thread names, engine names and
+        recurring messages, are written only once to a string table and referenced by id afterwards. Message parts are added to the
+        string table the second time they are logged, thus unique messages do not grow the string table.
+
+        After every indexInterval() messages an index block is written which describes the preceding segment of the file. These
+        blocks allow BinaryLogReader to skip segments which fall outside a time range or which do not contain the requested
+        message types. Files can be converted to any of the text formats provided by the formatting engines using BinaryLogReader::convert(),
+        or using the QtilitiesLogReader tool.
+
+        Formatting engines are not used by this engine, thus isFormattingEngineConstant() returns true.
+
+        This engine can be created through the logger engine factory using the qti_def_FACTORY_TAG_BINARY_LOGGER_ENGINE tag,
+        or directly:
+
+        \code
+        BinaryLoggerEngine* binary_engine = new BinaryLoggerEngine;
+        binary_engine->setFileName(QCoreApplication::applicationDirPath() + "/session" + qti_def_SUFFIX_BINARY_LOG);
+        Log->attachLoggerEngine(binary_engine);
+        \endcode
+
+        <i>This class was added in %Qtilities v1.5.</i>
+
+        \sa BinaryLogReader
+          */
+        class LOGGING_SHARED_EXPORT BinaryLoggerEngine : public AbstractLoggerEngine, public ILoggerExportable
+        {
+            Q_OBJECT
+            Q_INTERFACES(Qtilities::Logging::Interfaces::ILoggerExportable)
+            Q_PROPERTY(QString FileName READ getFileName)
+
+        public:
+            BinaryLoggerEngine();
+            ~BinaryLoggerEngine();
+
+            // --------------------------------
+            // AbstractLoggerEngine Implementation
+            // --------------------------------
+            bool initialize();
+            void finalize();
+            QString description() const;
+            QString status() const;
+            bool isFormattingEngineConstant() const { return true; }
+            void clearLog();
+
+            // --------------------------------
+            // ILoggerExportable Implementation
+            // --------------------------------
+            ExportModeFlags supportedFormats() const;
+            bool exportBinary(QDataStream& stream) const;
+            bool importBinary(QDataStream& stream);
+            QString factoryTag() const { return qti_def_FACTORY_TAG_BINARY_LOGGER_ENGINE; }
+            QString instanceName() const { return name(); }
+
+            //! Sets the file name to which this engine will write the log output.
+            /*!
+                Its not possible to change the file name while the logger engine is in a initialized state.
+                To change the file name: call finalize(), setFileName() and then call initialize() again.
+              */
+            void setFileName(const QString& fileName);
+            //! Gets the file name to which the logger is currently logging.
+            QString getFileName();
+            //! Sets the number of messages written between index blocks. The default is 1024.
+            /*!
+              Smaller intervals allow BinaryLogReader to skip more accurately, at the cost of a larger file.
+              */
+            void setIndexInterval(int message_count);
+            //! Gets the number of messages written between index blocks.
+            int indexInterval() const;
+            //! Returns the number of strings in the string table of the current file.
+            int internedStringCount() const;
+
+            // Make this class a factory item
+            static LoggerFactoryItem<AbstractLoggerEngine, BinaryLoggerEngine> factory;
+
+        public slots:
+            //! Writes a message consisting of a single part.
+            void logMessage(const QString& message, Logger::MessageType message_type);
+            //! Writes the unformatted message parts when the message is accepted by this engine.
+            void newMessages(const QString& engine_name, Logger::MessageType message_type, Logger::MessageContextFlags message_context, const QList<QVariant>& messages);
+
+        private:
+            //! Writes a record block. Must be called with the engine's mutex locked.
+            void writeRecord(const QString& engine_name, Logger::MessageType message_type, Logger::MessageContextFlags message_context, const QList<QVariant>& messages);
+            //! Returns the id of \p string in the string table, defining it when needed. Returns 0 when the string must be written inline.
+            /*!
+              When \p intern_on_first_use is false, the string is only interned the second time it is passed to this function.
+              */
+            quint32 internString(const QString& string, bool intern_on_first_use);
+            //! Writes a block with the contents of the block buffer.
+            void writeBlock(quint8 block_type);
+            //! Writes an index block describing the current segment.
+            void writeIndexBlock();
+
+            BinaryLoggerEnginePrivateData* d;
+        };
+    }
+}
+
+#endif // BINARYLOGGERENGINE_H
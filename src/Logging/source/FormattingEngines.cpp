@@ -11,6 +11,83 @@
 
 #include "FormattingEngines.h"
 
+#include <QThreadStorage>
+
+using namespace Qtilities::Logging;
+
+namespace {
+    // The time stamp used by the formatting engines only changes once per second, thus it is cached per thread.
+    struct TimeStampCache {
+        TimeStampCache() : second(-1), overridden(false) {}
+
+        qint64  second;
+        QString time_stamp;
+        // When true, time_stamp was set by FormattingEngineTimeStampOverride.
+        bool    overridden;
+    };
+    QThreadStorage<TimeStampCache*> qti_private_time_stamp_cache;
+
+    TimeStampCache* timeStampCache() {
+        if (!qti_private_time_stamp_cache.hasLocalData())
+            qti_private_time_stamp_cache.setLocalData(new TimeStampCache);
+        return qti_private_time_stamp_cache.localData();
+    }
+
+    QString currentTimeStamp() {
+        TimeStampCache* cache = timeStampCache();
+        if (cache->overridden)
+            return cache->time_stamp;
+
+        const qint64 second = QDateTime::currentMSecsSinceEpoch() / 1000;
+        if (cache->second != second) {
+            cache->time_stamp = QTime::currentTime().toString();
+            cache->second = second;
+        }
+        return cache->time_stamp;
+    }
+
+    // Appends " [<log level>] " with the log level padded to 8 characters using fill_char, without building intermediate strings.
+    void appendLogLevel(QString& message, Logger::MessageType message_type, QChar fill_char) {
+        const char* level_string = "";
+        switch (message_type) {
+        case Logger::None:          level_string = "None"; break;
+        case Logger::Info:          level_string = "Info"; break;
+        case Logger::Warning:       level_string = "Warning"; break;
+        case Logger::Error:         level_string = "Error"; break;
+        case Logger::Fatal:         level_string = "Fatal"; break;
+        case Logger::Debug:         level_string = "Debug"; break;
+        case Logger::Trace:         level_string = "Trace"; break;
+        case Logger::AllLogLevels:  level_string = "All Log Levels"; break;
+        }
+
+        const int length = qstrlen(level_string);
+        message.append(QLatin1String(" ["));
+        message.append(QLatin1String(level_string));
+        for (int i = length; i < 8; ++i)
+            message.append(fill_char);
+        message.append(QLatin1String("] "));
+    }
+}
+
+// -----------------------------------
+// FormattingEngineTimeStampOverride
+// -----------------------------------
+Qtilities::Logging::FormattingEngineTimeStampOverride::FormattingEngineTimeStampOverride() {
+    setTimeStamp(QDateTime::currentDateTime());
+}
+
+Qtilities::Logging::FormattingEngineTimeStampOverride::~FormattingEngineTimeStampOverride() {
+    TimeStampCache* cache = timeStampCache();
+    cache->overridden = false;
+    cache->second = -1;
+}
+
+void Qtilities::Logging::FormattingEngineTimeStampOverride::setTimeStamp(const QDateTime& time_stamp) {
+    TimeStampCache* cache = timeStampCache();
+    cache->time_stamp = time_stamp.time().toString();
+    cache->overridden = true;
+}
+
 // -----------------------------------
 // Default Formatting Engine
 // -----------------------------------
@@ -36,24 +113,19 @@ QString Qtilities::Logging::FormattingEngine_Default::initializeString() const {
 }
 
 QString Qtilities::Logging::FormattingEngine_Default::formatMessage(Logger::MessageType message_type, const QList<QVariant>& messages) const {
-    QString message = QTime::currentTime().toString();
-    if (message_type == Logger::Debug)
-        message.append(QString(" [%1] ").arg("Debug",-8,QChar(' ')));
-    else if (message_type == Logger::Trace)
-        message.append(QString(" [%1] ").arg("Trace",-8,QChar(' ')));
-    else if (message_type == Logger::Warning)
-        message.append(QString(" [%1] ").arg("Warning",-8,QChar(' ')));
-    else if (message_type == Logger::Error)
-        message.append(QString(" [%1] ").arg("Error",-8,QChar(' ')));
-    else if (message_type == Logger::Fatal)
-        message.append(QString(" [%1] ").arg("Fatal",-8,QChar(' ')));
-    else if (message_type == Logger::Info)
-        message.append(QString(" [%1] ").arg("Info",-8,QChar(' ')));
+    const QString first_message = messages.front().toString();
+    QString message;
+    message.reserve(first_message.length() + 24);
+    message.append(currentTimeStamp());
+    if (message_type == Logger::Debug || message_type == Logger::Trace || message_type == Logger::Warning ||
+            message_type == Logger::Error || message_type == Logger::Fatal || message_type == Logger::Info)
+        appendLogLevel(message,message_type,QLatin1Char(' '));
 
-    message.append(messages.front().toString());
+    message.append(first_message);
 
     for (int i = 1; i < messages.count(); ++i) {
-        message.append("\n            %1").arg(messages.at(i).toString());
+        message.append(QLatin1String("\n            "));
+        message.append(messages.at(i).toString());
     }
     return message;
 }
@@ -87,26 +159,27 @@ QString Qtilities::Logging::FormattingEngine_Rich_Text::initializeString() const
 }
 
 QString Qtilities::Logging::FormattingEngine_Rich_Text::formatMessage(Logger::MessageType message_type, const QList<QVariant>& messages) const {
+    const QString first_message = messages.front().toString();
     QString message;
+    message.reserve(first_message.length() + 64);
 
-    message.append(QTime::currentTime().toString());
-    message.append(QString(" [%1] ").arg(Log->logLevelToString(message_type),-8,QChar(QChar::Nbsp)));
+    message.append(currentTimeStamp());
+    appendLogLevel(message,message_type,QChar(QChar::Nbsp));
 
     // Since we convert it to rich text, < and > characters must be converted.
-    QString formatted_string = AbstractFormattingEngine::escape(messages.front().toString());
-    message.append(formatted_string);
+    message.append(AbstractFormattingEngine::escape(first_message));
     for (int i = 1; i < messages.count(); ++i) {
-        QString formatted_string = AbstractFormattingEngine::escape(messages.at(i).toString());
-        message.append("<br>            %1").arg(formatted_string);
+        message.append(QLatin1String("<br>            "));
+        message.append(AbstractFormattingEngine::escape(messages.at(i).toString()));
     }
-    message.append("</font>");
+    message.append(QLatin1String("</font>"));
 
     // To keep a user's log as intended, we need to reserve spaces:
     // message = message.replace(" ",QChar(QChar::Nbsp));
 
     QString custom_color_hint;
     if (messages.count() > 0)
-        custom_color_hint = matchColorFormattingHint(messages.front().toString(),message_type);
+        custom_color_hint = matchColorFormattingHint(first_message,message_type);
 
     // Start with the correct font:
     switch (message_type) {
@@ -248,22 +321,22 @@ QString Qtilities::Logging::FormattingEngine_HTML::formatMessage(Logger::Message
     QString message;
     switch (message_type) {
         case Logger::Trace:
-            message = QString("<td>%1</td><td><font color='grey'>%2</font></td>").arg(QTime::currentTime().toString()).arg(formatted_string);
+            message = QString("<td>%1</td><td><font color='grey'>%2</font></td>").arg(currentTimeStamp()).arg(formatted_string);
             break;
         case Logger::Debug:
-            message = QString("<td>%1</td><td><font color='grey'>%2</font></td>").arg(QTime::currentTime().toString()).arg(formatted_string);
+            message = QString("<td>%1</td><td><font color='grey'>%2</font></td>").arg(currentTimeStamp()).arg(formatted_string);
             break;
         case Logger::Warning:
-            message = QString("<td>%1</td><td><font color='orange'>%2</font></td>").arg(QTime::currentTime().toString()).arg(formatted_string);
+            message = QString("<td>%1</td><td><font color='orange'>%2</font></td>").arg(currentTimeStamp()).arg(formatted_string);
             break;
         case Logger::Info:
-            message = QString("<td>%1</td><td><font color='black'>%2</font></td>").arg(QTime::currentTime().toString()).arg(formatted_string);
+            message = QString("<td>%1</td><td><font color='black'>%2</font></td>").arg(currentTimeStamp()).arg(formatted_string);
             break;
         case Logger::Error:
-            message = QString("<td>%1</td><td><font color='red'>%2</font></td>").arg(QTime::currentTime().toString()).arg(formatted_string);
+            message = QString("<td>%1</td><td><font color='red'>%2</font></td>").arg(currentTimeStamp()).arg(formatted_string);
             break;
         case Logger::Fatal:
-            message = QString("<td>%1</td><td><font color='red'>%2</font></td>").arg(QTime::currentTime().toString()).arg(formatted_string);
+            message = QString("<td>%1</td><td><font color='red'>%2</font></td>").arg(currentTimeStamp()).arg(formatted_string);
             break;
         case Logger::None:
             return QString();
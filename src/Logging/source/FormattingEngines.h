@@ -22,6 +22,27 @@ namespace Qtilities {
     namespace Logging {
         using namespace Qtilities::Logging::Constants;
 
+        //! Overrides the time stamp used by the formatting engines provided by the logging module on the calling thread.
+        /*!
+          The formatting engines provided by the logging module stamp messages with the current time. Code which formats messages
+          that were logged earlier, like BinaryLogReader::convert(), uses this class to stamp messages with the time at which they
+          were logged instead. The override is removed when the object is destructed.
+
+          <i>This class was added in %Qtilities v1.5.</i>
+          */
+        class LOGGING_SHARED_EXPORT FormattingEngineTimeStampOverride
+        {
+        public:
+            FormattingEngineTimeStampOverride();
+            ~FormattingEngineTimeStampOverride();
+
+            //! Sets the time stamp used for messages formatted on the calling thread.
+            void setTimeStamp(const QDateTime& time_stamp);
+
+        private:
+            Q_DISABLE_COPY(FormattingEngineTimeStampOverride)
+        };
+
         //! Default formatting engine which basically parses the QVariant messages into a single QString message.
         /*!
           The default formatting engine. A preview of the formatting applied is shown below:
@@ -48,6 +69,7 @@ namespace Qtilities {
             QString fileExtension() const { return "log"; }
             QString name() const { return qti_def_FORMATTING_ENGINE_DEFAULT; }
             QString endOfLineChar() const { return "\n"; }
+            bool isFormattingCacheable() const { return true; }
         private:
             static FormattingEngine_Default* formattingEngine_Default_Instance;
         };
@@ -81,6 +103,7 @@ namespace Qtilities {
             QString fileExtension() const { return QString(); }
             QString name() const { return qti_def_FORMATTING_ENGINE_RICH_TEXT; }
             QString endOfLineChar() const { return "<br>"; }
+            bool isFormattingCacheable() const { return true; }
         private:
             static FormattingEngine_Rich_Text* formattingEngine_Rich_Text_Instance;
         };
@@ -112,6 +135,7 @@ namespace Qtilities {
             QString fileExtension() const { return "xml"; }
             QString name() const { return qti_def_FORMATTING_ENGINE_XML; }
             QString endOfLineChar() const { return "\n"; }
+            bool isFormattingCacheable() const { return true; }
         private:
             static FormattingEngine_XML* formattingEngine_XML_Instance;
         };
@@ -143,6 +167,7 @@ namespace Qtilities {
             QString fileExtension() const { return "html"; }
             QString name() const { return qti_def_FORMATTING_ENGINE_HTML; }
             QString endOfLineChar() const { return "<br>"; }
+            bool isFormattingCacheable() const { return true; }
         private:
             static FormattingEngine_HTML* formattingEngine_HTML_Instance;
         };
@@ -177,6 +202,7 @@ namespace Qtilities {
             QString fileExtension() const { return QString(); }
             QString name() const { return qti_def_FORMATTING_ENGINE_QT_MSG; }
             QString endOfLineChar() const { return "\n"; }
+            bool isFormattingCacheable() const { return true; }
         private:
             static FormattingEngine_QtMsgEngineFormat* formattingEngine_QtMsgEngineFormat_Instance;
         };
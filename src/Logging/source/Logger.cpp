@@ -15,12 +15,14 @@
 #include "AbstractLoggerEngine.h"
 #include "FormattingEngines.h"
 #include "LoggerEngines.h"
+#include "BinaryLoggerEngine.h"
 #include "LoggingConstants.h"
 
 #include <Qtilities.h>
 
 #include <QtDebug>
 #include <QMutex>
+#include <QMutexLocker>
 
 using namespace Qtilities::Logging::Constants;
 
@@ -36,8 +38,34 @@ struct Qtilities::Logging::LoggerPrivateData {
     QPointer<AbstractFormattingEngine>          priority_formatting_engine;
     QString                                     session_path;
     bool                                        settings_enabled;
+    //! The message types accepted by at least one attached engine for system wide messages (index 0) and engine specific messages (index 1). -1 when they must be determined again.
+    QAtomicInt                                  accepted_message_types[2];
+    //! Mutex protecting the determination and invalidation of accepted_message_types. Since accepted_message_types is determined from
+    //! logger_engines, which might happen on any thread logging a message, changes to logger_engines are made while holding it as well.
+    QMutex                                      accepted_message_types_mutex;
 };
 
+namespace {
+    // Builds the message contents passed to logger engines. The message parts are collected in a fixed array first,
+    // thus the list is allocated once with its final size.
+    QList<QVariant> qti_private_messageContents(const QVariant* const (&parts)[10]) {
+        int count = 1;
+        for (int i = 1; i < 10; ++i) {
+            if (!parts[i]->isNull())
+                ++count;
+        }
+
+        QList<QVariant> message_contents;
+        message_contents.reserve(count);
+        message_contents.push_back(*parts[0]);
+        for (int i = 1; i < 10; ++i) {
+            if (!parts[i]->isNull())
+                message_contents.push_back(*parts[i]);
+        }
+        return message_contents;
+    }
+}
+
 Qtilities::Logging::Logger* Qtilities::Logging::Logger::m_Instance = 0;
 
 Qtilities::Logging::Logger* Qtilities::Logging::Logger::instance() {
@@ -65,6 +93,8 @@ Qtilities::Logging::Logger::Logger(QObject* parent) : QObject(parent) {
     d->priority_formatting_engine = 0;
     d->session_path = QCoreApplication::applicationDirPath() + qti_def_PATH_SESSION;
     d->settings_enabled = true;
+    d->accepted_message_types[0].fetchAndStoreOrdered(-1);
+    d->accepted_message_types[1].fetchAndStoreOrdered(-1);
 
     qRegisterMetaType<Logger::MessageType>("Logger::MessageType");
     qRegisterMetaType<Logger::MessageContextFlags>("Logger::MessageContextFlags");
@@ -92,6 +122,7 @@ void Qtilities::Logging::Logger::initialize(const QString& configuration_file_na
 
     // Register the logger enigines that comes as part of the Qtilities Logging Framework
     d->logger_engine_factory.registerFactoryInterface(qti_def_FACTORY_TAG_FILE_LOGGER_ENGINE, &FileLoggerEngine::factory);
+    d->logger_engine_factory.registerFactoryInterface(qti_def_FACTORY_TAG_BINARY_LOGGER_ENGINE, &BinaryLoggerEngine::factory);
 
     //qDebug() << tr("> Number of formatting engines available: ") << d->formatting_engines.count();
     //qDebug() << tr("> Number of logger engine factories available: ") << d->logger_engine_factory.tags().count();
@@ -128,16 +159,24 @@ void Qtilities::Logging::Logger::finalize(const QString &configuration_file_name
 void Qtilities::Logging::Logger::clear() {
     // Delete all logger engines
     //qDebug() << tr("Qtilities Logging Framework, clearing started...");
-    for (int i = 0; i < d->logger_engines.count(); ++i) {
-        if (d->logger_engines.at(i)) {
-            if (d->logger_engines.at(i) != QtMsgLoggerEngine::instance() && d->logger_engines.at(i) != ConsoleLoggerEngine::instance()) {
-                //qDebug() << tr("> Deleting logger engine: ") << d->logger_engines.at(i)->objectName();
-                delete d->logger_engines.at(i);
+    // Engines are removed from the list before they are deleted, thus isMessageTypeAccepted() never sees deleted engines:
+    QList<QPointer<AbstractLoggerEngine> > logger_engines;
+    {
+        QMutexLocker locker(&d->accepted_message_types_mutex);
+        logger_engines = d->logger_engines;
+        d->logger_engines.clear();
+    }
+    invalidateAcceptedMessageTypes();
+
+    for (int i = 0; i < logger_engines.count(); ++i) {
+        if (logger_engines.at(i)) {
+            if (logger_engines.at(i) != QtMsgLoggerEngine::instance() && logger_engines.at(i) != ConsoleLoggerEngine::instance()) {
+                //qDebug() << tr("> Deleting logger engine: ") << logger_engines.at(i)->objectName();
+                delete logger_engines.at(i);
             }
         }
 
     }
-    d->logger_engines.clear();
     //qDebug() << tr("Qtilities Logging Framework, clearing finished successfully...");
 }
 
@@ -151,20 +190,12 @@ void Qtilities::Logging::Logger::logMessage(const QString& engine_name, MessageT
     if (message_type == AllLogLevels || message_type == None)
         return;
 
-    if (message_type > d->global_log_level)
+    // Don't build the message contents when no engine will log the message:
+    if (!isMessageTypeAccepted(message_type,engine_name.isEmpty() ? SystemWideMessages : EngineSpecificMessages))
         return;
 
-    QList<QVariant> message_contents;
-    message_contents.push_back(message);
-    if (!msg1.isNull()) message_contents.push_back(msg1);
-    if (!msg2.isNull()) message_contents.push_back(msg2);
-    if (!msg3.isNull()) message_contents.push_back(msg3);
-    if (!msg4.isNull()) message_contents.push_back(msg4);
-    if (!msg5.isNull()) message_contents.push_back(msg5);
-    if (!msg6.isNull()) message_contents.push_back(msg6);
-    if (!msg7.isNull()) message_contents.push_back(msg7);
-    if (!msg8.isNull()) message_contents.push_back(msg8);
-    if (!msg9.isNull()) message_contents.push_back(msg9);
+    const QVariant* const parts[10] = { &message, &msg1, &msg2, &msg3, &msg4, &msg5, &msg6, &msg7, &msg8, &msg9 };
+    QList<QVariant> message_contents = qti_private_messageContents(parts);
 
 //    if (message.toString().contains("Argument missing"))
 //        int i = 5;
@@ -214,17 +245,8 @@ void Qtilities::Logging::Logger::logPriorityMessage(const QString& engine_name,
     if (message_type > d->global_log_level)
         return;
 
-    QList<QVariant> message_contents;
-    message_contents.push_back(message);
-    if (!msg1.isNull()) message_contents.push_back(msg1);
-    if (!msg2.isNull()) message_contents.push_back(msg2);
-    if (!msg3.isNull()) message_contents.push_back(msg3);
-    if (!msg4.isNull()) message_contents.push_back(msg4);
-    if (!msg5.isNull()) message_contents.push_back(msg5);
-    if (!msg6.isNull()) message_contents.push_back(msg6);
-    if (!msg7.isNull()) message_contents.push_back(msg7);
-    if (!msg8.isNull()) message_contents.push_back(msg8);
-    if (!msg9.isNull()) message_contents.push_back(msg9);
+    const QVariant* const parts[10] = { &message, &msg1, &msg2, &msg3, &msg4, &msg5, &msg6, &msg7, &msg8, &msg9 };
+    QList<QVariant> message_contents = qti_private_messageContents(parts);
 
     // Create the correct message context:
     MessageContextFlags context = 0;
@@ -234,13 +256,60 @@ void Qtilities::Logging::Logger::logPriorityMessage(const QString& engine_name,
 
     QString formatted_message;
     if (d->priority_formatting_engine) {
-        formatted_message = d->priority_formatting_engine->formatMessage(message_type,message_contents);
+        formatted_message = d->priority_formatting_engine->formatMessageCached(message_type,message_contents);
     } else
         formatted_message = message.toString();
 
     emit newPriorityMessage(message_type,formatted_message);
 }
 
+bool Qtilities::Logging::Logger::isMessageTypeAccepted(MessageType message_type, MessageContext message_context) const {
+    // In release mode we should not log debug and trace messages.
+    #ifdef QT_NO_DEBUG
+        if (message_type == Debug || message_type == Trace)
+            return false;
+    #endif
+
+    if (message_type == AllLogLevels || message_type == None)
+        return false;
+
+    if (message_type > d->global_log_level)
+        return false;
+
+    // Priority messages are also emitted through newPriorityMessage(), thus they must be logged even when no engine accepts them:
+    if (message_context == PriorityMessages)
+        return true;
+
+    const int index = (message_context == EngineSpecificMessages) ? 1 : 0;
+    int accepted_message_types = d->accepted_message_types[index].fetchAndAddOrdered(0);
+    if (accepted_message_types == -1) {
+        QMutexLocker locker(&d->accepted_message_types_mutex);
+        int system_wide_types = 0;
+        int engine_specific_types = 0;
+        for (int i = 0; i < d->logger_engines.count(); ++i) {
+            AbstractLoggerEngine* engine = d->logger_engines.at(i);
+            if (!engine || !engine->isActive())
+                continue;
+
+            if (engine->messageContexts() & SystemWideMessages)
+                system_wide_types |= (int) engine->getEnabledMessageTypes();
+            if (engine->messageContexts() & EngineSpecificMessages)
+                engine_specific_types |= (int) engine->getEnabledMessageTypes();
+        }
+        d->accepted_message_types[0].fetchAndStoreOrdered(system_wide_types);
+        d->accepted_message_types[1].fetchAndStoreOrdered(engine_specific_types);
+        accepted_message_types = (index == 0) ? system_wide_types : engine_specific_types;
+    }
+
+    return (accepted_message_types & message_type);
+}
+
+void Qtilities::Logging::Logger::invalidateAcceptedMessageTypes() {
+    QMutexLocker locker(&d->accepted_message_types_mutex);
+    d->accepted_message_types[0].fetchAndStoreOrdered(-1);
+    d->accepted_message_types[1].fetchAndStoreOrdered(-1);
+}
+
 bool Qtilities::Logging::Logger::setPriorityFormattingEngine(const QString& name) {
     if (!availableLoggerEnginesInFactory().contains(name))
         return false;
@@ -363,8 +432,12 @@ bool Qtilities::Logging::Logger::attachLoggerEngine(AbstractLoggerEngine* new_lo
 
     if (new_logger_engine) {
         new_logger_engine->setObjectName(new_logger_engine->name());
-        d->logger_engines << new_logger_engine;
+        {
+            QMutexLocker locker(&d->accepted_message_types_mutex);
+            d->logger_engines << new_logger_engine;
+        }
         connect(this,SIGNAL(newMessage(QString,Logger::MessageType,Logger::MessageContextFlags,QList<QVariant>)),new_logger_engine,SLOT(newMessages(QString,Logger::MessageType,Logger::MessageContextFlags,QList<QVariant>)));
+        invalidateAcceptedMessageTypes();
     }
 
     emit loggerEngineCountChanged(new_logger_engine, EngineAdded);
@@ -373,7 +446,13 @@ bool Qtilities::Logging::Logger::attachLoggerEngine(AbstractLoggerEngine* new_lo
 
 bool Qtilities::Logging::Logger::detachLoggerEngine(AbstractLoggerEngine* logger_engine, bool delete_engine) {
     if (logger_engine) {
-        if (d->logger_engines.removeOne(logger_engine)) {
+        bool removed = false;
+        {
+            QMutexLocker locker(&d->accepted_message_types_mutex);
+            removed = d->logger_engines.removeOne(logger_engine);
+        }
+        if (removed) {
+            invalidateAcceptedMessageTypes();
             emit loggerEngineCountChanged(logger_engine, EngineRemoved);
             if (delete_engine)
                 delete logger_engine;
@@ -481,12 +560,19 @@ QStringList Qtilities::Logging::Logger::allMessageContextStrings() const {
 }
 
 void Qtilities::Logging::Logger::deleteAllLoggerEngines() {
-    // Delete all logger engines
-    for (int i = 0; i < d->logger_engines.count(); ++i) {
-        if (d->logger_engines.at(i))
-            delete d->logger_engines.at(i);
+    // Delete all logger engines, after removing them from the list used by isMessageTypeAccepted():
+    QList<QPointer<AbstractLoggerEngine> > logger_engines;
+    {
+        QMutexLocker locker(&d->accepted_message_types_mutex);
+        logger_engines = d->logger_engines;
+        d->logger_engines.clear();
+    }
+    invalidateAcceptedMessageTypes();
+
+    for (int i = 0; i < logger_engines.count(); ++i) {
+        if (logger_engines.at(i))
+            delete logger_engines.at(i);
     }
-    d->logger_engines.clear();
 }
 
 void Qtilities::Logging::Logger::disableAllLoggerEngines() {
@@ -220,6 +220,28 @@ namespace Qtilities {
             void setGlobalLogLevel(Logger::MessageType new_log_level);
             //! Returns the current global log level.
             Logger::MessageType globalLogLevel() const;
+            //! Indicates if a message of type \p message_type logged in \p message_context will be processed.
+            /*!
+              A message is processed when it passes the global log level and at least one attached, active logger engine accepts both
+              \p message_type and \p message_context. Priority messages only need to pass the global log level since they are also emitted
+              through newPriorityMessage().
+
+              The logging macros (for example LOG_DEBUG) use this function to check if a message will be processed before their message
+              arguments are evaluated. Thus, the cost of building messages which are discarded is avoided. The accepted message types of
+              the attached engines are cached, therefore this check is cheap.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            bool isMessageTypeAccepted(MessageType message_type, MessageContext message_context = SystemWideMessages) const;
+            //! Invalidates the cached message types accepted by the attached logger engines.
+            /*!
+              This function is called automatically when engines are attached or detached, and when their activity, enabled message types
+              or message contexts change. You only need to call it yourself when an engine reimplements newMessages() in a way which changes
+              the messages it accepts.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void invalidateAcceptedMessageTypes();
             //! Function which returns a string associated with a log level.
             QString logLevelToString(Logger::MessageType log_level) const;
             //! Function which returns the log level associated with an input string.
@@ -396,6 +418,9 @@ namespace Qtilities {
 
         signals:
             //! Signal which is emitted when a new message was logged. The logger connects all logger engines to this signal.
+            /*!
+              \note Since %Qtilities v1.5 this signal is only emitted for messages accepted by at least one attached engine, see isMessageTypeAccepted().
+              */
             void newMessage(const QString& engine_name, Logger::MessageType message_type, Logger::MessageContextFlags message_context, const QList<QVariant>& message_contents);
             //! Signal which is emitted when a new priority message was logged.
             /*!
@@ -446,6 +471,17 @@ Q_DECLARE_METATYPE(Qtilities::Logging::Logger::MessageType)
     */
 #define LOG_FINALIZE() Log->finalize()
 
+//! Evaluates \p Log_Call only when the logger will process messages of type \p Message_Type in \p Message_Context.
+/*!
+    All logging macros are built on this macro, thus the arguments passed to them (for example strings built using QString::arg()) are
+    only evaluated when the message will be processed.
+
+    \sa Qtilities::Logging::Logger::isMessageTypeAccepted()
+
+    <i>This macro was added in %Qtilities v1.5.</i>
+  */
+#define LOG_IF_ACCEPTED(Message_Type, Message_Context, Log_Call) (Log->isMessageTypeAccepted(Message_Type,Message_Context) ? Log_Call : (void) 0)
+
 // -----------------------------------
 // Basic Logging Macros
 // -----------------------------------
@@ -454,7 +490,7 @@ Q_DECLARE_METATYPE(Qtilities::Logging::Logger::MessageType)
     \note Trace messages are not part of release mode builds.
   */
 #ifndef QT_NO_DEBUG
-#define LOG_TRACE(Msg) Log->logMessage(QString(),Qtilities::Logging::Logger::Trace, Msg)
+#define LOG_TRACE(Msg) LOG_IF_ACCEPTED(Qtilities::Logging::Logger::Trace,Qtilities::Logging::Logger::SystemWideMessages,Log->logMessage(QString(),Qtilities::Logging::Logger::Trace, Msg))
 #else
 #define LOG_TRACE(Msg) ((void)0)
 #endif
@@ -463,18 +499,18 @@ Q_DECLARE_METATYPE(Qtilities::Logging::Logger::MessageType)
     \note Debug messages are not part of release mode builds.
   */
 #ifndef QT_NO_DEBUG
-#define LOG_DEBUG(Msg) Log->logMessage(QString(),Qtilities::Logging::Logger::Debug, Msg)
+#define LOG_DEBUG(Msg) LOG_IF_ACCEPTED(Qtilities::Logging::Logger::Debug,Qtilities::Logging::Logger::SystemWideMessages,Log->logMessage(QString(),Qtilities::Logging::Logger::Debug, Msg))
 #else
 #define LOG_DEBUG(Msg) ((void)0)
 #endif
 //! Logs an error message to all active engines.
-#define LOG_ERROR(Msg) Log->logMessage(QString(),Qtilities::Logging::Logger::Error, Msg)
+#define LOG_ERROR(Msg) LOG_IF_ACCEPTED(Qtilities::Logging::Logger::Error,Qtilities::Logging::Logger::SystemWideMessages,Log->logMessage(QString(),Qtilities::Logging::Logger::Error, Msg))
 //! Logs a warning message to all active engines.
-#define LOG_WARNING(Msg) Log->logMessage(QString(),Qtilities::Logging::Logger::Warning, Msg)
+#define LOG_WARNING(Msg) LOG_IF_ACCEPTED(Qtilities::Logging::Logger::Warning,Qtilities::Logging::Logger::SystemWideMessages,Log->logMessage(QString(),Qtilities::Logging::Logger::Warning, Msg))
 //! Logs a fatal message to all active engines.
-#define LOG_FATAL(Msg) Log->logMessage(QString(),Qtilities::Logging::Logger::Fatal, Msg)
+#define LOG_FATAL(Msg) LOG_IF_ACCEPTED(Qtilities::Logging::Logger::Fatal,Qtilities::Logging::Logger::SystemWideMessages,Log->logMessage(QString(),Qtilities::Logging::Logger::Fatal, Msg))
 //! Logs an information message to all active engines.
-#define LOG_INFO(Msg) Log->logMessage(QString(),Qtilities::Logging::Logger::Info, Msg)
+#define LOG_INFO(Msg) LOG_IF_ACCEPTED(Qtilities::Logging::Logger::Info,Qtilities::Logging::Logger::SystemWideMessages,Log->logMessage(QString(),Qtilities::Logging::Logger::Info, Msg))
 
 // -----------------------------------
 // Priority Logging Macros
@@ -484,7 +520,7 @@ Q_DECLARE_METATYPE(Qtilities::Logging::Logger::MessageType)
     \note Trace messages are not part of release mode builds.
   */
 #ifndef QT_NO_DEBUG
-#define LOG_TRACE_P(Msg) Log->logPriorityMessage(QString(),Qtilities::Logging::Logger::Trace, Msg)
+#define LOG_TRACE_P(Msg) LOG_IF_ACCEPTED(Qtilities::Logging::Logger::Trace,Qtilities::Logging::Logger::PriorityMessages,Log->logPriorityMessage(QString(),Qtilities::Logging::Logger::Trace, Msg))
 #else
 #define LOG_TRACE_P(Msg) ((void)0)
 #endif
@@ -493,42 +529,42 @@ Q_DECLARE_METATYPE(Qtilities::Logging::Logger::MessageType)
     \note Debug messages are not part of release mode builds.
   */
 #ifndef QT_NO_DEBUG
-#define LOG_DEBUG_P(Msg) Log->logPriorityMessage(QString(),Qtilities::Logging::Logger::Debug, Msg)
+#define LOG_DEBUG_P(Msg) LOG_IF_ACCEPTED(Qtilities::Logging::Logger::Debug,Qtilities::Logging::Logger::PriorityMessages,Log->logPriorityMessage(QString(),Qtilities::Logging::Logger::Debug, Msg))
 #else
 #define LOG_DEBUG_P(Msg) ((void)0)
 #endif
 //! Logs a priority error message to all active engines.
-#define LOG_ERROR_P(Msg) Log->logPriorityMessage(QString(),Qtilities::Logging::Logger::Error, Msg)
+#define LOG_ERROR_P(Msg) LOG_IF_ACCEPTED(Qtilities::Logging::Logger::Error,Qtilities::Logging::Logger::PriorityMessages,Log->logPriorityMessage(QString(),Qtilities::Logging::Logger::Error, Msg))
 //! Logs a priority warning message to all active engines.
-#define LOG_WARNING_P(Msg) Log->logPriorityMessage(QString(),Qtilities::Logging::Logger::Warning, Msg)
+#define LOG_WARNING_P(Msg) LOG_IF_ACCEPTED(Qtilities::Logging::Logger::Warning,Qtilities::Logging::Logger::PriorityMessages,Log->logPriorityMessage(QString(),Qtilities::Logging::Logger::Warning, Msg))
 //! Logs a priority fatal message to all active engines.
-#define LOG_FATAL_P(Msg) Log->logPriorityMessage(QString(),Qtilities::Logging::Logger::Fatal, Msg)
+#define LOG_FATAL_P(Msg) LOG_IF_ACCEPTED(Qtilities::Logging::Logger::Fatal,Qtilities::Logging::Logger::PriorityMessages,Log->logPriorityMessage(QString(),Qtilities::Logging::Logger::Fatal, Msg))
 //! Logs a priority information message to all active engines.
-#define LOG_INFO_P(Msg) Log->logPriorityMessage(QString(),Qtilities::Logging::Logger::Info, Msg)
+#define LOG_INFO_P(Msg) LOG_IF_ACCEPTED(Qtilities::Logging::Logger::Info,Qtilities::Logging::Logger::PriorityMessages,Log->logPriorityMessage(QString(),Qtilities::Logging::Logger::Info, Msg))
 
 // -----------------------------------
 // Engine Specific Logging
 // -----------------------------------
 //! Logs a trace message to the engine specified. Note that the engine must be active for the message to be logger.
 #ifndef QT_NO_DEBUG
-#define LOG_TRACE_E(Engine_Name, Msg) Log->logMessage(Engine_Name,Qtilities::Logging::Logger::Trace, Msg)
+#define LOG_TRACE_E(Engine_Name, Msg) LOG_IF_ACCEPTED(Qtilities::Logging::Logger::Trace,Qtilities::Logging::Logger::EngineSpecificMessages,Log->logMessage(Engine_Name,Qtilities::Logging::Logger::Trace, Msg))
 #else
 #define LOG_TRACE_E(Engine_Name, Msg) ((void)0)
 #endif
 //! Logs a debug message to the engine specified. Note that the engine must be active for the message to be logger.
 #ifndef QT_NO_DEBUG//!
-#define LOG_DEBUG_E(Engine_Name, Msg) Log->logMessage(Engine_Name,Qtilities::Logging::Logger::Debug, Msg)
+#define LOG_DEBUG_E(Engine_Name, Msg) LOG_IF_ACCEPTED(Qtilities::Logging::Logger::Debug,Qtilities::Logging::Logger::EngineSpecificMessages,Log->logMessage(Engine_Name,Qtilities::Logging::Logger::Debug, Msg))
 #else
 #define LOG_DEBUG_E(Engine_Name, Msg) ((void)0)
 #endif
 //! Logs an error message to the engine specified. Note that the engine must be active for the message to be logger.
-#define LOG_ERROR_E(Engine_Name, Msg) Log->logMessage(Engine_Name,Qtilities::Logging::Logger::Error, Msg)
+#define LOG_ERROR_E(Engine_Name, Msg) LOG_IF_ACCEPTED(Qtilities::Logging::Logger::Error,Qtilities::Logging::Logger::EngineSpecificMessages,Log->logMessage(Engine_Name,Qtilities::Logging::Logger::Error, Msg))
 //! Logs a warning message to the engine specified. Note that the engine must be active for the message to be logger.
-#define LOG_WARNING_E(Engine_Name, Msg) Log->logMessage(Engine_Name,Qtilities::Logging::Logger::Warning, Msg)
+#define LOG_WARNING_E(Engine_Name, Msg) LOG_IF_ACCEPTED(Qtilities::Logging::Logger::Warning,Qtilities::Logging::Logger::EngineSpecificMessages,Log->logMessage(Engine_Name,Qtilities::Logging::Logger::Warning, Msg))
 //! Logs a fatal message to the engine specified. Note that the engine must be active for the message to be logger.
-#define LOG_FATAL_E(Engine_Name, Msg) Log->logMessage(Engine_Name,Qtilities::Logging::Logger::Fatal, Msg)
+#define LOG_FATAL_E(Engine_Name, Msg) LOG_IF_ACCEPTED(Qtilities::Logging::Logger::Fatal,Qtilities::Logging::Logger::EngineSpecificMessages,Log->logMessage(Engine_Name,Qtilities::Logging::Logger::Fatal, Msg))
 //! Logs an info message to the engine specified. Note that the engine must be active for the message to be logger.
-#define LOG_INFO_E(Engine_Name, Msg) Log->logMessage(Engine_Name,Qtilities::Logging::Logger::Info, Msg)
+#define LOG_INFO_E(Engine_Name, Msg) LOG_IF_ACCEPTED(Qtilities::Logging::Logger::Info,Qtilities::Logging::Logger::EngineSpecificMessages,Log->logMessage(Engine_Name,Qtilities::Logging::Logger::Info, Msg))
 
 // -----------------------------------
 // Function Specific Logging
@@ -42,9 +42,11 @@ namespace Qtilities {
 
             // Default Factory Tags
             const char * const qti_def_FACTORY_TAG_FILE_LOGGER_ENGINE = "qti.def.FactoryTag.File";
+            const char * const qti_def_FACTORY_TAG_BINARY_LOGGER_ENGINE = "qti.def.FactoryTag.Binary";
 
             // File Extensions
             const char * const qti_def_SUFFIX_LOGGER_CONFIG         = ".logconfig";
+            const char * const qti_def_SUFFIX_BINARY_LOG            = ".qlog";
 
             // Default file paths (all subdirectories of the executable file)
             const char * const qti_def_PATH_SESSION                 = "Session";
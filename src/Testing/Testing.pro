@@ -36,6 +36,7 @@ UI_DIR = $$QTILITIES_TEMP/Testing
 contains(DEFINES, QTILITIES_TESTING) {
     HEADERS += \
             source/BenchmarkTests.h \
+            source/TestBinaryLogger.h \
             source/TestAbstractTreeItem.h \
             source/TestActivityPolicyFilter.h \
             source/TestExporting.h \
@@ -45,6 +46,7 @@ contains(DEFINES, QTILITIES_TESTING) {
             source/TestObjectManager.h \
             source/TestObserver.h \
             source/TestObserverRelationalTable.h \
+            source/TestObserverTableModel.h \
             source/TestSubjectIterator.h \
             source/TestSubjectTypeFilter.h \
             source/TestTask.h \
@@ -54,6 +56,7 @@ contains(DEFINES, QTILITIES_TESTING) {
 
     SOURCES += \
             source/BenchmarkTests.cpp \
+            source/TestBinaryLogger.cpp \
             source/TestAbstractTreeItem.cpp \
             source/TestActivityPolicyFilter.cpp \
             source/TestExporting.cpp \
@@ -61,6 +64,7 @@ contains(DEFINES, QTILITIES_TESTING) {
             source/TestObjectManager.cpp \
             source/TestObserver.cpp \
             source/TestObserverRelationalTable.cpp \
+            source/TestObserverTableModel.cpp \
             source/TestSubjectIterator.cpp \
             source/TestSubjectTypeFilter.cpp \
             source/TestTask.cpp \
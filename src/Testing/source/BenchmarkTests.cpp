@@ -15,6 +15,7 @@
 using namespace QtilitiesCoreGui;
 
 #include <QDomDocument>
+#include <QTextDocument>
 
 int Qtilities::Testing::BenchmarkTests::execTest(int argc, char ** argv) {
     return QTest::qExec(this,argc,argv);
@@ -89,3 +90,187 @@ void Qtilities::Testing::BenchmarkTests::benchmarkObserverImport_1_0_1_0() {
     file.close();
     delete obj_import_xml;
 }
+
+void Qtilities::Testing::BenchmarkTests::benchmarkSearchBoxReplaceAll_data() {
+    QTest::addColumn<int>("LineCount");
+    QTest::newRow("1000 lines") << 1000;
+    QTest::newRow("100000 lines") << 100000;
+}
+
+void Qtilities::Testing::BenchmarkTests::benchmarkSearchBoxReplaceAll() {
+    QFETCH(int, LineCount);
+
+    QStringList lines;
+    for (int i = 0; i < LineCount; ++i)
+        lines << "int value_" + QString::number(i) + " = old_value + old_value;";
+
+    QTextDocument document;
+    document.setPlainText(lines.join("\n"));
+
+    int count = 0;
+    QBENCHMARK_ONCE {
+        count = SearchBoxWidget::replaceAll(&document,"old_value","new_value");
+    }
+    QCOMPARE(count, LineCount * 2);
+    QVERIFY(!document.toPlainText().contains("old_value"));
+
+    // The complete replacement must be undone in a single step:
+    document.undo();
+    QCOMPARE(document.toPlainText(), lines.join("\n"));
+}
+
+void Qtilities::Testing::BenchmarkTests::benchmarkObserverTableModelScrolling_data() {
+    QTest::addColumn<int>("RowCount");
+    QTest::newRow("1000 rows") << 1000;
+    QTest::newRow("100000 rows") << 100000;
+}
+
+void Qtilities::Testing::BenchmarkTests::benchmarkObserverTableModelScrolling() {
+    QFETCH(int, RowCount);
+
+    Observer observer("Table Benchmark Observer");
+    observer.useDisplayHints();
+    observer.displayHints()->setItemViewColumnHint(ObserverHints::ColumnAllHints | ObserverHints::ColumnIDHint);
+
+    QList<QObject*> objects;
+    for (int i = 0; i < RowCount; ++i) {
+        QObject* obj = new QObject;
+        obj->setObjectName("Object " + QString::number(i));
+        objects << obj;
+    }
+    observer.attachSubjects(objects,Observer::ObserverScopeOwnership);
+    QCOMPARE(observer.subjectCount(), RowCount);
+
+    ObserverTableModel table_model;
+    table_model.setObserverContext(&observer);
+    while (table_model.canFetchMore(QModelIndex()))
+        table_model.fetchMore(QModelIndex());
+    QCOMPARE(table_model.rowCount(), RowCount);
+
+    // Scroll through the complete table one page at a time, requesting the roles a view paints for each visible cell:
+    const int page_size = 40;
+    const int column_count = table_model.columnCount();
+    QBENCHMARK {
+        for (int page_start = 0; page_start < RowCount; page_start += page_size) {
+            int page_end = qMin(page_start + page_size, RowCount);
+            for (int row = page_start; row < page_end; ++row) {
+                for (int column = 0; column < column_count; ++column) {
+                    QModelIndex index = table_model.index(row,column);
+                    table_model.data(index,Qt::DisplayRole);
+                    table_model.data(index,Qt::DecorationRole);
+                }
+            }
+        }
+    }
+
+    QCOMPARE(table_model.data(table_model.index(RowCount - 1,table_model.columnPosition(AbstractObserverItemModel::ColumnName)),Qt::DisplayRole).toString(), QString("Object " + QString::number(RowCount - 1)));
+}
+
+void Qtilities::Testing::BenchmarkTests::benchmarkObserverAttachLogging_data() {
+    QTest::addColumn<int>("SubjectCount");
+    QTest::newRow("1000 subjects") << 1000;
+    QTest::newRow("10000 subjects") << 10000;
+}
+
+void Qtilities::Testing::BenchmarkTests::benchmarkObserverAttachLogging() {
+    QFETCH(int, SubjectCount);
+
+    // Trace and debug messages logged during attachment must be discarded before their arguments are built:
+    Logger::MessageType previous_log_level = Log->globalLogLevel();
+    Log->setGlobalLogLevel(Logger::Warning);
+    QVERIFY(!Log->isMessageTypeAccepted(Logger::Debug));
+    QVERIFY(!Log->isMessageTypeAccepted(Logger::Trace));
+
+    QList<QObject*> objects;
+    for (int i = 0; i < SubjectCount; ++i) {
+        QObject* obj = new QObject;
+        obj->setObjectName("Object " + QString::number(i));
+        objects << obj;
+    }
+
+    Observer observer("Attach Logging Benchmark Observer");
+    QBENCHMARK {
+        for (int i = 0; i < objects.count(); ++i)
+            observer.attachSubject(objects.at(i));
+        observer.detachAll();
+    }
+
+    Log->setGlobalLogLevel(previous_log_level);
+    qDeleteAll(objects);
+}
+
+void Qtilities::Testing::BenchmarkTests::benchmarkObserverDeleteSubjects_data() {
+    QTest::addColumn<int>("SubjectCount");
+    QTest::addColumn<bool>("UseBatch");
+    QTest::newRow("1000 subjects, event loop") << 1000 << false;
+    QTest::newRow("1000 subjects, batch") << 1000 << true;
+    QTest::newRow("10000 subjects, event loop") << 10000 << false;
+    QTest::newRow("10000 subjects, batch") << 10000 << true;
+}
+
+void Qtilities::Testing::BenchmarkTests::benchmarkObserverDeleteSubjects() {
+    QFETCH(int, SubjectCount);
+    QFETCH(bool, UseBatch);
+
+    Observer observer("Delete Benchmark Observer");
+    QList<QObject*> objects;
+    for (int i = 0; i < SubjectCount; ++i) {
+        QObject* obj = new QObject;
+        obj->setObjectName("Object " + QString::number(i));
+        objects << obj;
+    }
+    observer.attachSubjects(objects,Observer::ObserverScopeOwnership);
+    QCOMPARE(observer.subjectCount(), SubjectCount);
+
+    ObserverTreeModel tree_model;
+    tree_model.setObserverContext(&observer);
+    QCoreApplication::processEvents();
+
+    // Delete the subjects one by one, the way application code deletes objects outside of deleteAll():
+    QBENCHMARK_ONCE {
+        if (UseBatch)
+            observer.beginSubjectDeletionBatch();
+        for (int i = 0; i < objects.count(); ++i)
+            delete objects.at(i);
+        if (UseBatch)
+            observer.endSubjectDeletionBatch();
+        else
+            QCoreApplication::processEvents();
+    }
+
+    QCOMPARE(observer.subjectCount(), 0);
+}
+
+void Qtilities::Testing::BenchmarkTests::benchmarkObserverDeleteAll_data() {
+    QTest::addColumn<int>("SubjectCount");
+    QTest::addColumn<bool>("DeleteSubjects");
+    QTest::newRow("10000 subjects, deleteAll") << 10000 << true;
+    QTest::newRow("100000 subjects, deleteAll") << 100000 << true;
+    QTest::newRow("10000 subjects, detachAll") << 10000 << false;
+    QTest::newRow("100000 subjects, detachAll") << 100000 << false;
+}
+
+void Qtilities::Testing::BenchmarkTests::benchmarkObserverDeleteAll() {
+    QFETCH(int, SubjectCount);
+    QFETCH(bool, DeleteSubjects);
+
+    // When subjects are detached with ObserverScopeOwnership they go out of scope and are deleted, thus both cases free all objects:
+    Observer observer("Delete All Benchmark Observer");
+    QList<QObject*> objects;
+    for (int i = 0; i < SubjectCount; ++i) {
+        QObject* obj = new QObject;
+        obj->setObjectName("Object " + QString::number(i));
+        objects << obj;
+    }
+    observer.attachSubjects(objects,Observer::ObserverScopeOwnership);
+    QCOMPARE(observer.subjectCount(), SubjectCount);
+
+    QBENCHMARK_ONCE {
+        if (DeleteSubjects)
+            observer.deleteAll();
+        else
+            observer.detachAll();
+    }
+
+    QCOMPARE(observer.subjectCount(), 0);
+}
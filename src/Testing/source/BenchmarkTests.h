@@ -46,6 +46,21 @@ namespace Qtilities {
             void benchmarkObserverExport_1_0_1_0();
             //! Do a benchmark on a big observer export
             void benchmarkObserverImport_1_0_1_0();
+            void benchmarkSearchBoxReplaceAll_data();
+            //! Do a benchmark on SearchBoxWidget::replaceAll() on a large document
+            void benchmarkSearchBoxReplaceAll();
+            void benchmarkObserverTableModelScrolling_data();
+            //! Do a benchmark on the per cell cost of ObserverTableModel::data() when scrolling through a large table
+            void benchmarkObserverTableModelScrolling();
+            void benchmarkObserverAttachLogging_data();
+            //! Do a benchmark on attaching subjects to an observer while the global log level discards trace and debug messages
+            void benchmarkObserverAttachLogging();
+            void benchmarkObserverDeleteSubjects_data();
+            //! Do a benchmark on deleting the subjects of an observer displayed in a tree model one by one
+            void benchmarkObserverDeleteSubjects();
+            void benchmarkObserverDeleteAll_data();
+            //! Do a benchmark on Observer::deleteAll() and Observer::detachAll() on a large observer
+            void benchmarkObserverDeleteAll();
         };
     }
 }
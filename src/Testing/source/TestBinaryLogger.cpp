@@ -0,0 +1,144 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#include "TestBinaryLogger.h"
+
+#include <QtilitiesLogging>
+using namespace QtilitiesLogging;
+
+#include <QBuffer>
+
+int Qtilities::Testing::TestBinaryLogger::execTest(int argc, char ** argv) {
+    return QTest::qExec(this,argc,argv);
+}
+
+namespace {
+    QStringList qti_private_readMessages(BinaryLogReader* reader) {
+        QStringList messages;
+        BinaryLogRecord record;
+        reader->rewind();
+        while (reader->readNext(&record)) {
+            if (!record.d_message_parts.isEmpty())
+                messages << record.d_message_parts.front().toString();
+        }
+        return messages;
+    }
+}
+
+void Qtilities::Testing::TestBinaryLogger::writeTestLogs() {
+    if (!d_finalized_file.isEmpty())
+        return;
+
+    d_finalized_file = QDir::tempPath() + "/qtilities_test_binary_log" + qti_def_SUFFIX_BINARY_LOG;
+    d_unfinalized_file = QDir::tempPath() + "/qtilities_test_binary_log_unfinalized" + qti_def_SUFFIX_BINARY_LOG;
+    QFile::remove(d_unfinalized_file);
+
+    // Messages are passed to the engine directly, thus the test does not depend on the global log level.
+    // An index block is written after every two messages:
+    BinaryLoggerEngine engine;
+    engine.setFileName(d_finalized_file);
+    engine.setIndexInterval(2);
+    QVERIFY(engine.initialize());
+
+    engine.newMessages(QString(),Logger::Info,Logger::SystemWideMessages,QList<QVariant>() << "first");
+    engine.newMessages(QString(),Logger::Warning,Logger::SystemWideMessages,QList<QVariant>() << "second" << 2);
+
+    QTest::qWait(50);
+    d_second_batch_start = QDateTime::currentDateTime();
+    QTest::qWait(50);
+
+    engine.newMessages(QString(),Logger::Error,Logger::SystemWideMessages,QList<QVariant>() << "third");
+    engine.newMessages(QString(),Logger::Info,Logger::SystemWideMessages,QList<QVariant>() << "fourth");
+    // Fatal messages are flushed immediately, thus the file on disk contains all messages at this point:
+    engine.newMessages(QString(),Logger::Fatal,Logger::SystemWideMessages,QList<QVariant>() << "fifth");
+
+    // Copy the file before the engine writes its last index block and trailer:
+    QVERIFY(QFile::copy(d_finalized_file,d_unfinalized_file));
+    engine.finalize();
+}
+
+void Qtilities::Testing::TestBinaryLogger::testReadFiltered() {
+    writeTestLogs();
+
+    BinaryLogReader reader;
+    QString errorMsg;
+    QVERIFY2(reader.open(d_finalized_file,&errorMsg),qPrintable(errorMsg));
+    QVERIFY(reader.isFinalized());
+    QCOMPARE(reader.segmentCount(),3);
+
+    // All messages, with their types and parts:
+    BinaryLogRecord record;
+    QVERIFY(reader.readNext(&record));
+    QCOMPARE(record.d_message_type,Logger::Info);
+    QCOMPARE(record.d_message_parts.count(),1);
+    QCOMPARE(record.d_message_parts.at(0).toString(),QString("first"));
+    QVERIFY(reader.readNext(&record));
+    QCOMPARE(record.d_message_type,Logger::Warning);
+    QCOMPARE(record.d_message_parts.count(),2);
+    QCOMPARE(record.d_message_parts.at(1).toInt(),2);
+    QCOMPARE(qti_private_readMessages(&reader),QStringList() << "first" << "second" << "third" << "fourth" << "fifth");
+
+    // Time range: the segment with the first batch must be skipped using the index:
+    reader.setTimeRange(d_second_batch_start,QDateTime());
+    QCOMPARE(qti_private_readMessages(&reader),QStringList() << "third" << "fourth" << "fifth");
+    QCOMPARE(reader.skippedSegmentCount(),1);
+
+    reader.setTimeRange(QDateTime(),d_second_batch_start);
+    QCOMPARE(qti_private_readMessages(&reader),QStringList() << "first" << "second");
+
+    // Message types:
+    reader.setTimeRange(QDateTime(),QDateTime());
+    reader.setMessageTypes(Logger::Error | Logger::Fatal);
+    QCOMPARE(qti_private_readMessages(&reader),QStringList() << "third" << "fifth");
+
+    // Both filters:
+    reader.setTimeRange(QDateTime(),d_second_batch_start);
+    reader.setMessageTypes(Logger::Warning);
+    QCOMPARE(qti_private_readMessages(&reader),QStringList() << "second");
+}
+
+void Qtilities::Testing::TestBinaryLogger::testConvert() {
+    writeTestLogs();
+
+    BinaryLogReader reader;
+    QVERIFY(reader.open(d_finalized_file));
+    reader.setMessageTypes(Logger::Error | Logger::Fatal);
+
+    QBuffer buffer;
+    QVERIFY(buffer.open(QIODevice::WriteOnly));
+    QCOMPARE(reader.convert(&buffer,FormattingEngine_Default::instance()),2);
+    buffer.close();
+
+    QString text = QString::fromUtf8(buffer.data());
+    QVERIFY(text.contains("third"));
+    QVERIFY(text.contains("fifth"));
+    QVERIFY(!text.contains("first"));
+    QVERIFY(!text.contains("fourth"));
+
+    // The reader is rewound after the conversion:
+    QCOMPARE(qti_private_readMessages(&reader),QStringList() << "third" << "fifth");
+}
+
+void Qtilities::Testing::TestBinaryLogger::testReadUnfinalized() {
+    writeTestLogs();
+
+    BinaryLogReader reader;
+    QString errorMsg;
+    QVERIFY2(reader.open(d_unfinalized_file,&errorMsg),qPrintable(errorMsg));
+    QVERIFY(!reader.isFinalized());
+    QVERIFY(reader.segmentCount() >= 2);
+
+    QCOMPARE(qti_private_readMessages(&reader),QStringList() << "first" << "second" << "third" << "fourth" << "fifth");
+
+    reader.setTimeRange(d_second_batch_start,QDateTime());
+    reader.setMessageTypes(Logger::Info | Logger::Fatal);
+    QCOMPARE(qti_private_readMessages(&reader),QStringList() << "fourth" << "fifth");
+}
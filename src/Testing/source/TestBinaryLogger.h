@@ -0,0 +1,62 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#ifndef TEST_BINARY_LOGGER_H
+#define TEST_BINARY_LOGGER_H
+
+#include "Testing_global.h"
+#include "ITestable.h"
+
+#include <QtTest/QtTest>
+
+namespace Qtilities {
+    namespace Testing {
+        using namespace Interfaces;
+
+        //! Allows testing of Qtilities::Logging::BinaryLoggerEngine and Qtilities::Logging::BinaryLogReader.
+        class TESTING_SHARED_EXPORT TestBinaryLogger: public QObject, public ITestable
+        {
+            Q_OBJECT
+            Q_INTERFACES(Qtilities::Testing::Interfaces::ITestable)
+
+        public:
+            // --------------------------------
+            // IObjectBase Implementation
+            // --------------------------------
+            QObject* objectBase() { return this; }
+            const QObject* objectBase() const { return this; }
+
+            // --------------------------------
+            // ITestable Implementation
+            // --------------------------------
+            int execTest(int argc = 0, char ** argv = 0);
+            QString testName() const { return tr("BinaryLogger"); }
+
+        private slots:
+            //! Writes a log file, then checks the messages read back from it with and without time range and message type filters.
+            void testReadFiltered();
+            //! Tests conversion of a binary log file to text.
+            void testConvert();
+            //! Tests reading a file which was not finalized, thus its index must be rebuilt by scanning the file.
+            void testReadUnfinalized();
+
+        private:
+            //! Writes the log files used by the tests, once.
+            void writeTestLogs();
+
+            QString d_finalized_file;
+            QString d_unfinalized_file;
+            QDateTime d_second_batch_start;
+        };
+    }
+}
+
+#endif // TEST_BINARY_LOGGER_H
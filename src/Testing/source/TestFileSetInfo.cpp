@@ -45,3 +45,39 @@ void Qtilities::Testing::TestFileSetInfo::testGetHash() {
     int hash2 = fsi.fileSetHash();
     QVERIFY(hash1 != hash2);
 }
+
+void Qtilities::Testing::TestFileSetInfo::testFileChangedInWatchedDirectory() {
+    QDir temp_dir(QDir::tempPath());
+    const QString dir_name = QString("qti_test_file_watch_%1").arg(QCoreApplication::applicationPid());
+    QVERIFY(temp_dir.mkpath(dir_name));
+    const QString dir_path = temp_dir.filePath(dir_name);
+
+    // Watch more files than the directory watch threshold in a single directory:
+    const int file_count = FileWatchService::instance()->directoryWatchThreshold() + 4;
+    FileSetInfo fsi;
+    for (int i = 0; i < file_count; ++i) {
+        QFile file(QString("%1/file_%2.txt").arg(dir_path).arg(i));
+        QVERIFY(file.open(QIODevice::WriteOnly | QIODevice::Text));
+        file.write("Initial contents\n");
+        file.close();
+        fsi.addFile(file.fileName());
+    }
+
+    // Rewrite a file in place:
+    QSignalSpy changed_spy(&fsi,SIGNAL(fileChanged(QString)));
+    const QString changed_file = QString("%1/file_%2.txt").arg(dir_path).arg(file_count / 2);
+    QFile file(changed_file);
+    QVERIFY(file.open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text));
+    file.write("Changed contents\n");
+    file.close();
+
+    for (int i = 0; i < 50 && changed_spy.isEmpty(); ++i)
+        QTest::qWait(100);
+    QCOMPARE(changed_spy.count(), 1);
+    QCOMPARE(QDir::cleanPath(changed_spy.at(0).at(0).toString()), QDir::cleanPath(changed_file));
+
+    fsi.clear();
+    for (int i = 0; i < file_count; ++i)
+        QFile::remove(QString("%1/file_%2.txt").arg(dir_path).arg(i));
+    temp_dir.rmdir(dir_name);
+}
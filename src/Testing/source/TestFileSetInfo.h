@@ -42,6 +42,8 @@ namespace Qtilities {
 
         private slots:
             void testGetHash();
+            //! Tests that writes to files are reported when many files in the same directory are watched.
+            void testFileChangedInWatchedDirectory();
         };
     }
 }
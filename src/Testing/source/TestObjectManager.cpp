@@ -187,6 +187,180 @@ void Qtilities::Testing::TestObjectManager::testCompareDynamicPropertiesDiff() {
     QCOMPARE(diff.d_changed_properties.values().at(0), QString("5,10"));
 }
 
+void Qtilities::Testing::TestObjectManager::testCompareObserverTrees() {
+    Observer tree1("Tree");
+    Observer tree2("Tree");
+
+    Observer* node1 = new Observer("Node");
+    Observer* node2 = new Observer("Node");
+    tree1.attachSubject(node1,Observer::ObserverScopeOwnership);
+    tree2.attachSubject(node2,Observer::ObserverScopeOwnership);
+
+    QObject* item1 = new QObject;
+    item1->setObjectName("Item");
+    item1->setProperty("Normal Property",QVariant(10));
+    node1->attachSubject(item1,Observer::ObserverScopeOwnership);
+    QObject* item2 = new QObject;
+    item2->setObjectName("Item");
+    item2->setProperty("Normal Property",QVariant(10));
+    node2->attachSubject(item2,Observer::ObserverScopeOwnership);
+
+    QVERIFY(ObjectManager::compareObserverTrees(&tree1,&tree2));
+
+    // Changed properties are reported with the path to the object:
+    item2->setProperty("Normal Property",QVariant(5));
+    QList<ObjectDiffInfo> diffs;
+    QVERIFY(!ObjectManager::compareObserverTrees(&tree1,&tree2));
+    QVERIFY(!ObjectManager::compareObserverTrees(&tree1,&tree2,ObjectManager::NonQtilitiesProperties,&diffs));
+    QCOMPARE(diffs.count(), 1);
+    QCOMPARE(diffs.at(0).d_diff_type, ObjectDiffInfo::PropertiesChanged);
+    QCOMPARE(diffs.at(0).d_path, QString("Tree/Node/Item"));
+    QCOMPARE(diffs.at(0).d_property_diff_info.d_changed_properties.values().at(0), QString("5,10"));
+
+    // Subjects which only exist in one of the trees:
+    QObject* extra_item = new QObject;
+    extra_item->setObjectName("Extra Item");
+    node1->attachSubject(extra_item,Observer::ObserverScopeOwnership);
+    item2->setProperty("Normal Property",QVariant(10));
+    QVERIFY(!ObjectManager::compareObserverTrees(&tree1,&tree2,ObjectManager::NonQtilitiesProperties,&diffs));
+    QCOMPARE(diffs.count(), 1);
+    QCOMPARE(diffs.at(0).d_diff_type, ObjectDiffInfo::SubjectAdded);
+    QCOMPARE(diffs.at(0).d_path, QString("Tree/Node/Extra Item"));
+
+    QVERIFY(!ObjectManager::compareObserverTrees(&tree2,&tree1,ObjectManager::NonQtilitiesProperties,&diffs));
+    QCOMPARE(diffs.count(), 1);
+    QCOMPARE(diffs.at(0).d_diff_type, ObjectDiffInfo::SubjectRemoved);
+
+    tree1.deleteAll();
+    tree2.deleteAll();
+}
+
 void Qtilities::Testing::TestObjectManager::testMoveSubjects() {
+    Observer source_observer("Source Observer");
+    Observer destination_observer("Destination Observer");
+
+    QList<QObject*> objects;
+    for (int i = 0; i < 3; ++i) {
+        QObject* obj = new QObject;
+        obj->setObjectName(QString("Object %1").arg(i));
+        source_observer.attachSubject(obj,Observer::ObserverScopeOwnership);
+        objects << obj;
+    }
+    QList<QPointer<QObject> > safe_objects;
+    for (int i = 0; i < objects.count(); ++i)
+        safe_objects << objects.at(i);
+
+    // 1. A successful move keeps the ownership of the objects:
+    QVERIFY(OBJECT_MANAGER->moveSubjects(objects,source_observer.observerID(),destination_observer.observerID()));
+    QCOMPARE(source_observer.subjectCount(), 0);
+    QCOMPARE(destination_observer.subjectCount(), 3);
+    for (int i = 0; i < safe_objects.count(); ++i) {
+        QVERIFY(safe_objects.at(i));
+        QCOMPARE(destination_observer.getMultiContextPropertyValue(objects.at(i),qti_prop_OWNERSHIP).toInt(), (int) Observer::ObserverScopeOwnership);
+    }
+
+    // 2. A move which fails halfway is rolled back completely:
+    source_observer.setSubjectLimit(2);
+    QString error_msg;
+    QVERIFY(!OBJECT_MANAGER->moveSubjects(objects,destination_observer.observerID(),source_observer.observerID(),&error_msg));
+    QVERIFY(!error_msg.isEmpty());
+    QCOMPARE(source_observer.subjectCount(), 0);
+    QCOMPARE(destination_observer.subjectCount(), 3);
+    for (int i = 0; i < safe_objects.count(); ++i) {
+        QVERIFY(safe_objects.at(i));
+        QVERIFY(destination_observer.contains(objects.at(i)));
+        QCOMPARE(Observer::parentCount(objects.at(i)), 1);
+    }
+
+    // 3. Invalid moves are rejected before anything is changed:
+    QVERIFY(!OBJECT_MANAGER->moveSubjects(objects,source_observer.observerID(),destination_observer.observerID(),&error_msg));
+    QCOMPARE(destination_observer.subjectCount(), 3);
+
+    destination_observer.deleteAll();
+}
+
+void Qtilities::Testing::TestObjectManager::testFactoryCatalog() {
+    // 1. Repeated lookups are answered from the catalog without querying the factory providers:
+    QVERIFY(OBJECT_MANAGER->allFactoryNames().contains(qti_def_FACTORY_QTILITIES));
+    QVERIFY(OBJECT_MANAGER->tagsForFactory(qti_def_FACTORY_QTILITIES).contains(qti_def_FACTORY_TAG_OBSERVER));
+    int build_count = OBJECT_MANAGER->factoryCatalogBuildCount();
+    int hit_count = OBJECT_MANAGER->factoryCatalogHitCount();
+    for (int i = 0; i < 10; ++i) {
+        OBJECT_MANAGER->allFactoryNames();
+        OBJECT_MANAGER->tagsForFactory(qti_def_FACTORY_QTILITIES);
+    }
+    QCOMPARE(OBJECT_MANAGER->factoryCatalogBuildCount(), build_count);
+    QCOMPARE(OBJECT_MANAGER->factoryCatalogHitCount(), hit_count + 20);
+
+    // 2. Tags are indexed by category:
+    QtilitiesCategory core_category("Core Classes");
+    QStringList core_tags = OBJECT_MANAGER->tagsForFactory(qti_def_FACTORY_QTILITIES,core_category);
+    QVERIFY(core_tags.contains(qti_def_FACTORY_TAG_OBSERVER));
+    QVERIFY(!core_tags.contains(qti_def_FACTORY_TAG_ACTIVITY_FILTER));
+    QVERIFY(OBJECT_MANAGER->categoriesForFactory(qti_def_FACTORY_QTILITIES).contains(core_category));
+    QVERIFY(OBJECT_MANAGER->tagsForFactory("Unknown Factory").isEmpty());
+
+    // 3. Registering a new factory interface invalidates the catalog:
+    QtilitiesCategory test_category("Factory Catalog Test");
+    OBJECT_MANAGER->registerFactoryInterface(&Observer::factory,FactoryItemID("Factory Catalog Test Observer",test_category));
+    QCOMPARE(OBJECT_MANAGER->tagsForFactory(qti_def_FACTORY_QTILITIES,test_category), QStringList() << "Factory Catalog Test Observer");
+    QCOMPARE(OBJECT_MANAGER->factoryCatalogBuildCount(), build_count + 1);
+
+    // 4. Unregistering the factory interface invalidates the catalog as well:
+    OBJECT_MANAGER->unregisterFactoryInterface("Factory Catalog Test Observer");
+    QVERIFY(OBJECT_MANAGER->tagsForFactory(qti_def_FACTORY_QTILITIES,test_category).isEmpty());
+    QVERIFY(!OBJECT_MANAGER->tagsForFactory(qti_def_FACTORY_QTILITIES).contains("Factory Catalog Test Observer"));
+    QCOMPARE(OBJECT_MANAGER->factoryCatalogBuildCount(), build_count + 2);
+}
+
+void Qtilities::Testing::TestObjectManager::testRegisteredInterfaces() {
+    const QString iface = "Qtilities::Core::Observer";
+    const int initial_count = OBJECT_MANAGER->registeredInterfaces(iface).count();
+    QSignalSpy added_spy(OBJECT_MANAGER,SIGNAL(newInterfaceObjectAdded(QString,QObject*)));
+    QSignalSpy removed_spy(OBJECT_MANAGER,SIGNAL(interfaceObjectRemoved(QString,QObject*)));
+
+    // 1. Registered objects are added to the index of interfaces they implement:
+    Observer* observer = new Observer("Interface Index Observer");
+    QObject* plain_object = new QObject;
+    OBJECT_MANAGER->registerObject(observer);
+    OBJECT_MANAGER->registerObject(plain_object);
+    QList<QObject*> objects = OBJECT_MANAGER->registeredInterfaces(iface);
+    QCOMPARE(objects.count(), initial_count + 1);
+    QVERIFY(objects.contains(observer));
+    QCOMPARE(added_spy.count(), 1);
+    QCOMPARE(added_spy.at(0).at(0).toString(), iface);
+
+    // 2. Removed objects are removed from the index:
+    OBJECT_MANAGER->removeObject(observer);
+    QVERIFY(!OBJECT_MANAGER->registeredInterfaces(iface).contains(observer));
+    QCOMPARE(removed_spy.count(), 1);
+
+    // 3. Deleted objects are removed from the index:
+    OBJECT_MANAGER->registerObject(observer);
+    QCOMPARE(OBJECT_MANAGER->registeredInterfaces(iface).count(), initial_count + 1);
+    delete observer;
+    QCOMPARE(OBJECT_MANAGER->registeredInterfaces(iface).count(), initial_count);
+    QCOMPARE(removed_spy.count(), 2);
+
+    // 4. Objects attached to the object pool directly are picked up:
+    Observer direct_observer("Direct Interface Index Observer");
+    OBJECT_MANAGER->objectPool()->attachSubject(&direct_observer);
+    QVERIFY(OBJECT_MANAGER->registeredInterfaces(iface).contains(&direct_observer));
+    OBJECT_MANAGER->objectPool()->detachSubject(&direct_observer);
+    QVERIFY(!OBJECT_MANAGER->registeredInterfaces(iface).contains(&direct_observer));
+
+    // 5. Attaching one object and detaching another directly, which leaves the number of objects in the pool unchanged, is picked up:
+    OBJECT_MANAGER->objectPool()->attachSubject(&direct_observer);
+    QVERIFY(OBJECT_MANAGER->registeredInterfaces(iface).contains(&direct_observer));
+    Observer other_direct_observer("Other Direct Interface Index Observer");
+    OBJECT_MANAGER->objectPool()->attachSubject(&other_direct_observer);
+    OBJECT_MANAGER->objectPool()->detachSubject(&direct_observer);
+    QList<QObject*> direct_objects = OBJECT_MANAGER->registeredInterfaces(iface);
+    QVERIFY(direct_objects.contains(&other_direct_observer));
+    QVERIFY(!direct_objects.contains(&direct_observer));
+    OBJECT_MANAGER->objectPool()->detachSubject(&other_direct_observer);
+    QVERIFY(!OBJECT_MANAGER->registeredInterfaces(iface).contains(&other_direct_observer));
 
+    OBJECT_MANAGER->removeObject(plain_object);
+    delete plain_object;
 }
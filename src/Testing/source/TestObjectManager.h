@@ -47,8 +47,14 @@ namespace Qtilities {
             void testCompareDynamicProperties();
             //! Tests comparing of dynamic properties diff calculation.
             void testCompareDynamicPropertiesDiff();
+            //! Tests comparing the dynamic properties of observer trees.
+            void testCompareObserverTrees();
             //! Tests moving of subjects between observers using ObjectManager::moveSubjects().
             void testMoveSubjects();
+            //! Tests the factory catalog used by ObjectManager::tagsForFactory() and ObjectManager::allFactoryNames().
+            void testFactoryCatalog();
+            //! Tests the interface index used by ObjectManager::registeredInterfaces().
+            void testRegisteredInterfaces();
         };
     }
 }
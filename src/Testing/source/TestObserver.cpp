@@ -48,6 +48,68 @@ void Qtilities::Testing::TestObserver::testSubjectLimit() {
     QVERIFY(node.addItem("Item 3") != 0);
 }
 
+void Qtilities::Testing::TestObserver::testSubjectDeletionNotifications() {
+    Observer observer("Subject Deletion Notifications Observer");
+    QList<QObject*> objects;
+    for (int i = 0; i < 20; ++i) {
+        QObject* obj = new QObject;
+        obj->setObjectName("Object " + QString::number(i));
+        objects << obj;
+    }
+    observer.attachSubjects(objects,Observer::ObserverScopeOwnership);
+    QCOMPARE(observer.subjectCount(), 20);
+
+    QSignalSpy layout_spy(&observer,SIGNAL(layoutChanged(QList<QPointer<QObject> >)));
+    QSignalSpy deleted_spy(&observer,SIGNAL(subjectsDeleted(QList<QObject*>)));
+
+    // Deletions outside of the observer are reported once the event loop is reached:
+    for (int i = 0; i < 5; ++i)
+        delete objects.at(i);
+    QCOMPARE(observer.subjectCount(), 15);
+    QCOMPARE(deleted_spy.count(), 0);
+    QCoreApplication::processEvents();
+    QCOMPARE(layout_spy.count(), 1);
+    QCOMPARE(deleted_spy.count(), 1);
+    QCOMPARE(deleted_spy.at(0).at(0).value<QList<QObject*> >().count(), 5);
+
+    // Deletions in a batch are reported when the batch ends:
+    layout_spy.clear();
+    deleted_spy.clear();
+    observer.beginSubjectDeletionBatch();
+    for (int i = 5; i < 10; ++i)
+        delete objects.at(i);
+    QCOMPARE(deleted_spy.count(), 0);
+    observer.endSubjectDeletionBatch();
+    QCOMPARE(layout_spy.count(), 1);
+    QCOMPARE(deleted_spy.count(), 1);
+    QCOMPARE(deleted_spy.at(0).at(0).value<QList<QObject*> >().count(), 5);
+    QCoreApplication::processEvents();
+    QCOMPARE(layout_spy.count(), 1);
+    QCOMPARE(deleted_spy.count(), 1);
+
+    // deleteAll() without refreshing views keeps the deletions pending until the next broadcast:
+    layout_spy.clear();
+    deleted_spy.clear();
+    observer.deleteAll("QObject",false);
+    QCOMPARE(observer.subjectCount(), 0);
+    QCOMPARE(layout_spy.count(), 0);
+    QCOMPARE(deleted_spy.count(), 0);
+    observer.startProcessingCycle();
+    observer.endProcessingCycle();
+    QCOMPARE(deleted_spy.count(), 1);
+    QCOMPARE(deleted_spy.at(0).at(0).value<QList<QObject*> >().count(), 10);
+
+    // deleteAll() refreshes views once:
+    for (int i = 0; i < 10; ++i)
+        observer.attachSubject(new QObject,Observer::ObserverScopeOwnership);
+    layout_spy.clear();
+    deleted_spy.clear();
+    observer.deleteAll();
+    QCOMPARE(observer.subjectCount(), 0);
+    QCOMPARE(layout_spy.count(), 1);
+    QCOMPARE(deleted_spy.count(), 1);
+}
+
 void Qtilities::Testing::TestObserver::testOwnershipManual() {
     LOG_INFO("TestObserver::testOwnershipManual() start:");
 
@@ -211,6 +273,47 @@ void Qtilities::Testing::TestObserver::testTreeCount() {
     QCOMPARE(rootNode->treeCount(), 7);
 }
 
+void Qtilities::Testing::TestObserver::testTreeCountCache() {
+    TreeNode rootNode("Root");
+    TreeNode* parentNode = rootNode.addNode("Parent");
+    TreeNode* childNode = parentNode->addNode("Child");
+    childNode->addItem("Grandchild 1");
+    TreeItem* grandchild = childNode->addItem("Grandchild 2");
+
+    // Fill the caches of all observers in the tree:
+    QCOMPARE(rootNode.treeCount(), 4);
+    QCOMPARE(rootNode.treeCount("Qtilities::CoreGui::TreeItem"), 2);
+    QCOMPARE(parentNode->treeCount(), 3);
+    QCOMPARE(childNode->treeCount(), 2);
+
+    // Nested attachment:
+    QObject nested_object;
+    QVERIFY(childNode->attachSubject(&nested_object,Observer::ManualOwnership));
+    QCOMPARE(rootNode.treeCount(), 5);
+    QCOMPARE(parentNode->treeCount(), 4);
+    QCOMPARE(childNode->treeCount(), 3);
+    QCOMPARE(rootNode.treeCount("Qtilities::CoreGui::TreeItem"), 2);
+
+    // Nested detachment:
+    QVERIFY(childNode->detachSubject(&nested_object));
+    QCOMPARE(rootNode.treeCount(), 4);
+    QCOMPARE(parentNode->treeCount(), 3);
+    QCOMPARE(childNode->treeCount(), 2);
+
+    // Deleting a grandchild:
+    delete grandchild;
+    QCOMPARE(rootNode.treeCount(), 3);
+    QCOMPARE(rootNode.treeCount("Qtilities::CoreGui::TreeItem"), 1);
+    QCOMPARE(parentNode->treeCount(), 2);
+    QCOMPARE(childNode->treeCount(), 1);
+
+    // Deleting a node removes its subtree:
+    delete childNode;
+    QCOMPARE(rootNode.treeCount(), 1);
+    QCOMPARE(rootNode.treeCount("Qtilities::CoreGui::TreeItem"), 0);
+    QCOMPARE(parentNode->treeCount(), 0);
+}
+
 void Qtilities::Testing::TestObserver::testTreeAt() {
     // Example tree using tree node classes to simplify test:
     TreeNode* rootNode = new TreeNode("Root");
@@ -267,6 +370,179 @@ void Qtilities::Testing::TestObserver::testTreeChildren() {
     QCOMPARE(items_verify.count(), 5);
 }
 
+void Qtilities::Testing::TestObserver::testTreeProcessingCycle() {
+    TreeNode rootNode("Root");
+    TreeNode* nodeA = rootNode.addNode("Node A");
+    TreeNode* nodeB = rootNode.addNode("Node B");
+    nodeA->addItem("Item A");
+    nodeB->addItem("Item B");
+
+    QSignalSpy root_layout_spy(&rootNode,SIGNAL(layoutChanged(QList<QPointer<QObject> >)));
+    QSignalSpy a_layout_spy(nodeA,SIGNAL(layoutChanged(QList<QPointer<QObject> >)));
+    QSignalSpy a_count_spy(nodeA,SIGNAL(numberOfSubjectsChanged(Observer::SubjectChangeIndication,QList<QPointer<QObject> >)));
+    QSignalSpy b_layout_spy(nodeB,SIGNAL(layoutChanged(QList<QPointer<QObject> >)));
+    QSignalSpy b_count_spy(nodeB,SIGNAL(numberOfSubjectsChanged(Observer::SubjectChangeIndication,QList<QPointer<QObject> >)));
+
+    rootNode.startTreeProcessingCycle();
+    QVERIFY(nodeA->isProcessingCycleActive());
+    QVERIFY(nodeB->isProcessingCycleActive());
+    nodeA->addItem("New Item A");
+    nodeA->addItem("Another Item A");
+    QCOMPARE(a_count_spy.count(), 0);
+    rootNode.endTreeProcessingCycle();
+
+    QVERIFY(!nodeA->isProcessingCycleActive());
+    QVERIFY(!nodeB->isProcessingCycleActive());
+    QCOMPARE(a_count_spy.count(), 1);
+    QCOMPARE(b_count_spy.count(), 0);
+    QCOMPARE(b_layout_spy.count(), 0);
+    // Only the observer on which the tree processing cycle was started emits layoutChanged():
+    QCOMPARE(a_layout_spy.count(), 0);
+    QCOMPARE(root_layout_spy.count(), 1);
+
+    // When the observer on which the tree processing cycle was started is deleted, the cycles of the members are ended:
+    Observer* ancestor = new Observer("Tree Processing Cycle Ancestor");
+    TreeNode middleNode("Middle");
+    TreeNode* childNode = middleNode.addNode("Child");
+    QVERIFY(ancestor->attachSubject(&middleNode,Observer::ManualOwnership));
+
+    QSignalSpy child_layout_spy(childNode,SIGNAL(layoutChanged(QList<QPointer<QObject> >)));
+    QSignalSpy child_count_spy(childNode,SIGNAL(numberOfSubjectsChanged(Observer::SubjectChangeIndication,QList<QPointer<QObject> >)));
+
+    ancestor->startTreeProcessingCycle();
+    childNode->addItem("Child Item");
+    QVERIFY(childNode->isProcessingCycleActive());
+    delete ancestor;
+    QVERIFY(!childNode->isProcessingCycleActive());
+    QCOMPARE(child_count_spy.count(), 1);
+    QCOMPARE(child_layout_spy.count(), 1);
+}
+
+void Qtilities::Testing::TestObserver::testSubjectCategories() {
+    // Categories with the same levels share their interned paths:
+    QtilitiesCategory category_a("Top::Middle","::");
+    QtilitiesCategory category_b;
+    category_b << "Top" << "Middle";
+    QCOMPARE(category_a.pathId(), category_b.pathId());
+    QVERIFY(category_a == category_b);
+    QVERIFY(category_a.parentCategory() == QtilitiesCategory("Top"));
+    QVERIFY(QtilitiesCategory("Top") < category_a);
+    QCOMPARE(QtilitiesCategory().pathId(), (quint32) 0);
+
+    TreeNode node("Categorized Node");
+    node.enableCategorizedDisplay();
+    QObject* item1 = node.addItem("Item 1",category_a);
+    QObject* item2 = node.addItem("Item 2",QtilitiesCategory("Other"));
+    QObject* item3 = node.addItem("Item 3",category_b);
+    QObject* item4 = node.addItem("Item 4");
+
+    QList<QtilitiesCategory> categories = node.subjectCategories();
+    QCOMPARE(categories.count(), 3);
+
+    QHash<QtilitiesCategory, QList<QPointer<QObject> > > category_hash = node.subjectReferenceCategoryHash();
+    QCOMPARE(category_hash.count(), 3);
+    QCOMPARE(category_hash.value(category_a).count(), 2);
+    QVERIFY(category_hash.value(category_a).at(0) == item1);
+    QVERIFY(category_hash.value(category_a).at(1) == item3);
+    QVERIFY(category_hash.value(QtilitiesCategory("Other")).at(0) == item2);
+    QVERIFY(category_hash.value(QtilitiesCategory()).at(0) == item4);
+    QCOMPARE(node.subjectReferencesByCategory(category_b).count(), 2);
+}
+
+void Qtilities::Testing::TestObserver::testModificationStatePropagation() {
+    TreeNode rootNode("Root");
+    TreeNode* nodeA = rootNode.addNode("Node A");
+    TreeNode* nodeB = nodeA->addNode("Node B");
+    TreeNode* nodeC = rootNode.addNode("Node C");
+    TreeItem* item = nodeB->addItem("Item");
+    nodeC->addItem("Other Item");
+
+    rootNode.setModificationState(false,IModificationNotifier::NotifyListeners | IModificationNotifier::NotifySubjects);
+    QVERIFY(!rootNode.isModified());
+    QVERIFY(!nodeA->isModified());
+    QVERIFY(!nodeB->isModified());
+    QVERIFY(!item->isModified());
+
+    // Changes deep in the tree are reported to all ancestors, but not to other branches:
+    item->setModificationState(true);
+    QVERIFY(nodeB->isModified());
+    QVERIFY(nodeA->isModified());
+    QVERIFY(rootNode.isModified());
+    QVERIFY(!nodeC->isModified());
+
+    // Clearing the state from the top of the tree clears it on the dirty path:
+    rootNode.setModificationState(false,IModificationNotifier::NotifyListeners | IModificationNotifier::NotifySubjects);
+    QVERIFY(!item->isModified());
+    QVERIFY(!nodeB->isModified());
+    QVERIFY(!nodeA->isModified());
+    QVERIFY(!rootNode.isModified());
+
+    // Subjects which change without notifying listeners are still found by the observer they are attached to:
+    item->setModificationState(true,IModificationNotifier::NotifySubjects);
+    QVERIFY(nodeB->isModified());
+    nodeB->setModificationState(false,IModificationNotifier::NotifyListeners | IModificationNotifier::NotifySubjects);
+    QVERIFY(!item->isModified());
+    QVERIFY(!nodeB->isModified());
+
+    // Subjects of which the modification states are not monitored are ignored:
+    QVERIFY(nodeB->setMonitorSubjectModificationState(item,false));
+    item->setModificationState(true);
+    nodeB->setModificationState(false);
+    QVERIFY(!nodeB->isModified());
+    QVERIFY(nodeB->setMonitorSubjectModificationState(item,true));
+    QVERIFY(nodeB->isModified());
+}
+
+void Qtilities::Testing::TestObserver::testModificationStateDetachedSubject() {
+    TreeNode node("Node");
+    TreeItem item("Item");
+    QVERIFY(node.attachSubject(&item,Observer::ManualOwnership));
+    node.setModificationState(false,IModificationNotifier::NotifyListeners | IModificationNotifier::NotifySubjects);
+    QVERIFY(!node.isModified());
+
+    item.setModificationState(true);
+    QVERIFY(node.isModified());
+
+    // Detaching the modified subject modifies the observer itself, once cleared the subject is not taken into account anymore:
+    QVERIFY(node.detachSubject(&item));
+    node.setModificationState(false);
+    QVERIFY(!node.isModified());
+    QVERIFY(item.isModified());
+
+    // The observer does not listen to the detached subject anymore:
+    item.setModificationState(false);
+    item.setModificationState(true);
+    QVERIFY(!node.isModified());
+}
+
+void Qtilities::Testing::TestObserver::testModificationStateSilentSubject() {
+    TreeNode rootNode("Root");
+    TreeNode* nodeA = rootNode.addNode("Node A");
+    TreeNode* nodeB = nodeA->addNode("Node B");
+    TreeItem* item = nodeB->addItem("Item");
+    rootNode.addNode("Node C");
+
+    rootNode.setModificationState(false,IModificationNotifier::NotifyListeners | IModificationNotifier::NotifySubjects);
+    QVERIFY(!rootNode.isModified());
+
+    // Modify the grandchild item without notifying listeners:
+    item->setModificationState(true,IModificationNotifier::NotifySubjects);
+    QVERIFY(nodeB->isModified());
+    QVERIFY(nodeA->isModified());
+    QVERIFY(rootNode.isModified());
+
+    // Clearing the modification state from the top of the tree must reach the item:
+    rootNode.setModificationState(false,IModificationNotifier::NotifyListeners | IModificationNotifier::NotifySubjects);
+    QVERIFY(!item->isModified());
+    QVERIFY(!rootNode.isModified());
+
+    // Items added to the tree afterwards are taken into account as well:
+    TreeItem* new_item = nodeB->addItem("New Item");
+    rootNode.setModificationState(false,IModificationNotifier::NotifyListeners | IModificationNotifier::NotifySubjects);
+    new_item->setModificationState(true,IModificationNotifier::NotifySubjects);
+    QVERIFY(rootNode.isModified());
+}
+
 //void Qtilities::Testing::TestObserver::testCountModificationStateChanges() {
 //    TreeNode node("testCountModificationStateChangesNode");
 //    QSignalSpy spy(&node, SIGNAL(modificationStateChanged(bool)));
@@ -54,6 +54,8 @@ namespace Qtilities {
             void testAttachWithObserverLimit();
             //! Tests the subject limit functionality Observer.
             void testSubjectLimit();
+            //! Tests that deletions of subjects are reported once per event loop turn, subject deletion batch or processing cycle.
+            void testSubjectDeletionNotifications();
 
             // -----------------------------
             // Ownership related tests
@@ -74,16 +76,32 @@ namespace Qtilities {
             // -----------------------------
             //! A test which tests treeCount() function.
             void testTreeCount();
+            //! A test which tests that cached treeCount() results are updated after changes deeper in the tree.
+            void testTreeCountCache();
             //! A test which tests treeAt() function.
             void testTreeAt();
             //! A test which tests treeAt() function.
             void testTreeContains();
             //! A test which tests treeChildren() function.
             void testTreeChildren();
+            //! A test which tests that only observers which changed during a tree processing cycle emit signals when it ends.
+            void testTreeProcessingCycle();
+
+            // -----------------------------
+            // Category related tests
+            // -----------------------------
+            //! A test which tests subjectCategories() and subjectReferenceCategoryHash().
+            void testSubjectCategories();
 
             // -----------------------------
             // Modification state tests.
             // -----------------------------
+            //! A test which tests that modification states of subjects deep in a tree are reported to the top of the tree, and cleared again.
+            void testModificationStatePropagation();
+            //! A test which tests that detached subjects do not change the modification state of an observer anymore.
+            void testModificationStateDetachedSubject();
+            //! A test which tests that subjects deep in a tree which change their modification states without notifying listeners are taken into account at the top of the tree.
+            void testModificationStateSilentSubject();
             //! A test which counts the number of modification state changed signal emissions for a specific test case.
             //void testCountModificationStateChanges();
         };
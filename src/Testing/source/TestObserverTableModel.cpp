@@ -0,0 +1,216 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#include "TestObserverTableModel.h"
+
+#include <QtilitiesCoreGui>
+using namespace QtilitiesCoreGui;
+
+int Qtilities::Testing::TestObserverTableModel::execTest(int argc, char ** argv) {
+    return QTest::qExec(this,argc,argv);
+}
+
+namespace {
+    // Prepares a model which shows the name and category columns of the observer context, with modification states.
+    void qti_private_initTableModel(ObserverTableModel* model, Observer* observer) {
+        ObserverHints hints;
+        hints.setItemViewColumnHint(ObserverHints::ColumnNameHint | ObserverHints::ColumnCategoryHint);
+        hints.setModificationStateDisplayHint(ObserverHints::CharacterModificationStateDisplay);
+        model->toggleUseObserverHints(false);
+        model->setCustomHints(&hints);
+        model->setObserverContext(observer);
+    }
+
+    QString qti_private_rowName(ObserverTableModel* model, int row) {
+        return model->data(model->index(row,model->columnPosition(AbstractObserverItemModel::ColumnName)),Qt::DisplayRole).toString();
+    }
+}
+
+void Qtilities::Testing::TestObserverTableModel::testAttachDetach() {
+    Observer observer("Table Model Observer");
+    ObserverTableModel model;
+    qti_private_initTableModel(&model,&observer);
+    QCOMPARE(model.rowCount(),0);
+
+    QSignalSpy inserted_spy(&model,SIGNAL(rowsInserted(QModelIndex,int,int)));
+    QSignalSpy removed_spy(&model,SIGNAL(rowsRemoved(QModelIndex,int,int)));
+    QSignalSpy layout_spy(&model,SIGNAL(layoutChanged()));
+
+    QObject* obj1 = new QObject;
+    obj1->setObjectName("Object 1");
+    QObject* obj2 = new QObject;
+    obj2->setObjectName("Object 2");
+    QObject* obj3 = new QObject;
+    obj3->setObjectName("Object 3");
+
+    // Attachments outside of processing cycles must be reported as row insertions:
+    QVERIFY(observer.attachSubject(obj1,Observer::ObserverScopeOwnership));
+    QVERIFY(observer.attachSubject(obj2,Observer::ObserverScopeOwnership));
+    QVERIFY(observer.attachSubject(obj3,Observer::ObserverScopeOwnership));
+    QCOMPARE(inserted_spy.count(),3);
+    QCOMPARE(layout_spy.count(),0);
+    QCOMPARE(model.rowCount(),3);
+    QCOMPARE(qti_private_rowName(&model,0),QString("Object 1"));
+    QCOMPARE(qti_private_rowName(&model,1),QString("Object 2"));
+    QCOMPARE(qti_private_rowName(&model,2),QString("Object 3"));
+
+    // Detaching the middle subject must remove only its row:
+    QVERIFY(observer.detachSubject(obj2));
+    QCOMPARE(removed_spy.count(),1);
+    QCOMPARE(removed_spy.at(0).at(1).toInt(),1);
+    QCOMPARE(removed_spy.at(0).at(2).toInt(),1);
+    QCOMPARE(layout_spy.count(),0);
+    QCOMPARE(model.rowCount(),2);
+    QCOMPARE(qti_private_rowName(&model,0),QString("Object 1"));
+    QCOMPARE(qti_private_rowName(&model,1),QString("Object 3"));
+    QCOMPARE(model.getObject(1),obj3);
+
+    // Deleting a subject must remove its row as well:
+    delete obj1;
+    QCOMPARE(model.rowCount(),1);
+    QCOMPARE(qti_private_rowName(&model,0),QString("Object 3"));
+
+    QVERIFY(observer.detachSubject(obj3));
+    QCOMPARE(model.rowCount(),0);
+}
+
+void Qtilities::Testing::TestObserverTableModel::testProcessingCycleChanges() {
+    Observer observer("Table Model Observer");
+    ObserverTableModel model;
+    qti_private_initTableModel(&model,&observer);
+
+    QObject* obj1 = new QObject;
+    obj1->setObjectName("Object 1");
+    QObject* obj2 = new QObject;
+    obj2->setObjectName("Object 2");
+    QObject* obj3 = new QObject;
+    obj3->setObjectName("Object 3");
+    QVERIFY(observer.attachSubject(obj1,Observer::ObserverScopeOwnership));
+    QVERIFY(observer.attachSubject(obj2,Observer::ObserverScopeOwnership));
+    QCOMPARE(model.rowCount(),2);
+    QCOMPARE(qti_private_rowName(&model,1),QString("Object 2"));
+
+    // Replace a subject during a processing cycle, the number of subjects stays the same:
+    QSignalSpy layout_spy(&model,SIGNAL(layoutChanged()));
+    observer.startProcessingCycle();
+    QVERIFY(observer.detachSubject(obj2));
+    QVERIFY(observer.attachSubject(obj3,Observer::ObserverScopeOwnership));
+    observer.endProcessingCycle();
+    QCOMPARE(layout_spy.count(),1);
+    QCOMPARE(model.rowCount(),2);
+    QCOMPARE(qti_private_rowName(&model,0),QString("Object 1"));
+    QCOMPARE(qti_private_rowName(&model,1),QString("Object 3"));
+    QCOMPARE(model.getObject(1),obj3);
+
+    // A processing cycle without changes must not refresh the model:
+    observer.startProcessingCycle();
+    observer.endProcessingCycle();
+    QCOMPARE(layout_spy.count(),1);
+}
+
+void Qtilities::Testing::TestObserverTableModel::testRowDataChanges() {
+    Observer observer("Table Model Observer");
+    ObserverTableModel model;
+    qti_private_initTableModel(&model,&observer);
+
+    TreeNode* node = new TreeNode("Node");
+    QVERIFY(observer.attachSubject(node,Observer::ObserverScopeOwnership));
+    QObject* other = new QObject;
+    other->setObjectName("Other");
+    QVERIFY(observer.attachSubject(other,Observer::ObserverScopeOwnership));
+    QCOMPARE(qti_private_rowName(&model,0),QString("Node"));
+
+    // Renaming the subject:
+    node->setObjectName("Renamed Node");
+    QCOMPARE(qti_private_rowName(&model,0),QString("Renamed Node"));
+
+    // Changing the modification state of the subject:
+    node->setModificationState(true);
+    QCOMPARE(qti_private_rowName(&model,0),QString("Renamed Node*"));
+    node->setModificationState(false);
+    QCOMPARE(qti_private_rowName(&model,0),QString("Renamed Node"));
+
+    // Changing the category of the subject:
+    QModelIndex category_index = model.index(0,model.columnPosition(AbstractObserverItemModel::ColumnCategory));
+    QCOMPARE(model.data(category_index,Qt::DisplayRole).toString(),QString());
+    QSignalSpy data_spy(&model,SIGNAL(dataChanged(QModelIndex,QModelIndex)));
+    QSignalSpy layout_spy(&model,SIGNAL(layoutChanged()));
+    MultiContextProperty category_property(qti_prop_CATEGORY_MAP);
+    category_property.setValue(qVariantFromValue(QtilitiesCategory("Category A")),observer.observerID());
+    ObjectManager::setMultiContextProperty(node,category_property);
+    QCOMPARE(model.data(category_index,Qt::DisplayRole).toString(),QString("Category A"));
+    QCOMPARE(model.rowCount(),2);
+
+    // Changing a role property of the subject:
+    SharedProperty decoration_property(qti_prop_DECORATION,QVariant(QString("Decoration")));
+    ObjectManager::setSharedProperty(node,decoration_property);
+
+    // Category and role property changes must only refresh the row of the subject, not the complete table:
+    QCOMPARE(layout_spy.count(),0);
+    QVERIFY(data_spy.count() > 0);
+    for (int i = 0; i < data_spy.count(); ++i) {
+        QCOMPARE(data_spy.at(i).at(0).value<QModelIndex>().row(),0);
+        QCOMPARE(data_spy.at(i).at(1).value<QModelIndex>().row(),0);
+    }
+}
+
+void Qtilities::Testing::TestObserverTableModel::testSearchIndexFiltering() {
+    Observer observer("Table Model Observer");
+    ObserverTableModel model;
+    qti_private_initTableModel(&model,&observer);
+
+    QObject* apple = new QObject;
+    apple->setObjectName("Apple");
+    QObject* banana = new QObject;
+    banana->setObjectName("Banana");
+    QObject* apricot = new QObject;
+    apricot->setObjectName("Apricot");
+    QVERIFY(observer.attachSubject(apple,Observer::ObserverScopeOwnership));
+    QVERIFY(observer.attachSubject(banana,Observer::ObserverScopeOwnership));
+    QVERIFY(observer.attachSubject(apricot,Observer::ObserverScopeOwnership));
+
+    ObserverTableModelProxyFilter proxy;
+    proxy.toggleUseObserverHints(false);
+    proxy.setSourceModel(&model);
+    ObserverSearchIndex search_index;
+    search_index.setDebounceInterval(0);
+    search_index.setSourceModel(&model);
+    proxy.setSearchIndex(&search_index);
+
+    // Run a query and filter the proxy once it completed, as ObserverWidget does:
+    QSignalSpy completed_spy(&search_index,SIGNAL(searchCompleted(int)));
+    search_index.search("ap");
+    for (int i = 0; i < 50 && completed_spy.isEmpty(); ++i)
+        QTest::qWait(20);
+    QCOMPARE(completed_spy.count(),1);
+    proxy.invalidateSearchFilter();
+    QCOMPARE(search_index.matchCount(),2);
+    QCOMPARE(proxy.rowCount(),2);
+
+    // Renaming a subject so that it matches must show its row:
+    QSignalSpy matches_spy(&search_index,SIGNAL(matchesChanged(QModelIndex,int,int)));
+    banana->setObjectName("Apple Banana");
+    observer.refreshViewsData();
+    QCOMPARE(matches_spy.count(),1);
+    QCOMPARE(search_index.matchCount(),3);
+    QCOMPARE(proxy.rowCount(),3);
+
+    // Renaming a subject so that it no longer matches must hide its row:
+    apricot->setObjectName("Peach");
+    observer.refreshViewsData();
+    QCOMPARE(matches_spy.count(),2);
+    QCOMPARE(proxy.rowCount(),2);
+    QStringList shown_names;
+    for (int i = 0; i < proxy.rowCount(); ++i)
+        shown_names << proxy.data(proxy.index(i,model.columnPosition(AbstractObserverItemModel::ColumnName))).toString();
+    QVERIFY(shown_names.contains("Apple"));
+    QVERIFY(shown_names.contains("Apple Banana"));
+}
@@ -0,0 +1,56 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#ifndef TEST_OBSERVER_TABLE_MODEL_H
+#define TEST_OBSERVER_TABLE_MODEL_H
+
+#include "Testing_global.h"
+#include "ITestable.h"
+
+#include <QtTest/QtTest>
+
+namespace Qtilities {
+    namespace Testing {
+        using namespace Interfaces;
+
+        //! Allows testing of Qtilities::CoreGui::ObserverTableModel.
+        class TESTING_SHARED_EXPORT TestObserverTableModel: public QObject, public ITestable
+        {
+            Q_OBJECT
+            Q_INTERFACES(Qtilities::Testing::Interfaces::ITestable)
+
+        public:
+            // --------------------------------
+            // IObjectBase Implementation
+            // --------------------------------
+            QObject* objectBase() { return this; }
+            const QObject* objectBase() const { return this; }
+
+            // --------------------------------
+            // ITestable Implementation
+            // --------------------------------
+            int execTest(int argc = 0, char ** argv = 0);
+            QString testName() const { return tr("ObserverTableModel"); }
+
+        private slots:
+            //! Tests that rows follow subjects attached to and detached from the observer context.
+            void testAttachDetach();
+            //! Tests that rows follow subjects replaced during a processing cycle without the number of subjects changing.
+            void testProcessingCycleChanges();
+            //! Tests that names, modification states and categories shown follow changes which are not structural changes.
+            void testRowDataChanges();
+            //! Tests that rows shown by a proxy filter using an ObserverSearchIndex follow changes to the names of subjects.
+            void testSearchIndexFiltering();
+        };
+    }
+}
+
+#endif // TEST_OBSERVER_TABLE_MODEL_H
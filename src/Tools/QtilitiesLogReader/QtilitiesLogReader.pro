@@ -0,0 +1,32 @@
+# ***************************************************************************
+# Copyright (c) 2009-2013, Jaco Naude
+#
+# See http://www.qtilities.org/licensing.html for licensing details.
+#
+# ***************************************************************************
+QTILITIES += logging
+include(../../Qtilities.pri)
+
+QT       += core
+QT       -= gui
+
+TARGET    = QtilitiesLogReader
+CONFIG   += console
+CONFIG   -= app_bundle
+
+TEMPLATE = app
+DESTDIR = $$QTILITIES_BIN/Tools/QtilitiesLogReader
+
+# ------------------------------
+# Temp Output Paths
+# ------------------------------
+OBJECTS_DIR     = $$QTILITIES_TEMP/QtilitiesLogReader
+MOC_DIR         = $$QTILITIES_TEMP/QtilitiesLogReader
+RCC_DIR         = $$QTILITIES_TEMP/QtilitiesLogReader
+UI_DIR          = $$QTILITIES_TEMP/QtilitiesLogReader
+
+# --------------------------
+# Application Files
+# --------------------------
+SOURCES += main.cpp
+RC_FILE = rc_file.rc
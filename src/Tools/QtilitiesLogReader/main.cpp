@@ -0,0 +1,157 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#include <QCoreApplication>
+#include <QFile>
+#include <QFileInfo>
+#include <QStringList>
+#include <QTextStream>
+
+#include <QtilitiesLogging>
+using namespace QtilitiesLogging;
+
+#include <stdio.h>
+
+void printUsage(QTextStream& err) {
+    err << "Usage: QtilitiesLogReader <binary log file> [options]\n"
+        << "\n"
+        << "Converts a log file written by BinaryLoggerEngine to text.\n"
+        << "\n"
+        << "Options:\n"
+        << "  -o <file>        Writes the output to <file> instead of the standard output.\n"
+        << "  -f <format>      The name of the formatting engine to use, for example \"Default\", \"XML Format\" or \"HTML Format\".\n"
+        << "                   By default the format is determined from the extension of the output file.\n"
+        << "  -from <time>     Only includes messages logged at or after <time> (ISO 8601, for example 2013-05-01T14:30:00).\n"
+        << "  -to <time>       Only includes messages logged at or before <time>.\n"
+        << "  -types <types>   Only includes messages of the given comma separated types, for example Warning,Error,Fatal.\n"
+        << "  -info            Prints information about the file and its index instead of converting it.\n";
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication a(argc, argv);
+    QCoreApplication::setApplicationName("QtilitiesLogReader");
+
+    QTextStream err(stderr);
+    QStringList arguments = a.arguments();
+    arguments.removeFirst();
+    if (arguments.isEmpty() || arguments.contains("-h") || arguments.contains("-help")) {
+        printUsage(err);
+        return arguments.isEmpty() ? 1 : 0;
+    }
+
+    QString input_file_name;
+    QString output_file_name;
+    QString format_name;
+    QDateTime from;
+    QDateTime to;
+    Logger::MessageTypeFlags message_types = Logger::AllLogLevels;
+    bool info_only = false;
+
+    for (int i = 0; i < arguments.count(); ++i) {
+        const QString& argument = arguments.at(i);
+        const bool has_value = (i + 1 < arguments.count());
+        if (argument == "-info") {
+            info_only = true;
+        } else if (argument == "-o" && has_value) {
+            output_file_name = arguments.at(++i);
+        } else if (argument == "-f" && has_value) {
+            format_name = arguments.at(++i);
+        } else if ((argument == "-from" || argument == "-to") && has_value) {
+            QDateTime time = QDateTime::fromString(arguments.at(++i),Qt::ISODate);
+            if (!time.isValid()) {
+                err << "Invalid time: " << arguments.at(i) << "\n";
+                return 1;
+            }
+            if (argument == "-from")
+                from = time;
+            else
+                to = time;
+        } else if (argument == "-types" && has_value) {
+            message_types = 0;
+            QStringList types = arguments.at(++i).split(",",QString::SkipEmptyParts);
+            foreach (const QString& type, types) {
+                Logger::MessageType message_type = Log->stringToLogLevel(type.trimmed());
+                if (message_type == Logger::None && type.trimmed() != "None") {
+                    err << "Invalid message type: " << type << "\n";
+                    return 1;
+                }
+                message_types |= message_type;
+            }
+        } else if (input_file_name.isEmpty() && !argument.startsWith("-")) {
+            input_file_name = argument;
+        } else {
+            err << "Invalid argument: " << argument << "\n\n";
+            printUsage(err);
+            return 1;
+        }
+    }
+
+    if (input_file_name.isEmpty()) {
+        printUsage(err);
+        return 1;
+    }
+
+    BinaryLogReader reader;
+    QString errorMsg;
+    if (!reader.open(input_file_name,&errorMsg)) {
+        err << errorMsg << "\n";
+        return 1;
+    }
+    reader.setTimeRange(from,to);
+    reader.setMessageTypes(message_types);
+
+    if (info_only) {
+        QTextStream out(stdout);
+        out << "File:          " << reader.fileName() << "\n";
+        out << "Application:   " << reader.applicationName() << "\n";
+        out << "Session start: " << reader.sessionStart().toString(Qt::ISODate) << "\n";
+        out << "Finalized:     " << (reader.isFinalized() ? "Yes" : "No (the index was rebuilt)") << "\n";
+        out << "Segments:      " << reader.segmentCount() << "\n";
+
+        int count = 0;
+        BinaryLogRecord record;
+        while (reader.readNext(&record))
+            ++count;
+        out << "Matching messages: " << count << "\n";
+        out << "Skipped segments:  " << reader.skippedSegmentCount() << "\n";
+        return 0;
+    }
+
+    // The formatting engines are registered when the logger is initialized:
+    LOG_INITIALIZE();
+    AbstractFormattingEngine* formatting_engine = 0;
+    if (!format_name.isEmpty())
+        formatting_engine = Log->formattingEngineReference(format_name);
+    else if (!output_file_name.isEmpty())
+        formatting_engine = Log->formattingEngineReferenceFromExtension(QFileInfo(output_file_name).suffix());
+    if (!formatting_engine && format_name.isEmpty())
+        formatting_engine = Log->formattingEngineReference(qti_def_FORMATTING_ENGINE_DEFAULT);
+    if (!formatting_engine) {
+        err << "Unknown format: " << format_name << ". Available formats: " << Log->availableFormattingEnginesInFactory().join(", ") << "\n";
+        return 1;
+    }
+
+    int count = -1;
+    if (output_file_name.isEmpty()) {
+        QFile out;
+        out.open(stdout,QIODevice::WriteOnly | QIODevice::Text);
+        count = reader.convert(&out,formatting_engine);
+    } else {
+        count = reader.convert(output_file_name,formatting_engine,&errorMsg);
+    }
+
+    if (count < 0) {
+        err << errorMsg << "\n";
+        return 1;
+    }
+    return 0;
+}
@@ -101,11 +101,17 @@ int main(int argc, char *argv[])
     TestTreeFileItem* testTreeFileItem = new TestTreeFileItem;
     testFrontend.addTest(testTreeFileItem,QtilitiesCategory("Qtilities::CoreGui","::"));
 
+    TestObserverTableModel* testObserverTableModel = new TestObserverTableModel;
+    testFrontend.addTest(testObserverTableModel,QtilitiesCategory("Qtilities::CoreGui","::"));
+
     TestTask* testTask = new TestTask;
     testFrontend.addTest(testTask,QtilitiesCategory("Qtilities::Core","::"));
 
     TestFileSetInfo* testFileSetInfo = new TestFileSetInfo;
     testFrontend.addTest(testFileSetInfo,QtilitiesCategory("Qtilities::Core","::"));
+
+    TestBinaryLogger* testBinaryLogger = new TestBinaryLogger;
+    testFrontend.addTest(testBinaryLogger,QtilitiesCategory("Qtilities::Logging","::"));
     #endif
 
     // ---------------------------------------------
@@ -17,3 +17,4 @@ CONFIG     += ordered
 SUBDIRS    += \
     QtilitiesTester \
     QtilitiesModelTester \
+    QtilitiesLogReader \